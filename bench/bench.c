@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023-2025 defg43
+// https://github.com/defg43/
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// glibc specific: route the public allocator entry points through counters
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+size_t bench_malloc_calls = 0;
+size_t bench_realloc_calls = 0;
+size_t bench_free_calls = 0;
+
+void *malloc(size_t size) {
+    bench_malloc_calls++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    bench_malloc_calls++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    bench_realloc_calls++;
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+    if(ptr) bench_free_calls++;
+    __libc_free(ptr);
+}
+
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+benchTimer_t benchStart(const char *name) {
+    return (benchTimer_t) {
+        .name = name,
+        .start_mallocs = bench_malloc_calls,
+        .start_reallocs = bench_realloc_calls,
+        .start_ns = nowNs(),
+    };
+}
+
+void benchStop(benchTimer_t timer, size_t ops) {
+    double elapsed = nowNs() - timer.start_ns;
+    size_t mallocs = bench_malloc_calls - timer.start_mallocs;
+    size_t reallocs = bench_realloc_calls - timer.start_reallocs;
+    printf("%-40s %10.2f ms %12.1f Mops/s %8.3f malloc/op %8.3f realloc/op\n",
+        timer.name, elapsed / 1e6, ops / (elapsed / 1e3),
+        (double)mallocs / ops, (double)reallocs / ops);
+}
+
+int bench_str(void);
+int bench_rope(void);
+int bench_strindex(void);
+
+int main(void) {
+    bench_str();
+    bench_rope();
+    bench_strindex();
+    return 0;
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023-2025 defg43
+// https://github.com/defg43/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// allocator calls since program start, counted by the malloc wrappers in bench.c
+extern size_t bench_malloc_calls;
+extern size_t bench_realloc_calls;
+extern size_t bench_free_calls;
+
+typedef struct {
+    const char *name;
+    double start_ns;
+    size_t start_mallocs;
+    size_t start_reallocs;
+} benchTimer_t;
+
+benchTimer_t benchStart(const char *name);
+/** Print elapsed time, throughput and allocator calls per operation */
+void benchStop(benchTimer_t timer, size_t ops);
+
+// keeps the optimizer from discarding benchmark results
+static inline void benchSink(uint64_t value) {
+    __asm__ volatile("" : : "r"(value) : "memory");
+}
+
+#endif // BENCH_H
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023-2025 defg43
+// https://github.com/defg43/
+
+#include "../include/chad/rope.h"
+#include "bench.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LINES 32768
+#define LINE "a report line of roughly sixty four bytes, ending in a newline\n"
+
+static void bench_prepend_lines(void) {
+    // assembling a 2 MiB report back to front
+    strview line = strview(LINE);
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("prepend 32k lines, string");
+    string flat = stringFromCharPtr("");
+    for(size_t i = 0; i < LINES; i++) {
+        flat = stringPrependCharPtr(flat, LINE);
+    }
+    total += stringlen(flat);
+    benchStop(t, LINES);
+    destroyString(flat);
+
+    t = benchStart("prepend 32k lines, rope");
+    rope_t rope = ropeCreate();
+    for(size_t i = 0; i < LINES; i++) {
+        ropePrepend(&rope, line);
+    }
+    string out = ropeToString(rope);
+    total += stringlen(out);
+    benchStop(t, LINES);
+    destroyString(out);
+    destroyRope(rope);
+    benchSink(total);
+}
+
+static void bench_insert_middle(void) {
+    // every line goes into the middle of what was written so far
+    strview line = strview(LINE);
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("insert 32k lines mid, string");
+    string flat = stringFromCharPtr("");
+    for(size_t i = 0; i < LINES; i++) {
+        // open a gap in place, the best a flat buffer can do
+        size_t at = stringlen(flat) / 2;
+        size_t length = stringlen(flat);
+        flat = stringGrowBuffer(flat, line.length);
+        memmove(flat.at + at + line.length, flat.at + at, length - at);
+        memcpy(flat.at + at, line.at, line.length);
+        getHeaderPointer(flat)->length = length + line.length;
+        flat.at[length + line.length] = '\0';
+        stringInvalidate(flat);
+    }
+    total += stringlen(flat);
+    benchStop(t, LINES);
+    destroyString(flat);
+
+    t = benchStart("insert 32k lines mid, rope");
+    rope_t rope = ropeCreate();
+    for(size_t i = 0; i < LINES; i++) {
+        ropeInsert(&rope, ropeLength(rope) / 2, line);
+    }
+    string out = ropeToString(rope);
+    total += stringlen(out);
+    benchStop(t, LINES);
+    destroyString(out);
+    destroyRope(rope);
+    benchSink(total);
+}
+
+int bench_rope(void) {
+    printf("\n-- rope --\n");
+    bench_prepend_lines();
+    bench_insert_middle();
+    return 0;
+}
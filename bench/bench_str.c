@@ -0,0 +1,1276 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023-2025 defg43
+// https://github.com/defg43/
+
+#include "../include/chad/str.h"
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define ROUNDS 1000000
+
+static const char *short_keys[] = {
+    "id", "name", "type", "value", "[", "{", "timestamp", "user_id",
+    "status", "x", "y", "created_at", "tags", "enabled", "count", "parent",
+};
+#define SHORT_KEY_COUNT (sizeof(short_keys) / sizeof(short_keys[0]))
+
+static void bench_small_from_charptr(void) {
+    uint64_t total = 0;
+    benchTimer_t t = benchStart("short stringFromCharPtr + destroy");
+    for(size_t i = 0; i < ROUNDS; i++) {
+        string s = stringFromCharPtr(short_keys[i % SHORT_KEY_COUNT]);
+        total += stringlen(s);
+        destroyString(s);
+    }
+    benchStop(t, ROUNDS);
+    benchSink(total);
+}
+
+static void bench_small_slices(void) {
+    uint64_t total = 0;
+    string src = stringFromCharPtr("{\"id\": 1, \"name\": \"value\", \"timestamp\": 1700000000}");
+    size_t len = stringlen(src);
+    benchTimer_t t = benchStart("short stringSliceFromString + destroy");
+    for(size_t i = 0; i < ROUNDS; i++) {
+        size_t start = i % (len - 8);
+        string s = stringSliceFromString(src, start, start + 1 + i % 8);
+        total += stringlen(s) + (unsigned char)s.at[0];
+        destroyString(s);
+    }
+    benchStop(t, ROUNDS);
+    benchSink(total);
+    destroyString(src);
+}
+
+static void bench_small_live_set(void) {
+    // many short strings alive at once, like the keys of a parsed document
+    enum { live = 4096 };
+    static string keys[live];
+    uint64_t total = 0;
+    benchTimer_t t = benchStart("short strings, 4096 live at once");
+    for(size_t round = 0; round < ROUNDS / live; round++) {
+        for(size_t i = 0; i < live; i++) {
+            keys[i] = stringFromCharPtr(short_keys[(i + round) % SHORT_KEY_COUNT]);
+        }
+        for(size_t i = 0; i < live; i++) {
+            total += stringlen(keys[i]);
+            destroyString(keys[i]);
+        }
+    }
+    benchStop(t, ROUNDS / live * live);
+    benchSink(total);
+}
+
+static void bench_append_chars(void) {
+    enum { count = 1000000 };
+    benchTimer_t t = benchStart("stringAppendChar x 1M");
+    string s = stringFromCharPtr("");
+    for(size_t i = 0; i < count; i++) {
+        s = stringAppendChar(s, (char)('a' + i % 26));
+    }
+    benchStop(t, count);
+    benchSink(stringlen(s));
+    destroyString(s);
+}
+
+// the byte-at-a-time loop stringFindFrom used before the search engine, kept as a reference
+static int naive_find(strview haystack, strview needle) {
+    for(size_t i = 0; i + needle.length <= haystack.length; i++) {
+        if(haystack.at[i] == needle.at[0] && memcmp(haystack.at + i, needle.at, needle.length) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static void bench_find(const char *label, strview haystack, strview needle, bool naive) {
+    enum { rounds = 200 };
+    uint64_t total = 0;
+    benchTimer_t t = benchStart(label);
+    for(size_t i = 0; i < rounds; i++) {
+        total += naive ? naive_find(haystack, needle) : strviewFind(haystack, needle);
+    }
+    benchStop(t, rounds);
+    benchSink(total);
+}
+
+static void bench_search(void) {
+    // 1 MiB of lowercase prose-like text with the needle only at the very end
+    enum { size = 1 << 20 };
+    static char text[size];
+    uint32_t seed = 1;
+    for(size_t i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        text[i] = (seed >> 16) % 6 == 0 ? ' ' : (char)('a' + (seed >> 16) % 26);
+    }
+    const char *short_needle = "needle";
+    const char *long_needle = "the quick brown fox jumps over the lazy dog and keeps running";
+    memcpy(text + size - strlen(long_needle), long_needle, strlen(long_needle));
+    memcpy(text + size - strlen(long_needle) - 8, short_needle, strlen(short_needle));
+
+    strview haystack = strviewFromParts(text, size);
+    strview s = strviewFromCharPtr(short_needle);
+    strview l = strviewFromCharPtr(long_needle);
+    bench_find("find 6-byte needle in 1 MiB, naive loop", haystack, s, true);
+    bench_find("find 6-byte needle in 1 MiB, stringFind", haystack, s, false);
+    bench_find("find 61-byte needle in 1 MiB, naive loop", haystack, l, true);
+    bench_find("find 61-byte needle in 1 MiB, stringFind", haystack, l, false);
+}
+
+static void bench_replace_many(void) {
+    // a sanitization pass: 24 escapes applied to 64 KiB records, chained vs one automaton
+    enum { rounds = 50, patterns = 24 };
+    const char *from[patterns] = {
+        "&", "<", ">", "\"", "'", "\t", "\r", "\\", "javascript:", "onload=", "onerror=", "<script",
+        "</script", "eval(", "document.", "window.", "--", "/*", "*/", "%00", "\x7f", "${", "`", "|",
+    };
+    string finds[patterns], replaces[patterns];
+    for(size_t i = 0; i < patterns; i++) {
+        finds[i] = stringFromCharPtr((char *)from[i]);
+        replaces[i] = stringFromCharPtr("_");
+    }
+    static char text[1 << 16];
+    uint32_t seed = 3;
+    for(size_t i = 0; i < sizeof text - 1; i++) {
+        seed = seed * 1103515245 + 12345;
+        unsigned r = (seed >> 16) % 64;
+        text[i] = r < 4 ? "&<'\""[r] : r < 12 ? ' ' : (char)('a' + r % 26);
+    }
+    text[sizeof text - 1] = '\0';
+    string record = stringFromCharPtr(text);
+
+    uint64_t total = 0;
+    benchTimer_t t = benchStart("24 replacements on 64 KiB, chained");
+    for(size_t round = 0; round < rounds; round++) {
+        string current = stringFromString(record);
+        for(size_t i = 0; i < patterns; i++) {
+            string next = stringReplace(current, finds[i], replaces[i]);
+            destroyString(current);
+            current = next;
+        }
+        total += stringlen(current);
+        destroyString(current);
+    }
+    benchStop(t, rounds);
+
+    stringReplacer_t *replacer = stringReplacerCreate(finds, replaces, patterns);
+    t = benchStart("24 replacements on 64 KiB, stringReplacer");
+    for(size_t round = 0; round < rounds; round++) {
+        string result = stringReplacerApply(replacer, record);
+        total += stringlen(result);
+        destroyString(result);
+    }
+    benchStop(t, rounds);
+    benchSink(total);
+
+    stringReplacerDestroy(replacer);
+    destroyString(record);
+    for(size_t i = 0; i < patterns; i++) {
+        destroyString(finds[i]);
+        destroyString(replaces[i]);
+    }
+}
+
+static void bench_split_fields(void) {
+    // a 40 field record of which only fields 3 and 17 are wanted
+    enum { rounds = 100000 };
+    string line = stringFromCharPtr("");
+    for(size_t i = 0; i < 40; i++) {
+        line = stringAppendCharPtr(line, i ? ",field_value" : "field_value");
+    }
+    string comma = stringFromCharPtr(",");
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("2 of 40 fields, stringSplit");
+    for(size_t round = 0; round < rounds; round++) {
+        dynarray(string) fields = stringSplit(line, comma);
+        total += stringlen(fields.at[3]) + stringlen(fields.at[17]);
+        for(size_t i = 0; i < fields.count; i++) {
+            destroyString(fields.at[i]);
+        }
+        free(fields.at);
+    }
+    benchStop(t, rounds);
+
+    t = benchStart("2 of 40 fields, stringSplitIter");
+    for(size_t round = 0; round < rounds; round++) {
+        stringSplitIter_t it = stringSplitIter(line, comma);
+        strview field;
+        for(size_t i = 0; i <= 17 && stringSplitNext(&it, &field); i++) {
+            if(i == 3 || i == 17) total += field.length;
+        }
+    }
+    benchStop(t, rounds);
+    benchSink(total);
+    destroyString(line);
+    destroyString(comma);
+}
+
+// the lead byte driven loop stringUtf8Validate used before, kept as a reference
+static bool lead_byte_validate(const unsigned char *at, size_t len) {
+    for(size_t i = 0; i < len; ) {
+        unsigned char c = at[i];
+        if((c & 0x80) == 0) {
+            i += 1;
+        } else if((c & 0xE0) == 0xC0) {
+            if(i + 1 >= len || (at[i + 1] & 0xC0) != 0x80) return false;
+            i += 2;
+        } else if((c & 0xF0) == 0xE0) {
+            if(i + 2 >= len || (at[i + 1] & 0xC0) != 0x80 || (at[i + 2] & 0xC0) != 0x80) return false;
+            i += 3;
+        } else if((c & 0xF8) == 0xF0) {
+            if(i + 3 >= len || (at[i + 1] & 0xC0) != 0x80 ||
+               (at[i + 2] & 0xC0) != 0x80 || (at[i + 3] & 0xC0) != 0x80) return false;
+            i += 4;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void bench_utf8(void) {
+    enum { size = 1 << 20, rounds = 200 };
+    static char ascii[size], mixed[size];
+    static const char *pieces[] = { "plain ascii text ", "caf\xC3\xA9 ", "\xE2\x82\xAC" "5 ", "\xF0\x9F\x98\x80 ", "\xE6\x97\xA5\xE6\x9C\xAC " };
+    size_t filled = 0;
+    uint32_t seed = 5;
+    while(filled < size - 32) {
+        seed = seed * 1103515245 + 12345;
+        const char *piece = pieces[(seed >> 16) % 5];
+        memcpy(mixed + filled, piece, strlen(piece));
+        filled += strlen(piece);
+    }
+    memset(mixed + filled, ' ', size - filled);
+    for(size_t i = 0; i < size; i++) {
+        ascii[i] = (char)('a' + i % 26);
+    }
+
+    uint64_t total = 0;
+    benchTimer_t t = benchStart("validate 1 MiB ascii, lead byte loop");
+    for(size_t i = 0; i < rounds; i++) total += lead_byte_validate((unsigned char *)ascii, size);
+    benchStop(t, rounds);
+    t = benchStart("validate 1 MiB ascii, strviewUtf8Validate");
+    for(size_t i = 0; i < rounds; i++) total += strviewUtf8Validate(strviewFromParts(ascii, size));
+    benchStop(t, rounds);
+    t = benchStart("validate 1 MiB mixed, lead byte loop");
+    for(size_t i = 0; i < rounds; i++) total += lead_byte_validate((unsigned char *)mixed, size);
+    benchStop(t, rounds);
+    t = benchStart("validate 1 MiB mixed, strviewUtf8Validate");
+    for(size_t i = 0; i < rounds; i++) total += strviewUtf8Validate(strviewFromParts(mixed, size));
+    benchStop(t, rounds);
+    t = benchStart("count 1 MiB mixed, strviewUtf8Length");
+    for(size_t i = 0; i < rounds; i++) total += strviewUtf8Length(strviewFromParts(mixed, size));
+    benchStop(t, rounds);
+    benchSink(total);
+}
+
+// the walk from byte 0 that stringUtf8At did on every call before the index
+static size_t walk_to_char(string str, size_t char_index) {
+    size_t byte_pos = 0;
+    for(size_t count = 0; byte_pos < stringlen(str) && count < char_index; count++) {
+        unsigned char c = str.at[byte_pos];
+        byte_pos += (c & 0x80) == 0 ? 1 : (c & 0xE0) == 0xC0 ? 2 : (c & 0xF0) == 0xE0 ? 3 : (c & 0xF8) == 0xF0 ? 4 : 1;
+    }
+    return byte_pos;
+}
+
+static void bench_utf8_at(void) {
+    enum { chars = 20000 };
+    static const char *glyphs[] = { "a", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80" };
+    string text = stringFromCharPtr("");
+    for(size_t i = 0; i < chars; i++) {
+        text = stringAppendCharPtr(text, (char *)glyphs[i % 4]);
+    }
+    uint64_t total = 0;
+    benchTimer_t t = benchStart("iterate 20k chars by index, walk from 0");
+    for(size_t i = 0; i < chars; i++) {
+        total += walk_to_char(text, i);
+    }
+    benchStop(t, chars);
+    t = benchStart("iterate 20k chars by index, stringUtf8At");
+    for(size_t i = 0; i < chars; i++) {
+        string c = stringUtf8At(text, i);
+        total += stringlen(c);
+        destroyString(c);
+    }
+    benchStop(t, chars);
+    benchSink(total);
+    destroyString(text);
+}
+
+// the byte at a time FNV-1a that strviewHash used before, kept as a reference
+static uint64_t fnv1a(const char *at, size_t len) {
+    uint64_t hash = 14695981039346656037ULL;
+    for(size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)at[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void bench_hash(void) {
+    static char data[4096];
+    for(size_t i = 0; i < sizeof data; i++) {
+        data[i] = (char)('a' + i * 7 % 26);
+    }
+    static const size_t lengths[] = { 8, 32, 256, 4096 };
+    uint64_t total = 0;
+    char label[64];
+    for(size_t l = 0; l < sizeof lengths / sizeof lengths[0]; l++) {
+        size_t len = lengths[l];
+        size_t rounds = (64u << 20) / len;
+        snprintf(label, sizeof label, "hash %zu bytes, fnv-1a", len);
+        benchTimer_t t = benchStart(label);
+        for(size_t i = 0; i < rounds; i++) {
+            total += fnv1a(data + (i & 7), len - (i & 7));
+        }
+        benchStop(t, rounds);
+        snprintf(label, sizeof label, "hash %zu bytes, strviewHash", len);
+        t = benchStart(label);
+        for(size_t i = 0; i < rounds; i++) {
+            total += strviewHash(strviewFromParts(data + (i & 7), len - (i & 7)));
+        }
+        benchStop(t, rounds);
+    }
+    string key = stringFromCharPtr("timestamp");
+    benchTimer_t t = benchStart("stringHash64 of the same key, cached");
+    for(size_t i = 0; i < ROUNDS; i++) {
+        total += stringHash64(key);
+    }
+    benchStop(t, ROUNDS);
+    benchSink(total);
+    destroyString(key);
+}
+
+static void bench_intern(void) {
+    // looking up a key among the 16 keys of a record, plain copies vs interned keys
+    string plain[SHORT_KEY_COUNT], interned[SHORT_KEY_COUNT];
+    for(size_t i = 0; i < SHORT_KEY_COUNT; i++) {
+        plain[i] = stringFromCharPtr((char *)short_keys[i]);
+        interned[i] = stringIntern(strviewFromCharPtr(short_keys[i]));
+    }
+    string wanted_plain = stringFromCharPtr("parent");
+    string wanted_interned = stringIntern(strview("parent"));
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("find key among 16, stringeql on copies");
+    for(size_t round = 0; round < ROUNDS; round++) {
+        for(size_t i = 0; i < SHORT_KEY_COUNT; i++) {
+            if(stringeql(plain[i], wanted_plain)) { total += i; break; }
+        }
+    }
+    benchStop(t, ROUNDS);
+    t = benchStart("find key among 16, interned pointers");
+    for(size_t round = 0; round < ROUNDS; round++) {
+        for(size_t i = 0; i < SHORT_KEY_COUNT; i++) {
+            if(interned[i].data == wanted_interned.data) { total += i; break; }
+        }
+    }
+    benchStop(t, ROUNDS);
+    t = benchStart("stringIntern of an existing key");
+    for(size_t round = 0; round < ROUNDS; round++) {
+        total += (uintptr_t)stringIntern(strviewFromCharPtr(short_keys[round % SHORT_KEY_COUNT])).data;
+    }
+    benchStop(t, ROUNDS);
+    benchSink(total);
+
+    for(size_t i = 0; i < SHORT_KEY_COUNT; i++) {
+        destroyString(plain[i]);
+    }
+    destroyString(wanted_plain);
+    stringInternReset();
+}
+
+static void bench_copy(void) {
+    // copying a 4 KiB value the way a deep copy of a document tree does, and copying then editing
+    char text[4096];
+    for(size_t i = 0; i < sizeof text - 1; i++) {
+        text[i] = 'a' + i % 26;
+    }
+    text[sizeof text - 1] = '\0';
+    string value = stringFromCharPtr(text);
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("stringFromString of 4 KiB, then destroy");
+    for(size_t round = 0; round < ROUNDS; round++) {
+        string copy = stringFromString(value);
+        total += stringlen(copy);
+        destroyString(copy);
+    }
+    benchStop(t, ROUNDS);
+    t = benchStart("stringFromString of 4 KiB, append one char");
+    for(size_t round = 0; round < ROUNDS; round++) {
+        string copy = stringFromString(value);
+        copy = stringAppendChar(copy, '!');
+        total += stringlen(copy);
+        destroyString(copy);
+    }
+    benchStop(t, ROUNDS);
+    benchSink(total);
+    destroyString(value);
+}
+
+// the per byte ctype loops the ascii kernels replaced
+static string naiveToLower(string str) {
+    string result = stringClone(str);
+    for(size_t i = 0; i < stringlen(result); i++) {
+        result.at[i] = tolower((unsigned char)result.at[i]);
+    }
+    return result;
+}
+
+static bool naiveIsAlpha(string str) {
+    for(size_t i = 0; i < stringlen(str); i++) {
+        if(!isalpha((unsigned char)str.at[i])) return false;
+    }
+    return stringlen(str) > 0;
+}
+
+static void bench_ascii(void) {
+    static const char *headers[] = {
+        "Content-Type", "Accept-Encoding", "X-Forwarded-For", "Cache-Control",
+        "Authorization", "User-Agent", "If-None-Match", "Strict-Transport-Security",
+    };
+    string keys[8];
+    for(size_t i = 0; i < 8; i++) {
+        keys[i] = stringFromCharPtr(headers[i]);
+    }
+    char text[4096];
+    for(size_t i = 0; i < sizeof text - 1; i++) {
+        text[i] = "AbCdEfGhIjKlMnOpQrStUvWxYz"[i % 26];
+    }
+    text[sizeof text - 1] = '\0';
+    string large = stringFromCharPtr(text);
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("header names, per byte tolower");
+    for(size_t round = 0; round < ROUNDS; round++) {
+        string lower = naiveToLower(keys[round % 8]);
+        total += (unsigned char)lower.at[0];
+        destroyString(lower);
+    }
+    benchStop(t, ROUNDS);
+    t = benchStart("header names, stringToLower");
+    for(size_t round = 0; round < ROUNDS; round++) {
+        string lower = stringToLower(keys[round % 8]);
+        total += (unsigned char)lower.at[0];
+        destroyString(lower);
+    }
+    benchStop(t, ROUNDS);
+    t = benchStart("header names, stringToLowerInPlace");
+    for(size_t round = 0; round < ROUNDS; round++) {
+        keys[round % 8] = stringToLowerInPlace(keys[round % 8]);
+        total += (unsigned char)keys[round % 8].at[0];
+    }
+    benchStop(t, ROUNDS);
+
+    size_t large_rounds = ROUNDS / 100;
+    t = benchStart("4 KiB, per byte tolower");
+    for(size_t round = 0; round < large_rounds; round++) {
+        string lower = naiveToLower(large);
+        total += (unsigned char)lower.at[round % 4000];
+        destroyString(lower);
+    }
+    benchStop(t, large_rounds);
+    t = benchStart("4 KiB, stringToLower");
+    for(size_t round = 0; round < large_rounds; round++) {
+        string lower = stringToLower(large);
+        total += (unsigned char)lower.at[round % 4000];
+        destroyString(lower);
+    }
+    benchStop(t, large_rounds);
+    t = benchStart("4 KiB, per byte isalpha");
+    for(size_t round = 0; round < large_rounds; round++) {
+        total += naiveIsAlpha(large);
+    }
+    benchStop(t, large_rounds);
+    t = benchStart("4 KiB, stringIsAlpha");
+    for(size_t round = 0; round < large_rounds; round++) {
+        total += stringIsAlpha(large);
+    }
+    benchStop(t, large_rounds);
+    t = benchStart("4 KiB, stringcmpIgnoreCase");
+    string upper = stringToUpper(large);
+    for(size_t round = 0; round < large_rounds; round++) {
+        total += stringcmpIgnoreCase(large, upper) == 0;
+    }
+    benchStop(t, large_rounds);
+    benchSink(total);
+
+    destroyString(upper);
+    destroyString(large);
+    for(size_t i = 0; i < 8; i++) {
+        destroyString(keys[i]);
+    }
+}
+
+static void bench_builder(void) {
+    // a CSV-like report: short fields, a formatted number and a separator per record
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("1M records, stringAppend + stringFormat");
+    string flat = stringFromCharPtr("");
+    for(size_t round = 0; round < ROUNDS; round++) {
+        flat = stringAppendCharPtr(flat, short_keys[round % SHORT_KEY_COUNT]);
+        string number = stringFormat(";%zu;", round);
+        flat = stringAppendString(flat, number);
+        destroyString(number);
+        flat = stringAppendChar(flat, '\n');
+    }
+    string copy = stringClone(flat);
+    total += stringlen(copy);
+    benchStop(t, ROUNDS);
+    destroyString(copy);
+    destroyString(flat);
+
+    t = benchStart("1M records, stringBuilder + Finish");
+    stringBuilder_t sb = stringBuilderCreate(0);
+    for(size_t round = 0; round < ROUNDS; round++) {
+        stringBuilderAppendCStr(&sb, short_keys[round % SHORT_KEY_COUNT]);
+        stringBuilderAppendFormat(&sb, ";%zu;", round);
+        stringBuilderAppendChar(&sb, '\n');
+    }
+    string done = stringBuilderFinish(&sb);
+    total += stringlen(done);
+    benchStop(t, ROUNDS);
+    destroyString(done);
+
+    t = benchStart("1M records, chunked stringBuilder");
+    stringBuilder_t chunked = stringBuilderCreateChunked(0);
+    for(size_t round = 0; round < ROUNDS; round++) {
+        stringBuilderAppendCStr(&chunked, short_keys[round % SHORT_KEY_COUNT]);
+        stringBuilderAppendFormat(&chunked, ";%zu;", round);
+        stringBuilderAppendChar(&chunked, '\n');
+    }
+    dynarray(string) chunks = stringBuilderFinishChunks(&chunked);
+    for(size_t i = 0; i < chunks.count; i++) {
+        total += stringlen(chunks.at[i]);
+        destroyString(chunks.at[i]);
+    }
+    destroy_dynarray(chunks);
+    benchStop(t, ROUNDS);
+    benchSink(total);
+}
+
+// one character at a time through a 256 entry table
+static size_t naiveBase64Decode(const char *src, size_t len, unsigned char *dst) {
+    static const char chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    uint8_t table[256];
+    for(size_t i = 0; i < 64; i++) table[(unsigned char)chars[i]] = (uint8_t)i;
+    uint32_t bits = 0;
+    size_t count = 0, o = 0;
+    for(size_t i = 0; i < len && src[i] != '='; i++) {
+        bits = bits << 6 | table[(unsigned char)src[i]];
+        if(++count == 4) {
+            dst[o++] = (unsigned char)(bits >> 16);
+            dst[o++] = (unsigned char)(bits >> 8);
+            dst[o++] = (unsigned char)bits;
+            bits = 0;
+            count = 0;
+        }
+    }
+    return o;
+}
+
+static void naiveBase64Encode(const unsigned char *src, size_t len, char *dst) {
+    static const char chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for(size_t i = 0; i + 3 <= len; i += 3) {
+        *dst++ = chars[src[i] >> 2];
+        *dst++ = chars[((src[i] & 0x03) << 4) | (src[i + 1] >> 4)];
+        *dst++ = chars[((src[i + 1] & 0x0f) << 2) | (src[i + 2] >> 6)];
+        *dst++ = chars[src[i + 2] & 0x3f];
+    }
+}
+
+static void bench_numbers(void) {
+    enum { count = 1 << 20 };
+    int64_t *ints = malloc(count * sizeof *ints);
+    double *doubles = malloc(count * sizeof *doubles);
+    uint64_t seed = 11;
+    for(size_t i = 0; i < count; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        ints[i] = (int64_t)seed >> (seed % 48);
+        doubles[i] = (double)(int64_t)(seed >> 11) / (double)(1ull << (seed % 40));
+    }
+    uint64_t total = 0;
+    char buffer[64];
+
+    benchTimer_t t = benchStart("1M integers, snprintf into a string");
+    for(size_t i = 0; i < count; i++) {
+        snprintf(buffer, sizeof buffer, "%lld", (long long)ints[i]);
+        string s = stringFromCharPtr(buffer);
+        total += stringlen(s);
+        destroyString(s);
+    }
+    benchStop(t, count);
+
+    t = benchStart("1M integers, stringFromInt64");
+    for(size_t i = 0; i < count; i++) {
+        string s = stringFromInt64(ints[i]);
+        total += stringlen(s);
+        destroyString(s);
+    }
+    benchStop(t, count);
+
+    t = benchStart("1M doubles, snprintf %.17g into a string");
+    for(size_t i = 0; i < count; i++) {
+        snprintf(buffer, sizeof buffer, "%.17g", doubles[i]);
+        string s = stringFromCharPtr(buffer);
+        total += stringlen(s);
+        destroyString(s);
+    }
+    benchStop(t, count);
+
+    t = benchStart("1M doubles, shortest stringFromDouble");
+    for(size_t i = 0; i < count; i++) {
+        string s = stringFromDouble(doubles[i], -1);
+        total += stringlen(s);
+        destroyString(s);
+    }
+    benchStop(t, count);
+
+    t = benchStart("1M integers, builder AppendFormat %lld");
+    stringBuilder_t sb = stringBuilderCreate(0);
+    for(size_t i = 0; i < count; i++) stringBuilderAppendFormat(&sb, "%lld,", (long long)ints[i]);
+    total += stringBuilderLength(&sb);
+    stringBuilderDestroy(&sb);
+    benchStop(t, count);
+
+    t = benchStart("1M integers, builder AppendInt");
+    sb = stringBuilderCreate(0);
+    for(size_t i = 0; i < count; i++) {
+        stringBuilderAppendInt(&sb, ints[i]);
+        stringBuilderAppendChar(&sb, ',');
+    }
+    total += stringBuilderLength(&sb);
+    stringBuilderDestroy(&sb);
+    benchStop(t, count);
+
+    free(doubles);
+    free(ints);
+    benchSink(total);
+}
+
+static void bench_parse_numbers(void) {
+    enum { count = 1 << 20 };
+    // NUL separated so that strtol and strtod get their terminator for free
+    char *ints = malloc(count * 24), *doubles = malloc(count * 32);
+    strview *int_views = malloc(count * sizeof *int_views), *double_views = malloc(count * sizeof *double_views);
+    size_t int_length = 0, double_length = 0;
+    uint64_t seed = 23;
+    for(size_t i = 0; i < count; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        int n = snprintf(ints + int_length, 24, "%lld", (long long)((int64_t)seed >> (seed % 48)));
+        int_views[i] = strviewFromParts(ints + int_length, (size_t)n);
+        int_length += (size_t)n + 1;
+        double d = (double)(int64_t)(seed >> 11) / (double)(1ull << (seed % 40));
+        n = snprintf(doubles + double_length, 32, i % 2 ? "%.17g" : "%g", d);
+        double_views[i] = strviewFromParts(doubles + double_length, (size_t)n);
+        double_length += (size_t)n + 1;
+    }
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("1M integers, strtoll");
+    for(size_t i = 0; i < count; i++) total += (uint64_t)strtoll(int_views[i].at, NULL, 10);
+    benchStop(t, count);
+
+    t = benchStart("1M integers, strviewToInt64");
+    for(size_t i = 0; i < count; i++) {
+        int64_t value;
+        strviewToInt64(int_views[i], &value);
+        total += (uint64_t)value;
+    }
+    benchStop(t, count);
+
+    double sum = 0;
+    t = benchStart("1M doubles, strtod");
+    for(size_t i = 0; i < count; i++) sum += strtod(double_views[i].at, NULL);
+    benchStop(t, count);
+
+    t = benchStart("1M doubles, strviewToDouble");
+    for(size_t i = 0; i < count; i++) {
+        double value;
+        strviewToDouble(double_views[i], &value);
+        sum += value;
+    }
+    benchStop(t, count);
+
+    free(double_views);
+    free(int_views);
+    free(doubles);
+    free(ints);
+    benchSink(total + (uint64_t)(sum != 0));
+}
+
+// the byte at a time versions stringEscapeC, stringToHex and stringFromHex replaced
+static string naiveEscapeC(string str) {
+    stringBuilder_t sb = stringBuilderCreate(stringlen(str) * 2);
+    for(size_t i = 0; i < stringlen(str); i++) {
+        char ch = str.at[i];
+        switch(ch) {
+            case '\n': stringBuilderAppendCStr(&sb, "\\n"); break;
+            case '\r': stringBuilderAppendCStr(&sb, "\\r"); break;
+            case '\t': stringBuilderAppendCStr(&sb, "\\t"); break;
+            case '\b': stringBuilderAppendCStr(&sb, "\\b"); break;
+            case '\f': stringBuilderAppendCStr(&sb, "\\f"); break;
+            case '\\': stringBuilderAppendCStr(&sb, "\\\\"); break;
+            case '\"': stringBuilderAppendCStr(&sb, "\\\""); break;
+            case '\'': stringBuilderAppendCStr(&sb, "\\'"); break;
+            default:
+                if(ch >= 32 && ch <= 126) {
+                    stringBuilderAppendChar(&sb, ch);
+                } else {
+                    char hex[8];
+                    snprintf(hex, sizeof(hex), "\\x%02x", (unsigned char)ch);
+                    stringBuilderAppendCStr(&sb, hex);
+                }
+                break;
+        }
+    }
+    return stringBuilderFinish(&sb);
+}
+
+static string naiveToHex(string str) {
+    stringBuilder_t sb = stringBuilderCreate(stringlen(str) * 2);
+    for(size_t i = 0; i < stringlen(str); i++) {
+        char hex[3];
+        snprintf(hex, sizeof(hex), "%02x", (unsigned char)str.at[i]);
+        stringBuilderAppendCStr(&sb, hex);
+    }
+    return stringBuilderFinish(&sb);
+}
+
+static size_t naiveFromHex(string hex_str, unsigned char *out) {
+    for(size_t i = 0; i < stringlen(hex_str) / 2; i++) {
+        char hex[3] = {hex_str.at[i*2], hex_str.at[i*2+1], '\0'};
+        out[i] = (unsigned char)strtol(hex, NULL, 16);
+    }
+    return stringlen(hex_str) / 2;
+}
+
+static void bench_escape_hex(void) {
+    enum { payload = 8 << 20, repeats = 4 };
+    // prose with a quote or newline every 80 bytes or so, like most string fields
+    char *text = malloc(payload);
+    uint64_t seed = 13;
+    for(size_t i = 0; i < payload; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        text[i] = (seed >> 56) % 80 == 0 ? "\"\n"[(seed >> 20) & 1] : (char)('a' + (seed >> 40) % 26);
+    }
+    string prose = stringFromStrview(strviewFromParts(text, payload));
+    for(size_t i = 0; i < payload; i++) text[i] = (char)(i * 2654435761u >> 24);
+    string blob = stringFromStrview(strviewFromParts(text, payload));
+    unsigned char *back = malloc(payload);
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("8 MiB escape, byte at a time");
+    for(size_t r = 0; r < repeats; r++) {
+        string e = naiveEscapeC(prose);
+        total += stringlen(e);
+        destroyString(e);
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("8 MiB escape, stringEscapeC");
+    for(size_t r = 0; r < repeats; r++) {
+        string e = stringEscapeC(prose);
+        total += stringlen(e);
+        destroyString(e);
+    }
+    benchStop(t, repeats);
+
+    string escaped = stringEscapeC(prose);
+    t = benchStart("8 MiB unescape, stringUnescapeC");
+    for(size_t r = 0; r < repeats; r++) {
+        string u = stringUnescapeC(escaped);
+        total += stringlen(u);
+        destroyString(u);
+    }
+    benchStop(t, repeats);
+    destroyString(escaped);
+
+    t = benchStart("8 MiB to hex, snprintf per byte");
+    for(size_t r = 0; r < repeats; r++) {
+        string h = naiveToHex(blob);
+        total += stringlen(h);
+        destroyString(h);
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("8 MiB to hex, stringToHex");
+    for(size_t r = 0; r < repeats; r++) {
+        string h = stringToHex(blob);
+        total += stringlen(h);
+        destroyString(h);
+    }
+    benchStop(t, repeats);
+
+    string hex = stringToHex(blob);
+    t = benchStart("8 MiB from hex, strtol per pair");
+    for(size_t r = 0; r < repeats; r++) total += naiveFromHex(hex, back);
+    benchStop(t, repeats);
+
+    t = benchStart("8 MiB from hex, stringFromHex");
+    for(size_t r = 0; r < repeats; r++) {
+        string d = stringFromHex(hex);
+        total += stringlen(d);
+        destroyString(d);
+    }
+    benchStop(t, repeats);
+
+    destroyString(hex);
+    destroyString(blob);
+    destroyString(prose);
+    free(back);
+    free(text);
+    benchSink(total);
+}
+
+// reading a file the way callers did before stringMapFile
+static string readWholeFile(const char *path) {
+    FILE *file = fopen(path, "rb");
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *buffer = malloc((size_t)size + 1);
+    size_t n = fread(buffer, 1, (size_t)size, file);
+    buffer[n] = '\0';
+    fclose(file);
+    string contents = stringFromCharPtr(buffer);
+    free(buffer);
+    return contents;
+}
+
+static void bench_map_file(void) {
+    enum { payload = 64 << 20, repeats = 4 };
+    const char *path = "chad_bench_map.tmp";
+    FILE *file = fopen(path, "wb");
+    char line[64];
+    for(size_t written = 0; written < payload; written += 64) {
+        memset(line, 'a' + (char)(written / 64 % 26), 63);
+        line[63] = '\n';
+        fwrite(line, 1, 64, file);
+    }
+    fclose(file);
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("64 MiB file, fread + copy, one search");
+    for(size_t r = 0; r < repeats; r++) {
+        string contents = readWholeFile(path);
+        total += (uint64_t)stringFind(contents, string("zzzzq"));
+        destroyString(contents);
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("64 MiB file, stringMapFile, one search");
+    for(size_t r = 0; r < repeats; r++) {
+        option(string) contents = stringMapFileWith(path, string_map_sequential);
+        total += (uint64_t)stringFind(contents.value, string("zzzzq"));
+        destroyString(contents.value);
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("64 MiB file, stringMapFile, first line");
+    for(size_t r = 0; r < repeats; r++) {
+        option(string) contents = stringMapFile(path);
+        total += (uint64_t)stringFind(contents.value, string("\n"));
+        destroyString(contents.value);
+    }
+    benchStop(t, repeats);
+
+    remove(path);
+    benchSink(total);
+}
+
+static void bench_reader(void) {
+    enum { payload = 64 << 20, repeats = 2 };
+    // log lines of 20 to 140 bytes
+    const char *path = "chad_bench_reader.tmp";
+    FILE *file = fopen(path, "wb");
+    char line[160];
+    uint64_t seed = 41;
+    for(size_t written = 0; written < payload;) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        size_t n = 20 + (seed >> 33) % 120;
+        memset(line, 'a' + (char)(seed >> 59), n);
+        line[n] = '\n';
+        fwrite(line, 1, n + 1, file);
+        written += n + 1;
+    }
+    fclose(file);
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("64 MiB of lines, fgets");
+    for(size_t r = 0; r < repeats; r++) {
+        file = fopen(path, "rb");
+        char buffer[4096];
+        while(fgets(buffer, sizeof buffer, file) != NULL) total += strlen(buffer);
+        fclose(file);
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("64 MiB of lines, stringReaderNextLine");
+    for(size_t r = 0; r < repeats; r++) {
+        file = fopen(path, "rb");
+        stringReader_t reader = stringReaderFromFile(file, 0);
+        strview view;
+        while(stringReaderNextLine(&reader, &view)) total += view.length;
+        destroyStringReader(&reader);
+        fclose(file);
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("64 MiB of lines, stringReaderNextRecord");
+    for(size_t r = 0; r < repeats; r++) {
+        file = fopen(path, "rb");
+        stringReader_t reader = stringReaderFromFile(file, 0);
+        strview view;
+        while(stringReaderNextRecord(&reader, strview("\n"), &view)) total += view.length;
+        destroyStringReader(&reader);
+        fclose(file);
+    }
+    benchStop(t, repeats);
+
+    remove(path);
+    benchSink(total);
+}
+
+static void bench_base64(void) {
+    enum { payload = 8 << 20, repeats = 8 };
+    unsigned char *bytes = malloc(payload);
+    uint64_t seed = 3;
+    for(size_t i = 0; i < payload; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        bytes[i] = (unsigned char)(seed >> 56);
+    }
+    string source = stringFromStrview(strviewFromParts((const char *)bytes, payload));
+    char *text = malloc(payload / 3 * 4 + 8);
+    unsigned char *back = malloc(payload);
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("8 MiB encode, 3 bytes at a time");
+    for(size_t r = 0; r < repeats; r++) {
+        naiveBase64Encode(bytes, payload / 3 * 3, text);
+        total += (unsigned char)text[r];
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("8 MiB encode, stringBase64Encode");
+    for(size_t r = 0; r < repeats; r++) {
+        string e = stringBase64Encode(source);
+        total += stringlen(e);
+        destroyString(e);
+    }
+    benchStop(t, repeats);
+
+    string encoded = stringBase64Encode(source);
+    t = benchStart("8 MiB decode, table per character");
+    for(size_t r = 0; r < repeats; r++) {
+        total += naiveBase64Decode(encoded.at, stringlen(encoded), back);
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("8 MiB decode, stringBase64Decode");
+    for(size_t r = 0; r < repeats; r++) {
+        option(string) d = stringBase64Decode(encoded);
+        total += stringlen(d.value);
+        destroyString(d.value);
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("8 MiB decode, 64 KiB stream chunks");
+    for(size_t r = 0; r < repeats; r++) {
+        stringBase64Stream_t stream = stringBase64StreamCreate(string_base64_standard);
+        stringBuilder_t out = stringBuilderCreateChunked(0);
+        for(size_t i = 0; i < stringlen(encoded); i += 1 << 16) {
+            size_t n = stringlen(encoded) - i < (1 << 16) ? stringlen(encoded) - i : (1 << 16);
+            stringBase64DecodeChunk(&stream, &out, strviewFromParts(encoded.at + i, n));
+        }
+        stringBase64DecodeEnd(&stream, &out);
+        total += stringBuilderLength(&out);
+        stringBuilderDestroy(&out);
+    }
+    benchStop(t, repeats);
+
+    destroyString(encoded);
+    destroyString(source);
+    free(back);
+    free(text);
+    free(bytes);
+    benchSink(total);
+}
+
+static void bench_glob(void) {
+    // a routing table: literal prefixes with a wildcard tail, checked in order
+    enum { route_count = 300, key_count = 20000 };
+    static const char *segments[] = { "users", "orders", "items", "carts", "sessions", "reports" };
+    dynarray(string) routes = {};
+    for(size_t i = 0; i < route_count; i++) {
+        string route = stringFormat("/api/v%zu/%s%zu/*", i % 5, segments[i % 6], i / 30);
+        dynarray_append(routes, route);
+    }
+    dynarray(string) keys = {};
+    for(size_t i = 0; i < key_count; i++) {
+        string key = stringFormat("/api/v%zu/%s%zu/%zu", (i * 7) % 6, segments[i % 6], (i * 13) % 11, i);
+        dynarray_append(keys, key);
+    }
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("300 routes, stringMatchWildcard each");
+    for(size_t i = 0; i < keys.count; i++) {
+        for(size_t r = 0; r < routes.count; r++) {
+            if(stringMatchWildcard(keys.at[i], routes.at[r])) {
+                total += r;
+                break;
+            }
+        }
+    }
+    benchStop(t, key_count);
+
+    stringGlob_t *compiled = malloc(route_count * sizeof(stringGlob_t));
+    for(size_t r = 0; r < routes.count; r++) compiled[r] = stringGlobCompile(routes.at[r]);
+    t = benchStart("300 routes, stringGlobMatch each");
+    for(size_t i = 0; i < keys.count; i++) {
+        for(size_t r = 0; r < routes.count; r++) {
+            if(stringGlobMatch(compiled[r], keys.at[i])) {
+                total += r;
+                break;
+            }
+        }
+    }
+    benchStop(t, key_count);
+    for(size_t r = 0; r < routes.count; r++) destroyStringGlob(compiled[r]);
+    free(compiled);
+
+    t = benchStart("300 routes, compiling the set");
+    stringGlob_t set = stringGlobCompileSet(routes);
+    benchStop(t, 1);
+    t = benchStart("300 routes, stringGlobMatchFirst");
+    for(size_t i = 0; i < keys.count; i++) {
+        int r = stringGlobMatchFirst(set, keys.at[i]);
+        total += r < 0 ? 0 : (size_t)r;
+    }
+    benchStop(t, key_count);
+    destroyStringGlob(set);
+
+    for(size_t i = 0; i < routes.count; i++) destroyString(routes.at[i]);
+    for(size_t i = 0; i < keys.count; i++) destroyString(keys.at[i]);
+    destroy_dynarray(routes);
+    destroy_dynarray(keys);
+    benchSink(total);
+}
+
+// the two row dynamic programming table stringLevenshteinDistance used before
+static size_t dpLevenshtein(string a, string b) {
+    size_t len_a = stringlen(a), len_b = stringlen(b);
+    size_t *prev_row = malloc((len_b + 1) * sizeof(size_t));
+    size_t *curr_row = malloc((len_b + 1) * sizeof(size_t));
+    for(size_t j = 0; j <= len_b; j++) prev_row[j] = j;
+    for(size_t i = 0; i < len_a; i++) {
+        curr_row[0] = i + 1;
+        for(size_t j = 0; j < len_b; j++) {
+            size_t best = prev_row[j] + (a.at[i] != b.at[j]);
+            if(prev_row[j + 1] + 1 < best) best = prev_row[j + 1] + 1;
+            if(curr_row[j] + 1 < best) best = curr_row[j] + 1;
+            curr_row[j + 1] = best;
+        }
+        size_t *swap = prev_row;
+        prev_row = curr_row;
+        curr_row = swap;
+    }
+    size_t result = prev_row[len_b];
+    free(prev_row);
+    free(curr_row);
+    return result;
+}
+
+static void bench_levenshtein(void) {
+    enum { identifiers = 100000, queries = 20 };
+    // identifier-like candidates of 6 to 30 characters over a small alphabet
+    dynarray(string) names = {};
+    uint64_t seed = 7;
+    char buf[32];
+    for(size_t i = 0; i < identifiers; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        size_t len = 6 + (seed >> 33) % 25;
+        for(size_t c = 0; c < len; c++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            buf[c] = "etaoinshrdlu_"[(seed >> 33) % 13];
+        }
+        dynarray_append(names, stringFromStrview(strviewFromParts(buf, len)));
+    }
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("100k ids, dp table");
+    for(size_t q = 0; q < queries; q++) {
+        string query = names.at[q * 4999];
+        for(size_t i = 0; i < names.count; i++) total += dpLevenshtein(query, names.at[i]);
+    }
+    benchStop(t, queries * identifiers);
+
+    t = benchStart("100k ids, bit-parallel");
+    for(size_t q = 0; q < queries; q++) {
+        string query = names.at[q * 4999];
+        for(size_t i = 0; i < names.count; i++) total += stringLevenshteinDistance(query, names.at[i]);
+    }
+    benchStop(t, queries * identifiers);
+
+    t = benchStart("100k ids within 3, dp table");
+    for(size_t q = 0; q < queries; q++) {
+        string query = names.at[q * 4999];
+        size_t hits = 0;
+        for(size_t i = 0; i < names.count; i++) hits += dpLevenshtein(query, names.at[i]) <= 3;
+        total += hits;
+    }
+    benchStop(t, queries * identifiers);
+
+    t = benchStart("100k ids top 5 within 3, bit-parallel");
+    for(size_t q = 0; q < queries; q++) {
+        dynarray(stringFuzzyMatch_t) top = stringClosestMatches(names.at[q * 4999], names, 5, 3);
+        total += top.count;
+        destroy_dynarray(top);
+    }
+    benchStop(t, queries * identifiers);
+
+    // pattern longer than one machine word
+    string long_a = stringFromCharPtr("");
+    string long_b = stringFromCharPtr("");
+    for(size_t i = 0; i < 40; i++) {
+        long_a = stringAppendString(long_a, names.at[i]);
+        long_b = stringAppendString(long_b, names.at[i + (i % 3 == 0)]);
+    }
+    t = benchStart("~700 byte texts, dp table");
+    for(size_t round = 0; round < 200; round++) total += dpLevenshtein(long_a, long_b);
+    benchStop(t, 200);
+    t = benchStart("~700 byte texts, bit-parallel");
+    for(size_t round = 0; round < 200; round++) total += stringLevenshteinDistance(long_a, long_b);
+    benchStop(t, 200);
+
+    destroyString(long_a);
+    destroyString(long_b);
+    for(size_t i = 0; i < names.count; i++) destroyString(names.at[i]);
+    destroy_dynarray(names);
+    benchSink(total);
+}
+
+static int naiveCompareStrings(const void *a, const void *b) {
+    return stringcmp(*(const string *)a, *(const string *)b);
+}
+
+static void bench_sort(void) {
+    enum { count = 1 << 20, repeats = 3 };
+    // url-like keys, most share a long prefix and differ further in
+    dynarray(string) keys = {};
+    char text[64];
+    uint64_t seed = 43;
+    for(size_t i = 0; i < count; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        int n = snprintf(text, sizeof text, "https://example.com/%s/%llu",
+            (seed >> 62) ? "items" : "users", (unsigned long long)(seed >> 24) % 1000000);
+        dynarray_append(keys, stringFromStrview(strviewFromParts(text, (size_t)n)));
+    }
+    string *original = malloc(count * sizeof *original);
+    memcpy(original, keys.at, count * sizeof *original);
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("1M keys, qsort + stringcmp");
+    for(size_t r = 0; r < repeats; r++) {
+        memcpy(keys.at, original, count * sizeof *original);
+        qsort(keys.at, count, sizeof *keys.at, naiveCompareStrings);
+        total += stringlen(keys.at[count / 2]);
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("1M keys, stringSort");
+    for(size_t r = 0; r < repeats; r++) {
+        memcpy(keys.at, original, count * sizeof *original);
+        stringSort(keys);
+        total += stringlen(keys.at[count / 2]);
+    }
+    benchStop(t, repeats);
+
+    t = benchStart("1M keys, stringSortParallel");
+    for(size_t r = 0; r < repeats; r++) {
+        memcpy(keys.at, original, count * sizeof *original);
+        stringSortParallel(keys, 0);
+        total += stringlen(keys.at[count / 2]);
+    }
+    benchStop(t, repeats);
+
+    for(size_t i = 0; i < keys.count; i++) destroyString(keys.at[i]);
+    destroy_dynarray(keys);
+    free(original);
+    benchSink(total);
+}
+
+int bench_str(void) {
+    #ifdef CHAD_STRING_NO_SMALL
+    printf("\n-- small strings: disabled (CHAD_STRING_NO_SMALL) --\n");
+    #else
+    printf("\n-- small strings: enabled (<= %d bytes) --\n", STRING_SMALL_CAPACITY);
+    #endif
+    bench_small_from_charptr();
+    bench_small_slices();
+    bench_small_live_set();
+
+    #ifdef CHAD_STRING_EXACT_GROWTH
+    printf("\n-- append growth: exact (CHAD_STRING_EXACT_GROWTH) --\n");
+    #else
+    printf("\n-- append growth: geometric --\n");
+    #endif
+    bench_append_chars();
+
+    printf("\n-- substring search --\n");
+    bench_search();
+
+    printf("\n-- replacement --\n");
+    bench_replace_many();
+
+    printf("\n-- splitting --\n");
+    bench_split_fields();
+
+    printf("\n-- utf-8 --\n");
+    bench_utf8();
+    bench_utf8_at();
+
+    printf("\n-- hashing --\n");
+    bench_hash();
+    bench_intern();
+
+    printf("\n-- copies --\n");
+    bench_copy();
+
+    printf("\n-- ascii case and classes --\n");
+    bench_ascii();
+
+    printf("\n-- string builder --\n");
+    bench_builder();
+
+    printf("\n-- base64 --\n");
+    bench_base64();
+
+    printf("\n-- mapped files --\n");
+    bench_map_file();
+    bench_reader();
+
+    printf("\n-- escaping and hex --\n");
+    bench_escape_hex();
+
+    printf("\n-- numbers --\n");
+    bench_numbers();
+    bench_parse_numbers();
+
+    printf("\n-- sorting --\n");
+    bench_sort();
+
+    printf("\n-- globs --\n");
+    bench_glob();
+
+    printf("\n-- edit distance --\n");
+    bench_levenshtein();
+    return 0;
+}
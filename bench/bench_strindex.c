@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023-2025 defg43
+// https://github.com/defg43/
+
+#include "../include/chad/strindex.h"
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEXT_BYTES (16 << 20)
+#define QUERIES 20000
+#define LOCATE_QUERIES 2000
+#define SCAN_QUERIES 50
+
+// 16 MiB of words drawn from a small vocabulary, the shape of a log or a document corpus
+static string makeCorpus(void) {
+    static const char *syllables[] = { "ka", "lo", "mer", "tin", "os", "va", "ru", "shi", "pel", "dan" };
+    char *text = malloc(TEXT_BYTES + 1);
+    uint64_t seed = 77;
+    size_t length = 0;
+    while(length < TEXT_BYTES - 32) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        size_t parts = 1 + (seed >> 62);
+        for(size_t p = 0; p < parts; p++) {
+            const char *s = syllables[(seed >> (8 + p * 4)) % 10];
+            size_t n = strlen(s);
+            memcpy(text + length, s, n);
+            length += n;
+        }
+        text[length++] = (seed >> 20) % 16 == 0 ? '\n' : ' ';
+    }
+    text[length] = '\0';
+    string ret = stringFromStrview(strviewFromParts(text, length));
+    free(text);
+    return ret;
+}
+
+// patterns cut from the corpus so that all of them occur, short ones thousands of times
+static strview makePattern(string corpus, uint64_t *seed, size_t min_length) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    size_t length = min_length + (*seed >> 60) % 11;
+    size_t at = (*seed >> 20) % (stringlen(corpus) - length);
+    return strviewFromParts(corpus.at + at, length);
+}
+
+static void bench_index(void) {
+    string corpus = makeCorpus();
+    uint64_t total = 0;
+
+    benchTimer_t t = benchStart("16 MiB, stringIndexBuild (SA-IS)");
+    stringIndex_t sa = stringIndexBuild(corpus);
+    benchStop(t, 1);
+
+    t = benchStart("16 MiB, FM-index build");
+    stringIndex_t fm = stringIndexBuildWith(corpus, string_index_fm);
+    benchStop(t, 1);
+
+    uint64_t seed = 5;
+    t = benchStart("count, stringCount scan");
+    for(size_t q = 0; q < SCAN_QUERIES; q++) {
+        strview pattern = makePattern(corpus, &seed, 6);
+        string needle = stringFromStrview(pattern);
+        total += stringCount(corpus, needle);
+        destroyString(needle);
+    }
+    benchStop(t, SCAN_QUERIES);
+
+    seed = 5;
+    t = benchStart("count, suffix array");
+    for(size_t q = 0; q < QUERIES; q++) total += stringIndexCount(sa, makePattern(corpus, &seed, 6));
+    benchStop(t, QUERIES);
+
+    seed = 5;
+    t = benchStart("count, FM-index");
+    for(size_t q = 0; q < QUERIES; q++) total += stringIndexCount(fm, makePattern(corpus, &seed, 6));
+    benchStop(t, QUERIES);
+
+    seed = 5;
+    t = benchStart("locate 24+ bytes, suffix array");
+    for(size_t q = 0; q < LOCATE_QUERIES; q++) {
+        dynarray(size_t) found = stringIndexLocate(sa, makePattern(corpus, &seed, 24));
+        total += found.count;
+        destroy_dynarray(found);
+    }
+    benchStop(t, LOCATE_QUERIES);
+
+    seed = 5;
+    t = benchStart("locate 24+ bytes, FM-index");
+    for(size_t q = 0; q < LOCATE_QUERIES; q++) {
+        dynarray(size_t) found = stringIndexLocate(fm, makePattern(corpus, &seed, 24));
+        total += found.count;
+        destroy_dynarray(found);
+    }
+    benchStop(t, LOCATE_QUERIES);
+
+    const char *path = "chad_bench_index.tmp";
+    stringIndexSave(sa, path);
+    t = benchStart("load a saved index + 1 query");
+    option(stringIndex_t) loaded = stringIndexLoad(path);
+    if(loaded.valid) {
+        total += stringIndexCount(loaded.value, strview("merka"));
+        destroyStringIndex(loaded.value);
+    }
+    benchStop(t, 1);
+    remove(path);
+
+    total += stringIndexLongestRepeat(sa).length;
+    destroyStringIndex(fm);
+    destroyStringIndex(sa);
+    destroyString(corpus);
+    benchSink(total);
+}
+
+int bench_strindex(void) {
+    printf("\n-- string index --\n");
+    bench_index();
+    return 0;
+}
@@ -0,0 +1,13 @@
+#!/bin/bash
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+
+cd "$SCRIPT_DIR"
+
+# each benchmark is built twice, once with the optimizations under test switched off for comparison
+gcc bench/*.c src/*.c -Iinclude -std=c23 -O2 -DNDEBUG -DCHAD_STRING_NO_SMALL -DCHAD_STRING_EXACT_GROWTH -DCHAD_STRING_NO_SHARING -o bench_baseline
+gcc bench/*.c src/*.c -Iinclude -std=c23 -O2 -DNDEBUG -o bench_current
+
+./bench_baseline && ./bench_current
+rm bench_baseline bench_current
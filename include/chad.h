@@ -9,6 +9,8 @@
 #include "chad/format.h"
 #include "chad/ion.h"
 #include "chad/parser.h"
+#include "chad/rope.h"
 #include "chad/str.h"
+#include "chad/strindex.h"
 
 #endif // CHAD_H
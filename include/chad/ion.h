@@ -32,6 +32,11 @@ typedef enum : int8_t {
 	number_t_float = 4,
 } number_t_discriminant_t;
 
+typedef enum : int8_t {
+	ion_parse_default = 0,
+	ion_parse_intern_keys = 1 << 0, // keys come from stringIntern and live until stringInternReset
+} ion_parse_flags_t;
+
 typedef struct {
 	number_t_discriminant_t number_discriminant;
 	union {
@@ -139,6 +144,9 @@ string arrayToJson(array_t arr);
 string numberToString(number_t number);
 
 object_t jsonToObject(string json_string);
+/** Like jsonToObject, intern_keys shares one copy of each key across records, for many small
+    records with the same keys. the intern pool only shrinks on stringInternReset */
+object_t jsonToObjectWith(string json_string, ion_parse_flags_t flags);
 
 bool parseKey(string json, size_t *pos, string *result);
 bool parseValue(string json, size_t *pos, obj_t_value_t *result);
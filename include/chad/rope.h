@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023-2025 defg43
+// https://github.com/defg43/
+
+#ifndef ROPE_H
+#define ROPE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "str.h"
+
+// ropes
+//
+// a rope holds its text as a balanced tree of pieces, each piece a range of a string. insert,
+// delete and slice cost O(log n) instead of moving the whole buffer, which makes ropes the
+// better fit for assembling or editing large texts out of order. trees are persistent: copies
+// and slices share nodes, which are only duplicated along the path an edit walks
+
+typedef struct ropeNode ropeNode_t;
+
+/** Text stored as a tree of string pieces, an empty rope has no root */
+typedef struct {
+    ropeNode_t *root;
+} rope_t;
+
+/** Chunk iterator state, see ropeChunks */
+typedef struct {
+    const ropeNode_t *root;
+    size_t pos;
+} ropeChunkIter_t;
+
+// construction and destruction
+
+rope_t ropeCreate(void);
+rope_t ropeFromStrview(strview text);
+
+/** Rope over str, which is shared rather than copied */
+rope_t ropeFromString(string str);
+
+/** Another rope with the same contents, O(1), nodes are shared until either is edited */
+rope_t ropeCopy(rope_t rope);
+void destroyRope(rope_t rope);
+
+// properties
+
+size_t ropeLength(rope_t rope);
+
+/** Byte at index, '\0' past the end */
+char ropeCharAt(rope_t rope, size_t index);
+
+// editing, indices past the end are clamped to the end
+
+/** Insert a copy of text at index, small inserts are merged into neighbouring pieces */
+void ropeInsert(rope_t *rope, size_t index, strview text);
+
+/** Insert str at index, large strings are shared rather than copied */
+void ropeInsertString(rope_t *rope, size_t index, string str);
+void ropeAppend(rope_t *rope, strview text);
+void ropePrepend(rope_t *rope, strview text);
+
+/** Append the contents of other, which stays valid and unchanged */
+void ropeAppendRope(rope_t *rope, rope_t other);
+
+/** Remove length bytes starting at index */
+void ropeDelete(rope_t *rope, size_t index, size_t length);
+
+/** Rope over [startIdx, endIdx), shares the pieces of rope */
+rope_t ropeSlice(rope_t rope, size_t startIdx, size_t endIdx);
+
+// reading
+
+/** Flatten into a new string */
+string ropeToString(rope_t rope);
+
+/** Iterate over the pieces in order, the rope must not be edited meanwhile */
+ropeChunkIter_t ropeChunks(rope_t rope);
+
+/** Advance to the next piece, false once the rope is exhausted */
+bool ropeChunkNext(ropeChunkIter_t *iter, strview *chunk);
+
+#endif // ROPE_H
@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdarg.h>
+#include <stdio.h>
 #include "cstl.h"
 
 typedef uint8_t byte;
@@ -26,21 +27,149 @@ typedef struct {
     };
 } string;
 
+// strings up to this length are placed in small fixed size cells instead of their own allocation
+#define STRING_SMALL_CAPACITY 23
+
+typedef enum : uint32_t {
+    string_small = 1 << 0, // lives in a small string cell, not in its own malloc block
+    string_hash_cached = 1 << 1, // hash holds stringHash64 of the current contents
+    string_interned = 1 << 2,    // canonical copy owned by the intern pool, immutable
+    string_mapped = 1 << 3,      // contents are a read only file mapping, see stringMapFile
+} stringFlags_t;
+
+// allocator backends, see stringUseAllocator
+
+#define STRING_POOL_CLASSES 8
+
+typedef enum {
+    string_allocator_malloc = 0,
+    string_allocator_arena = 1, // bump allocation, freed all at once by stringAllocatorReset
+    string_allocator_pool = 2,  // power of two size classes from 64 bytes up, with free lists
+} stringAllocatorKind_t;
+
+typedef struct stringArenaBlock stringArenaBlock_t;
+typedef struct stringPoolLarge stringPoolLarge_t;
+typedef struct stringReplacer stringReplacer_t;
+typedef struct stringUtf8Index stringUtf8Index_t;
+
+typedef struct stringAllocator {
+    stringAllocatorKind_t kind;
+    union {
+        struct {
+            stringArenaBlock_t *block;
+            size_t block_size;
+        } arena;
+        struct {
+            void *free_list[STRING_POOL_CLASSES];
+            stringArenaBlock_t *chunks;
+            stringPoolLarge_t *large; // blocks above the largest class, malloc'd one by one
+        } pool;
+    };
+} stringAllocator_t;
+
 typedef struct {
+    stringAllocator_t *allocator; // owning backend, NULL for the default malloc backend
+    _Atomic stringFlags_t flags;  // string_hash_cached is set with release order, see stringHash64
+    _Atomic uint32_t refcount;     // handles sharing this header, see stringFromString
+    stringUtf8Index_t *_Atomic utf8_index; // code point offsets for stringUtf8At, NULL until needed
+    _Atomic uint64_t hash;         // valid while string_hash_cached is set
     size_t allocated_bytes;
     size_t length;
     char data[];
 } stringHeader_t;
 
+/** Non-owning view into string data, never needs to be destroyed */
+typedef struct {
+    const char *at;
+    size_t length;
+} strview;
+
 typedef struct {
     size_t previous;
     size_t index;
     string str;
 } iterstring_t;
 
+typedef enum {
+    string_split_delimiter,
+    string_split_lines,
+    string_split_tokenize,
+    string_split_pairwise,
+} stringSplitKind_t;
+
+/** Lazy splitter state, see stringSplitIter */
+typedef struct {
+    stringSplitKind_t kind;
+    strview input;
+    strview delimiter;
+    strview end_delimiter; // pairwise only
+    size_t pos;            // where scanning resumes
+    size_t mark;           // start of the pending token (tokenize only)
+    bool done;
+} stringSplitIter_t;
+
+/** Buffered reader over a file descriptor or FILE *, see stringReaderFromFd */
 typedef struct {
-    string buffer;
+    int fd;        // read from when file is NULL
+    FILE *file;
+    char *buffer;
     size_t capacity;
+    size_t start;  // first byte not returned yet
+    size_t end;    // end of the bytes read so far
+    bool eof;
+    bool failed;   // the input ended with a read error rather than at its end
+} stringReader_t;
+
+typedef enum : uint32_t {
+    string_base64_standard = 0,
+    string_base64_url = 1 << 0,      // - and _ in place of + and /
+    string_base64_no_pad = 1 << 1,   // no trailing '=', decoding rejects it unless lenient
+    string_base64_lenient = 1 << 2,  // decoding skips whitespace, takes both alphabets and missing padding
+} stringBase64Flags_t;
+
+// access pattern hints for stringMapFileWith
+typedef enum {
+    string_map_normal = 0,
+    string_map_sequential = 1, // read front to back: aggressive read ahead, pages dropped behind
+    string_map_random = 2,     // scattered reads: no read ahead
+} stringMapAdvice_t;
+
+// outcome of the strviewTo* number parsers, out is left alone when invalid
+typedef enum {
+    string_number_ok = 0,
+    string_number_invalid = 1,  // empty, no digits, or anything left over
+    string_number_overflow = 2, // well formed but out of range, out holds the saturated value
+} stringNumberStatus_t;
+
+/** Streaming base64 state, see stringBase64StreamCreate */
+typedef struct {
+    stringBase64Flags_t flags;
+    uint32_t bits;    // pending bytes (encoding) or sextets (decoding)
+    uint8_t count;
+    uint8_t padding;  // '=' seen while decoding
+    bool failed;
+} stringBase64Stream_t;
+
+typedef struct stringGlobProgram stringGlobProgram_t;
+
+/** A compiled glob or glob set, read only once compiled and safe to share between threads */
+typedef struct {
+    stringGlobProgram_t *program;
+} stringGlob_t;
+
+/** Candidate position and distance, see stringClosestMatches */
+typedef struct {
+    size_t index;
+    size_t distance;
+} stringFuzzyMatch_t;
+
+/** Append-only text under construction, see stringBuilderCreate and stringBuilderCreateChunked */
+typedef struct {
+    string buffer;            // bytes written since the last sealed chunk, always terminated
+    size_t capacity;          // bytes buffer takes before it has to grow, excluding the terminator
+    size_t chunk_size;        // 0 for a single growing buffer, else the size of sealed chunks
+    dynarray(string) chunks;  // full chunks in order, chunked mode only
+    size_t sealed_length;     // bytes in chunks
 } stringBuilder_t;
 
 // construction and destruction
@@ -72,19 +201,45 @@ typedef struct {
     })
 
 string stringFromCharPtr(const char *cstr);
+/** Copy of src, shares its buffer (copy on write) until one side is modified */
 string stringFromString(string src);
+/** Always take a private copy, unlike stringFromString which may share */
+string stringClone(string src);
 void destroyString(string str);
 
+/** Read only string over a file, mapped rather than read where possible, none if it cannot be opened.
+    the file must not shrink while mapped, destroyString unmaps it */
+option(string) stringMapFile(const char *path);
+option(string) stringMapFileWith(const char *path, stringMapAdvice_t advice);
+
+// allocator backends
+
+/** Create an arena, strings in it are only released by stringAllocatorReset or Destroy */
+stringAllocator_t stringArenaCreate(size_t blockSize);
+
+/** Create a size class pool, strings are recycled through per class free lists */
+stringAllocator_t stringPoolCreate(void);
+
+/** Release every string allocated from the backend at once */
+void stringAllocatorReset(stringAllocator_t *alloc);
+void stringAllocatorDestroy(stringAllocator_t *alloc);
+
+/** Allocate new strings on this thread from alloc (NULL for malloc), returns the previous one */
+stringAllocator_t *stringUseAllocator(stringAllocator_t *alloc);
+
 // properties
 
 stringHeader_t *getHeaderPointer(string str);
 size_t stringlen(string str);
 size_t stringbytesalloced(string str);
 
-/** Get UTF-8 character count (slower than byte length) */
+/** Bytes the string can hold without reallocating, excluding the terminator */
+size_t stringCapacity(string str);
+
+/** Get UTF-8 character count, every byte that is not a continuation byte counts */
 size_t stringUtf8Length(string str);
 
-/** Validate UTF-8 encoding */
+/** Validate UTF-8 encoding, overlong forms, surrogates and code points above U+10FFFF are rejected */
 bool stringUtf8Validate(string str);
 
 // comparisons
@@ -105,9 +260,34 @@ bool stringStartsWith(string str, string prefix);
 /** Check if string ends with suffix */
 bool stringEndsWith(string str, string suffix);
 
-/** Case-insensitive comparison */
+/** Case-insensitive comparison, only ascii letters are folded */
 int stringcmpIgnoreCase(string strA, string strB);
 
+// hashing
+
+/** 64-bit hash of the contents, cached in the header until the string is modified */
+uint64_t stringHash64(string str);
+
+/** 32-bit fold of stringHash64 */
+uint32_t stringHash(string str);
+
+/** Hash with a caller chosen seed, not cached */
+uint64_t stringHashSeeded(string str, uint64_t seed);
+
+// interning
+
+/** Canonical immutable copy, equal contents give the same .data pointer (thread safe) */
+string stringIntern(strview view);
+
+/** Whether str came from stringIntern, destroyString ignores those */
+bool stringIsInterned(string str);
+
+/** Number of distinct strings in the intern pool */
+size_t stringInternCount(void);
+
+/** Free every interned string at once, none of them may be used afterwards */
+void stringInternReset(void);
+
 // searching
 
 /** Find first occurrence of substring, returns index or -1 */
@@ -129,10 +309,10 @@ string stringSliceFromCharPtr(const char *cstr, size_t startIdx, size_t endIdx);
 string stringConcat(string strA, string strB);
 string stringReverse(string str);
 
-/** Convert to uppercase (allocates new string) */
+/** Convert ascii letters to uppercase, other bytes are kept (allocates new string) */
 string stringToUpper(string str);
 
-/** Convert to lowercase (allocates new string) */
+/** Convert ascii letters to lowercase, other bytes are kept (allocates new string) */
 string stringToLower(string str);
 
 /** Remove whitespace from both ends (allocates new string) */
@@ -150,14 +330,36 @@ string stringReplace(string str, string findStr, string replaceStr);
 /** Replace first N occurrences (allocates new string) */
 string stringReplaceN(string str, string findStr, string replaceStr, size_t maxReplacements);
 
+/** Replace finds[i] with replaces[i] in one pass, leftmost-longest match wins (allocates new string) */
+string stringReplaceMany(string str, const string finds[], const string replaces[], size_t count);
+
+/** Compile a set of replacements once, for applying to many strings */
+stringReplacer_t *stringReplacerCreate(const string finds[], const string replaces[], size_t count);
+
+/** Apply compiled replacements (allocates new string) */
+string stringReplacerApply(const stringReplacer_t *replacer, string str);
+
+void stringReplacerDestroy(stringReplacer_t *replacer);
+
 // in-place modifications (original string is modified, string is returned for chaining)
+/** Drop cached data derived from the contents, needed after writing through .at directly */
+void stringInvalidate(string str);
+/** Make room for at least additionalBytes more, capacity grows geometrically */
 string stringGrowBuffer(string str, size_t additionalBytes);
+/** Make room for at least capacity bytes in total (excluding the terminator) */
+string stringReserve(string str, size_t capacity);
+/** Give back unused capacity */
+string stringShrinkToFit(string str);
 string stringAppendCharPtr(string str, const char *cstr);
 string stringAppendString(string str, string other);
 string stringAppendChar(string str, char ch);
 string stringPrependCharPtr(string str, const char *cstr);
 string stringPrependString(string str, string other);
 string stringPrependChar(string str, char ch);
+/** stringToUpper without the allocation, unless str is shared */
+string stringToUpperInPlace(string str);
+/** stringToLower without the allocation, unless str is shared */
+string stringToLowerInPlace(string str);
 
 #define stringAppend(str, toAppend)                                         \
     _Generic((toAppend),                                                    \
@@ -187,9 +389,51 @@ dynarray(string) stringTokenizePairwise(char *inputCstr, char *startDelim, char
 /** Split string object by delimiter (returns dynarray) */
 dynarray(string) stringSplit(string str, string delimiter);
 
+/** Split string object on line breaks (\n, \r\n or \r, returns dynarray) */
+dynarray(string) stringSplitLines(string str);
+
+// lazy splitting, tokens are views into the input and nothing is allocated
+
+/** Yield the tokens of stringSplit one at a time */
+stringSplitIter_t stringSplitIter(string str, string delimiter);
+
+/** Yield the tokens of stringSplitLines one at a time */
+stringSplitIter_t stringSplitLinesIter(string str);
+
+/** Yield the tokens of stringTokenize one at a time */
+stringSplitIter_t stringTokenizeIter(const char *inputCstr, const char *delimCstr);
+
+/** Yield the tokens of stringTokenizePairwise one at a time */
+stringSplitIter_t stringTokenizePairwiseIter(const char *inputCstr, const char *startDelim, const char *endDelim);
+
+/** Advance to the next token, false once the input is exhausted */
+bool stringSplitNext(stringSplitIter_t *iter, strview *token);
+
+/** Copy all remaining tokens into strings from allocator (NULL: the current one) */
+dynarray(string) stringSplitCollect(stringSplitIter_t iter, stringAllocator_t *allocator);
+
+// streaming readers, for input too large or too endless to hold in one string
+
+/** Read fd in chunks of buffer_size bytes (0: 64 KiB), the fd is not closed by destroyStringReader */
+stringReader_t stringReaderFromFd(int fd, size_t buffer_size);
+stringReader_t stringReaderFromFile(FILE *file, size_t buffer_size);
+void destroyStringReader(stringReader_t *reader);
+
+/** Next line without its "\n", "\r\n" or "\r", false at the end. the view is valid until the next call */
+bool stringReaderNextLine(stringReader_t *reader, strview *line);
+
+/** Next record up to delimiter, which may differ between calls. no empty record after a final delimiter */
+bool stringReaderNextRecord(stringReader_t *reader, strview delimiter, strview *record);
+
 /** Join array of strings with separator */
 string stringJoin(dynarray(string) parts, string separator);
 
+/** Sort in place into stringcmp order */
+void stringSort(dynarray(string) strings);
+
+/** stringSort spread over up to threads threads (0: one per processor), for arrays in the millions */
+void stringSortParallel(dynarray(string) strings, size_t threads);
+
 // Legacy tokenize macro
 #define tokenize(str, delim) stringTokenize(str, delim)
 
@@ -201,12 +445,40 @@ string stringFormat(const char *fmt, ...);
 /** Format string with va_list */
 string stringFormatVa(const char *fmt, va_list args);
 
+// numbers
+
+/** Parse the whole string as a base 10 number, false if anything is left over or out of range */
+bool stringToInt(string str, int *out);
+bool stringToLong(string str, long *out);
+bool stringToDouble(string str, double *out);
+
+/** Parse all of view as an optionally signed base 10 integer, saturated on overflow */
+stringNumberStatus_t strviewToInt64(strview view, int64_t *out);
+stringNumberStatus_t strviewToUint64(strview view, uint64_t *out);
+
+/** Decimal with optional point and exponent, or inf, infinity, nan; ±HUGE_VAL on overflow */
+stringNumberStatus_t strviewToDouble(strview view, double *out);
+
+/** true/false, yes/no, on/off or 1/0, case-insensitive */
+bool stringToBool(string str, bool *out);
+
+string stringFromInt(int value);
+string stringFromLong(long value);
+string stringFromInt64(int64_t value);
+string stringFromUint64(uint64_t value);
+
+/** Fixed with precision digits after the point, or the shortest text that reads back exactly if negative */
+string stringFromDouble(double value, int precision);
+string stringFromBool(bool value);
+
 // utf-8
 
 /** Check binary prefix for UTF-8 parsing */
 bool stringBinaryPrefix(unsigned char byteToCheck, unsigned char prefix, size_t bitDepth);
 
-/** Get nth UTF-8 character (returns string slice) */
+/** Get nth UTF-8 character (returns string slice), O(1) amortized through a lazily built index.
+    safe to call from several threads on the same string as long as none of them modifies it,
+    strings from an arena or pool backend and interned strings are not indexed and walk instead */
 string stringUtf8At(string str, size_t charIndex);
 
 /** Decode UTF-8 character at byte position */
@@ -217,6 +489,8 @@ string stringUtf8Encode(utf32_t codepoint);
 
 // classification
 
+// classes are ascii only and do not depend on the locale, bytes from 0x80 up belong to none
+
 bool stringIsOnlyAlphNum(const char *inputCstr);
 
 /** Check if string contains only alphabetic characters */
@@ -225,7 +499,7 @@ bool stringIsAlpha(string str);
 /** Check if string contains only digits */
 bool stringIsDigit(string str);
 
-/** Check if string contains only whitespace */
+/** Check if string contains only whitespace (space, \t, \n, \v, \f, \r) */
 bool stringIsWhitespace(string str);
 
 /** Check if string is empty */
@@ -233,6 +507,61 @@ static inline bool stringIsEmpty(string str) {
     return stringlen(str) == 0;
 }
 
+// string views
+//
+// views point into memory owned by someone else (a string, a literal, an input buffer) and stay
+// valid only as long as that memory does. none of these functions allocate except stringFromStrview
+
+/** Create a view of a C string, string or another view */
+#define strview(input)                                                      \
+    ({                                                                      \
+        auto _view_input = (input);                                         \
+        _Generic((_view_input),                                             \
+            char *: strviewFromCharPtr(coerce(_view_input, char *)),        \
+            const char *: strviewFromCharPtr(coerce(_view_input, char *)),  \
+            string: strviewFromString(coerce(_view_input, string)),         \
+            strview: coerce(_view_input, strview)                           \
+        );                                                                  \
+    })
+
+strview strviewFromString(string str);
+strview strviewFromCharPtr(const char *cstr);
+strview strviewFromParts(const char *at, size_t length);
+
+/** Copy the viewed bytes into a new string */
+string stringFromStrview(strview view);
+
+/** Sub-view of [startIdx, endIdx), indices are clamped to the view */
+strview strviewSlice(strview view, size_t startIdx, size_t endIdx);
+
+int strviewcmp(strview viewA, strview viewB);
+bool strvieweql(strview viewA, strview viewB);
+bool strviewStartsWith(strview view, strview prefix);
+bool strviewEndsWith(strview view, strview suffix);
+
+/** Find first occurrence at or after startIdx, returns index or -1 */
+int strviewFindFrom(strview haystack, strview needle, size_t startIdx);
+int strviewFind(strview haystack, strview needle);
+int strviewFindLast(strview haystack, strview needle);
+
+uint64_t strviewHash(strview view);
+
+/** Hash with a caller chosen seed, e.g. per table to resist collision flooding */
+uint64_t strviewHashSeeded(strview view, uint64_t seed);
+
+strview strviewTrim(strview view);
+strview strviewTrimLeft(strview view);
+strview strviewTrimRight(strview view);
+
+/** Decode UTF-8 character at byte position */
+utf32_t strviewUtf8DecodeAt(strview view, size_t byteIndex, size_t *bytesRead);
+
+/** Validate UTF-8 encoding of the viewed bytes, see stringUtf8Validate */
+bool strviewUtf8Validate(strview view);
+
+/** Get UTF-8 character count of the viewed bytes */
+size_t strviewUtf8Length(strview view);
+
 // iterstring
 
 bool iterstringReset(iterstring_t *iter);
@@ -241,24 +570,118 @@ bool iterstringAdvance(iterstring_t *iter);
 // some functions are missing here
 
 // string builder stuff
+//
+// appends go straight into spare capacity, which grows geometrically. a chunked builder never
+// moves what it has written: once a chunk is full it is sealed and writing continues in a new one
 
 stringBuilder_t stringBuilderCreate(size_t initialSize);
+
+/** Builder that seals full chunks of chunkSize bytes (0: 64 KiB) instead of reallocating */
+stringBuilder_t stringBuilderCreateChunked(size_t chunkSize);
 void stringBuilderAppend(stringBuilder_t *sb, string str);
+void stringBuilderAppendStrview(stringBuilder_t *sb, strview view);
 void stringBuilderAppendCStr(stringBuilder_t *sb, const char *cstr);
 void stringBuilderAppendChar(stringBuilder_t *sb, char c);
+
+/** printf into the builder's tail, no temporary string */
 void stringBuilderAppendFormat(stringBuilder_t *sb, const char *fmt, ...);
+void stringBuilderAppendFormatVa(stringBuilder_t *sb, const char *fmt, va_list args);
+void stringBuilderAppendInt(stringBuilder_t *sb, int64_t value);
+void stringBuilderAppendUint(stringBuilder_t *sb, uint64_t value);
+
+/** Shortest text that reads back exactly, like stringFromDouble with a negative precision */
+void stringBuilderAppendDouble(stringBuilder_t *sb, double value);
+
+/** Bytes appended since creation or the last clear */
+size_t stringBuilderLength(const stringBuilder_t *sb);
+
+/** Copy of the contents, the builder stays usable (shares the buffer until the next append) */
 string stringBuilderToString(stringBuilder_t *sb);
+
+/** Hand the contents over without copying (chunked: joined once), the builder is left empty */
+string stringBuilderFinish(stringBuilder_t *sb);
+
+/** Hand over the chunks without copying or joining them, the builder is left empty */
+dynarray(string) stringBuilderFinishChunks(stringBuilder_t *sb);
 void stringBuilderClear(stringBuilder_t *sb);
 void stringBuilderDestroy(stringBuilder_t *sb);
 string stringRemoveDuplicates(string str);
 string stringIntersect(string str1, string str2);
+
+// escaping and hex
+
+/** C escapes for quotes, backslashes and control characters, \xNN for other bytes outside printable ASCII */
 string stringEscapeC(string str);
+
+/** Undo stringEscapeC, unknown escapes stand for the escaped character */
 string stringUnescapeC(string str);
+
+/** Two lowercase hex digits per byte */
+string stringToHex(string str);
+
+/** Bytes from pairs of hex digits in either case, empty on odd length or any other character */
+string stringFromHex(string hex_str);
+
+// base64
+
+/** Standard alphabet with padding */
 string stringBase64Encode(string str);
-string stringBase64Decode(string str); // currently not implemented
+string stringBase64EncodeWith(string str, stringBase64Flags_t flags);
+
+/** Strict standard decoding, none on invalid input */
+option(string) stringBase64Decode(string str);
+option(string) stringBase64DecodeWith(string str, stringBase64Flags_t flags);
+
+/** State for encoding or decoding input that arrives in pieces, into a builder */
+stringBase64Stream_t stringBase64StreamCreate(stringBase64Flags_t flags);
+void stringBase64EncodeChunk(stringBase64Stream_t *stream, stringBuilder_t *out, strview chunk);
+
+/** Write the last partial group and the padding */
+void stringBase64EncodeEnd(stringBase64Stream_t *stream, stringBuilder_t *out);
+
+/** False once the input turned out invalid, the failing chunk adds nothing to out */
+bool stringBase64DecodeChunk(stringBase64Stream_t *stream, stringBuilder_t *out, strview chunk);
+
+/** Decode the last partial group, false if the input ended in the wrong place */
+bool stringBase64DecodeEnd(stringBase64Stream_t *stream, stringBuilder_t *out);
+
+
+/** Match with * and ?, where * also matches '/', backtracks on every call */
 bool stringMatchWildcard(string str, string pattern);
+
+/** Compile and match once, compile with stringGlobCompile to match many strings */
 bool stringMatchGlob(string str, string pattern);
+
+// compiled globs
+
+/** Compile a glob: ? * ** [a-z] [!a-z] {a,b} and \ escapes, * and ? do not match '/' */
+stringGlob_t stringGlobCompile(string pattern);
+
+/** Compile patterns into one matcher that checks all of them in a single pass */
+stringGlob_t stringGlobCompileSet(dynarray(string) patterns);
+void destroyStringGlob(stringGlob_t glob);
+
+/** Whether str matches the glob, or any pattern of a set */
+bool stringGlobMatch(stringGlob_t glob, string str);
+
+/** Index of the first pattern in the set matching str, or -1 */
+int stringGlobMatchFirst(stringGlob_t glob, string str);
+
+/** Indices of all patterns in the set matching str, ascending */
+dynarray(size_t) stringGlobMatchAll(stringGlob_t glob, string str);
+
+// edit distance
+
+/** Levenshtein distance, bit-parallel over 64 characters at a time */
 size_t stringLevenshteinDistance(string str1, string str2);
+
+/** Distance if it is at most maxDistance, otherwise maxDistance + 1, gives up as early as it can */
+size_t stringLevenshteinBounded(string str1, string str2, size_t maxDistance);
+
+/** The k candidates closest to query within maxDistance, nearest first, ties by lower index */
+dynarray(stringFuzzyMatch_t) stringClosestMatches(string query, dynarray(string) candidates,
+    size_t k, size_t maxDistance);
+
 string stringToSnakeCase(string str);
 string stringToKebabCase(string str);
 
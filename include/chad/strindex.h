@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023-2025 defg43
+// https://github.com/defg43/
+
+#ifndef STRINDEX_H
+#define STRINDEX_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "str.h"
+
+// string indexes
+//
+// an index is built once over a large string and then answers any number of substring queries
+// without rescanning it. the suffix array is built with SA-IS in linear time, a query binary
+// searches it in O(m log n) for a pattern of m bytes. the FM-index keeps the Burrows-Wheeler
+// transform in a wavelet matrix and counts in O(m) regardless of the text size, at roughly 1.3
+// bytes per text byte instead of the 4 of a suffix array. an index can be saved and mapped back
+// later, the mapped file is used as is without being parsed into memory
+
+typedef enum {
+    string_index_suffix_array = 1 << 0, // keep the full suffix array, locating is a lookup
+    string_index_fm = 1 << 1,           // keep an FM-index, locating walks to a sampled suffix
+} stringIndexFlags_t;
+
+typedef struct stringIndexData stringIndexData_t;
+
+/** Substring index over one string, see stringIndexBuild */
+typedef struct {
+    stringIndexData_t *data;
+} stringIndex_t;
+
+// construction and destruction
+
+/** Index str with a suffix array. str is shared rather than copied and must be below 4 GiB */
+stringIndex_t stringIndexBuild(string str);
+stringIndex_t stringIndexBuildWith(string str, stringIndexFlags_t flags);
+void destroyStringIndex(stringIndex_t index);
+
+/** Write the index and its text to path, false if the file could not be written */
+bool stringIndexSave(stringIndex_t index, const char *path);
+
+/** Map an index written by stringIndexSave, none if it cannot be opened or its header is invalid.
+    the tables behind the header are trusted as written, only load files stringIndexSave produced */
+option(stringIndex_t) stringIndexLoad(const char *path);
+
+// queries, safe to run from several threads at once
+
+/** The indexed text */
+strview stringIndexText(stringIndex_t index);
+
+/** Occurrences of pattern, overlapping ones included unlike stringCount, 0 for an empty pattern */
+size_t stringIndexCount(stringIndex_t index, strview pattern);
+
+/** Offsets of every occurrence of pattern in ascending order */
+dynarray(size_t) stringIndexLocate(stringIndex_t index, strview pattern);
+
+/** A longest substring that occurs at least twice, empty if no byte repeats */
+strview stringIndexLongestRepeat(stringIndex_t index);
+
+#endif // STRINDEX_H
@@ -12,6 +12,9 @@
 // this prototypes are only function internal could be exported in future
 void consumeWhitespace(string *json, size_t *pos);
 
+// flags of the jsonToObjectWith call running on this thread, the parsers share one signature
+static thread_local ion_parse_flags_t parse_flags = ion_parse_default;
+
 object_t createEmptyObject() {
     return (object_t) {
         .key = NULL,
@@ -29,7 +32,7 @@ object_t insertObjectEntry(object_t object, string key, obj_t_value_t value) {
         exit(EXIT_FAILURE);
     } 
     object.key[object.count] = key; // key is just absorbed here and owned here from now on
-    // this should be sourced from the string allocator backend once it is implemented
+    // it lives in whichever string backend was active when it was made, see stringUseAllocator
     object.value[object.count] = value;
     object.count++;
     return object;
@@ -46,7 +49,7 @@ object_t insertSubobjectEntry(object_t object, string key, object_t value) {
     object.key = key_;
     object.value = value_;
     object.key[object.count] = key; // key is just absorbed here and owned here from now on
-    // this should be sourced from the string allocator backend once it is implemented
+    // it lives in whichever string backend was active when it was made, see stringUseAllocator
     object.value[object.count].discriminant = obj_t_obj;
     object.value[object.count].obj = value;
     object.count++;
@@ -63,7 +66,7 @@ object_t insertArrayEntry(object_t object, string key, array_t value) {
     object.key = key_;
     object.value = value_;
     object.key[object.count] = key; // key is just absorbed here and owned here from now on
-    // this should be sourced from the string allocator backend once it is implemented
+    // it lives in whichever string backend was active when it was made, see stringUseAllocator
     object.value[object.count].discriminant = obj_t_array;
     object.value[object.count].arr = value;
     object.count++;
@@ -80,7 +83,7 @@ object_t insertNumberEntry(object_t object, string key, number_t value) {
     object.key = key_;
     object.value = value_;
     object.key[object.count] = key; // key is just absorbed here and owned here from now on
-    // this should be sourced from the string allocator backend once it is implemented
+    // it lives in whichever string backend was active when it was made, see stringUseAllocator
     object.value[object.count].discriminant = obj_t_number;
     object.value[object.count].num = value;
     object.count++;
@@ -100,7 +103,7 @@ object_t insertStringEntry(object_t object, string key, string value) {
     printf("the object entry count is %ld\n", object.count);
     printf("%p\n", object.key);
     object.key[object.count] = key; // key is just absorbed here and owned here from now on
-    // this should be sourced from the string allocator backend once it is implemented
+    // it lives in whichever string backend was active when it was made, see stringUseAllocator
     object.value[object.count].discriminant = obj_t_string;
     object.value[object.count].str = value;
     object.count++;
@@ -117,7 +120,7 @@ object_t insertBoolEntry(object_t object, string key, bool value) {
     object.key = key_;
     object.value = value_;
     object.key[object.count] = key; // key is just absorbed here and owned here from now on
-    // this should be sourced from the string allocator backend once it is implemented
+    // it lives in whichever string backend was active when it was made, see stringUseAllocator
     if(value) {
         object.value[object.count].discriminant = obj_t_true;
     } else {
@@ -206,8 +209,10 @@ bool parseKey(string json, size_t *pos, string *result) {
 	bool success = false;
 	obj_t_value_t val = {};
 	success = parseString(json, pos, &val);
-	if(success) {
-		// if there is anything in result destroy it
+	if(success && (parse_flags & ion_parse_intern_keys)) {
+		*result = stringIntern(strviewFromString(val.str));
+		destroyString(val.str);
+	} else if(success) {
 		*result = val.str;
 	}
 	return success;
@@ -326,7 +331,8 @@ bool parseString(string json, size_t *pos, obj_t_value_t *result) {
 }
 
 bool parsePrimitive(string json, size_t *pos, obj_t_value_t *result) {
-	if(streql(&json.at[*pos], "true")) {
+	strview rest = strviewSlice(strviewFromString(json), *pos, stringlen(json));
+	if(strviewStartsWith(rest, strview("true"))) {
 		*result = (obj_t_value_t) {
 			.discriminant = obj_t_true,
 		};
@@ -334,7 +340,7 @@ bool parsePrimitive(string json, size_t *pos, obj_t_value_t *result) {
 		return true;
 	}
 	
-	if(streql(&json.at[*pos], "false")) {
+	if(strviewStartsWith(rest, strview("false"))) {
 		*result = (obj_t_value_t) {
 			.discriminant = obj_t_false,
 		};
@@ -342,7 +348,7 @@ bool parsePrimitive(string json, size_t *pos, obj_t_value_t *result) {
 		return true;
 	}
 	
-	if(streql(&json.at[*pos], "null")) {
+	if(strviewStartsWith(rest, strview("null"))) {
 		*result = (obj_t_value_t) {
 			.discriminant = obj_t_null,
 		};
@@ -458,12 +464,19 @@ bool parseArray(string json, size_t *pos, obj_t_value_t *result) {
 }
 
 object_t jsonToObject(string json_string) {
+	return jsonToObjectWith(json_string, ion_parse_default);
+}
+
+object_t jsonToObjectWith(string json_string, ion_parse_flags_t flags) {
 	object_t ret = createEmptyObject();
 	obj_t_value_t val = {};
 	size_t pos = 0;
+	ion_parse_flags_t previous = parse_flags;
+	parse_flags = flags;
 	if(parseObject(json_string, &pos, &val)) {
 		ret = val.obj;
 	}
+	parse_flags = previous;
 	return ret;		
 }
 
@@ -521,34 +534,20 @@ string objectToJson(object_t object) {
 }
 
 string numberToString(number_t number) {
-    string ret = string("");
-    char digit[2] = { '0', '\0' };
-    bool needs_sign = false;
     switch(number.number_discriminant) {
         case number_t_uint64_t:
-            while(number.as_uint64_t > 0) {
-                digit[0] = '0' + number.as_uint64_t % 10;
-                number.as_uint64_t /= 10;
-                ret = stringAppend(ret, digit);
-            }
-            stringReverse(ret);
-        break;
+            return stringFromUint64(number.as_uint64_t);
         case number_t_int64_t:
-            if(number.as_int64_t < 0) {
-                number.as_int64_t = -number.as_int64_t;
-                needs_sign = true;
-            }
-            while(number.as_int64_t > 0) {
-                digit[0] = '0' + number.as_int64_t % 10;
-                number.as_int64_t /= 10;
-                ret = stringAppend(ret, digit);
-            }
-            if(needs_sign) {
-                ret = stringAppend(ret, "-");
-                needs_sign = false;
-            }
-            stringReverse(ret);
+            return stringFromInt64(number.as_int64_t);
+        case number_t_double:
+            // shortest text that reads back to the same double
+            return stringFromDouble(number.as_double, -1);
+        default:
         break;
+    }
+    string ret = string("");
+    bool needs_sign = false;
+    switch(number.number_discriminant) {
         case number_t_float:
             if(number.as_float < 0) {
                 number.as_float = -number.as_float;
@@ -569,26 +568,6 @@ string numberToString(number_t number) {
                 ret = stringAppend(ret, num_buff);
             }
         break;
-        case number_t_double:
-            if(number.as_double < 0) {
-                number.as_double = -number.as_double;
-                needs_sign = true;
-            }
-            {
-                // extra 3 for null terminator, . and sign
-                #define MAX_FLOAT_DIGITS (32 * 4 + 3)
-                // man, i sure do hope this fixed stack buffer is enough to hold my string
-                // what could possibly go wrong?
-                char num_buff[MAX_FLOAT_DIGITS]; 
-                snprintf(num_buff, MAX_FLOAT_DIGITS, "%.15g", number.as_double);
-                #undef MAX_FLOAT_DIGITS
-                if(needs_sign) {
-                    ret = stringAppend(ret, "-");
-                    needs_sign = false;
-                }
-                ret = stringAppend(ret, num_buff);
-            }
-        break;
         case number_t_long_double:
             if(number.as_long_double < 0) {
                 number.as_long_double = -number.as_long_double;
@@ -161,6 +161,14 @@ bool isFollowedByAlternative(iterstring_t *rule) {
 	return true;
 }
 
+// rule names and storage keys are interned, every match of a rule then reuses the same key string
+// and rule lookups compare pointers
+static string internIdentifier(string identifier) {
+    string interned = stringIntern(strviewFromString(identifier));
+    destroyString(identifier);
+    return interned;
+}
+
 option(rule_t) compileRule(iterstring_t *rule) {
     parseWhitespace(rule);
     
@@ -177,6 +185,7 @@ option(rule_t) compileRule(iterstring_t *rule) {
     }
     
     if((res = parseIdentifier(rule)).valid) {
+        res.value = internIdentifier(res.value);
         parseWhitespace(rule);
         
         if(rule->str.at[rule->index] == ':') {
@@ -190,7 +199,7 @@ option(rule_t) compileRule(iterstring_t *rule) {
 					.type_mod = parseTypeModifier(rule),
 					.storage_key = res,
 					.literal_or_rule = is_rule,
-					.rule_name = rule_name.value,
+					.rule_name = internIdentifier(rule_name.value),
 					.ge = NULL,
 				};
 				return (option(rule_t)) some(ret);
@@ -288,14 +297,14 @@ option(grammar_entry_t) compileGrammarEntry(string rule_definition) {
     parseWhitespace(&it);
     
     grammar_entry_t ret = {
-        .name = name.value,
+        .name = internIdentifier(name.value),
         .rule_type = storage_type_not_set,
     };
     
     ret.element = create_dynarray(rule_node_t);
     
     if(!parseStringLiterally(&it, "->")) {
-        fprintf(stderr, "Expected '->' after rule name '%s'\n", name.value.at);
+        fprintf(stderr, "Expected '->' after rule name '%s'\n", ret.name.at);
         destroyString(ret.name);
         return (option(grammar_entry_t)) none;
     }
@@ -363,12 +372,29 @@ option(size_t) findGrammarEntry(grammar_t *gram, string *name) {
     return (option(size_t)) none;
 }
 
+// suggests the closest entry name, typos in rule references are the usual cause
+static void reportUnknownRule(string name, grammar_t *gram) {
+    dynarray(string) names = {};
+    for(size_t i = 0; i < gram->entry.count; i++) {
+        dynarray_append(names, gram->entry.at[i].name);
+    }
+    size_t max_distance = stringlen(name) / 3 > 2 ? stringlen(name) / 3 : 2;
+    dynarray(stringFuzzyMatch_t) closest = stringClosestMatches(name, names, 1, max_distance);
+    if(closest.count > 0) {
+        fprintf(stderr, "Linking failed: unknown rule '%s', did you mean '%s'?\n",
+                name.at, names.at[closest.at[0].index].at);
+    } else {
+        fprintf(stderr, "Linking failed: unknown rule '%s'\n", name.at);
+    }
+    destroy_dynarray(closest);
+    destroy_dynarray(names);
+}
+
 bool linkRule(rule_t *rule, grammar_t *gram) {
     if(rule->literal_or_rule == is_rule) {
         option(size_t) idx = findGrammarEntry(gram, &rule->rule_name);
         if(!idx.valid) {
-            fprintf(stderr, "Linking failed: unknown rule '%s'\n", 
-                    rule->rule_name.at);
+            reportUnknownRule(rule->rule_name, gram);
             return false;
         }
         rule->ge = &gram->entry.at[idx.value];
@@ -450,16 +476,12 @@ static option(obj_t_value_t) executeRuleNode(iterstring_t *is, rule_node_t *node
 static option(obj_t_value_t) executeGrammarEntry(iterstring_t *is, grammar_entry_t *entry, grammar_t *gram);
 
 static bool parseLiteralFromInput(iterstring_t *is, string literal) {
-    size_t lit_len = stringlen(literal);
-    
-    for(size_t i = 0; i < lit_len; i++) {
-        if(is->str.at[is->index + i] == '\0' || 
-           is->str.at[is->index + i] != literal.at[i]) {
-            return false;
-        }
+    strview rest = strviewSlice(strviewFromString(is->str), is->index, stringlen(is->str));
+    if(!strviewStartsWith(rest, strviewFromString(literal))) {
+        return false;
     }
     
-    is->index += lit_len;
+    is->index += stringlen(literal);
     iterstringAdvance(is);
     return true;
 }
@@ -645,8 +667,7 @@ static option(obj_t_value_t) executeGrammarEntry(iterstring_t *is, grammar_entry
                     option(obj_t_value_t) val = executeRule(is, &node->alternative.at[j], gram);
                     if(val.valid) {
                         if(node->alternative.at[j].storage_key.valid) {
-                        	string key_copy = stringFromString(node->alternative.at[j].storage_key.value);
-                            result = insertObjectEntry(result, key_copy, val.value);
+                            result = insertObjectEntry(result, node->alternative.at[j].storage_key.value, val.value);
                         }
                         matched = true;
                         break;
@@ -666,8 +687,7 @@ static option(obj_t_value_t) executeGrammarEntry(iterstring_t *is, grammar_entry
                 }
                 
                 if(node->rule.storage_key.valid) {
-                 	string key_copy = stringFromString(node->rule.storage_key.value);
-                    result = insertObjectEntry(result, key_copy, val.value);
+                    result = insertObjectEntry(result, node->rule.storage_key.value, val.value);
                 }
             }
         }
@@ -0,0 +1,392 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023-2025 defg43
+// https://github.com/defg43/
+
+#include "../include/chad/rope.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+
+// the tree is a treap ordered by position: every node holds one piece and a random priority,
+// parents outrank their children, which keeps the expected depth logarithmic without any
+// rebalancing bookkeeping. edits are expressed as split and merge, both consume the trees they
+// are given. a node with more than one owner is copied before it is changed, so ropes that share
+// nodes never see each other's edits
+
+// inserts shorter than this are merged into a neighbouring piece instead of getting their own
+#define ROPE_SMALL_PIECE 512
+
+struct ropeNode {
+    _Atomic uint32_t refcount;
+    uint32_t priority;
+    size_t length; // bytes in the whole subtree
+    ropeNode_t *left;
+    ropeNode_t *right;
+    string piece;  // this node covers piece.at[offset, offset + piece_length)
+    size_t offset;
+    size_t piece_length;
+};
+
+static thread_local uint64_t rope_priority_state = 0x9E3779B97F4A7C15ull;
+
+static uint32_t nextPriority(void) {
+    // xorshift64*, only needs to be cheap and well spread
+    uint64_t x = rope_priority_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rope_priority_state = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static size_t nodeLength(const ropeNode_t *node) {
+    return node ? node->length : 0;
+}
+
+static void nodeUpdate(ropeNode_t *node) {
+    node->length = nodeLength(node->left) + node->piece_length + nodeLength(node->right);
+}
+
+// takes ownership of piece
+static ropeNode_t *newNode(string piece, size_t offset, size_t piece_length) {
+    ropeNode_t *node = malloc(sizeof(ropeNode_t));
+    if(node == NULL) {
+        fprintf(stderr, "failed to allocate memory in newNode\n");
+        exit(EXIT_FAILURE);
+    }
+    atomic_init(&node->refcount, 1);
+    node->priority = nextPriority();
+    node->left = NULL;
+    node->right = NULL;
+    node->piece = piece;
+    node->offset = offset;
+    node->piece_length = piece_length;
+    node->length = piece_length;
+    return node;
+}
+
+static ropeNode_t *nodeRetain(ropeNode_t *node) {
+    if(node != NULL) {
+        atomic_fetch_add_explicit(&node->refcount, 1, memory_order_relaxed);
+    }
+    return node;
+}
+
+static void nodeRelease(ropeNode_t *node) {
+    if(node == NULL) return;
+    if(atomic_fetch_sub_explicit(&node->refcount, 1, memory_order_acq_rel) != 1) return;
+    nodeRelease(node->left);
+    nodeRelease(node->right);
+    destroyString(node->piece);
+    free(node);
+}
+
+// a node the caller may change, copied when someone else still holds it
+static ropeNode_t *nodeMutable(ropeNode_t *node) {
+    if(atomic_load_explicit(&node->refcount, memory_order_acquire) == 1) {
+        return node;
+    }
+    ropeNode_t *copy = malloc(sizeof(ropeNode_t));
+    if(copy == NULL) {
+        fprintf(stderr, "failed to allocate memory in nodeMutable\n");
+        exit(EXIT_FAILURE);
+    }
+    atomic_init(&copy->refcount, 1);
+    copy->priority = node->priority;
+    copy->length = node->length;
+    copy->left = nodeRetain(node->left);
+    copy->right = nodeRetain(node->right);
+    copy->piece = stringFromString(node->piece);
+    copy->offset = node->offset;
+    copy->piece_length = node->piece_length;
+    nodeRelease(node);
+    return copy;
+}
+
+static ropeNode_t *merge(ropeNode_t *a, ropeNode_t *b) {
+    if(a == NULL) return b;
+    if(b == NULL) return a;
+    if(a->priority > b->priority) {
+        a = nodeMutable(a);
+        a->right = merge(a->right, b);
+        nodeUpdate(a);
+        return a;
+    }
+    b = nodeMutable(b);
+    b->left = merge(a, b->left);
+    nodeUpdate(b);
+    return b;
+}
+
+// restore the heap order when a tail cut from a piece below now heads node->left. only that root
+// can outrank node, everything under it came from node's own subtree, so one rotation per level
+// carries it up to where it belongs, as in a treap insertion
+static ropeNode_t *raiseLeft(ropeNode_t *node) {
+    if(node->left == NULL || node->left->priority <= node->priority) return node;
+    ropeNode_t *child = nodeMutable(node->left);
+    node->left = child->right;
+    nodeUpdate(node);
+    child->right = node;
+    nodeUpdate(child);
+    return child;
+}
+
+// first pos bytes go to *left, the rest to *right
+static void split(ropeNode_t *node, size_t pos, ropeNode_t **left, ropeNode_t **right) {
+    if(node == NULL) {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+    node = nodeMutable(node);
+    size_t left_length = nodeLength(node->left);
+    if(pos <= left_length) {
+        split(node->left, pos, left, &node->left);
+        nodeUpdate(node);
+        *right = raiseLeft(node);
+        return;
+    }
+    if(pos >= left_length + node->piece_length) {
+        split(node->right, pos - left_length - node->piece_length, &node->right, right);
+        nodeUpdate(node);
+        *left = node;
+        return;
+    }
+    // the cut falls inside this piece, the tail becomes a node of its own sharing the string. its
+    // fresh priority may outrank the ancestors it ends up under, raiseLeft rotates it into place
+    size_t cut = pos - left_length;
+    ropeNode_t *tail = newNode(stringFromString(node->piece), node->offset + cut,
+        node->piece_length - cut);
+    ropeNode_t *rest = node->right;
+    node->piece_length = cut;
+    node->right = NULL;
+    nodeUpdate(node);
+    *left = node;
+    *right = merge(tail, rest);
+}
+
+static string appendView(string str, strview text) {
+    str = stringGrowBuffer(str, text.length);
+    size_t length = stringlen(str);
+    memcpy(str.at + length, text.at, text.length);
+    getHeaderPointer(str)->length = length + text.length;
+    str.at[length + text.length] = '\0';
+    stringInvalidate(str);
+    return str;
+}
+
+static strview nodeView(const ropeNode_t *node) {
+    return strviewFromParts(node->piece.at + node->offset, node->piece_length);
+}
+
+// small pieces
+
+// left followed by text, extending the last piece of left when it stays small
+static ropeNode_t *appendSmall(ropeNode_t *left, strview text) {
+    ropeNode_t *last = left;
+    while(last != NULL && last->right != NULL) {
+        last = last->right;
+    }
+    if(last == NULL || last->piece_length + text.length > ROPE_SMALL_PIECE) {
+        return merge(left, newNode(stringFromStrview(text), 0, text.length));
+    }
+    ropeNode_t *tail;
+    split(left, left->length - last->piece_length, &left, &tail);
+    tail = nodeMutable(tail);
+    string piece = tail->piece;
+    size_t capacity = stringCapacity(piece);
+    bool aliases = text.at >= piece.at && text.at <= piece.at + capacity;
+    bool ends_string = tail->offset + tail->piece_length == stringlen(piece);
+    if(ends_string && !aliases && !stringIsInterned(piece)
+        && stringlen(piece) <= 2 * ROPE_SMALL_PIECE) {
+        // the piece ends where its string does, grow the string (copy on write if shared)
+        tail->piece = appendView(piece, text);
+    } else {
+        string joined = stringFromStrview(nodeView(tail));
+        tail->piece = appendView(joined, text);
+        tail->offset = 0;
+        destroyString(piece);
+    }
+    tail->piece_length += text.length;
+    nodeUpdate(tail);
+    return merge(left, tail);
+}
+
+// text followed by right, folding the first piece of right into it when that stays small
+static ropeNode_t *prependSmall(strview text, ropeNode_t *right) {
+    ropeNode_t *first = right;
+    while(first != NULL && first->left != NULL) {
+        first = first->left;
+    }
+    if(first == NULL || first->piece_length + text.length > ROPE_SMALL_PIECE) {
+        return merge(newNode(stringFromStrview(text), 0, text.length), right);
+    }
+    ropeNode_t *head;
+    split(right, first->piece_length, &head, &right);
+    head = nodeMutable(head);
+    string joined = appendView(stringFromStrview(text), nodeView(head));
+    destroyString(head->piece);
+    head->piece = joined;
+    head->offset = 0;
+    head->piece_length = stringlen(joined);
+    nodeUpdate(head);
+    return merge(head, right);
+}
+
+// construction and destruction
+
+rope_t ropeCreate(void) {
+    return (rope_t) { .root = NULL };
+}
+
+rope_t ropeFromStrview(strview text) {
+    if(text.length == 0) return ropeCreate();
+    return (rope_t) { .root = newNode(stringFromStrview(text), 0, text.length) };
+}
+
+rope_t ropeFromString(string str) {
+    if(str.data == NULL || stringlen(str) == 0) return ropeCreate();
+    return (rope_t) { .root = newNode(stringFromString(str), 0, stringlen(str)) };
+}
+
+rope_t ropeCopy(rope_t rope) {
+    return (rope_t) { .root = nodeRetain(rope.root) };
+}
+
+void destroyRope(rope_t rope) {
+    nodeRelease(rope.root);
+}
+
+// properties
+
+size_t ropeLength(rope_t rope) {
+    return nodeLength(rope.root);
+}
+
+char ropeCharAt(rope_t rope, size_t index) {
+    const ropeNode_t *node = rope.root;
+    while(node != NULL) {
+        size_t left_length = nodeLength(node->left);
+        if(index < left_length) {
+            node = node->left;
+        } else if(index < left_length + node->piece_length) {
+            return node->piece.at[node->offset + index - left_length];
+        } else {
+            index -= left_length + node->piece_length;
+            node = node->right;
+        }
+    }
+    return '\0';
+}
+
+// editing
+
+void ropeInsert(rope_t *rope, size_t index, strview text) {
+    if(text.length == 0) return;
+    size_t length = ropeLength(*rope);
+    if(index > length) index = length;
+    ropeNode_t *left, *right;
+    split(rope->root, index, &left, &right);
+    if(text.length >= ROPE_SMALL_PIECE) {
+        left = merge(left, newNode(stringFromStrview(text), 0, text.length));
+    } else if(left != NULL) {
+        left = appendSmall(left, text);
+    } else {
+        right = prependSmall(text, right);
+    }
+    rope->root = merge(left, right);
+}
+
+void ropeInsertString(rope_t *rope, size_t index, string str) {
+    if(str.data == NULL || stringlen(str) < ROPE_SMALL_PIECE) {
+        if(str.data != NULL) ropeInsert(rope, index, strviewFromString(str));
+        return;
+    }
+    size_t length = ropeLength(*rope);
+    if(index > length) index = length;
+    ropeNode_t *left, *right;
+    split(rope->root, index, &left, &right);
+    left = merge(left, newNode(stringFromString(str), 0, stringlen(str)));
+    rope->root = merge(left, right);
+}
+
+void ropeAppend(rope_t *rope, strview text) {
+    ropeInsert(rope, ropeLength(*rope), text);
+}
+
+void ropePrepend(rope_t *rope, strview text) {
+    ropeInsert(rope, 0, text);
+}
+
+void ropeAppendRope(rope_t *rope, rope_t other) {
+    rope->root = merge(rope->root, nodeRetain(other.root));
+}
+
+void ropeDelete(rope_t *rope, size_t index, size_t length) {
+    size_t total = ropeLength(*rope);
+    if(index >= total || length == 0) return;
+    if(length > total - index) length = total - index;
+    ropeNode_t *left, *middle, *right;
+    split(rope->root, index, &left, &middle);
+    split(middle, length, &middle, &right);
+    nodeRelease(middle);
+    rope->root = merge(left, right);
+}
+
+rope_t ropeSlice(rope_t rope, size_t start, size_t end) {
+    size_t length = ropeLength(rope);
+    if(end > length) end = length;
+    if(start >= end) return ropeCreate();
+    ropeNode_t *head, *middle, *tail;
+    split(nodeRetain(rope.root), end, &middle, &tail);
+    nodeRelease(tail);
+    split(middle, start, &head, &middle);
+    nodeRelease(head);
+    return (rope_t) { .root = middle };
+}
+
+// reading
+
+static char *flattenInto(const ropeNode_t *node, char *out) {
+    while(node != NULL) {
+        out = flattenInto(node->left, out);
+        memcpy(out, node->piece.at + node->offset, node->piece_length);
+        out += node->piece_length;
+        node = node->right;
+    }
+    return out;
+}
+
+string ropeToString(rope_t rope) {
+    size_t length = ropeLength(rope);
+    string ret = stringReserve(stringFromCharPtr(""), length);
+    flattenInto(rope.root, ret.at);
+    getHeaderPointer(ret)->length = length;
+    ret.at[length] = '\0';
+    return ret;
+}
+
+ropeChunkIter_t ropeChunks(rope_t rope) {
+    return (ropeChunkIter_t) { .root = rope.root, .pos = 0 };
+}
+
+bool ropeChunkNext(ropeChunkIter_t *iter, strview *chunk) {
+    // descend to the piece holding pos, no stack to keep between calls
+    const ropeNode_t *node = iter->root;
+    size_t index = iter->pos;
+    while(node != NULL) {
+        size_t left_length = nodeLength(node->left);
+        if(index < left_length) {
+            node = node->left;
+        } else if(index < left_length + node->piece_length) {
+            size_t skip = index - left_length;
+            *chunk = strviewFromParts(node->piece.at + node->offset + skip, node->piece_length - skip);
+            iter->pos += chunk->length;
+            return true;
+        } else {
+            index -= left_length + node->piece_length;
+            node = node->right;
+        }
+    }
+    return false;
+}
@@ -2,6 +2,10 @@
 // Copyright (C) 2023-2025 defg43
 // https://github.com/defg43/
 
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE // mmap flags and madvise
+#endif
+
 #include "../include/chad/str.h"
 #include <stddef.h>
 #include <stdio.h>
@@ -9,6 +13,23 @@
 #include <ctype.h>
 #include <string.h>
 #include <limits.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <threads.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define CHAD_X86_SIMD 1
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <unistd.h>
+#define CHAD_POSIX 1
+#endif
 
 #ifndef container_of
 #define container_of(ptr, type, member) ((type *)((size_t)ptr - offsetof(type, member)))
@@ -39,16 +60,568 @@ static size_t my_strlen(const char *str) {
     return (size_t)(str - orig_ptr - 1);
 }
 
-string stringFromCharPtr(const char *input) {
-    size_t len = my_strlen(input);
-    size_t to_allocate = sizeof(stringHeader_t) + len + 1; 
-    stringHeader_t *result = malloc(to_allocate);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringFromCharPtr\n");
+// small strings
+//
+// strings of up to STRING_SMALL_CAPACITY bytes live in fixed size cells carved out of larger
+// blocks instead of getting their own malloc block. freed cells go onto a per-thread free list
+// and are reused by the next short string, the blocks themselves are never returned
+
+#ifndef CHAD_STRING_NO_SMALL
+
+#define STRING_SMALL_CELL_BYTES (sizeof(stringHeader_t) + STRING_SMALL_CAPACITY + 1)
+#define STRING_SMALL_CELLS_PER_BLOCK 128
+
+typedef union stringSmallCell stringSmallCell_t;
+
+union stringSmallCell {
+    stringSmallCell_t *next;
+    alignas(stringHeader_t) char bytes[STRING_SMALL_CELL_BYTES];
+};
+
+static thread_local stringSmallCell_t *small_free_list = NULL;
+
+static stringHeader_t *stringSmallAlloc(void) {
+    if(small_free_list == NULL) {
+        stringSmallCell_t *block = malloc(sizeof(stringSmallCell_t) * STRING_SMALL_CELLS_PER_BLOCK);
+        if(!block) {
+            fprintf(stderr, "failed to allocate memory in stringSmallAlloc\n");
+            exit(EXIT_FAILURE);
+        }
+        for(size_t i = 0; i < STRING_SMALL_CELLS_PER_BLOCK - 1; i++) {
+            block[i].next = &block[i + 1];
+        }
+        block[STRING_SMALL_CELLS_PER_BLOCK - 1].next = NULL;
+        small_free_list = block;
+    }
+    stringSmallCell_t *cell = small_free_list;
+    small_free_list = cell->next;
+    return (stringHeader_t *)cell;
+}
+
+static void stringSmallFree(stringHeader_t *header) {
+    stringSmallCell_t *cell = (stringSmallCell_t *)header;
+    cell->next = small_free_list;
+    small_free_list = cell;
+}
+
+#endif // CHAD_STRING_NO_SMALL
+
+// allocator backends
+//
+// strings record the backend they were allocated from in their header, new strings are taken
+// from the backend selected with stringUseAllocator on the calling thread. NULL selects the
+// default malloc backend (which also hands out the small string cells)
+
+struct stringArenaBlock {
+    stringArenaBlock_t *next;
+    size_t size;
+    size_t used;
+    alignas(max_align_t) char bytes[];
+};
+
+// pool requests above the largest size class, kept on a list so that reset and destroy find them
+struct stringPoolLarge {
+    stringPoolLarge_t *prev;
+    stringPoolLarge_t *next;
+    alignas(max_align_t) char bytes[];
+};
+
+#define STRING_ALLOC_ALIGN alignof(stringHeader_t)
+#define STRING_POOL_MIN_CLASS_BYTES 64
+#define STRING_POOL_CHUNK_BYTES (64 * 1024)
+
+static thread_local stringAllocator_t *current_allocator = NULL;
+
+static size_t alignUp(size_t bytes, size_t align) {
+    return (bytes + align - 1) & ~(align - 1);
+}
+
+static stringArenaBlock_t *newArenaBlock(size_t size, stringArenaBlock_t *next) {
+    stringArenaBlock_t *block = malloc(sizeof(stringArenaBlock_t) + size);
+    if(!block) {
+        fprintf(stderr, "failed to allocate memory in newArenaBlock\n");
         exit(EXIT_FAILURE);
     }
-    result->allocated_bytes = to_allocate;
-    result->length = len;
+    block->next = next;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+static void freeArenaBlocks(stringArenaBlock_t *block) {
+    while(block) {
+        stringArenaBlock_t *next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+static void freePoolLarge(stringPoolLarge_t *large) {
+    while(large) {
+        stringPoolLarge_t *next = large->next;
+        free(large);
+        large = next;
+    }
+}
+
+static void *arenaAlloc(stringAllocator_t *arena, size_t *bytes) {
+    size_t size = alignUp(*bytes, STRING_ALLOC_ALIGN);
+    stringArenaBlock_t *block = arena->arena.block;
+    if(block == NULL || block->size - block->used < size) {
+        size_t block_size = size > arena->arena.block_size ? size : arena->arena.block_size;
+        block = newArenaBlock(block_size, block);
+        arena->arena.block = block;
+    }
+    void *ret = block->bytes + block->used;
+    block->used += size;
+    *bytes = size;
+    return ret;
+}
+
+// size class index for pooled allocations, STRING_POOL_CLASSES for anything too large
+static size_t poolClass(size_t bytes) {
+    size_t index = 0;
+    size_t class_bytes = STRING_POOL_MIN_CLASS_BYTES;
+    while(class_bytes < bytes && index < STRING_POOL_CLASSES) {
+        class_bytes <<= 1;
+        index++;
+    }
+    return index;
+}
+
+static void *poolAlloc(stringAllocator_t *pool, size_t *bytes) {
+    size_t index = poolClass(*bytes);
+    if(index == STRING_POOL_CLASSES) {
+        stringPoolLarge_t *large = malloc(sizeof(stringPoolLarge_t) + *bytes);
+        if(!large) {
+            fprintf(stderr, "failed to allocate memory in poolAlloc\n");
+            exit(EXIT_FAILURE);
+        }
+        large->prev = NULL;
+        large->next = pool->pool.large;
+        if(large->next) large->next->prev = large;
+        pool->pool.large = large;
+        return large->bytes;
+    }
+    size_t class_bytes = (size_t)STRING_POOL_MIN_CLASS_BYTES << index;
+    if(pool->pool.free_list[index] == NULL) {
+        stringArenaBlock_t *chunk = newArenaBlock(STRING_POOL_CHUNK_BYTES, pool->pool.chunks);
+        pool->pool.chunks = chunk;
+        for(size_t offset = 0; offset + class_bytes <= chunk->size; offset += class_bytes) {
+            void **cell = (void **)(chunk->bytes + offset);
+            *cell = pool->pool.free_list[index];
+            pool->pool.free_list[index] = cell;
+        }
+    }
+    void **cell = pool->pool.free_list[index];
+    pool->pool.free_list[index] = *cell;
+    *bytes = class_bytes;
+    return cell;
+}
+
+static void poolFree(stringAllocator_t *pool, void *ptr, size_t bytes) {
+    size_t index = poolClass(bytes);
+    if(index == STRING_POOL_CLASSES) {
+        stringPoolLarge_t *large = (stringPoolLarge_t *)((char *)ptr - offsetof(stringPoolLarge_t, bytes));
+        if(large->prev) large->prev->next = large->next;
+        else pool->pool.large = large->next;
+        if(large->next) large->next->prev = large->prev;
+        free(large);
+        return;
+    }
+    void **cell = ptr;
+    *cell = pool->pool.free_list[index];
+    pool->pool.free_list[index] = cell;
+}
+
+stringAllocator_t stringArenaCreate(size_t block_size) {
+    if(block_size == 0) block_size = 64 * 1024;
+    return (stringAllocator_t) {
+        .kind = string_allocator_arena,
+        .arena = { .block = NULL, .block_size = block_size },
+    };
+}
+
+stringAllocator_t stringPoolCreate(void) {
+    return (stringAllocator_t) {
+        .kind = string_allocator_pool,
+        .pool = { .free_list = {}, .chunks = NULL, .large = NULL },
+    };
+}
+
+void stringAllocatorReset(stringAllocator_t *alloc) {
+    switch(alloc->kind) {
+        case string_allocator_arena: {
+            // keep the newest block around for reuse, everything else goes
+            stringArenaBlock_t *keep = alloc->arena.block;
+            if(keep) {
+                freeArenaBlocks(keep->next);
+                keep->next = NULL;
+                keep->used = 0;
+            }
+            break;
+        }
+        case string_allocator_pool:
+            freeArenaBlocks(alloc->pool.chunks);
+            freePoolLarge(alloc->pool.large);
+            *alloc = stringPoolCreate();
+            break;
+        default:
+            break;
+    }
+}
+
+void stringAllocatorDestroy(stringAllocator_t *alloc) {
+    if(current_allocator == alloc) {
+        current_allocator = NULL;
+    }
+    switch(alloc->kind) {
+        case string_allocator_arena:
+            freeArenaBlocks(alloc->arena.block);
+            alloc->arena.block = NULL;
+            break;
+        case string_allocator_pool:
+            freeArenaBlocks(alloc->pool.chunks);
+            freePoolLarge(alloc->pool.large);
+            *alloc = stringPoolCreate();
+            break;
+        default:
+            break;
+    }
+}
+
+stringAllocator_t *stringUseAllocator(stringAllocator_t *alloc) {
+    stringAllocator_t *previous = current_allocator;
+    if(alloc != NULL && alloc->kind == string_allocator_malloc) {
+        alloc = NULL;
+    }
+    current_allocator = alloc;
+    return previous;
+}
+
+// raw block of at least *bytes from a backend, *bytes is updated to the usable size
+static void *backendAlloc(stringAllocator_t *alloc, size_t *bytes) {
+    switch(alloc->kind) {
+        case string_allocator_arena:
+            return arenaAlloc(alloc, bytes);
+        case string_allocator_pool:
+            return poolAlloc(alloc, bytes);
+        default: {
+            void *ret = malloc(*bytes);
+            if(!ret) {
+                fprintf(stderr, "failed to allocate memory in backendAlloc\n");
+                exit(EXIT_FAILURE);
+            }
+            return ret;
+        }
+    }
+}
+
+static void backendFree(stringAllocator_t *alloc, void *ptr, size_t bytes) {
+    switch(alloc->kind) {
+        case string_allocator_arena:
+            // released all at once by stringAllocatorReset
+            break;
+        case string_allocator_pool:
+            poolFree(alloc, ptr, bytes);
+            break;
+        default:
+            free(ptr);
+            break;
+    }
+}
+
+// every string header is obtained through here, room for len bytes plus the terminator
+static stringHeader_t *allocStringHeader(size_t len) {
+    stringHeader_t *header;
+    size_t to_allocate = sizeof(stringHeader_t) + len + 1;
+    stringAllocator_t *alloc = current_allocator;
+    if(alloc != NULL) {
+        header = backendAlloc(alloc, &to_allocate);
+        header->allocator = alloc;
+        atomic_init(&header->flags, 0);
+        atomic_init(&header->refcount, 1);
+        atomic_init(&header->utf8_index, NULL);
+        header->allocated_bytes = to_allocate;
+        header->length = len;
+        return header;
+    }
+    #ifndef CHAD_STRING_NO_SMALL
+    if(len <= STRING_SMALL_CAPACITY) {
+        header = stringSmallAlloc();
+        header->allocator = NULL;
+        atomic_init(&header->flags, string_small);
+        atomic_init(&header->refcount, 1);
+        atomic_init(&header->utf8_index, NULL);
+        header->allocated_bytes = STRING_SMALL_CELL_BYTES;
+        header->length = len;
+        return header;
+    }
+    #endif
+    header = malloc(to_allocate);
+    if(!header) {
+        fprintf(stderr, "failed to allocate memory in allocStringHeader\n");
+        exit(EXIT_FAILURE);
+    }
+    header->allocator = NULL;
+    atomic_init(&header->flags, 0);
+    atomic_init(&header->refcount, 1);
+    atomic_init(&header->utf8_index, NULL);
+    header->allocated_bytes = to_allocate;
+    header->length = len;
+    return header;
+}
+
+// code point index
+//
+// byte offsets of every STRING_UTF8_INDEX_STRIDE-th code point, built on the first stringUtf8At
+// that reaches past the first stride. readers on several threads may race to build it, the first
+// compare exchange publishes its index and the others free theirs. it is always malloc'd, strings
+// from the arena and pool backends are never indexed since those backends are not locked and are
+// reset without visiting their strings. anything that changes the bytes in place drops the index
+// through stringInvalidate
+
+#define STRING_UTF8_INDEX_STRIDE 64
+
+struct stringUtf8Index {
+    size_t count;
+    size_t offsets[];
+};
+
+static void dropUtf8Index(stringHeader_t *header) {
+    free(atomic_exchange_explicit(&header->utf8_index, NULL, memory_order_acquire));
+}
+
+static stringUtf8Index_t *allocUtf8Index(size_t count) {
+    stringUtf8Index_t *index = malloc(sizeof(stringUtf8Index_t) + count * sizeof(size_t));
+    if(index == NULL) {
+        fprintf(stderr, "failed to allocate memory in allocUtf8Index\n");
+        exit(EXIT_FAILURE);
+    }
+    index->count = 0;
+    return index;
+}
+
+void stringInvalidate(string str) {
+    if(str.data == NULL) return;
+    stringHeader_t *header = getHeaderPointer(str);
+    if(atomic_load_explicit(&header->flags, memory_order_relaxed) & string_hash_cached) {
+        atomic_fetch_and_explicit(&header->flags, ~string_hash_cached, memory_order_relaxed);
+    }
+    dropUtf8Index(header);
+}
+
+// mapped files
+//
+// stringMapFile maps a file read only right behind a header of its own. one page for the
+// header, the file and one more page are reserved first, then the file is mapped over the
+// middle. the header ends exactly where the first page does, so that header->data is the first
+// byte of the file, and the terminator comes for free: the rest of the file's last page reads as
+// zeros, and when the file fills that page exactly, the spare page of the reservation does.
+// mapped strings are never written to, mutators take a private copy as they do of a shared
+// string, and the last destroyString unmaps everything at once
+
+#ifdef CHAD_POSIX
+
+static void unmapStringHeader(stringHeader_t *header) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    munmap(header->data - page, header->allocated_bytes);
+}
+
+option(string) stringMapFileWith(const char *path, stringMapAdvice_t advice) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if(fd < 0) {
+        return (option(string)) none;
+    }
+    struct stat info;
+    if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(fd);
+        return (option(string)) none;
+    }
+    size_t size = (size_t)info.st_size;
+    if(size == 0) {
+        // nothing to map, an ordinary empty string does
+        close(fd);
+        return (option(string)) some(stringFromCharPtr(""));
+    }
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t total = page + alignUp(size, page) + page;
+    char *base = mmap(NULL, total, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(base == MAP_FAILED) {
+        close(fd);
+        return (option(string)) none;
+    }
+    if(mmap(base + page, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED
+        || mprotect(base, page, PROT_READ | PROT_WRITE) != 0) {
+        munmap(base, total);
+        close(fd);
+        return (option(string)) none;
+    }
+    close(fd);
+    if(advice == string_map_sequential) {
+        madvise(base + page, size, MADV_SEQUENTIAL);
+    } else if(advice == string_map_random) {
+        madvise(base + page, size, MADV_RANDOM);
+    }
+
+    stringHeader_t *header = (stringHeader_t *)(base + page - sizeof(stringHeader_t));
+    header->allocator = NULL;
+    atomic_init(&header->flags, string_mapped);
+    atomic_init(&header->refcount, 1);
+    atomic_init(&header->utf8_index, NULL);
+    header->allocated_bytes = total;
+    header->length = size;
+    return (option(string)) some((string) { .data = (dataSegmentOfString_t *)header->data });
+}
+
+#else
+
+// no mmap, the file is read into an ordinary string instead
+option(string) stringMapFileWith(const char *path, stringMapAdvice_t advice) {
+    (void)advice;
+    FILE *file = fopen(path, "rb");
+    if(file == NULL) {
+        return (option(string)) none;
+    }
+    stringBuilder_t sb = stringBuilderCreate(0);
+    char buffer[1 << 16];
+    size_t n;
+    while((n = fread(buffer, 1, sizeof buffer, file)) > 0) {
+        stringBuilderAppendStrview(&sb, strviewFromParts(buffer, n));
+    }
+    bool failed = ferror(file);
+    fclose(file);
+    string contents = stringBuilderFinish(&sb);
+    if(failed) {
+        destroyString(contents);
+        return (option(string)) none;
+    }
+    return (option(string)) some(contents);
+}
+
+#endif // CHAD_POSIX
+
+option(string) stringMapFile(const char *path) {
+    return stringMapFileWith(path, string_map_normal);
+}
+
+static void freeStringHeader(stringHeader_t *header) {
+    dropUtf8Index(header);
+    if(header->allocator != NULL) {
+        backendFree(header->allocator, header, header->allocated_bytes);
+        return;
+    }
+    #ifndef CHAD_STRING_NO_SMALL
+    if(header->flags & string_small) {
+        stringSmallFree(header);
+        return;
+    }
+    #endif
+    #ifdef CHAD_POSIX
+    if(header->flags & string_mapped) {
+        unmapStringHeader(header);
+        return;
+    }
+    #endif
+    free(header);
+}
+
+// moves a string into a block of new_bytes owned by the same backend, the old block is released
+static stringHeader_t *resizeStringHeader(stringHeader_t *header, size_t new_bytes) {
+    stringHeader_t *new_header;
+    stringAllocator_t *alloc = header->allocator;
+    if(alloc != NULL) {
+        if(alloc->kind == string_allocator_arena) {
+            // the most recent allocation of an arena can simply be extended in place
+            stringArenaBlock_t *block = alloc->arena.block;
+            char *end = (char *)header + header->allocated_bytes;
+            size_t extra = alignUp(new_bytes - header->allocated_bytes, STRING_ALLOC_ALIGN);
+            if(end == block->bytes + block->used && block->size - block->used >= extra) {
+                block->used += extra;
+                header->allocated_bytes += extra;
+                return header;
+            }
+        }
+        new_header = backendAlloc(alloc, &new_bytes);
+        memcpy(new_header, header, sizeof(stringHeader_t) + header->length + 1);
+        backendFree(alloc, header, header->allocated_bytes);
+    }
+    #ifndef CHAD_STRING_NO_SMALL
+    else if(header->flags & string_small) {
+        new_header = malloc(new_bytes);
+        if(new_header == NULL) {
+            fprintf(stderr, "failed to allocate memory in resizeStringHeader\n");
+            exit(EXIT_FAILURE);
+        }
+        memcpy(new_header, header, sizeof(stringHeader_t) + header->length + 1);
+        new_header->flags &= ~string_small;
+        stringSmallFree(header);
+    }
+    #endif
+    else {
+        new_header = realloc(header, new_bytes);
+        if(new_header == NULL) {
+            fprintf(stderr, "realloc failed in resizeStringHeader\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    new_header->allocated_bytes = new_bytes;
+    return new_header;
+}
+
+// sharing
+//
+// when the source already lives in the backend a copy would be taken from, stringFromString
+// hands out another reference to the same header instead of copying. a shared header is read
+// only: every mutator detaches a private copy first, and the lazily filled hash and code point
+// index are only cached while there is a single owner, so shared strings can be read and
+// released from any thread
+
+static bool headerIsShared(stringHeader_t *header) {
+    return atomic_load_explicit(&header->refcount, memory_order_acquire) > 1;
+}
+
+// shared or a read only file mapping, either way written only after detaching a copy
+static bool headerIsReadOnly(stringHeader_t *header) {
+    return (header->flags & string_mapped) || headerIsShared(header);
+}
+
+static void releaseStringHeader(stringHeader_t *header) {
+    if(atomic_fetch_sub_explicit(&header->refcount, 1, memory_order_acq_rel) == 1) {
+        freeStringHeader(header);
+    }
+}
+
+// private copy of the first keep bytes of a shared header, from the same backend and with room
+// for capacity bytes. gives up the caller's reference to the shared one
+static stringHeader_t *detachStringHeader(stringHeader_t *header, size_t keep, size_t capacity) {
+    stringAllocator_t *previous = stringUseAllocator(header->allocator);
+    stringHeader_t *copy = allocStringHeader(capacity > keep ? capacity : keep);
+    stringUseAllocator(previous);
+    copy->length = keep;
+    memcpy(copy->data, header->data, keep);
+    copy->data[keep] = '\0';
+    releaseStringHeader(header);
+    return copy;
+}
+
+// header of str ready to be written in place, detached first when shared
+static stringHeader_t *writableHeader(string str) {
+    stringHeader_t *header = getHeaderPointer(str);
+    if(header->flags & string_interned) {
+        fprintf(stderr, "attempt to modify interned string \"%s\"\n", header->data);
+        exit(EXIT_FAILURE);
+    }
+    if(headerIsReadOnly(header)) {
+        header = detachStringHeader(header, header->length, header->length);
+    }
+    return header;
+}
+
+string stringFromCharPtr(const char *input) {
+    size_t len = my_strlen(input);
+    stringHeader_t *result = allocStringHeader(len);
     my_strcpy(input, result->data);
     return (string) { .data = (dataSegmentOfString_t *)result->data };
 }
@@ -67,21 +640,35 @@ string stringFromString(string input) {
         exit(EXIT_FAILURE);
     }
     #endif
-    size_t to_alloctate = header->allocated_bytes;
-    stringHeader_t *result = malloc(to_alloctate);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringFromString\n");
-        exit(EXIT_FAILURE);
+    #ifndef CHAD_STRING_NO_SHARING
+    if(header->flags & string_interned) {
+        return input; // immutable and never freed, nothing to count
     }
-    result->allocated_bytes = to_alloctate;
-    result->length = header->length;
+    if(header->allocator == current_allocator) {
+        atomic_fetch_add_explicit(&header->refcount, 1, memory_order_relaxed);
+        return input;
+    }
+    #endif
+    return stringClone(input);
+}
+
+string stringClone(string input) {
+    stringHeader_t *header = containerof(input.data, stringHeader_t, data);
+    stringHeader_t *result = allocStringHeader(header->length);
     my_strncpy(result->data, header->data, header->length);
     result->data[header->length] = '\0';
     return (string) { .data = (dataSegmentOfString_t *)result->data };
 }
 
 void destroyString(string input) {
-    free(containerof(input.data, stringHeader_t, data));
+    if(input.data == NULL) {
+        return;
+    }
+    stringHeader_t *header = containerof(input.data, stringHeader_t, data);
+    if(header->flags & string_interned) {
+        return; // owned by the intern pool, see stringInternReset
+    }
+    releaseStringHeader(header);
 }
 
 stringHeader_t *getHeaderPointer(string input) {
@@ -103,12 +690,11 @@ int stringcmp(string a, string b) {
         return 0;
     }
     size_t min = a_header->length < b_header->length ? a_header->length : b_header->length;
-    for(size_t i = 0; i < min; i++) {
-        if(a_header->data[i] != b_header->data[i]) {
-            return (int)(unsigned char)a_header->data[i] - (int)(unsigned char)b_header->data[i];
-        }
+    int res = min ? memcmp(a_header->data, b_header->data, min) : 0;
+    if(res != 0) {
+        return res;
     }
-    return (int)a_header->length - (int)b_header->length;
+    return (a_header->length > b_header->length) - (a_header->length < b_header->length);
 }
 
 int stringncmp(string a, string b, size_t n) {
@@ -124,14 +710,25 @@ int stringncmp(string a, string b, size_t n) {
             return (int)(unsigned char)a_header->data[i] - (int)(unsigned char)b_header->data[i];
         }
     }
-    if(n >= a_header->length && n >= b_header->length) {
-        return (int)a_header->length - (int)b_header->length;
-    }
-    return 0;
+    // a string that ends within the first n bytes sorts before one that goes on
+    size_t a_length = a_header->length < n ? a_header->length : n;
+    size_t b_length = b_header->length < n ? b_header->length : n;
+    return (a_length > b_length) - (a_length < b_length);
 }
 
 bool stringeql(string a, string b) {
-    return stringcmp(a, b) == 0;
+    if(a.data == b.data) return true;
+    stringHeader_t *ha = getHeaderPointer(a), *hb = getHeaderPointer(b);
+    if(ha->length != hb->length) return false;
+    // acquire pairs with the release in stringHash64, a set string_hash_cached means hash is written
+    stringFlags_t both = atomic_load_explicit(&ha->flags, memory_order_acquire)
+        & atomic_load_explicit(&hb->flags, memory_order_acquire);
+    // distinct interned strings never have equal contents
+    if(both & string_interned) return false;
+    // two cached hashes that differ settle it without touching the bytes
+    if((both & string_hash_cached) && atomic_load_explicit(&ha->hash, memory_order_relaxed)
+        != atomic_load_explicit(&hb->hash, memory_order_relaxed)) return false;
+    return memcmp(ha->data, hb->data, ha->length) == 0;
 }
 
 bool stringneql(string a, string b, size_t n) {
@@ -176,139 +773,602 @@ bool stringeqlidx(string haystack, size_t n, string needle) {
 }
 
 bool stringStartsWith(string str, string prefix) {
-    return stringeqlidx(str, 0, prefix);
+    return strviewStartsWith(strviewFromString(str), strviewFromString(prefix));
 }
 
 bool stringEndsWith(string str, string suffix) {
-    size_t str_len = stringlen(str);
-    size_t suffix_len = stringlen(suffix);
-    if(suffix_len > str_len) {
-        return false;
-    }
-    return stringeqlidx(str, str_len - suffix_len, suffix);
+    return strviewEndsWith(strviewFromString(str), strviewFromString(suffix));
 }
 
-int stringcmpIgnoreCase(string a, string b) {
-    stringHeader_t *a_header = getHeaderPointer(a);
-    stringHeader_t *b_header = getHeaderPointer(b);
-    size_t min = a_header->length < b_header->length ? a_header->length : b_header->length;
-    for(size_t i = 0; i < min; i++) {
-        int ca = tolower((unsigned char)a_header->data[i]);
-        int cb = tolower((unsigned char)b_header->data[i]);
-        if(ca != cb) {
-            return ca - cb;
-        }
-    }
-    return (int)a_header->length - (int)b_header->length;
-}
+// ascii kernels
+//
+// locale free case conversion and character classes. only the ascii letters are converted and
+// bytes from 0x80 up are never in a class, which matches the ctype functions in the "C" locale.
+// blocks of 32 (AVX2) or 16 (SSE2) bytes are handled at once, a byte is in a range exactly when
+// shifting the range start to -128 leaves it below -128 + width in a signed compare. the scalar
+// code does the same eight bytes at a time in a 64 bit word
 
-int stringFind(string haystack, string needle) {
-    return stringFindFrom(haystack, needle, 0);
+#define ASCII_ALPHA (1 << 0)
+#define ASCII_DIGIT (1 << 1)
+#define ASCII_SPACE (1 << 2) // \t \n \v \f \r and space
+
+static const uint8_t ascii_classes[256] = {
+    ['A' ... 'Z'] = ASCII_ALPHA,
+    ['a' ... 'z'] = ASCII_ALPHA,
+    ['0' ... '9'] = ASCII_DIGIT,
+    ['\t' ... '\r'] = ASCII_SPACE,
+    [' '] = ASCII_SPACE,
+};
+
+static inline unsigned char asciiLower(unsigned char c) {
+    return (unsigned char)(c - 'A') < 26 ? c | 0x20 : c;
 }
 
-int stringFindFrom(string haystack, string needle, size_t start) {
-    size_t haystack_len = stringlen(haystack);
-    size_t needle_len = stringlen(needle);
-    if(needle_len == 0) return (int)start;
-    if(needle_len > haystack_len || start > haystack_len - needle_len) return -1;
-    
-    for(size_t i = start; i <= haystack_len - needle_len; i++) {
-        if(stringeqlidx(haystack, i, needle)) {
-            return (int)i;
-        }
+// first is 'a' to convert to upper case, 'A' to convert to lower case
+static void asciiCaseScalar(char *dst, const char *src, size_t len, unsigned char first) {
+    const uint64_t ones = 0x0101010101010101ull;
+    size_t i = 0;
+    for(; i + 8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, src + i, 8);
+        // bit 7 of each byte: at least first, at least first + 26, and not from 0x80 up
+        uint64_t low_bits = word & (0x7F * ones);
+        uint64_t from_first = low_bits + (0x80 - first) * ones;
+        uint64_t past_last = low_bits + (0x80 - first - 26) * ones;
+        uint64_t letters = (from_first ^ past_last) & ~word & (0x80 * ones);
+        word ^= letters >> 2;
+        memcpy(dst + i, &word, 8);
+    }
+    for(; i < len; i++) {
+        unsigned char c = src[i];
+        dst[i] = (unsigned char)(c - first) < 26 ? c ^ 0x20 : c;
     }
-    return -1;
 }
 
-int stringFindLast(string haystack, string needle) {
-    size_t haystack_len = stringlen(haystack);
-    size_t needle_len = stringlen(needle);
-    if(needle_len == 0) return (int)haystack_len;
-    if(needle_len > haystack_len) return -1;
-    
-    for(size_t i = haystack_len - needle_len + 1; i > 0; i--) {
-        if(stringeqlidx(haystack, i - 1, needle)) {
-            return (int)(i - 1);
-        }
+static bool asciiAllOfScalar(const unsigned char *at, size_t len, unsigned classes) {
+    for(size_t i = 0; i < len; i++) {
+        if(!(ascii_classes[at[i]] & classes)) return false;
     }
-    return -1;
+    return true;
 }
 
-size_t stringCount(string haystack, string needle) {
-    size_t count = 0;
-    size_t needle_len = stringlen(needle);
-    if(needle_len == 0) return 0;
-    
-    int pos = 0;
-    while((pos = stringFindFrom(haystack, needle, pos)) != -1) {
-        count++;
-        pos += needle_len;
+static int asciiCmpIgnoreCaseScalar(const unsigned char *a, const unsigned char *b, size_t len) {
+    for(size_t i = 0; i < len; i++) {
+        unsigned char ca = asciiLower(a[i]);
+        unsigned char cb = asciiLower(b[i]);
+        if(ca != cb) return ca - cb;
     }
-    return count;
+    return 0;
 }
 
+#ifdef CHAD_X86_SIMD
 
-string stringConcat(string a, string b) {
-    stringHeader_t *a_header = containerof(a.data, stringHeader_t, data);
-    stringHeader_t *b_header = containerof(b.data, stringHeader_t, data);
-    size_t to_alloctate = sizeof(stringHeader_t) + a_header->length + b_header->length + 1;
-    stringHeader_t *result = malloc(to_alloctate);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in concat\n");
-        exit(EXIT_FAILURE);
-    }
-    result->allocated_bytes = to_alloctate;
-    result->length = a_header->length + b_header->length;
-    my_strncpy(result->data, a_header->data, a_header->length);
-    my_strncpy(result->data + a_header->length, b_header->data, b_header->length);
-    result->data[result->length] = '\0';
-    return (string) { .data = (dataSegmentOfString_t *)result->data };
+static inline __m128i asciiInRangeSse2(__m128i v, unsigned char first, unsigned char width) {
+    __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - first)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + width)));
 }
 
-string stringSliceFromString(string input, size_t start, size_t end) {
-    bool needs_reversing = false;
-    if(input.data == NULL) {
-        return (string) { .data = NULL };
+static inline __m128i asciiLowerSse2(__m128i v) {
+    return _mm_xor_si128(v, _mm_and_si128(asciiInRangeSse2(v, 'A', 26), _mm_set1_epi8(0x20)));
+}
+
+static __m128i asciiClassSse2(__m128i v, unsigned classes) {
+    __m128i in = _mm_setzero_si128();
+    if(classes & ASCII_ALPHA) {
+        in = _mm_or_si128(in, asciiInRangeSse2(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 26));
     }
-    if(end > stringlen(input)) {
-        if(start > stringlen(input)) {
-            return (string) { .data = NULL };
-        }
-        end = stringlen(input);
-    } else if(start > end) {
-        needs_reversing = true;
-        size_t temp = start;
-        start = end;
-        end = temp;
+    if(classes & ASCII_DIGIT) {
+        in = _mm_or_si128(in, asciiInRangeSse2(v, '0', 10));
     }
-    if(start > stringlen(input)) {
-        if(!needs_reversing)   {
-            return (string) { .data = NULL };
-        } else {
-            start = stringlen(input);
-        }
+    if(classes & ASCII_SPACE) {
+        in = _mm_or_si128(in, asciiInRangeSse2(v, '\t', 5));
+        in = _mm_or_si128(in, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
     }
-    size_t to_allocate = end - start;
-    stringHeader_t *buf = malloc(sizeof(stringHeader_t) + to_allocate + 1);
-    if(!buf) {
-        fprintf(stderr, "failed to allocate memory in stringSliceFromString\n");
-        exit(EXIT_FAILURE);
+    return in;
+}
+
+static void asciiCaseSse2(char *dst, const char *src, size_t len, unsigned char first) {
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i flip = _mm_and_si128(asciiInRangeSse2(v, first, 26), _mm_set1_epi8(0x20));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(v, flip));
     }
-    buf->allocated_bytes = sizeof(stringHeader_t) + to_allocate + 1;
-    buf->length = to_allocate;
-    for(size_t index = 0; index < to_allocate; index++) {
-        buf->data[index] = input.at[start + index];
+    asciiCaseScalar(dst + i, src + i, len - i, first);
+}
+
+static bool asciiAllOfSse2(const unsigned char *at, size_t len, unsigned classes) {
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(at + i));
+        if(_mm_movemask_epi8(asciiClassSse2(v, classes)) != 0xFFFF) return false;
     }
-    buf->data[to_allocate] = '\0';
-    string ret = (string) { .data = (dataSegmentOfString_t *)buf->data };
-    if(needs_reversing) {
-        stringReverse(ret);
+    return asciiAllOfScalar(at + i, len - i, classes);
+}
+
+static int asciiCmpIgnoreCaseSse2(const unsigned char *a, const unsigned char *b, size_t len) {
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        __m128i va = asciiLowerSse2(_mm_loadu_si128((const __m128i *)(a + i)));
+        __m128i vb = asciiLowerSse2(_mm_loadu_si128((const __m128i *)(b + i)));
+        unsigned differ = ~_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) & 0xFFFF;
+        if(differ != 0) {
+            size_t at = i + __builtin_ctz(differ);
+            return asciiLower(a[at]) - asciiLower(b[at]);
+        }
     }
-    return ret;
+    return asciiCmpIgnoreCaseScalar(a + i, b + i, len - i);
 }
 
-string stringSliceFromCharPtr(const char *input, size_t start, size_t end) {
-    size_t len = my_strlen(input);
+__attribute__((target("avx2")))
+static inline __m256i asciiInRangeAvx2(__m256i v, unsigned char first, unsigned char width) {
+    __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - first)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + width)), shifted);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i asciiLowerAvx2(__m256i v) {
+    return _mm256_xor_si256(v, _mm256_and_si256(asciiInRangeAvx2(v, 'A', 26), _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+static __m256i asciiClassAvx2(__m256i v, unsigned classes) {
+    __m256i in = _mm256_setzero_si256();
+    if(classes & ASCII_ALPHA) {
+        in = _mm256_or_si256(in, asciiInRangeAvx2(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 26));
+    }
+    if(classes & ASCII_DIGIT) {
+        in = _mm256_or_si256(in, asciiInRangeAvx2(v, '0', 10));
+    }
+    if(classes & ASCII_SPACE) {
+        in = _mm256_or_si256(in, asciiInRangeAvx2(v, '\t', 5));
+        in = _mm256_or_si256(in, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')));
+    }
+    return in;
+}
+
+__attribute__((target("avx2")))
+static void asciiCaseAvx2(char *dst, const char *src, size_t len, unsigned char first) {
+    size_t i = 0;
+    for(; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i flip = _mm256_and_si256(asciiInRangeAvx2(v, first, 26), _mm256_set1_epi8(0x20));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_xor_si256(v, flip));
+    }
+    asciiCaseSse2(dst + i, src + i, len - i, first);
+}
+
+__attribute__((target("avx2")))
+static bool asciiAllOfAvx2(const unsigned char *at, size_t len, unsigned classes) {
+    size_t i = 0;
+    for(; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(at + i));
+        if((unsigned)_mm256_movemask_epi8(asciiClassAvx2(v, classes)) != 0xFFFFFFFFu) return false;
+    }
+    return asciiAllOfSse2(at + i, len - i, classes);
+}
+
+__attribute__((target("avx2")))
+static int asciiCmpIgnoreCaseAvx2(const unsigned char *a, const unsigned char *b, size_t len) {
+    size_t i = 0;
+    for(; i + 32 <= len; i += 32) {
+        __m256i va = asciiLowerAvx2(_mm256_loadu_si256((const __m256i *)(a + i)));
+        __m256i vb = asciiLowerAvx2(_mm256_loadu_si256((const __m256i *)(b + i)));
+        unsigned differ = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+        if(differ != 0) {
+            size_t at = i + __builtin_ctz(differ);
+            return asciiLower(a[at]) - asciiLower(b[at]);
+        }
+    }
+    return asciiCmpIgnoreCaseSse2(a + i, b + i, len - i);
+}
+
+#endif // CHAD_X86_SIMD
+
+// short inputs skip the dispatch, a key or header name rarely fills a single block
+
+static void asciiCase(char *dst, const char *src, size_t len, unsigned char first) {
+    #ifdef CHAD_X86_SIMD
+    if(len >= 32 && __builtin_cpu_supports("avx2")) {
+        asciiCaseAvx2(dst, src, len, first);
+        return;
+    }
+    if(len >= 16) {
+        asciiCaseSse2(dst, src, len, first);
+        return;
+    }
+    #endif
+    asciiCaseScalar(dst, src, len, first);
+}
+
+static bool asciiAllOf(const char *at, size_t len, unsigned classes) {
+    const unsigned char *bytes = (const unsigned char *)at;
+    #ifdef CHAD_X86_SIMD
+    if(len >= 32 && __builtin_cpu_supports("avx2")) {
+        return asciiAllOfAvx2(bytes, len, classes);
+    }
+    if(len >= 16) {
+        return asciiAllOfSse2(bytes, len, classes);
+    }
+    #endif
+    return asciiAllOfScalar(bytes, len, classes);
+}
+
+static int asciiCmpIgnoreCase(const char *a, const char *b, size_t len) {
+    const unsigned char *ua = (const unsigned char *)a;
+    const unsigned char *ub = (const unsigned char *)b;
+    #ifdef CHAD_X86_SIMD
+    if(len >= 32 && __builtin_cpu_supports("avx2")) {
+        return asciiCmpIgnoreCaseAvx2(ua, ub, len);
+    }
+    if(len >= 16) {
+        return asciiCmpIgnoreCaseSse2(ua, ub, len);
+    }
+    #endif
+    return asciiCmpIgnoreCaseScalar(ua, ub, len);
+}
+
+int stringcmpIgnoreCase(string a, string b) {
+    stringHeader_t *a_header = getHeaderPointer(a);
+    stringHeader_t *b_header = getHeaderPointer(b);
+    size_t min = a_header->length < b_header->length ? a_header->length : b_header->length;
+    int differ = asciiCmpIgnoreCase(a_header->data, b_header->data, min);
+    if(differ != 0) {
+        return differ;
+    }
+    return (a_header->length > b_header->length) - (a_header->length < b_header->length);
+}
+
+// substring search
+//
+// short needles are located by comparing the first and last needle byte against a whole block
+// of haystack positions at once (AVX2 or SSE2, picked at runtime, with a scalar fallback) and
+// only verifying the candidates. needles longer than SEARCH_SHORT_NEEDLE use the two-way
+// algorithm, which is linear in the worst case. both have a reverse variant for stringFindLast
+
+#define SEARCH_NOT_FOUND SIZE_MAX
+#define SEARCH_SHORT_NEEDLE 32
+
+static size_t searchFilterScalar(const unsigned char *h, size_t hlen, const unsigned char *n, size_t m) {
+    const unsigned char *at = h;
+    const unsigned char *stop = h + hlen - m + 1;
+    while(at < stop) {
+        at = memchr(at, n[0], stop - at);
+        if(at == NULL) {
+            return SEARCH_NOT_FOUND;
+        }
+        if(at[m - 1] == n[m - 1] && memcmp(at + 1, n + 1, m - 2) == 0) {
+            return at - h;
+        }
+        at++;
+    }
+    return SEARCH_NOT_FOUND;
+}
+
+static size_t searchFilterScalarReverse(const unsigned char *h, size_t hlen, const unsigned char *n, size_t m) {
+    for(size_t i = hlen - m + 1; i > 0; i--) {
+        const unsigned char *at = h + i - 1;
+        if(at[0] == n[0] && at[m - 1] == n[m - 1] && memcmp(at + 1, n + 1, m - 2) == 0) {
+            return i - 1;
+        }
+    }
+    return SEARCH_NOT_FOUND;
+}
+
+#ifdef CHAD_X86_SIMD
+
+// candidates are the set bits of mask, block_start + bit is a haystack position
+#define SEARCH_VERIFY_FORWARD(mask, block_start)                                \
+    while(mask) {                                                               \
+        size_t candidate = (block_start) + __builtin_ctz(mask);                 \
+        if(memcmp(h + candidate + 1, n + 1, m - 2) == 0) {                      \
+            return candidate;                                                   \
+        }                                                                       \
+        mask &= mask - 1;                                                       \
+    }
+
+#define SEARCH_VERIFY_REVERSE(mask, block_start)                                \
+    while(mask) {                                                               \
+        unsigned bit = 31 - __builtin_clz(mask);                                \
+        size_t candidate = (block_start) + bit;                                 \
+        if(memcmp(h + candidate + 1, n + 1, m - 2) == 0) {                      \
+            return candidate;                                                   \
+        }                                                                       \
+        mask &= ~(1u << bit);                                                   \
+    }
+
+static size_t searchFilterSse2(const unsigned char *h, size_t hlen, const unsigned char *n, size_t m) {
+    const __m128i first = _mm_set1_epi8((char)n[0]);
+    const __m128i last = _mm_set1_epi8((char)n[m - 1]);
+    size_t positions = hlen - m + 1;
+    size_t i = 0;
+    for(; i + 16 <= positions; i += 16) {
+        __m128i block_first = _mm_loadu_si128((const __m128i *)(h + i));
+        __m128i block_last = _mm_loadu_si128((const __m128i *)(h + i + m - 1));
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+        SEARCH_VERIFY_FORWARD(mask, i);
+    }
+    size_t rest = searchFilterScalar(h + i, hlen - i, n, m);
+    return rest == SEARCH_NOT_FOUND ? rest : i + rest;
+}
+
+static size_t searchFilterSse2Reverse(const unsigned char *h, size_t hlen, const unsigned char *n, size_t m) {
+    const __m128i first = _mm_set1_epi8((char)n[0]);
+    const __m128i last = _mm_set1_epi8((char)n[m - 1]);
+    size_t end = hlen - m + 1;
+    for(; end >= 16; end -= 16) {
+        size_t i = end - 16;
+        __m128i block_first = _mm_loadu_si128((const __m128i *)(h + i));
+        __m128i block_last = _mm_loadu_si128((const __m128i *)(h + i + m - 1));
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+        SEARCH_VERIFY_REVERSE(mask, i);
+    }
+    return end ? searchFilterScalarReverse(h, end + m - 1, n, m) : SEARCH_NOT_FOUND;
+}
+
+__attribute__((target("avx2")))
+static size_t searchFilterAvx2(const unsigned char *h, size_t hlen, const unsigned char *n, size_t m) {
+    const __m256i first = _mm256_set1_epi8((char)n[0]);
+    const __m256i last = _mm256_set1_epi8((char)n[m - 1]);
+    size_t positions = hlen - m + 1;
+    size_t i = 0;
+    for(; i + 32 <= positions; i += 32) {
+        __m256i block_first = _mm256_loadu_si256((const __m256i *)(h + i));
+        __m256i block_last = _mm256_loadu_si256((const __m256i *)(h + i + m - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last)));
+        SEARCH_VERIFY_FORWARD(mask, i);
+    }
+    size_t rest = searchFilterSse2(h + i, hlen - i, n, m);
+    return rest == SEARCH_NOT_FOUND ? rest : i + rest;
+}
+
+__attribute__((target("avx2")))
+static size_t searchFilterAvx2Reverse(const unsigned char *h, size_t hlen, const unsigned char *n, size_t m) {
+    const __m256i first = _mm256_set1_epi8((char)n[0]);
+    const __m256i last = _mm256_set1_epi8((char)n[m - 1]);
+    size_t end = hlen - m + 1;
+    for(; end >= 32; end -= 32) {
+        size_t i = end - 32;
+        __m256i block_first = _mm256_loadu_si256((const __m256i *)(h + i));
+        __m256i block_last = _mm256_loadu_si256((const __m256i *)(h + i + m - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last)));
+        SEARCH_VERIFY_REVERSE(mask, i);
+    }
+    return end ? searchFilterSse2Reverse(h, end + m - 1, n, m) : SEARCH_NOT_FOUND;
+}
+
+#undef SEARCH_VERIFY_FORWARD
+#undef SEARCH_VERIFY_REVERSE
+
+#endif // CHAD_X86_SIMD
+
+// two-way string matching (Crochemore-Perrin), written once over index accessors so that the
+// reverse variant is the same algorithm run over the mirrored haystack and needle
+#define SEARCH_BITOP(set, byte, op) \
+    ((set)[(size_t)(byte) / (8 * sizeof *(set))] op (size_t)1 << ((size_t)(byte) % (8 * sizeof *(set))))
+
+#define SEARCH_DEFINE_TWOWAY(name, H, N)                                                    \
+static size_t name(const unsigned char *h, size_t hlen, const unsigned char *n, size_t l) {  \
+    size_t i, ip, jp, k, p, ms, p0, mem, mem0, pos = 0;                                     \
+    size_t byteset[32 / sizeof(size_t)] = { 0 };                                            \
+    size_t shift[256];                                                                      \
+    for(i = 0; i < l; i++) {                                                                \
+        SEARCH_BITOP(byteset, N(i), |=);                                                    \
+        shift[N(i)] = i + 1;                                                                \
+    }                                                                                       \
+    /* maximal suffix */                                                                    \
+    ip = -1; jp = 0; k = p = 1;                                                             \
+    while(jp + k < l) {                                                                     \
+        if(N(ip + k) == N(jp + k)) {                                                        \
+            if(k == p) { jp += p; k = 1; } else k++;                                        \
+        } else if(N(ip + k) > N(jp + k)) {                                                  \
+            jp += k; k = 1; p = jp - ip;                                                    \
+        } else {                                                                            \
+            ip = jp++; k = p = 1;                                                           \
+        }                                                                                   \
+    }                                                                                       \
+    ms = ip;                                                                                \
+    p0 = p;                                                                                 \
+    /* and with the opposite comparison */                                                  \
+    ip = -1; jp = 0; k = p = 1;                                                             \
+    while(jp + k < l) {                                                                     \
+        if(N(ip + k) == N(jp + k)) {                                                        \
+            if(k == p) { jp += p; k = 1; } else k++;                                        \
+        } else if(N(ip + k) < N(jp + k)) {                                                  \
+            jp += k; k = 1; p = jp - ip;                                                    \
+        } else {                                                                            \
+            ip = jp++; k = p = 1;                                                           \
+        }                                                                                   \
+    }                                                                                       \
+    if(ip + 1 > ms + 1) ms = ip;                                                            \
+    else p = p0;                                                                            \
+    /* periodic needle? */                                                                  \
+    bool periodic = true;                                                                   \
+    for(i = 0; i <= ms; i++) {                                                              \
+        if(N(i) != N(i + p)) { periodic = false; break; }                                   \
+    }                                                                                       \
+    if(!periodic) {                                                                         \
+        mem0 = 0;                                                                           \
+        p = (ms > l - ms - 1 ? ms : l - ms - 1) + 1;                                        \
+    } else {                                                                                \
+        mem0 = l - p;                                                                       \
+    }                                                                                       \
+    mem = 0;                                                                                \
+    for(;;) {                                                                               \
+        if(hlen - pos < l) return SEARCH_NOT_FOUND;                                         \
+        unsigned char tail = H(pos + l - 1);                                                \
+        if(SEARCH_BITOP(byteset, tail, &)) {                                                \
+            k = l - shift[tail];                                                            \
+            if(k) {                                                                         \
+                if(k < mem) k = mem;                                                        \
+                pos += k;                                                                   \
+                mem = 0;                                                                    \
+                continue;                                                                   \
+            }                                                                               \
+        } else {                                                                            \
+            pos += l;                                                                       \
+            mem = 0;                                                                        \
+            continue;                                                                       \
+        }                                                                                   \
+        /* right half */                                                                    \
+        for(k = (ms + 1 > mem ? ms + 1 : mem); k < l && N(k) == H(pos + k); k++);           \
+        if(k < l) {                                                                         \
+            pos += k - ms;                                                                  \
+            mem = 0;                                                                        \
+            continue;                                                                       \
+        }                                                                                   \
+        /* left half */                                                                     \
+        for(k = ms + 1; k > mem && N(k - 1) == H(pos + k - 1); k--);                        \
+        if(k <= mem) return pos;                                                            \
+        pos += p;                                                                           \
+        mem = mem0;                                                                         \
+    }                                                                                       \
+}
+
+#define SEARCH_FORWARD_H(i) h[(i)]
+#define SEARCH_FORWARD_N(i) n[(i)]
+#define SEARCH_REVERSE_H(i) h[hlen - 1 - (i)]
+#define SEARCH_REVERSE_N(i) n[l - 1 - (i)]
+
+SEARCH_DEFINE_TWOWAY(searchTwoWay, SEARCH_FORWARD_H, SEARCH_FORWARD_N)
+SEARCH_DEFINE_TWOWAY(searchTwoWayReverseMirrored, SEARCH_REVERSE_H, SEARCH_REVERSE_N)
+
+#undef SEARCH_DEFINE_TWOWAY
+#undef SEARCH_FORWARD_H
+#undef SEARCH_FORWARD_N
+#undef SEARCH_REVERSE_H
+#undef SEARCH_REVERSE_N
+#undef SEARCH_BITOP
+
+// offset of the first occurrence of n in h, SEARCH_NOT_FOUND if there is none
+static size_t searchForward(const char *hay, size_t hlen, const char *needle, size_t m) {
+    const unsigned char *h = (const unsigned char *)hay;
+    const unsigned char *n = (const unsigned char *)needle;
+    if(m == 0) return 0;
+    if(m > hlen) return SEARCH_NOT_FOUND;
+    if(m == 1) {
+        const unsigned char *at = memchr(h, n[0], hlen);
+        return at ? (size_t)(at - h) : SEARCH_NOT_FOUND;
+    }
+    if(m > SEARCH_SHORT_NEEDLE) {
+        return searchTwoWay(h, hlen, n, m);
+    }
+    #ifdef CHAD_X86_SIMD
+    if(__builtin_cpu_supports("avx2")) {
+        return searchFilterAvx2(h, hlen, n, m);
+    }
+    return searchFilterSse2(h, hlen, n, m);
+    #else
+    return searchFilterScalar(h, hlen, n, m);
+    #endif
+}
+
+// offset of the last occurrence of n in h, SEARCH_NOT_FOUND if there is none
+static size_t searchReverse(const char *hay, size_t hlen, const char *needle, size_t m) {
+    const unsigned char *h = (const unsigned char *)hay;
+    const unsigned char *n = (const unsigned char *)needle;
+    if(m == 0) return hlen;
+    if(m > hlen) return SEARCH_NOT_FOUND;
+    if(m == 1) {
+        for(size_t i = hlen; i > 0; i--) {
+            if(h[i - 1] == n[0]) return i - 1;
+        }
+        return SEARCH_NOT_FOUND;
+    }
+    if(m > SEARCH_SHORT_NEEDLE) {
+        size_t mirrored = searchTwoWayReverseMirrored(h, hlen, n, m);
+        return mirrored == SEARCH_NOT_FOUND ? mirrored : hlen - mirrored - m;
+    }
+    #ifdef CHAD_X86_SIMD
+    if(__builtin_cpu_supports("avx2")) {
+        return searchFilterAvx2Reverse(h, hlen, n, m);
+    }
+    return searchFilterSse2Reverse(h, hlen, n, m);
+    #else
+    return searchFilterScalarReverse(h, hlen, n, m);
+    #endif
+}
+
+int stringFind(string haystack, string needle) {
+    return stringFindFrom(haystack, needle, 0);
+}
+
+int stringFindFrom(string haystack, string needle, size_t start) {
+    return strviewFindFrom(strviewFromString(haystack), strviewFromString(needle), start);
+}
+
+int stringFindLast(string haystack, string needle) {
+    return strviewFindLast(strviewFromString(haystack), strviewFromString(needle));
+}
+
+size_t stringCount(string haystack, string needle) {
+    size_t count = 0;
+    size_t needle_len = stringlen(needle);
+    if(needle_len == 0) return 0;
+    
+    int pos = 0;
+    while((pos = stringFindFrom(haystack, needle, pos)) != -1) {
+        count++;
+        pos += needle_len;
+    }
+    return count;
+}
+
+
+string stringConcat(string a, string b) {
+    stringHeader_t *a_header = containerof(a.data, stringHeader_t, data);
+    stringHeader_t *b_header = containerof(b.data, stringHeader_t, data);
+    stringHeader_t *result = allocStringHeader(a_header->length + b_header->length);
+    result->length = a_header->length + b_header->length;
+    my_strncpy(result->data, a_header->data, a_header->length);
+    my_strncpy(result->data + a_header->length, b_header->data, b_header->length);
+    result->data[result->length] = '\0';
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+string stringSliceFromString(string input, size_t start, size_t end) {
+    bool needs_reversing = false;
+    if(input.data == NULL) {
+        return (string) { .data = NULL };
+    }
+    if(end > stringlen(input)) {
+        if(start > stringlen(input)) {
+            return (string) { .data = NULL };
+        }
+        end = stringlen(input);
+    } else if(start > end) {
+        needs_reversing = true;
+        size_t temp = start;
+        start = end;
+        end = temp;
+    }
+    if(start > stringlen(input)) {
+        if(!needs_reversing)   {
+            return (string) { .data = NULL };
+        } else {
+            start = stringlen(input);
+        }
+    }
+    size_t to_allocate = end - start;
+    stringHeader_t *buf = allocStringHeader(to_allocate);
+    buf->length = to_allocate;
+    for(size_t index = 0; index < to_allocate; index++) {
+        buf->data[index] = input.at[start + index];
+    }
+    buf->data[to_allocate] = '\0';
+    string ret = (string) { .data = (dataSegmentOfString_t *)buf->data };
+    if(needs_reversing) {
+        ret = stringReverse(ret);
+    }
+    return ret;
+}
+
+string stringSliceFromCharPtr(const char *input, size_t start, size_t end) {
+    size_t len = my_strlen(input);
     bool needs_reversing = false;
     if(input == NULL) {
         return (string) { .data = NULL };
@@ -332,12 +1392,7 @@ string stringSliceFromCharPtr(const char *input, size_t start, size_t end) {
         }
     }
     size_t to_allocate = end - start;
-    stringHeader_t *buf = malloc(sizeof(stringHeader_t) + to_allocate + 1);
-    if(!buf) {
-        fprintf(stderr, "failed to allocate memory in stringSliceFromCharPtr\n");
-        exit(EXIT_FAILURE);
-    }
-    buf->allocated_bytes = sizeof(stringHeader_t) + to_allocate + 1;
+    stringHeader_t *buf = allocStringHeader(to_allocate);
     buf->length = to_allocate;
     for(size_t index = 0; index < to_allocate; index++) {
         buf->data[index] = input[start + index];
@@ -345,133 +1400,362 @@ string stringSliceFromCharPtr(const char *input, size_t start, size_t end) {
     buf->data[to_allocate] = '\0';
     string ret = (string) { .data = (dataSegmentOfString_t *)buf->data };
     if(needs_reversing) {
-        stringReverse(ret);
+        ret = stringReverse(ret);
     }
     return ret;
 }
 
 string stringToUpper(string str) {
-    string result = stringFromString(str);
-    for(size_t i = 0; i < stringlen(result); i++) {
-        result.at[i] = toupper((unsigned char)result.at[i]);
-    }
-    return result;
+    size_t len = stringlen(str);
+    stringHeader_t *result = allocStringHeader(len);
+    asciiCase(result->data, str.at, len, 'a');
+    result->data[len] = '\0';
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
 }
 
 string stringToLower(string str) {
-    string result = stringFromString(str);
-    for(size_t i = 0; i < stringlen(result); i++) {
-        result.at[i] = tolower((unsigned char)result.at[i]);
-    }
-    return result;
+    size_t len = stringlen(str);
+    stringHeader_t *result = allocStringHeader(len);
+    asciiCase(result->data, str.at, len, 'A');
+    result->data[len] = '\0';
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+string stringToUpperInPlace(string str) {
+    stringHeader_t *header = writableHeader(str);
+    asciiCase(header->data, header->data, header->length, 'a');
+    str = (string) { .data = (dataSegmentOfString_t *)header->data };
+    stringInvalidate(str);
+    return str;
+}
+
+string stringToLowerInPlace(string str) {
+    stringHeader_t *header = writableHeader(str);
+    asciiCase(header->data, header->data, header->length, 'A');
+    str = (string) { .data = (dataSegmentOfString_t *)header->data };
+    stringInvalidate(str);
+    return str;
 }
 
 string stringTrim(string str) {
-    size_t len = stringlen(str);
-    if(len == 0) return stringFromString(str);
-    
-    size_t start = 0;
-    while(start < len && isspace((unsigned char)str.at[start])) {
-        start++;
-    }
-    
-    size_t end = len;
-    while(end > start && isspace((unsigned char)str.at[end - 1])) {
-        end--;
-    }
-    
-    return stringSliceFromString(str, start, end);
+    return stringFromStrview(strviewTrim(strviewFromString(str)));
 }
 
 string stringTrimLeft(string str) {
-    size_t len = stringlen(str);
-    size_t start = 0;
-    while(start < len && isspace((unsigned char)str.at[start])) {
-        start++;
-    }
-    return stringSliceFromString(str, start, len);
+    return stringFromStrview(strviewTrimLeft(strviewFromString(str)));
 }
 
 string stringTrimRight(string str) {
-    size_t len = stringlen(str);
-    size_t end = len;
-    while(end > 0 && isspace((unsigned char)str.at[end - 1])) {
-        end--;
-    }
-    return stringSliceFromString(str, 0, end);
+    return stringFromStrview(strviewTrimRight(strviewFromString(str)));
 }
 
 string stringReplace(string str, string find, string replace) {
     return stringReplaceN(str, find, replace, (size_t)-1);
 }
 
-string stringReplaceN(string str, string find, string replace, size_t max) {
-    if(stringlen(find) == 0) return stringFromString(str);
-    
-    size_t count = stringCount(str, find);
-    if(count == 0 || max == 0) return stringFromString(str);
-    if(count > max) count = max;
-    
-    size_t find_len = stringlen(find);
-    size_t replace_len = stringlen(replace);
-    size_t new_len = stringlen(str) + count * (replace_len - find_len);
-    
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + new_len + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringReplaceN\n");
-        exit(EXIT_FAILURE);
-    }
-    result->allocated_bytes = sizeof(stringHeader_t) + new_len + 1;
-    result->length = new_len;
-    
-    size_t src_pos = 0;
-    size_t dst_pos = 0;
-    size_t replacements = 0;
-    
-    while(src_pos < stringlen(str) && replacements < max) {
-        if(stringeqlidx(str, src_pos, find)) {
-            memcpy(result->data + dst_pos, replace.at, replace_len);
-            dst_pos += replace_len;
-            src_pos += find_len;
-            replacements++;
-        } else {
-            result->data[dst_pos++] = str.at[src_pos++];
+// replacement matches are collected first, the result is then sized exactly and assembled from
+// memcpy'd runs. the first few live on the stack, enough for most calls
+typedef struct {
+    size_t at;
+    size_t find_len;
+    const char *with;
+    size_t with_len;
+} replaceMatch_t;
+
+typedef struct {
+    replaceMatch_t *items;
+    size_t count;
+    size_t capacity;
+    replaceMatch_t local[32];
+} replaceMatches_t;
+
+static void replaceMatchesInit(replaceMatches_t *matches) {
+    matches->items = matches->local;
+    matches->count = 0;
+    matches->capacity = sizeof matches->local / sizeof matches->local[0];
+}
+
+static void replaceMatchesPush(replaceMatches_t *matches, replaceMatch_t match) {
+    if(matches->count == matches->capacity) {
+        size_t new_capacity = matches->capacity * 2;
+        replaceMatch_t *grown = matches->items == matches->local
+            ? malloc(new_capacity * sizeof *grown)
+            : realloc(matches->items, new_capacity * sizeof *grown);
+        if(!grown) {
+            fprintf(stderr, "failed to allocate memory in replaceMatchesPush\n");
+            exit(EXIT_FAILURE);
+        }
+        if(matches->items == matches->local) {
+            memcpy(grown, matches->local, sizeof matches->local);
         }
+        matches->items = grown;
+        matches->capacity = new_capacity;
     }
-    
-    while(src_pos < stringlen(str)) {
-        result->data[dst_pos++] = str.at[src_pos++];
+    matches->items[matches->count++] = match;
+}
+
+static string replaceAssemble(string str, replaceMatches_t *matches) {
+    size_t len = stringlen(str);
+    size_t new_len = len;
+    for(size_t i = 0; i < matches->count; i++) {
+        new_len = new_len - matches->items[i].find_len + matches->items[i].with_len;
+    }
+
+    stringHeader_t *result = allocStringHeader(new_len);
+    char *dst = result->data;
+    size_t src_pos = 0;
+    for(size_t i = 0; i < matches->count; i++) {
+        replaceMatch_t *match = &matches->items[i];
+        memcpy(dst, str.at + src_pos, match->at - src_pos);
+        dst += match->at - src_pos;
+        memcpy(dst, match->with, match->with_len);
+        dst += match->with_len;
+        src_pos = match->at + match->find_len;
+    }
+    memcpy(dst, str.at + src_pos, len - src_pos);
+    result->data[new_len] = '\0';
+
+    if(matches->items != matches->local) {
+        free(matches->items);
     }
-    
-    result->data[dst_pos] = '\0';
     return (string) { .data = (dataSegmentOfString_t *)result->data };
 }
 
-// utf-8 support
+string stringReplaceN(string str, string find, string replace, size_t max) {
+    size_t find_len = stringlen(find);
+    size_t len = stringlen(str);
+    if(find_len == 0 || max == 0) return stringFromString(str);
 
-bool stringBinaryPrefix(unsigned char to_check, unsigned char prefix, size_t depth) {
-    byte ones = 0b11111111;
-    byte mask = ones << (8 - depth);
-    byte result = to_check & mask;
-    bool matches = result == prefix;
-    #ifdef DEBUG
-    printf("to_check: %08b\nprefix:   %08b\nmask:     %08b\nresult:   %08b\nmatches:  %s\n", 
-        to_check, prefix, mask, result, matches ? "true" : "false");
-    #endif
-    return matches;
+    replaceMatches_t matches;
+    replaceMatchesInit(&matches);
+    size_t pos = 0;
+    while(matches.count < max && pos + find_len <= len) {
+        size_t found = searchForward(str.at + pos, len - pos, find.at, find_len);
+        if(found == SEARCH_NOT_FOUND) break;
+        replaceMatchesPush(&matches, (replaceMatch_t) {
+            .at = pos + found, .find_len = find_len, .with = replace.at, .with_len = stringlen(replace),
+        });
+        pos += found + find_len;
+    }
+    if(matches.count == 0) return stringFromString(str);
+    return replaceAssemble(str, &matches);
 }
 
-static void reverseUtf8_char(char *to_reverse) {
-    size_t index = 0;
-    while (to_reverse[index] != '\0') {
-        if (stringBinaryPrefix(to_reverse[index], 0b00000000, 1)) {
-            index++;
-            continue;
+// multi-pattern replacement
+//
+// an aho-corasick automaton over all find strings, stored as a dense transition table. bytes
+// that occur in no pattern share class 0, so the table is states * (distinct pattern bytes + 1)
+
+struct stringReplacer {
+    size_t pattern_count;
+    size_t *find_lengths;
+    const char **replacements;
+    size_t *replacement_lengths;
+    char *replacement_bytes;
+    uint8_t byte_class[256];
+    size_t class_count;
+    size_t state_count;
+    uint32_t *next;        // state_count * class_count transitions
+    uint32_t *longest;     // longest pattern ending in each state, UINT32_MAX for none
+    uint32_t *depth;       // length of the prefix each state stands for
+};
+
+static void *replacerAlloc(size_t bytes) {
+    void *memory = malloc(bytes ? bytes : 1);
+    if(!memory) {
+        fprintf(stderr, "failed to allocate memory in stringReplacerCreate\n");
+        exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+stringReplacer_t *stringReplacerCreate(const string finds[], const string replaces[], size_t count) {
+    stringReplacer_t *replacer = replacerAlloc(sizeof *replacer);
+    replacer->pattern_count = count;
+    replacer->find_lengths = replacerAlloc(count * sizeof(size_t));
+    replacer->replacements = replacerAlloc(count * sizeof(char *));
+    replacer->replacement_lengths = replacerAlloc(count * sizeof(size_t));
+
+    // own copies of the replacements, so the caller may destroy theirs
+    size_t replacement_total = 0;
+    size_t max_states = 1;
+    memset(replacer->byte_class, 0, sizeof replacer->byte_class);
+    replacer->class_count = 1;
+    for(size_t i = 0; i < count; i++) {
+        replacer->find_lengths[i] = stringlen(finds[i]);
+        replacer->replacement_lengths[i] = stringlen(replaces[i]);
+        replacement_total += stringlen(replaces[i]);
+        max_states += stringlen(finds[i]);
+        for(size_t j = 0; j < stringlen(finds[i]); j++) {
+            unsigned char c = finds[i].at[j];
+            if(replacer->byte_class[c] == 0) {
+                replacer->byte_class[c] = replacer->class_count++;
+            }
         }
-        if (stringBinaryPrefix(to_reverse[index], 0b11000000, 3) && to_reverse[index + 1] != '\0') {
-            char temp = to_reverse[index];
-            to_reverse[index] = to_reverse[index + 1];
-            to_reverse[index + 1] = temp;
+    }
+    replacer->replacement_bytes = replacerAlloc(replacement_total);
+    char *copy_to = replacer->replacement_bytes;
+    for(size_t i = 0; i < count; i++) {
+        memcpy(copy_to, replaces[i].at, replacer->replacement_lengths[i]);
+        replacer->replacements[i] = copy_to;
+        copy_to += replacer->replacement_lengths[i];
+    }
+
+    size_t classes = replacer->class_count;
+    uint32_t *next = replacerAlloc(max_states * classes * sizeof(uint32_t));
+    uint32_t *longest = replacerAlloc(max_states * sizeof(uint32_t));
+    uint32_t *depth = replacerAlloc(max_states * sizeof(uint32_t));
+    uint32_t *fail = replacerAlloc(max_states * sizeof(uint32_t));
+    memset(next, 0, max_states * classes * sizeof(uint32_t));
+
+    // trie, 0 doubles as "no edge" since nothing points back at the root
+    size_t states = 1;
+    longest[0] = UINT32_MAX;
+    depth[0] = 0;
+    for(size_t i = 0; i < count; i++) {
+        size_t find_len = replacer->find_lengths[i];
+        if(find_len == 0) continue;
+        uint32_t state = 0;
+        for(size_t j = 0; j < find_len; j++) {
+            uint32_t *edge = &next[state * classes + replacer->byte_class[(unsigned char)finds[i].at[j]]];
+            if(*edge == 0) {
+                *edge = states;
+                longest[states] = UINT32_MAX;
+                depth[states] = depth[state] + 1;
+                states++;
+            }
+            state = *edge;
+        }
+        if(longest[state] == UINT32_MAX) {
+            longest[state] = i; // the first of several identical patterns wins
+        }
+    }
+
+    // breadth first over the trie to fill in failure links and complete the transitions
+    uint32_t *queue = replacerAlloc(states * sizeof(uint32_t));
+    size_t head = 0, tail = 0;
+    for(size_t c = 0; c < classes; c++) {
+        uint32_t child = next[c];
+        if(child != 0) {
+            fail[child] = 0;
+            queue[tail++] = child;
+        }
+    }
+    while(head < tail) {
+        uint32_t state = queue[head++];
+        if(longest[state] == UINT32_MAX) {
+            longest[state] = longest[fail[state]];
+        }
+        for(size_t c = 0; c < classes; c++) {
+            uint32_t *edge = &next[state * classes + c];
+            uint32_t fallback = next[fail[state] * classes + c];
+            if(*edge != 0) {
+                fail[*edge] = fallback;
+                queue[tail++] = *edge;
+            } else {
+                *edge = fallback;
+            }
+        }
+    }
+    free(queue);
+    free(fail);
+
+    replacer->state_count = states;
+    replacer->next = next;
+    replacer->longest = longest;
+    replacer->depth = depth;
+    return replacer;
+}
+
+void stringReplacerDestroy(stringReplacer_t *replacer) {
+    if(replacer == NULL) return;
+    free(replacer->find_lengths);
+    free(replacer->replacements);
+    free(replacer->replacement_lengths);
+    free(replacer->replacement_bytes);
+    free(replacer->next);
+    free(replacer->longest);
+    free(replacer->depth);
+    free(replacer);
+}
+
+// leftmost match wins, among matches starting at the same offset the longest one
+string stringReplacerApply(const stringReplacer_t *replacer, string str) {
+    const unsigned char *text = (const unsigned char *)str.at;
+    size_t len = stringlen(str);
+    size_t classes = replacer->class_count;
+
+    replaceMatches_t matches;
+    replaceMatchesInit(&matches);
+    uint32_t state = 0;
+    size_t best_start = SIZE_MAX;
+    uint32_t best_pattern = UINT32_MAX;
+    size_t i = 0;
+    for(;;) {
+        // no later match can start at or before the pending one once the automaton's prefix
+        // no longer reaches back to it, so the pending match is final
+        if(best_pattern != UINT32_MAX && (i == len || i - replacer->depth[state] > best_start)) {
+            size_t find_len = replacer->find_lengths[best_pattern];
+            replaceMatchesPush(&matches, (replaceMatch_t) {
+                .at = best_start, .find_len = find_len,
+                .with = replacer->replacements[best_pattern],
+                .with_len = replacer->replacement_lengths[best_pattern],
+            });
+            i = best_start + find_len;
+            state = 0;
+            best_pattern = UINT32_MAX;
+            best_start = SIZE_MAX;
+        }
+        if(i == len) break;
+
+        state = replacer->next[state * classes + replacer->byte_class[text[i]]];
+        i++;
+        uint32_t pattern = replacer->longest[state];
+        if(pattern != UINT32_MAX) {
+            size_t start = i - replacer->find_lengths[pattern];
+            if(start < best_start || (start == best_start
+                && replacer->find_lengths[pattern] > replacer->find_lengths[best_pattern])) {
+                best_start = start;
+                best_pattern = pattern;
+            }
+        }
+    }
+    if(matches.count == 0) return stringFromString(str);
+    return replaceAssemble(str, &matches);
+}
+
+string stringReplaceMany(string str, const string finds[], const string replaces[], size_t count) {
+    stringReplacer_t *replacer = stringReplacerCreate(finds, replaces, count);
+    string result = stringReplacerApply(replacer, str);
+    stringReplacerDestroy(replacer);
+    return result;
+}
+
+// utf-8 support
+
+bool stringBinaryPrefix(unsigned char to_check, unsigned char prefix, size_t depth) {
+    byte ones = 0b11111111;
+    byte mask = ones << (8 - depth);
+    byte result = to_check & mask;
+    bool matches = result == prefix;
+    #ifdef DEBUG
+    printf("to_check: %08b\nprefix:   %08b\nmask:     %08b\nresult:   %08b\nmatches:  %s\n", 
+        to_check, prefix, mask, result, matches ? "true" : "false");
+    #endif
+    return matches;
+}
+
+static void reverseUtf8_char(char *to_reverse) {
+    size_t index = 0;
+    while (to_reverse[index] != '\0') {
+        if (stringBinaryPrefix(to_reverse[index], 0b00000000, 1)) {
+            index++;
+            continue;
+        }
+        if (stringBinaryPrefix(to_reverse[index], 0b11000000, 3) && to_reverse[index + 1] != '\0') {
+            char temp = to_reverse[index];
+            to_reverse[index] = to_reverse[index + 1];
+            to_reverse[index + 1] = temp;
             index += 2;
             continue;
         }
@@ -497,6 +1781,8 @@ static void reverseUtf8_char(char *to_reverse) {
 }
 
 string stringReverse(string input) {
+    input = (string) { .data = (dataSegmentOfString_t *)writableHeader(input)->data };
+    stringInvalidate(input);
     reverseUtf8_char(input.at);
     unsigned char temp;
     for(size_t i = 0, evil_i = stringlen(input); i < stringlen(input) / 2; i++, evil_i--) {
@@ -507,106 +1793,320 @@ string stringReverse(string input) {
     return input;
 }
 
-size_t stringUtf8Length(string str) {
-    size_t count = 0;
-    for(size_t i = 0; i < stringlen(str); ) {
-        unsigned char c = str.at[i];
-        if((c & 0x80) == 0) {
-            i += 1;
-        } else if((c & 0xE0) == 0xC0) {
-            i += 2;
-        } else if((c & 0xF0) == 0xE0) {
-            i += 3;
-        } else if((c & 0xF8) == 0xF0) {
-            i += 4;
-        } else {
-            i += 1;
-        }
-        count++;
-    }
-    return count;
-}
+// utf-8 validation and counting
+//
+// the validator follows the lookup approach of Keiser and Lemire: three 16 entry tables indexed
+// by the high and low nibble of the previous byte and the high nibble of the current byte each
+// yield a set of error classes, a byte pair is invalid when all three agree on one. what a pair
+// cannot see (third and fourth bytes of a sequence) is checked separately against the bytes two
+// and three positions back. blocks of pure ascii skip all of that
 
-bool stringUtf8Validate(string str) {
-    size_t len = stringlen(str);
-    for(size_t i = 0; i < len; ) {
-        unsigned char c = str.at[i];
-        
-        if((c & 0x80) == 0) {
-            i += 1;
-        } else if((c & 0xE0) == 0xC0) {
-            if(i + 1 >= len || (str.at[i + 1] & 0xC0) != 0x80) return false;
-            i += 2;
-        } else if((c & 0xF0) == 0xE0) {
-            if(i + 2 >= len || (str.at[i + 1] & 0xC0) != 0x80 || (str.at[i + 2] & 0xC0) != 0x80) return false;
-            i += 3;
-        } else if((c & 0xF8) == 0xF0) {
-            if(i + 3 >= len || (str.at[i + 1] & 0xC0) != 0x80 || 
-               (str.at[i + 2] & 0xC0) != 0x80 || (str.at[i + 3] & 0xC0) != 0x80) return false;
-            i += 4;
+#define UTF8_TOO_SHORT  (1 << 0) // lead byte followed by ascii or another lead byte
+#define UTF8_TOO_LONG   (1 << 1) // ascii followed by a continuation
+#define UTF8_OVERLONG_3 (1 << 2) // e0 followed by 80..9f
+#define UTF8_TOO_LARGE  (1 << 3) // f4 followed by 90..bf, or f5 and above
+#define UTF8_SURROGATE  (1 << 4) // ed followed by a0..bf
+#define UTF8_OVERLONG_2 (1 << 5) // c0 or c1
+#define UTF8_TOO_LARGE_1000 (1 << 6) // f5 and above followed by 80..8f
+#define UTF8_OVERLONG_4 (1 << 6) // f0 followed by 80..8f
+#define UTF8_TWO_CONTS  (1 << 7) // a continuation after a continuation, unless a lead requires it
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+static const int8_t utf8_byte_1_high[16] = {
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+    UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+};
+
+static const int8_t utf8_byte_1_low[16] = {
+    UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+    UTF8_CARRY | UTF8_OVERLONG_2,
+    UTF8_CARRY,
+    UTF8_CARRY,
+    UTF8_CARRY | UTF8_TOO_LARGE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+};
+
+static const int8_t utf8_byte_2_high[16] = {
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    (int8_t)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4),
+    (int8_t)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE),
+    (int8_t)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+    (int8_t)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+};
+
+// byte by byte, ranges as in table 3-7 of the unicode standard
+static bool utf8ValidateScalar(const unsigned char *at, size_t len) {
+    size_t i = 0;
+    while(i < len) {
+        if(i + 8 <= len) {
+            uint64_t word;
+            memcpy(&word, at + i, sizeof word);
+            if((word & 0x8080808080808080ull) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+        unsigned char c = at[i];
+        if(c < 0x80) {
+            i++;
+            continue;
+        }
+        size_t need;
+        unsigned char low = 0x80, high = 0xBF; // allowed range of the second byte
+        if(c >= 0xC2 && c <= 0xDF) {
+            need = 1;
+        } else if(c >= 0xE0 && c <= 0xEF) {
+            need = 2;
+            if(c == 0xE0) low = 0xA0;
+            if(c == 0xED) high = 0x9F;
+        } else if(c >= 0xF0 && c <= 0xF4) {
+            need = 3;
+            if(c == 0xF0) low = 0x90;
+            if(c == 0xF4) high = 0x8F;
         } else {
             return false;
         }
+        if(len - i <= need || at[i + 1] < low || at[i + 1] > high) return false;
+        for(size_t k = 2; k <= need; k++) {
+            if((at[i + k] & 0xC0) != 0x80) return false;
+        }
+        i += need + 1;
     }
     return true;
 }
 
-utf32_t stringUtf8DecodeAt(string str, size_t byte_index, size_t *bytes_read) {
-    if(byte_index >= stringlen(str)) {
-        if(bytes_read) *bytes_read = 0;
-        return 0;
+// code points are all bytes that are not continuation bytes, eight at a time
+static size_t utf8CountScalar(const unsigned char *at, size_t len) {
+    size_t continuations = 0;
+    size_t i = 0;
+    for(; i + 8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, at + i, sizeof word);
+        continuations += __builtin_popcountll((word >> 7) & ~(word >> 6) & 0x0101010101010101ull);
     }
-    
-    unsigned char c = str.at[byte_index];
-    
-    if((c & 0x80) == 0) {
-        if(bytes_read) *bytes_read = 1;
-        return c;
-    } else if((c & 0xE0) == 0xC0) {
-        if(byte_index + 1 >= stringlen(str)) {
-            if(bytes_read) *bytes_read = 0;
-            return 0;
+    for(; i < len; i++) {
+        continuations += (at[i] & 0xC0) == 0x80;
+    }
+    return len - continuations;
+}
+
+#ifdef CHAD_X86_SIMD
+
+__attribute__((target("ssse3")))
+static __m128i utf8CheckBlockSsse3(__m128i input, __m128i prev) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+    __m128i byte_1_high = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)utf8_byte_1_high),
+        _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+    __m128i byte_1_low = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)utf8_byte_1_low),
+        _mm_and_si128(prev1, nibble));
+    __m128i byte_2_high = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)utf8_byte_2_high),
+        _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+    __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+    __m128i prev2 = _mm_alignr_epi8(input, prev, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, prev, 13);
+    __m128i is_third = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80)));
+    __m128i is_fourth = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80)));
+    __m128i must_continue = _mm_and_si128(_mm_or_si128(is_third, is_fourth), _mm_set1_epi8((char)0x80));
+    return _mm_xor_si128(must_continue, special);
+}
+
+__attribute__((target("ssse3")))
+static bool utf8ValidateSsse3(const unsigned char *at, size_t len) {
+    __m128i prev = _mm_setzero_si128();
+    __m128i error = _mm_setzero_si128();
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        __m128i input = _mm_loadu_si128((const __m128i *)(at + i));
+        if(_mm_movemask_epi8(_mm_or_si128(input, prev)) != 0) {
+            error = _mm_or_si128(error, utf8CheckBlockSsse3(input, prev));
         }
-        if(bytes_read) *bytes_read = 2;
-        return ((c & 0x1F) << 6) | (str.at[byte_index + 1] & 0x3F);
-    } else if((c & 0xF0) == 0xE0) {
-        if(byte_index + 2 >= stringlen(str)) {
-            if(bytes_read) *bytes_read = 0;
-            return 0;
+        prev = input;
+    }
+    // the tail is padded with ascii, which also exposes a sequence cut off at the end
+    unsigned char tail[16] = { 0 };
+    memcpy(tail, at + i, len - i);
+    error = _mm_or_si128(error, utf8CheckBlockSsse3(_mm_loadu_si128((const __m128i *)tail), prev));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+
+__attribute__((target("avx2")))
+static __m256i utf8CheckBlockAvx2(__m256i input, __m256i prev) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i shifted_in = _mm256_permute2x128_si256(prev, input, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(input, shifted_in, 15);
+    __m256i byte_1_high = _mm256_shuffle_epi8(
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)utf8_byte_1_high)),
+        _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    __m256i byte_1_low = _mm256_shuffle_epi8(
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)utf8_byte_1_low)),
+        _mm256_and_si256(prev1, nibble));
+    __m256i byte_2_high = _mm256_shuffle_epi8(
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)utf8_byte_2_high)),
+        _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    __m256i prev2 = _mm256_alignr_epi8(input, shifted_in, 14);
+    __m256i prev3 = _mm256_alignr_epi8(input, shifted_in, 13);
+    __m256i is_third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i must_continue = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8((char)0x80));
+    return _mm256_xor_si256(must_continue, special);
+}
+
+__attribute__((target("avx2")))
+static bool utf8ValidateAvx2(const unsigned char *at, size_t len) {
+    __m256i prev = _mm256_setzero_si256();
+    __m256i error = _mm256_setzero_si256();
+    size_t i = 0;
+    for(; i + 32 <= len; i += 32) {
+        __m256i input = _mm256_loadu_si256((const __m256i *)(at + i));
+        if(_mm256_movemask_epi8(_mm256_or_si256(input, prev)) != 0) {
+            error = _mm256_or_si256(error, utf8CheckBlockAvx2(input, prev));
         }
-        if(bytes_read) *bytes_read = 3;
-        return ((c & 0x0F) << 12) | ((str.at[byte_index + 1] & 0x3F) << 6) | (str.at[byte_index + 2] & 0x3F);
-    } else if((c & 0xF8) == 0xF0) {
-        if(byte_index + 3 >= stringlen(str)) {
-            if(bytes_read) *bytes_read = 0;
-            return 0;
+        prev = input;
+    }
+    unsigned char tail[32] = { 0 };
+    memcpy(tail, at + i, len - i);
+    error = _mm256_or_si256(error, utf8CheckBlockAvx2(_mm256_loadu_si256((const __m256i *)tail), prev));
+    return _mm256_testz_si256(error, error);
+}
+
+static size_t utf8CountSse2(const unsigned char *at, size_t len) {
+    const __m128i below_continuation = _mm_set1_epi8(-65); // signed, continuations are -128..-65
+    size_t count = 0;
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(at + i));
+        count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpgt_epi8(block, below_continuation)));
+    }
+    return count + utf8CountScalar(at + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static size_t utf8CountAvx2(const unsigned char *at, size_t len) {
+    const __m256i below_continuation = _mm256_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+    for(; i + 32 <= len; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(at + i));
+        count += __builtin_popcount((unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, below_continuation)));
+    }
+    return count + utf8CountSse2(at + i, len - i);
+}
+
+#endif // CHAD_X86_SIMD
+
+bool strviewUtf8Validate(strview view) {
+    const unsigned char *at = (const unsigned char *)view.at;
+    #ifdef CHAD_X86_SIMD
+    if(__builtin_cpu_supports("avx2")) {
+        return utf8ValidateAvx2(at, view.length);
+    }
+    if(__builtin_cpu_supports("ssse3")) {
+        return utf8ValidateSsse3(at, view.length);
+    }
+    #endif
+    return utf8ValidateScalar(at, view.length);
+}
+
+size_t strviewUtf8Length(strview view) {
+    const unsigned char *at = (const unsigned char *)view.at;
+    #ifdef CHAD_X86_SIMD
+    if(__builtin_cpu_supports("avx2")) {
+        return utf8CountAvx2(at, view.length);
+    }
+    return utf8CountSse2(at, view.length);
+    #else
+    return utf8CountScalar(at, view.length);
+    #endif
+}
+
+size_t stringUtf8Length(string str) {
+    return strviewUtf8Length(strviewFromString(str));
+}
+
+bool stringUtf8Validate(string str) {
+    return strviewUtf8Validate(strviewFromString(str));
+}
+
+utf32_t stringUtf8DecodeAt(string str, size_t byte_index, size_t *bytes_read) {
+    return strviewUtf8DecodeAt(strviewFromString(str), byte_index, bytes_read);
+}
+
+// how far stringUtf8At steps for a lead byte, stray bytes count as one character
+static size_t utf8StepLength(unsigned char c) {
+    if((c & 0x80) == 0) return 1;
+    if((c & 0xE0) == 0xC0) return 2;
+    if((c & 0xF0) == 0xE0) return 3;
+    if((c & 0xF8) == 0xF0) return 4;
+    return 1;
+}
+
+static stringUtf8Index_t *buildUtf8Index(stringHeader_t *header) {
+    size_t len = header->length;
+    // at most one checkpoint per stride bytes, plus the one at offset 0
+    stringUtf8Index_t *index = allocUtf8Index(len / STRING_UTF8_INDEX_STRIDE + 1);
+    size_t char_count = 0;
+    for(size_t byte_pos = 0; byte_pos < len; char_count++) {
+        if(char_count % STRING_UTF8_INDEX_STRIDE == 0) {
+            index->offsets[index->count++] = byte_pos;
         }
-        if(bytes_read) *bytes_read = 4;
-        return ((c & 0x07) << 18) | ((str.at[byte_index + 1] & 0x3F) << 12) | 
-               ((str.at[byte_index + 2] & 0x3F) << 6) | (str.at[byte_index + 3] & 0x3F);
+        byte_pos += utf8StepLength(header->data[byte_pos]);
     }
-    
-    if(bytes_read) *bytes_read = 0;
-    return 0;
+    // release so that a reader acquiring the pointer sees the offsets
+    stringUtf8Index_t *published = NULL;
+    if(!atomic_compare_exchange_strong_explicit(&header->utf8_index, &published, index,
+            memory_order_release, memory_order_acquire)) {
+        free(index);
+        return published;
+    }
+    return index;
 }
 
 string stringUtf8At(string str, size_t char_index) {
     size_t byte_pos = 0;
     size_t char_count = 0;
-    
-    while(byte_pos < stringlen(str) && char_count < char_index) {
-        unsigned char c = str.at[byte_pos];
-        if((c & 0x80) == 0) {
-            byte_pos += 1;
-        } else if((c & 0xE0) == 0xC0) {
-            byte_pos += 2;
-        } else if((c & 0xF0) == 0xE0) {
-            byte_pos += 3;
-        } else if((c & 0xF8) == 0xF0) {
-            byte_pos += 4;
-        } else {
-            byte_pos += 1;
+
+    // short hops are cheaper to walk than to index
+    if(char_index >= STRING_UTF8_INDEX_STRIDE) {
+        stringHeader_t *header = getHeaderPointer(str);
+        stringUtf8Index_t *index = atomic_load_explicit(&header->utf8_index, memory_order_acquire);
+        // interned strings live until stringInternReset, which does not look for indexes
+        if(index == NULL && header->allocator == NULL && !(header->flags & string_interned)) {
+            index = buildUtf8Index(header);
+        }
+        // backend and interned strings are walked from the start
+        if(index != NULL) {
+            size_t checkpoint = char_index / STRING_UTF8_INDEX_STRIDE;
+            if(checkpoint >= index->count) {
+                return (string) { .data = NULL };
+            }
+            byte_pos = index->offsets[checkpoint];
+            char_count = checkpoint * STRING_UTF8_INDEX_STRIDE;
         }
+    }
+
+    while(byte_pos < stringlen(str) && char_count < char_index) {
+        byte_pos += utf8StepLength(str.at[byte_pos]);
         char_count++;
     }
     
@@ -614,18 +2114,7 @@ string stringUtf8At(string str, size_t char_index) {
         return (string) { .data = NULL };
     }
     
-    size_t char_bytes = 1;
-    unsigned char c = str.at[byte_pos];
-    if((c & 0x80) == 0) {
-        char_bytes = 1;
-    } else if((c & 0xE0) == 0xC0) {
-        char_bytes = 2;
-    } else if((c & 0xF0) == 0xE0) {
-        char_bytes = 3;
-    } else if((c & 0xF8) == 0xF0) {
-        char_bytes = 4;
-    }
-    
+    size_t char_bytes = utf8StepLength(str.at[byte_pos]);
     return stringSliceFromString(str, byte_pos, byte_pos + char_bytes);
 }
 
@@ -633,45 +2122,25 @@ string stringUtf8Encode(utf32_t codepoint) {
     stringHeader_t *result;
     
     if(codepoint <= 0x7F) {
-        result = malloc(sizeof(stringHeader_t) + 2);
-        if(!result) {
-            fprintf(stderr, "failed to allocate memory in stringUtf8Encode\n");
-            exit(EXIT_FAILURE);
-        }
-        result->allocated_bytes = sizeof(stringHeader_t) + 2;
+        result = allocStringHeader(1);
         result->length = 1;
         result->data[0] = (char)codepoint;
         result->data[1] = '\0';
     } else if(codepoint <= 0x7FF) {
-        result = malloc(sizeof(stringHeader_t) + 3);
-        if(!result) {
-            fprintf(stderr, "failed to allocate memory in stringUtf8Encode\n");
-            exit(EXIT_FAILURE);
-        }
-        result->allocated_bytes = sizeof(stringHeader_t) + 3;
+        result = allocStringHeader(2);
         result->length = 2;
         result->data[0] = 0xC0 | (codepoint >> 6);
         result->data[1] = 0x80 | (codepoint & 0x3F);
         result->data[2] = '\0';
     } else if(codepoint <= 0xFFFF) {
-        result = malloc(sizeof(stringHeader_t) + 4);
-        if(!result) {
-            fprintf(stderr, "failed to allocate memory in stringUtf8Encode\n");
-            exit(EXIT_FAILURE);
-        }
-        result->allocated_bytes = sizeof(stringHeader_t) + 4;
+        result = allocStringHeader(3);
         result->length = 3;
         result->data[0] = 0xE0 | (codepoint >> 12);
         result->data[1] = 0x80 | ((codepoint >> 6) & 0x3F);
         result->data[2] = 0x80 | (codepoint & 0x3F);
         result->data[3] = '\0';
     } else if(codepoint <= 0x10FFFF) {
-        result = malloc(sizeof(stringHeader_t) + 5);
-        if(!result) {
-            fprintf(stderr, "failed to allocate memory in stringUtf8Encode\n");
-            exit(EXIT_FAILURE);
-        }
-        result->allocated_bytes = sizeof(stringHeader_t) + 5;
+        result = allocStringHeader(4);
         result->length = 4;
         result->data[0] = 0xF0 | (codepoint >> 18);
         result->data[1] = 0x80 | ((codepoint >> 12) & 0x3F);
@@ -679,12 +2148,7 @@ string stringUtf8Encode(utf32_t codepoint) {
         result->data[3] = 0x80 | (codepoint & 0x3F);
         result->data[4] = '\0';
     } else {
-        result = malloc(sizeof(stringHeader_t) + 1);
-        if(!result) {
-            fprintf(stderr, "failed to allocate memory in stringUtf8Encode\n");
-            exit(EXIT_FAILURE);
-        }
-        result->allocated_bytes = sizeof(stringHeader_t) + 1;
+        result = allocStringHeader(0);
         result->length = 0;
         result->data[0] = '\0';
     }
@@ -692,130 +2156,421 @@ string stringUtf8Encode(utf32_t codepoint) {
     return (string) { .data = (dataSegmentOfString_t *)result->data };
 }
 
-dynarray(string) stringTokenize(char *input, char *delim) {
-    if (!input || !delim) {
-        return (dynarray(string)) { .at = NULL, .count = 0 };
-    }
-    size_t input_index = 0, delim_index = 0, marker = 0;
-    bool found = false, delim_matches = true;
-    string token = {};
-    dynarray(string) ret = {};
+// split iterators
+//
+// each kind reproduces the token boundaries of the matching dynarray function exactly, those
+// are now implemented by collecting the iterator
+
+static char delimiterAt(strview delimiter, size_t index) {
+    return index < delimiter.length ? delimiter.at[index] : '\0';
+}
 
-    while (input[input_index]) {
-        delim_matches = input[input_index] == delim[delim_index];
-        found = !delim[delim_index];
+static bool splitNextTokenize(stringSplitIter_t *iter, strview *token) {
+    strview input = iter->input;
+    strview delim = iter->delimiter;
+    size_t delim_index = 0;
+    for(size_t input_index = iter->pos; input_index < input.length; input_index++) {
+        bool delim_matches = input.at[input_index] == delimiterAt(delim, delim_index);
+        bool found = delim_index == delim.length;
         delim_index++;
         delim_index *= delim_matches;
 
-        if (found) {
-            token = stringSliceFromCharPtr(input, marker, input_index - my_strlen(delim));
-            dynarray_append(ret, token);
-            marker = input_index;
-            delim_index = 0;
+        if(found) {
+            *token = strviewSlice(input, iter->mark, input_index - delim.length);
+            iter->mark = input_index;
+            iter->pos = input_index + 1;
+            return true;
         }
-        input_index++;
     }
-
-    if (marker < input_index) {
-        token = stringSliceFromCharPtr(input, marker, input_index);
-        dynarray_append(ret, token);
+    iter->done = true;
+    if(iter->mark < input.length) {
+        *token = strviewSlice(input, iter->mark, input.length);
+        return true;
     }
-
-    return ret;
+    return false;
 }
 
-dynarray(string) stringTokenizePairwise(char *input, char *start_delimiter, char *end_delimiter) {
-    if (!input || !start_delimiter || !end_delimiter) {
-        return (dynarray(string)) { .at = NULL, .count = 0 };
-    }
-    size_t input_index = 0, start_delimiter_index = 0, end_delimiter_index = 0, token_start = 0;
-    bool start_delimiter_matches = true, end_delimiter_matches = true, in_token = false;
-    string token = {};
-    dynarray(string) ret = {};
-    
-    while (input[input_index]) {
+static bool splitNextPairwise(stringSplitIter_t *iter, strview *token) {
+    strview input = iter->input;
+    size_t start_index = 0, end_index = 0, token_start = 0;
+    bool in_token = false;
+    for(size_t input_index = iter->pos; input_index < input.length; input_index++) {
         if(!in_token) {
-            start_delimiter_matches = input[input_index] == start_delimiter[start_delimiter_index];
-            start_delimiter_index++;
-            start_delimiter_index *= start_delimiter_matches;
-            
-            if (!start_delimiter[start_delimiter_index]) {
+            bool matches = input.at[input_index] == delimiterAt(iter->delimiter, start_index);
+            start_index++;
+            start_index *= matches;
+
+            if(delimiterAt(iter->delimiter, start_index) == '\0') {
                 token_start = input_index + 1;
                 in_token = true;
-                start_delimiter_index = 0;
+                start_index = 0;
             }
         } else {
-            end_delimiter_matches = input[input_index] == end_delimiter[end_delimiter_index];
-            end_delimiter_index++;
-            end_delimiter_index *= end_delimiter_matches;
-            
-            if (!end_delimiter[end_delimiter_index]) {
-                token = stringSliceFromCharPtr(input, token_start, input_index - my_strlen(end_delimiter) + 1);
-                dynarray_append(ret, token);
-                in_token = false;
-                end_delimiter_index = 0;
+            bool matches = input.at[input_index] == delimiterAt(iter->end_delimiter, end_index);
+            end_index++;
+            end_index *= matches;
+
+            if(delimiterAt(iter->end_delimiter, end_index) == '\0') {
+                *token = strviewSlice(input, token_start, input_index - iter->end_delimiter.length + 1);
+                iter->pos = input_index + 1;
+                return true;
             }
         }
-        input_index++;
     }
-
-    if (in_token && token_start < input_index) {
-        token = stringSliceFromCharPtr(input, token_start, input_index);
-        dynarray_append(ret, token);
+    iter->done = true;
+    if(in_token && token_start < input.length) {
+        *token = strviewSlice(input, token_start, input.length);
+        return true;
     }
+    return false;
+}
 
-    return ret;
+static bool splitNextDelimiter(stringSplitIter_t *iter, strview *token) {
+    strview input = iter->input;
+    size_t found = iter->delimiter.length == 0 ? SEARCH_NOT_FOUND
+        : searchForward(input.at + iter->pos, input.length - iter->pos, iter->delimiter.at, iter->delimiter.length);
+    if(found == SEARCH_NOT_FOUND) {
+        *token = strviewSlice(input, iter->pos, input.length);
+        iter->done = true;
+        return true;
+    }
+    *token = strviewSlice(input, iter->pos, iter->pos + found);
+    iter->pos += found + iter->delimiter.length;
+    return true;
 }
 
-dynarray(string) stringSplit(string str, string delimiter) {
-    dynarray(string) ret = {};
-    if(stringlen(delimiter) == 0) {
-        dynarray_append(ret, stringFromString(str));
-        return ret;
+// offset of the first '\n' or '\r', compared a block at a time
+static size_t findLineBreakScalar(const char *at, size_t len) {
+    for(size_t i = 0; i < len; i++) {
+        if(at[i] == '\n' || at[i] == '\r') return i;
     }
-    
-    size_t start = 0;
-    int pos;
-    while((pos = stringFindFrom(str, delimiter, start)) != -1) {
-        string token = stringSliceFromString(str, start, pos);
-        dynarray_append(ret, token);
-        start = pos + stringlen(delimiter);
+    return SEARCH_NOT_FOUND;
+}
+
+#ifdef CHAD_X86_SIMD
+
+static size_t findLineBreakSse2(const char *at, size_t len) {
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(at + i));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+    size_t found = findLineBreakScalar(at + i, len - i);
+    return found == SEARCH_NOT_FOUND ? found : i + found;
+}
+
+__attribute__((target("avx2")))
+static size_t findLineBreakAvx2(const char *at, size_t len) {
+    size_t i = 0;
+    for(; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(at + i));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+    size_t found = findLineBreakSse2(at + i, len - i);
+    return found == SEARCH_NOT_FOUND ? found : i + found;
+}
+
+#endif // CHAD_X86_SIMD
+
+static size_t findLineBreak(const char *at, size_t len) {
+    #ifdef CHAD_X86_SIMD
+    if(len >= 32 && __builtin_cpu_supports("avx2")) {
+        return findLineBreakAvx2(at, len);
     }
-    
-    if(start <= stringlen(str)) {
-        string token = stringSliceFromString(str, start, stringlen(str));
-        dynarray_append(ret, token);
+    if(len >= 16) {
+        return findLineBreakSse2(at, len);
     }
-    
-    return ret;
+    #endif
+    return findLineBreakScalar(at, len);
 }
 
-string stringJoin(dynarray(string) parts, string separator) {
-    if(parts.count == 0) {
-        return string("");
+static bool splitNextLine(stringSplitIter_t *iter, strview *token) {
+    strview input = iter->input;
+    size_t found = findLineBreak(input.at + iter->pos, input.length - iter->pos);
+    if(found != SEARCH_NOT_FOUND) {
+        size_t i = iter->pos + found;
+        *token = strviewSlice(input, iter->pos, i);
+        bool crlf = input.at[i] == '\r' && i + 1 < input.length && input.at[i + 1] == '\n';
+        iter->pos = i + (crlf ? 2 : 1);
+        return true;
+    }
+    *token = strviewSlice(input, iter->pos, input.length);
+    iter->done = true;
+    return true;
+}
+
+stringSplitIter_t stringSplitIter(string str, string delimiter) {
+    return (stringSplitIter_t) {
+        .kind = string_split_delimiter,
+        .input = strviewFromString(str),
+        .delimiter = strviewFromString(delimiter),
+    };
+}
+
+stringSplitIter_t stringSplitLinesIter(string str) {
+    return (stringSplitIter_t) { .kind = string_split_lines, .input = strviewFromString(str) };
+}
+
+stringSplitIter_t stringTokenizeIter(const char *input, const char *delim) {
+    return (stringSplitIter_t) {
+        .kind = string_split_tokenize,
+        .input = strviewFromCharPtr(input),
+        .delimiter = strviewFromCharPtr(delim),
+        .done = !input || !delim,
+    };
+}
+
+stringSplitIter_t stringTokenizePairwiseIter(const char *input, const char *start_delimiter, const char *end_delimiter) {
+    return (stringSplitIter_t) {
+        .kind = string_split_pairwise,
+        .input = strviewFromCharPtr(input),
+        .delimiter = strviewFromCharPtr(start_delimiter),
+        .end_delimiter = strviewFromCharPtr(end_delimiter),
+        .done = !input || !start_delimiter || !end_delimiter,
+    };
+}
+
+bool stringSplitNext(stringSplitIter_t *iter, strview *token) {
+    if(iter->done) return false;
+    switch(iter->kind) {
+        case string_split_delimiter: return splitNextDelimiter(iter, token);
+        case string_split_lines:     return splitNextLine(iter, token);
+        case string_split_tokenize:  return splitNextTokenize(iter, token);
+        case string_split_pairwise:  return splitNextPairwise(iter, token);
     }
-    
-    size_t total_len = 0;
-    for(size_t i = 0; i < parts.count; i++) {
-        total_len += stringlen(parts.at[i]);
+    return false;
+}
+
+dynarray(string) stringSplitCollect(stringSplitIter_t iter, stringAllocator_t *allocator) {
+    stringAllocator_t *previous = allocator ? stringUseAllocator(allocator) : NULL;
+    dynarray(string) ret = {};
+    strview token;
+    while(stringSplitNext(&iter, &token)) {
+        dynarray_append(ret, stringFromStrview(token));
     }
-    total_len += stringlen(separator) * (parts.count - 1);
-    
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + total_len + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringJoin\n");
-        exit(EXIT_FAILURE);
+    if(allocator) {
+        stringUseAllocator(previous);
     }
-    result->allocated_bytes = sizeof(stringHeader_t) + total_len + 1;
-    result->length = total_len;
-    
-    size_t pos = 0;
-    for(size_t i = 0; i < parts.count; i++) {
-        size_t part_len = stringlen(parts.at[i]);
-        memcpy(result->data + pos, parts.at[i].at, part_len);
-        pos += part_len;
-        
-        if(i < parts.count - 1) {
+    return ret;
+}
+
+dynarray(string) stringTokenize(char *input, char *delim) {
+    return stringSplitCollect(stringTokenizeIter(input, delim), NULL);
+}
+
+dynarray(string) stringTokenizePairwise(char *input, char *start_delimiter, char *end_delimiter) {
+    return stringSplitCollect(stringTokenizePairwiseIter(input, start_delimiter, end_delimiter), NULL);
+}
+
+dynarray(string) stringSplit(string str, string delimiter) {
+    return stringSplitCollect(stringSplitIter(str, delimiter), NULL);
+}
+
+// streaming readers
+//
+// a reader keeps one buffer: bytes are read in behind the pending record, and the pending
+// record is moved back to the front before each read, so the buffer only grows when a single
+// record outgrows it. records are returned as views into the buffer, nothing is allocated per
+// record. a search that reaches the end of the buffered bytes resumes where it left off after
+// the next read instead of starting over, less the bytes a longer delimiter could straddle
+
+#define STRING_READER_DEFAULT_BUFFER (64 * 1024)
+
+static stringReader_t readerCreate(int fd, FILE *file, size_t buffer_size) {
+    if(buffer_size == 0) buffer_size = STRING_READER_DEFAULT_BUFFER;
+    char *buffer = malloc(buffer_size);
+    if(buffer == NULL) {
+        fprintf(stderr, "failed to allocate memory in stringReader\n");
+        exit(EXIT_FAILURE);
+    }
+    return (stringReader_t) { .fd = fd, .file = file, .buffer = buffer, .capacity = buffer_size };
+}
+
+stringReader_t stringReaderFromFd(int fd, size_t buffer_size) {
+    return readerCreate(fd, NULL, buffer_size);
+}
+
+stringReader_t stringReaderFromFile(FILE *file, size_t buffer_size) {
+    return readerCreate(-1, file, buffer_size);
+}
+
+void destroyStringReader(stringReader_t *reader) {
+    free(reader->buffer);
+    *reader = (stringReader_t) { .fd = -1, .eof = true };
+}
+
+// bytes stdio holds for file that can be taken without touching its descriptor, -1 where the C
+// library does not expose it
+static ptrdiff_t stdioBuffered(FILE *file) {
+    #if defined(__GLIBC__)
+    return file->_IO_read_end - file->_IO_read_ptr;
+    #elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+    return file->_r;
+    #else
+    (void)file;
+    return -1;
+    #endif
+}
+
+// whatever file has available, waiting only for the first byte. fread would wait for room bytes,
+// which on a pipe or terminal holds back lines that have long arrived
+static size_t readAvailable(FILE *file, char *out, size_t room, bool *failed) {
+    size_t n = 0;
+    #ifdef CHAD_POSIX
+    flockfile(file);
+    #endif
+    ptrdiff_t buffered = stdioBuffered(file);
+    if(buffered > 0) {
+        n = fread(out, 1, (size_t)buffered < room ? (size_t)buffered : room, file);
+        *failed = false;
+    }
+    #ifdef CHAD_POSIX
+    else if(buffered == 0) {
+        // nothing buffered, so one read of the descriptor keeps the stream position consistent
+        ssize_t got;
+        do {
+            got = read(fileno(file), out, room);
+        } while(got < 0 && errno == EINTR);
+        *failed = got < 0;
+        n = got > 0 ? (size_t)got : 0;
+    }
+    #endif
+    else {
+        // without a count, stop at the end of a line so that interactive input is not held back
+        int c;
+        while(n < room && (c = getc(file)) != EOF) {
+            out[n++] = (char)c;
+            if(c == '\n') break;
+        }
+        *failed = n == 0 && ferror(file);
+    }
+    #ifdef CHAD_POSIX
+    funlockfile(file);
+    #endif
+    return n;
+}
+
+// reads more behind the pending bytes, which may move them, false once the input is exhausted
+static bool readerFill(stringReader_t *reader) {
+    if(reader->eof) return false;
+    if(reader->start > 0) {
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+    if(reader->end == reader->capacity) {
+        char *grown = realloc(reader->buffer, reader->capacity * 2);
+        if(grown == NULL) {
+            fprintf(stderr, "failed to allocate memory in readerFill\n");
+            exit(EXIT_FAILURE);
+        }
+        reader->buffer = grown;
+        reader->capacity *= 2;
+    }
+    size_t room = reader->capacity - reader->end;
+    size_t n;
+    if(reader->file != NULL) {
+        n = readAvailable(reader->file, reader->buffer + reader->end, room, &reader->failed);
+    } else {
+        #ifdef CHAD_POSIX
+        ssize_t got;
+        do {
+            got = read(reader->fd, reader->buffer + reader->end, room);
+        } while(got < 0 && errno == EINTR);
+        reader->failed = got < 0;
+        n = got > 0 ? (size_t)got : 0;
+        #else
+        reader->failed = true;
+        n = 0;
+        #endif
+    }
+    if(n == 0) {
+        reader->eof = true;
+        return false;
+    }
+    reader->end += n;
+    return true;
+}
+
+static bool readerNext(stringReader_t *reader, strview delimiter, bool lines, strview *record) {
+    if(reader->buffer == NULL) return false;
+    size_t scanned = 0; // bytes after start known not to begin a delimiter
+    for(;;) {
+        const char *pending = reader->buffer + reader->start;
+        size_t length = reader->end - reader->start;
+        size_t found = SEARCH_NOT_FOUND;
+        if(lines) {
+            found = findLineBreak(pending + scanned, length - scanned);
+        } else if(delimiter.length > 0) {
+            found = searchForward(pending + scanned, length - scanned, delimiter.at, delimiter.length);
+        }
+        if(found != SEARCH_NOT_FOUND) {
+            found += scanned;
+            size_t skip = lines ? 1 : delimiter.length;
+            if(lines && pending[found] == '\r') {
+                // a '\r' at the end of the buffer could be the first half of "\r\n"
+                if(found + 1 == length) {
+                    if(readerFill(reader)) {
+                        scanned = found;
+                        continue;
+                    }
+                    pending = reader->buffer + reader->start;
+                } else if(pending[found + 1] == '\n') {
+                    skip = 2;
+                }
+            }
+            *record = strviewFromParts(pending, found);
+            reader->start += found + skip;
+            return true;
+        }
+        if(lines) {
+            scanned = length;
+        } else {
+            scanned = length >= delimiter.length ? length - delimiter.length + 1 : 0;
+        }
+        if(!readerFill(reader)) {
+            if(reader->end == reader->start) return false;
+            // the last record, without a delimiter after it
+            *record = strviewFromParts(reader->buffer + reader->start, reader->end - reader->start);
+            reader->start = reader->end;
+            return true;
+        }
+    }
+}
+
+bool stringReaderNextLine(stringReader_t *reader, strview *line) {
+    return readerNext(reader, (strview) {0}, true, line);
+}
+
+bool stringReaderNextRecord(stringReader_t *reader, strview delimiter, strview *record) {
+    return readerNext(reader, delimiter, false, record);
+}
+
+string stringJoin(dynarray(string) parts, string separator) {
+    if(parts.count == 0) {
+        return string("");
+    }
+    
+    size_t total_len = 0;
+    for(size_t i = 0; i < parts.count; i++) {
+        total_len += stringlen(parts.at[i]);
+    }
+    total_len += stringlen(separator) * (parts.count - 1);
+    
+    stringHeader_t *result = allocStringHeader(total_len);
+    result->length = total_len;
+    
+    size_t pos = 0;
+    for(size_t i = 0; i < parts.count; i++) {
+        size_t part_len = stringlen(parts.at[i]);
+        memcpy(result->data + pos, parts.at[i].at, part_len);
+        pos += part_len;
+        
+        if(i < parts.count - 1) {
             size_t sep_len = stringlen(separator);
             memcpy(result->data + pos, separator.at, sep_len);
             pos += sep_len;
@@ -826,6 +2581,194 @@ string stringJoin(dynarray(string) parts, string separator) {
     return (string) { .data = (dataSegmentOfString_t *)result->data };
 }
 
+// sorting
+//
+// multikey quicksort (Bentley and Sedgewick) eight bytes at a time. every entry caches the next
+// eight bytes of its string from the current depth as a big endian integer, so partitioning
+// compares integers in one contiguous array instead of chasing each string's header. entries
+// equal on their key move on to the next eight bytes, apart from those that end within them:
+// those are equal up to their own length and only need ordering by it. short ranges are
+// finished by insertion sort. the parallel sort hands one part of each large partition to
+// another thread while threads are left, the largest part always stays on the current one
+
+#define STRING_SORT_INSERTION_MAX 16
+#define STRING_SORT_PARALLEL_MIN (1 << 15)
+
+typedef struct {
+    uint64_t key; // bytes [depth, depth + 8) as a big endian integer, zero past the end
+    string str;
+    size_t length;
+} sortEntry_t;
+
+static inline uint64_t sortKey(const sortEntry_t *entry, size_t depth) {
+    if(entry->length >= depth + 8) {
+        uint64_t word;
+        memcpy(&word, entry->str.at + depth, sizeof word);
+        #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        word = __builtin_bswap64(word);
+        #endif
+        return word;
+    }
+    uint64_t key = 0;
+    for(size_t i = depth; i < depth + 8; i++) {
+        key = key << 8 | (i < entry->length ? (unsigned char)entry->str.at[i] : 0);
+    }
+    return key;
+}
+
+// entries that agree before depth
+static int sortCompare(const sortEntry_t *a, const sortEntry_t *b, size_t depth) {
+    if(a->key != b->key) return a->key < b->key ? -1 : 1;
+    size_t min = a->length < b->length ? a->length : b->length;
+    if(min > depth + 8) {
+        int res = memcmp(a->str.at + depth + 8, b->str.at + depth + 8, min - depth - 8);
+        if(res != 0) return res;
+    }
+    return (a->length > b->length) - (a->length < b->length);
+}
+
+static void sortInsertion(sortEntry_t *entries, size_t count, size_t depth) {
+    for(size_t i = 1; i < count; i++) {
+        sortEntry_t item = entries[i];
+        size_t j = i;
+        while(j > 0 && sortCompare(&item, &entries[j - 1], depth) < 0) {
+            entries[j] = entries[j - 1];
+            j--;
+        }
+        entries[j] = item;
+    }
+}
+
+static inline void sortSwap(sortEntry_t *a, sortEntry_t *b) {
+    sortEntry_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+static uint64_t sortPivot(const sortEntry_t *entries, size_t count) {
+    uint64_t a = entries[0].key, b = entries[count / 2].key, c = entries[count - 1].key;
+    if(a > b) { uint64_t t = a; a = b; b = t; }
+    if(b > c) b = c;
+    return a > b ? a : b;
+}
+
+typedef struct {
+    sortEntry_t *entries;
+    size_t count;
+    size_t depth;
+    size_t threads;
+} sortTask_t;
+
+static void multikeySort(sortEntry_t *entries, size_t count, size_t depth, size_t threads);
+
+static int sortTaskRun(void *arg) {
+    sortTask_t *task = arg;
+    multikeySort(task->entries, task->count, task->depth, task->threads);
+    return 0;
+}
+
+// keys must be loaded for depth
+static void multikeySort(sortEntry_t *entries, size_t count, size_t depth, size_t threads) {
+    while(count > STRING_SORT_INSERTION_MAX) {
+        uint64_t pivot = sortPivot(entries, count);
+        size_t lt = 0, i = 0, gt = count;
+        while(i < gt) {
+            if(entries[i].key < pivot) {
+                sortSwap(&entries[lt++], &entries[i++]);
+            } else if(entries[i].key > pivot) {
+                sortSwap(&entries[i], &entries[--gt]);
+            } else {
+                i++;
+            }
+        }
+
+        // strings that end within the equal key go first, ordered by length with one pass per length
+        sortEntry_t *equal = entries + lt;
+        size_t equal_count = gt - lt, ended = 0;
+        for(size_t k = 0; k < equal_count; k++) {
+            if(equal[k].length <= depth + 8) sortSwap(&equal[ended++], &equal[k]);
+        }
+        size_t placed = 0;
+        for(size_t length = depth; length < depth + 8 && placed < ended; length++) {
+            for(size_t k = placed; k < ended; k++) {
+                if(equal[k].length == length) sortSwap(&equal[placed++], &equal[k]);
+            }
+        }
+        for(size_t k = ended; k < equal_count; k++) {
+            equal[k].key = sortKey(&equal[k], depth + 8);
+        }
+
+        sortTask_t parts[3] = {
+            { entries, lt, depth, 0 },
+            { entries + gt, count - gt, depth, 0 },
+            { equal + ended, equal_count - ended, depth + 8, 0 },
+        };
+        size_t largest = 0;
+        for(size_t k = 1; k < 3; k++) {
+            if(parts[k].count > parts[largest].count) largest = k;
+        }
+        thrd_t thread;
+        sortTask_t *spawned = NULL;
+        for(size_t k = 0; k < 3; k++) {
+            if(k == largest || parts[k].count < 2) continue;
+            if(spawned == NULL && threads > 1 && parts[k].count >= STRING_SORT_PARALLEL_MIN) {
+                parts[k].threads = threads / 2;
+                if(thrd_create(&thread, sortTaskRun, &parts[k]) == thrd_success) {
+                    spawned = &parts[k];
+                    threads -= threads / 2;
+                    continue;
+                }
+            }
+            multikeySort(parts[k].entries, parts[k].count, parts[k].depth, threads);
+        }
+        if(spawned != NULL) {
+            multikeySort(parts[largest].entries, parts[largest].count, parts[largest].depth, threads);
+            thrd_join(thread, NULL);
+            return;
+        }
+        entries = parts[largest].entries;
+        count = parts[largest].count;
+        depth = parts[largest].depth;
+    }
+    sortInsertion(entries, count, depth);
+}
+
+static void sortStrings(dynarray(string) strings, size_t threads) {
+    size_t count = strings.count;
+    if(count < 2) return;
+    sortEntry_t *entries = malloc(count * sizeof *entries);
+    if(entries == NULL) {
+        fprintf(stderr, "failed to allocate memory in stringSort\n");
+        exit(EXIT_FAILURE);
+    }
+    for(size_t i = 0; i < count; i++) {
+        entries[i].str = strings.at[i];
+        entries[i].length = stringlen(strings.at[i]);
+        entries[i].key = sortKey(&entries[i], 0);
+    }
+    multikeySort(entries, count, 0, threads);
+    for(size_t i = 0; i < count; i++) {
+        strings.at[i] = entries[i].str;
+    }
+    free(entries);
+}
+
+void stringSort(dynarray(string) strings) {
+    sortStrings(strings, 1);
+}
+
+void stringSortParallel(dynarray(string) strings, size_t threads) {
+    if(threads == 0) {
+        #ifdef CHAD_POSIX
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (size_t)online : 1;
+        #else
+        threads = 4;
+        #endif
+    }
+    sortStrings(strings, threads);
+}
+
 string stringFormat(const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
@@ -845,12 +2788,7 @@ string stringFormatVa(const char *fmt, va_list args) {
         exit(EXIT_FAILURE);
     }
     
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + len + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringFormatVa\n");
-        exit(EXIT_FAILURE);
-    }
-    result->allocated_bytes = sizeof(stringHeader_t) + len + 1;
+    stringHeader_t *result = allocStringHeader(len);
     result->length = len;
     
     vsnprintf(result->data, len + 1, fmt, args);
@@ -859,40 +2797,19 @@ string stringFormatVa(const char *fmt, va_list args) {
 }
 
 bool stringIsOnlyAlphNum(const char* input) {
-    while (*input) {
-        if (!isalnum((unsigned char)*input)) {
-            return false;
-        }
-        input++;
-    }
-    return true;
+    return asciiAllOf(input, strlen(input), ASCII_ALPHA | ASCII_DIGIT);
 }
 
 bool stringIsAlpha(string str) {
-    for(size_t i = 0; i < stringlen(str); i++) {
-        if(!isalpha((unsigned char)str.at[i])) {
-            return false;
-        }
-    }
-    return stringlen(str) > 0;
+    return stringlen(str) > 0 && asciiAllOf(str.at, stringlen(str), ASCII_ALPHA);
 }
 
 bool stringIsDigit(string str) {
-    for(size_t i = 0; i < stringlen(str); i++) {
-        if(!isdigit((unsigned char)str.at[i])) {
-            return false;
-        }
-    }
-    return stringlen(str) > 0;
+    return stringlen(str) > 0 && asciiAllOf(str.at, stringlen(str), ASCII_DIGIT);
 }
 
 bool stringIsWhitespace(string str) {
-    for(size_t i = 0; i < stringlen(str); i++) {
-        if(!isspace((unsigned char)str.at[i])) {
-            return false;
-        }
-    }
-    return stringlen(str) > 0;
+    return stringlen(str) > 0 && asciiAllOf(str.at, stringlen(str), ASCII_SPACE);
 }
 
 string stringGrowBuffer(string orig, size_t to_add) {
@@ -900,24 +2817,100 @@ string stringGrowBuffer(string orig, size_t to_add) {
         orig = string("");
     }
     stringHeader_t *hdr = getHeaderPointer(orig);
-    size_t old_bytes = stringbytesalloced(orig);
-    stringHeader_t *new_hdr = realloc(hdr, old_bytes + to_add);
-    if(new_hdr == NULL) {
-        fprintf(stderr, "realloc failed in stringGrowBuffer\n");
+    if(hdr->flags & string_interned) {
+        fprintf(stderr, "attempt to modify interned string \"%s\"\n", hdr->data);
         exit(EXIT_FAILURE);
     }
-    new_hdr->allocated_bytes += to_add;
+    if(headerIsReadOnly(hdr)) {
+        stringHeader_t *copy = detachStringHeader(hdr, hdr->length, hdr->length + to_add);
+        return (string) { .data = (dataSegmentOfString_t *)copy->data };
+    }
+    size_t old_bytes = stringbytesalloced(orig);
+    size_t needed = sizeof(stringHeader_t) + hdr->length + to_add + 1;
+    #ifdef CHAD_STRING_EXACT_GROWTH
+    if(needed <= old_bytes && ((hdr->flags & string_small) || hdr->allocator != NULL)) {
+        return orig;
+    }
+    size_t new_bytes = old_bytes + to_add;
+    #else
+    if(needed <= old_bytes) {
+        return orig;
+    }
+    // grow geometrically so that repeated appends cost amortized O(1)
+    size_t new_bytes = old_bytes + to_add;
+    if(new_bytes < old_bytes * 2) {
+        new_bytes = old_bytes * 2;
+    }
+    #endif
+    stringHeader_t *new_hdr = resizeStringHeader(hdr, new_bytes);
     new_hdr->data[new_hdr->length] = '\0';
     return (string) { .data = (dataSegmentOfString_t *)new_hdr->data };
 }
 
+string stringReserve(string orig, size_t capacity) {
+    if(orig.data == NULL) {
+        orig = string("");
+    }
+    stringHeader_t *hdr = getHeaderPointer(orig);
+    if(hdr->flags & string_interned) {
+        fprintf(stderr, "attempt to modify interned string \"%s\"\n", hdr->data);
+        exit(EXIT_FAILURE);
+    }
+    if(headerIsReadOnly(hdr)) {
+        stringHeader_t *copy = detachStringHeader(hdr, hdr->length, capacity);
+        return (string) { .data = (dataSegmentOfString_t *)copy->data };
+    }
+    size_t needed = sizeof(stringHeader_t) + capacity + 1;
+    if(needed <= hdr->allocated_bytes) {
+        return orig;
+    }
+    stringHeader_t *new_hdr = resizeStringHeader(hdr, needed);
+    return (string) { .data = (dataSegmentOfString_t *)new_hdr->data };
+}
+
+string stringShrinkToFit(string orig) {
+    if(orig.data == NULL) {
+        return orig;
+    }
+    stringHeader_t *hdr = getHeaderPointer(orig);
+    size_t needed = sizeof(stringHeader_t) + hdr->length + 1;
+    if(needed >= hdr->allocated_bytes || (hdr->flags & string_small) || headerIsReadOnly(hdr)) {
+        return orig;
+    }
+    stringAllocator_t *alloc = hdr->allocator;
+    if(alloc != NULL) {
+        if(alloc->kind != string_allocator_pool 
+            || poolClass(needed) >= poolClass(hdr->allocated_bytes)) {
+            return orig;
+        }
+    } else if(hdr->length > STRING_SMALL_CAPACITY) {
+        stringHeader_t *new_hdr = realloc(hdr, needed);
+        if(new_hdr == NULL) {
+            fprintf(stderr, "realloc failed in stringShrinkToFit\n");
+            exit(EXIT_FAILURE);
+        }
+        new_hdr->allocated_bytes = needed;
+        return (string) { .data = (dataSegmentOfString_t *)new_hdr->data };
+    }
+    // smaller pool class or a small string cell, take a fresh copy from the owning backend
+    stringAllocator_t *previous = stringUseAllocator(alloc);
+    string ret = stringClone(orig);
+    stringUseAllocator(previous);
+    freeStringHeader(hdr);
+    return ret;
+}
+
+size_t stringCapacity(string str) {
+    return getHeaderPointer(str)->allocated_bytes - sizeof(stringHeader_t) - 1;
+}
+
 string stringAppendCharPtr(string orig, const char *to_append) {
     size_t append_len = my_strlen(to_append);
     string ret = stringGrowBuffer(orig, append_len);
     my_strncpy(ret.at + stringlen(ret), to_append, append_len);
     getHeaderPointer(ret)->length += append_len;
+    stringInvalidate(ret);
     ret.at[stringlen(ret)] = '\0';
-    assert(stringlen(ret) == my_strlen(ret.at));
     return ret;
 }
 
@@ -925,8 +2918,8 @@ string stringAppendString(string orig, string to_append) {
     string ret = stringGrowBuffer(orig, stringlen(to_append));
     my_strncpy(ret.at + stringlen(ret), to_append.at, stringlen(to_append));
     getHeaderPointer(ret)->length += stringlen(to_append);
+    stringInvalidate(ret);
     ret.at[stringlen(ret)] = '\0';
-    assert(stringlen(ret) == my_strlen(ret.at));
     return ret;
 }
 
@@ -934,8 +2927,8 @@ string stringAppendChar(string orig, char c) {
     string ret = stringGrowBuffer(orig, 1);
     ret.at[stringlen(ret)] = c;
     getHeaderPointer(ret)->length++;
+    stringInvalidate(ret);
     ret.at[stringlen(ret)] = '\0';
-    assert(stringlen(ret) == my_strlen(ret.at));
     return ret;
 }
 
@@ -946,8 +2939,8 @@ string stringPrependCharPtr(string orig, const char *to_prepend) {
     memmove(ret.at + prepend_len, ret.at, orig_len);
     memcpy(ret.at, to_prepend, prepend_len);
     getHeaderPointer(ret)->length += prepend_len;
+    stringInvalidate(ret);
     ret.at[stringlen(ret)] = '\0';
-    assert(stringlen(ret) == my_strlen(ret.at));
     return ret;
 }
 
@@ -958,8 +2951,8 @@ string stringPrependString(string orig, string to_prepend) {
     memmove(ret.at + prepend_len, ret.at, orig_len);
     memcpy(ret.at, to_prepend.at, prepend_len);
     getHeaderPointer(ret)->length += prepend_len;
+    stringInvalidate(ret);
     ret.at[stringlen(ret)] = '\0';
-    assert(stringlen(ret) == my_strlen(ret.at));
     return ret;
 }
 
@@ -969,8 +2962,8 @@ string stringPrependChar(string orig, char c) {
     memmove(ret.at + 1, ret.at, orig_len);
     ret.at[0] = c;  
     getHeaderPointer(ret)->length++;
+    stringInvalidate(ret);
     ret.at[stringlen(ret)] = '\0';
-    assert(stringlen(ret) == my_strlen(ret.at));
     return ret;
 }
 
@@ -997,12 +2990,7 @@ string stringRepeat(string str, size_t count) {
     size_t str_len = stringlen(str);
     size_t total_len = str_len * count;
     
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + total_len + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringRepeat\n");
-        exit(EXIT_FAILURE);
-    }
-    result->allocated_bytes = sizeof(stringHeader_t) + total_len + 1;
+    stringHeader_t *result = allocStringHeader(total_len);
     result->length = total_len;
     
     for(size_t i = 0; i < count; i++) {
@@ -1020,12 +3008,7 @@ string stringPad(string str, size_t total_width, char pad_char, bool pad_left) {
     }
     
     size_t pad_count = total_width - str_len;
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + total_width + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringPad\n");
-        exit(EXIT_FAILURE);
-    }
-    result->allocated_bytes = sizeof(stringHeader_t) + total_width + 1;
+    stringHeader_t *result = allocStringHeader(total_width);
     result->length = total_width;
     
     if(pad_left) {
@@ -1058,12 +3041,7 @@ string stringCenter(string str, size_t total_width, char pad_char) {
     size_t left_padding = total_padding / 2;
     size_t right_padding = total_padding - left_padding;
     
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + total_width + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringCenter\n");
-        exit(EXIT_FAILURE);
-    }
-    result->allocated_bytes = sizeof(stringHeader_t) + total_width + 1;
+    stringHeader_t *result = allocStringHeader(total_width);
     result->length = total_width;
     
     memset(result->data, pad_char, left_padding);
@@ -1087,628 +3065,3486 @@ bool stringContainsChar(string str, char ch) {
     return false;
 }
 
-int stringIndexOf(string haystack, char ch) {
-    for(size_t i = 0; i < stringlen(haystack); i++) {
-        if(haystack.at[i] == ch) {
-            return (int)i;
-        }
-    }
-    return -1;
+int stringIndexOf(string haystack, char ch) {
+    for(size_t i = 0; i < stringlen(haystack); i++) {
+        if(haystack.at[i] == ch) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+int stringLastIndexOf(string haystack, char ch) {
+    for(size_t i = stringlen(haystack); i > 0; i--) {
+        if(haystack.at[i - 1] == ch) {
+            return (int)(i - 1);
+        }
+    }
+    return -1;
+}
+
+string stringSubstring(string str, size_t start, size_t length) {
+    if(start >= stringlen(str)) {
+        return string("");
+    }
+    size_t end = start + length;
+    if(end > stringlen(str)) {
+        end = stringlen(str);
+    }
+    return stringSliceFromString(str, start, end);
+}
+
+dynarray(string) stringSplitLines(string str) {
+    return stringSplitCollect(stringSplitLinesIter(str), NULL);
+}
+
+string stringReplaceChar(string str, char find, char replace) {
+    string result = stringClone(str);
+    for(size_t i = 0; i < stringlen(result); i++) {
+        if(result.at[i] == find) {
+            result.at[i] = replace;
+        }
+    }
+    return result;
+}
+
+string stringRemoveChar(string str, char to_remove) {
+    size_t new_len = 0;
+    for(size_t i = 0; i < stringlen(str); i++) {
+        if(str.at[i] != to_remove) {
+            new_len++;
+        }
+    }
+    
+    stringHeader_t *result = allocStringHeader(new_len);
+    result->length = new_len;
+    
+    size_t pos = 0;
+    for(size_t i = 0; i < stringlen(str); i++) {
+        if(str.at[i] != to_remove) {
+            result->data[pos++] = str.at[i];
+        }
+    }
+    result->data[new_len] = '\0';
+    
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+string stringTruncate(string str, size_t max_length, const char *suffix) {
+    if(stringlen(str) <= max_length) {
+        return stringFromString(str);
+    }
+    
+    size_t suffix_len = suffix ? my_strlen(suffix) : 0;
+    if(suffix_len >= max_length) {
+        return stringSliceFromString(str, 0, max_length);
+    }
+    
+    size_t truncate_at = max_length - suffix_len;
+    string truncated = stringSliceFromString(str, 0, truncate_at);
+    
+    if(suffix) {
+        string with_suffix = stringAppendCharPtr(truncated, suffix);
+        return with_suffix;
+    }
+    
+    return truncated;
+}
+
+
+// number parsing
+//
+// the parsers read a view up to its length and no further, so slices and other text without a
+// terminator are parsed in place, and they accept the same text in every locale. digits are
+// taken eight at a time as one little endian word where they fit: one check tells whether all
+// eight bytes are digits and three multiplies combine them. doubles first try Clinger's fast
+// path, exact when both the digits and the power of ten fit in a double, then Eisel and
+// Lemire's: the digits are scaled by a 128 bit power of ten from a table and rounded, unless
+// the truncated product lies too close to a halfway point to tell. only those rare cases go
+// to strtod, handed the digits as an integer with an exponent, which has nothing locale
+// dependent in it
+
+#define NUMBER_PARSE_MAX_DIGITS 768 // enough to round any double, further digits only count as nonzero
+
+// full 64 x 64 -> 128 bit product, defined with the hashes below
+static inline void wyhashMultiply(uint64_t *a, uint64_t *b);
+
+static inline uint64_t loadEightDigits(const char *at) {
+    uint64_t word;
+    memcpy(&word, at, sizeof word);
+    #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+    #endif
+    return word;
+}
+
+static inline bool areEightDigits(uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0ull) | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))
+        == 0x3333333333333333ull;
+}
+
+// the first digit is in the lowest byte
+static inline uint32_t parseEightDigits(uint64_t word) {
+    word -= 0x3030303030303030ull;
+    word = word * 10 + (word >> 8);
+    word = ((word & 0x000000FF000000FFull) * (100 + (1000000ull << 32))
+        + ((word >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32))) >> 32;
+    return (uint32_t)word;
+}
+
+// at[0, length) must be all digits, overflow is only reported once all of them were checked
+static stringNumberStatus_t parseUint64Digits(const char *at, size_t length, uint64_t *out) {
+    if(length == 0) return string_number_invalid;
+    size_t i = 0;
+    while(i < length && at[i] == '0') i++;
+    size_t significant = i;
+    uint64_t value = 0;
+    // 16 digits always fit, the last few need overflow checks
+    while(i + 8 <= length && i - significant <= 8) {
+        uint64_t word = loadEightDigits(at + i);
+        if(!areEightDigits(word)) break;
+        value = value * 100000000 + parseEightDigits(word);
+        i += 8;
+    }
+    bool overflow = false;
+    for(; i < length; i++) {
+        unsigned digit = (unsigned char)at[i] - '0';
+        if(digit > 9) return string_number_invalid;
+        overflow |= __builtin_mul_overflow(value, 10, &value);
+        overflow |= __builtin_add_overflow(value, digit, &value);
+    }
+    *out = value;
+    return overflow ? string_number_overflow : string_number_ok;
+}
+
+stringNumberStatus_t strviewToUint64(strview text, uint64_t *out) {
+    const char *at = text.at;
+    size_t length = text.length;
+    if(length > 0 && at[0] == '+') {
+        at++;
+        length--;
+    }
+    uint64_t value;
+    stringNumberStatus_t status = parseUint64Digits(at, length, &value);
+    if(status == string_number_invalid) return status;
+    if(out) *out = status == string_number_overflow ? UINT64_MAX : value;
+    return status;
+}
+
+stringNumberStatus_t strviewToInt64(strview text, int64_t *out) {
+    const char *at = text.at;
+    size_t length = text.length;
+    bool negative = false;
+    if(length > 0 && (at[0] == '-' || at[0] == '+')) {
+        negative = at[0] == '-';
+        at++;
+        length--;
+    }
+    uint64_t magnitude;
+    stringNumberStatus_t status = parseUint64Digits(at, length, &magnitude);
+    if(status == string_number_invalid) return status;
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    if(status == string_number_overflow || magnitude > limit) {
+        if(out) *out = negative ? INT64_MIN : INT64_MAX;
+        return string_number_overflow;
+    }
+    if(out) *out = negative ? -(int64_t)(magnitude - 1) - 1 : (int64_t)magnitude;
+    return string_number_ok;
+}
+
+static const double exact_powers_of_ten[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// 10^e for e in [-348, 347], normalized to 128 bits and rounded down, { low, high }
+#define EISEL_LEMIRE_MIN_EXPONENT -348
+#define EISEL_LEMIRE_MAX_EXPONENT 347
+static const uint64_t eisel_lemire_pow10[696][2] = {
+    { 0x1732c869cd60e453ull, 0xfa8fd5a0081c0288ull }, { 0xe7fbd42205c8eb4ull, 0x9c99e58405118195ull },
+    { 0x521fac92a873b261ull, 0xc3c05ee50655e1faull }, { 0xe6a797b752909ef9ull, 0xf4b0769e47eb5a78ull },
+    { 0x9028bed2939a635cull, 0x98ee4a22ecf3188bull }, { 0x7432ee873880fc33ull, 0xbf29dcaba82fdeaeull },
+    { 0x113faa2906a13b3full, 0xeef453d6923bd65aull }, { 0x4ac7ca59a424c507ull, 0x9558b4661b6565f8ull },
+    { 0x5d79bcf00d2df649ull, 0xbaaee17fa23ebf76ull }, { 0xf4d82c2c107973dcull, 0xe95a99df8ace6f53ull },
+    { 0x79071b9b8a4be869ull, 0x91d8a02bb6c10594ull }, { 0x9748e2826cdee284ull, 0xb64ec836a47146f9ull },
+    { 0xfd1b1b2308169b25ull, 0xe3e27a444d8d98b7ull }, { 0xfe30f0f5e50e20f7ull, 0x8e6d8c6ab0787f72ull },
+    { 0xbdbd2d335e51a935ull, 0xb208ef855c969f4full }, { 0xad2c788035e61382ull, 0xde8b2b66b3bc4723ull },
+    { 0x4c3bcb5021afcc31ull, 0x8b16fb203055ac76ull }, { 0xdf4abe242a1bbf3dull, 0xaddcb9e83c6b1793ull },
+    { 0xd71d6dad34a2af0dull, 0xd953e8624b85dd78ull }, { 0x8672648c40e5ad68ull, 0x87d4713d6f33aa6bull },
+    { 0x680efdaf511f18c2ull, 0xa9c98d8ccb009506ull }, { 0x212bd1b2566def2ull, 0xd43bf0effdc0ba48ull },
+    { 0x14bb630f7604b57ull, 0x84a57695fe98746dull }, { 0x419ea3bd35385e2dull, 0xa5ced43b7e3e9188ull },
+    { 0x52064cac828675b9ull, 0xcf42894a5dce35eaull }, { 0x7343efebd1940993ull, 0x818995ce7aa0e1b2ull },
+    { 0x1014ebe6c5f90bf8ull, 0xa1ebfb4219491a1full }, { 0xd41a26e077774ef6ull, 0xca66fa129f9b60a6ull },
+    { 0x8920b098955522b4ull, 0xfd00b897478238d0ull }, { 0x55b46e5f5d5535b0ull, 0x9e20735e8cb16382ull },
+    { 0xeb2189f734aa831dull, 0xc5a890362fddbc62ull }, { 0xa5e9ec7501d523e4ull, 0xf712b443bbd52b7bull },
+    { 0x47b233c92125366eull, 0x9a6bb0aa55653b2dull }, { 0x999ec0bb696e840aull, 0xc1069cd4eabe89f8ull },
+    { 0xc00670ea43ca250dull, 0xf148440a256e2c76ull }, { 0x380406926a5e5728ull, 0x96cd2a865764dbcaull },
+    { 0xc605083704f5ecf2ull, 0xbc807527ed3e12bcull }, { 0xf7864a44c633682eull, 0xeba09271e88d976bull },
+    { 0x7ab3ee6afbe0211dull, 0x93445b8731587ea3ull }, { 0x5960ea05bad82964ull, 0xb8157268fdae9e4cull },
+    { 0x6fb92487298e33bdull, 0xe61acf033d1a45dfull }, { 0xa5d3b6d479f8e056ull, 0x8fd0c16206306babull },
+    { 0x8f48a4899877186cull, 0xb3c4f1ba87bc8696ull }, { 0x331acdabfe94de87ull, 0xe0b62e2929aba83cull },
+    { 0x9ff0c08b7f1d0b14ull, 0x8c71dcd9ba0b4925ull }, { 0x7ecf0ae5ee44dd9ull, 0xaf8e5410288e1b6full },
+    { 0xc9e82cd9f69d6150ull, 0xdb71e91432b1a24aull }, { 0xbe311c083a225cd2ull, 0x892731ac9faf056eull },
+    { 0x6dbd630a48aaf406ull, 0xab70fe17c79ac6caull }, { 0x92cbbccdad5b108ull, 0xd64d3d9db981787dull },
+    { 0x25bbf56008c58ea5ull, 0x85f0468293f0eb4eull }, { 0xaf2af2b80af6f24eull, 0xa76c582338ed2621ull },
+    { 0x1af5af660db4aee1ull, 0xd1476e2c07286faaull }, { 0x50d98d9fc890ed4dull, 0x82cca4db847945caull },
+    { 0xe50ff107bab528a0ull, 0xa37fce126597973cull }, { 0x1e53ed49a96272c8ull, 0xcc5fc196fefd7d0cull },
+    { 0x25e8e89c13bb0f7aull, 0xff77b1fcbebcdc4full }, { 0x77b191618c54e9acull, 0x9faacf3df73609b1ull },
+    { 0xd59df5b9ef6a2417ull, 0xc795830d75038c1dull }, { 0x4b0573286b44ad1dull, 0xf97ae3d0d2446f25ull },
+    { 0x4ee367f9430aec32ull, 0x9becce62836ac577ull }, { 0x229c41f793cda73full, 0xc2e801fb244576d5ull },
+    { 0x6b43527578c1110full, 0xf3a20279ed56d48aull }, { 0x830a13896b78aaa9ull, 0x9845418c345644d6ull },
+    { 0x23cc986bc656d553ull, 0xbe5691ef416bd60cull }, { 0x2cbfbe86b7ec8aa8ull, 0xedec366b11c6cb8full },
+    { 0x7bf7d71432f3d6a9ull, 0x94b3a202eb1c3f39ull }, { 0xdaf5ccd93fb0cc53ull, 0xb9e08a83a5e34f07ull },
+    { 0xd1b3400f8f9cff68ull, 0xe858ad248f5c22c9ull }, { 0x23100809b9c21fa1ull, 0x91376c36d99995beull },
+    { 0xabd40a0c2832a78aull, 0xb58547448ffffb2dull }, { 0x16c90c8f323f516cull, 0xe2e69915b3fff9f9ull },
+    { 0xae3da7d97f6792e3ull, 0x8dd01fad907ffc3bull }, { 0x99cd11cfdf41779cull, 0xb1442798f49ffb4aull },
+    { 0x40405643d711d583ull, 0xdd95317f31c7fa1dull }, { 0x482835ea666b2572ull, 0x8a7d3eef7f1cfc52ull },
+    { 0xda3243650005eecfull, 0xad1c8eab5ee43b66ull }, { 0x90bed43e40076a82ull, 0xd863b256369d4a40ull },
+    { 0x5a7744a6e804a291ull, 0x873e4f75e2224e68ull }, { 0x711515d0a205cb36ull, 0xa90de3535aaae202ull },
+    { 0xd5a5b44ca873e03ull, 0xd3515c2831559a83ull }, { 0xe858790afe9486c2ull, 0x8412d9991ed58091ull },
+    { 0x626e974dbe39a872ull, 0xa5178fff668ae0b6ull }, { 0xfb0a3d212dc8128full, 0xce5d73ff402d98e3ull },
+    { 0x7ce66634bc9d0b99ull, 0x80fa687f881c7f8eull }, { 0x1c1fffc1ebc44e80ull, 0xa139029f6a239f72ull },
+    { 0xa327ffb266b56220ull, 0xc987434744ac874eull }, { 0x4bf1ff9f0062baa8ull, 0xfbe9141915d7a922ull },
+    { 0x6f773fc3603db4a9ull, 0x9d71ac8fada6c9b5ull }, { 0xcb550fb4384d21d3ull, 0xc4ce17b399107c22ull },
+    { 0x7e2a53a146606a48ull, 0xf6019da07f549b2bull }, { 0x2eda7444cbfc426dull, 0x99c102844f94e0fbull },
+    { 0xfa911155fefb5308ull, 0xc0314325637a1939ull }, { 0x793555ab7eba27caull, 0xf03d93eebc589f88ull },
+    { 0x4bc1558b2f3458deull, 0x96267c7535b763b5ull }, { 0x9eb1aaedfb016f16ull, 0xbbb01b9283253ca2ull },
+    { 0x465e15a979c1cadcull, 0xea9c227723ee8bcbull }, { 0xbfacd89ec191ec9ull, 0x92a1958a7675175full },
+    { 0xcef980ec671f667bull, 0xb749faed14125d36ull }, { 0x82b7e12780e7401aull, 0xe51c79a85916f484ull },
+    { 0xd1b2ecb8b0908810ull, 0x8f31cc0937ae58d2ull }, { 0x861fa7e6dcb4aa15ull, 0xb2fe3f0b8599ef07ull },
+    { 0x67a791e093e1d49aull, 0xdfbdcece67006ac9ull }, { 0xe0c8bb2c5c6d24e0ull, 0x8bd6a141006042bdull },
+    { 0x58fae9f773886e18ull, 0xaecc49914078536dull }, { 0xaf39a475506a899eull, 0xda7f5bf590966848ull },
+    { 0x6d8406c952429603ull, 0x888f99797a5e012dull }, { 0xc8e5087ba6d33b83ull, 0xaab37fd7d8f58178ull },
+    { 0xfb1e4a9a90880a64ull, 0xd5605fcdcf32e1d6ull }, { 0x5cf2eea09a55067full, 0x855c3be0a17fcd26ull },
+    { 0xf42faa48c0ea481eull, 0xa6b34ad8c9dfc06full }, { 0xf13b94daf124da26ull, 0xd0601d8efc57b08bull },
+    { 0x76c53d08d6b70858ull, 0x823c12795db6ce57ull }, { 0x54768c4b0c64ca6eull, 0xa2cb1717b52481edull },
+    { 0xa9942f5dcf7dfd09ull, 0xcb7ddcdda26da268ull }, { 0xd3f93b35435d7c4cull, 0xfe5d54150b090b02ull },
+    { 0xc47bc5014a1a6dafull, 0x9efa548d26e5a6e1ull }, { 0x359ab6419ca1091bull, 0xc6b8e9b0709f109aull },
+    { 0xc30163d203c94b62ull, 0xf867241c8cc6d4c0ull }, { 0x79e0de63425dcf1dull, 0x9b407691d7fc44f8ull },
+    { 0x985915fc12f542e4ull, 0xc21094364dfb5636ull }, { 0x3e6f5b7b17b2939dull, 0xf294b943e17a2bc4ull },
+    { 0xa705992ceecf9c42ull, 0x979cf3ca6cec5b5aull }, { 0x50c6ff782a838353ull, 0xbd8430bd08277231ull },
+    { 0xa4f8bf5635246428ull, 0xece53cec4a314ebdull }, { 0x871b7795e136be99ull, 0x940f4613ae5ed136ull },
+    { 0x28e2557b59846e3full, 0xb913179899f68584ull }, { 0x331aeada2fe589cfull, 0xe757dd7ec07426e5ull },
+    { 0x3ff0d2c85def7621ull, 0x9096ea6f3848984full }, { 0xfed077a756b53a9ull, 0xb4bca50b065abe63ull },
+    { 0xd3e8495912c62894ull, 0xe1ebce4dc7f16dfbull }, { 0x64712dd7abbbd95cull, 0x8d3360f09cf6e4bdull },
+    { 0xbd8d794d96aacfb3ull, 0xb080392cc4349decull }, { 0xecf0d7a0fc5583a0ull, 0xdca04777f541c567ull },
+    { 0xf41686c49db57244ull, 0x89e42caaf9491b60ull }, { 0x311c2875c522ced5ull, 0xac5d37d5b79b6239ull },
+    { 0x7d633293366b828bull, 0xd77485cb25823ac7ull }, { 0xae5dff9c02033197ull, 0x86a8d39ef77164bcull },
+    { 0xd9f57f830283fdfcull, 0xa8530886b54dbdebull }, { 0xd072df63c324fd7bull, 0xd267caa862a12d66ull },
+    { 0x4247cb9e59f71e6dull, 0x8380dea93da4bc60ull }, { 0x52d9be85f074e608ull, 0xa46116538d0deb78ull },
+    { 0x67902e276c921f8bull, 0xcd795be870516656ull }, { 0xba1cd8a3db53b6ull, 0x806bd9714632dff6ull },
+    { 0x80e8a40eccd228a4ull, 0xa086cfcd97bf97f3ull }, { 0x6122cd128006b2cdull, 0xc8a883c0fdaf7df0ull },
+    { 0x796b805720085f81ull, 0xfad2a4b13d1b5d6cull }, { 0xcbe3303674053bb0ull, 0x9cc3a6eec6311a63ull },
+    { 0xbedbfc4411068a9cull, 0xc3f490aa77bd60fcull }, { 0xee92fb5515482d44ull, 0xf4f1b4d515acb93bull },
+    { 0x751bdd152d4d1c4aull, 0x991711052d8bf3c5ull }, { 0xd262d45a78a0635dull, 0xbf5cd54678eef0b6ull },
+    { 0x86fb897116c87c34ull, 0xef340a98172aace4ull }, { 0xd45d35e6ae3d4da0ull, 0x9580869f0e7aac0eull },
+    { 0x8974836059cca109ull, 0xbae0a846d2195712ull }, { 0x2bd1a438703fc94bull, 0xe998d258869facd7ull },
+    { 0x7b6306a34627ddcfull, 0x91ff83775423cc06ull }, { 0x1a3bc84c17b1d542ull, 0xb67f6455292cbf08ull },
+    { 0x20caba5f1d9e4a93ull, 0xe41f3d6a7377eecaull }, { 0x547eb47b7282ee9cull, 0x8e938662882af53eull },
+    { 0xe99e619a4f23aa43ull, 0xb23867fb2a35b28dull }, { 0x6405fa00e2ec94d4ull, 0xdec681f9f4c31f31ull },
+    { 0xde83bc408dd3dd04ull, 0x8b3c113c38f9f37eull }, { 0x9624ab50b148d445ull, 0xae0b158b4738705eull },
+    { 0x3badd624dd9b0957ull, 0xd98ddaee19068c76ull }, { 0xe54ca5d70a80e5d6ull, 0x87f8a8d4cfa417c9ull },
+    { 0x5e9fcf4ccd211f4cull, 0xa9f6d30a038d1dbcull }, { 0x7647c3200069671full, 0xd47487cc8470652bull },
+    { 0x29ecd9f40041e073ull, 0x84c8d4dfd2c63f3bull }, { 0xf468107100525890ull, 0xa5fb0a17c777cf09ull },
+    { 0x7182148d4066eeb4ull, 0xcf79cc9db955c2ccull }, { 0xc6f14cd848405530ull, 0x81ac1fe293d599bfull },
+    { 0xb8ada00e5a506a7cull, 0xa21727db38cb002full }, { 0xa6d90811f0e4851cull, 0xca9cf1d206fdc03bull },
+    { 0x908f4a166d1da663ull, 0xfd442e4688bd304aull }, { 0x9a598e4e043287feull, 0x9e4a9cec15763e2eull },
+    { 0x40eff1e1853f29fdull, 0xc5dd44271ad3cdbaull }, { 0xd12bee59e68ef47cull, 0xf7549530e188c128ull },
+    { 0x82bb74f8301958ceull, 0x9a94dd3e8cf578b9ull }, { 0xe36a52363c1faf01ull, 0xc13a148e3032d6e7ull },
+    { 0xdc44e6c3cb279ac1ull, 0xf18899b1bc3f8ca1ull }, { 0x29ab103a5ef8c0b9ull, 0x96f5600f15a7b7e5ull },
+    { 0x7415d448f6b6f0e7ull, 0xbcb2b812db11a5deull }, { 0x111b495b3464ad21ull, 0xebdf661791d60f56ull },
+    { 0xcab10dd900beec34ull, 0x936b9fcebb25c995ull }, { 0x3d5d514f40eea742ull, 0xb84687c269ef3bfbull },
+    { 0xcb4a5a3112a5112ull, 0xe65829b3046b0afaull }, { 0x47f0e785eaba72abull, 0x8ff71a0fe2c2e6dcull },
+    { 0x59ed216765690f56ull, 0xb3f4e093db73a093ull }, { 0x306869c13ec3532cull, 0xe0f218b8d25088b8ull },
+    { 0x1e414218c73a13fbull, 0x8c974f7383725573ull }, { 0xe5d1929ef90898faull, 0xafbd2350644eeacfull },
+    { 0xdf45f746b74abf39ull, 0xdbac6c247d62a583ull }, { 0x6b8bba8c328eb783ull, 0x894bc396ce5da772ull },
+    { 0x66ea92f3f326564ull, 0xab9eb47c81f5114full }, { 0xc80a537b0efefebdull, 0xd686619ba27255a2ull },
+    { 0xbd06742ce95f5f36ull, 0x8613fd0145877585ull }, { 0x2c48113823b73704ull, 0xa798fc4196e952e7ull },
+    { 0xf75a15862ca504c5ull, 0xd17f3b51fca3a7a0ull }, { 0x9a984d73dbe722fbull, 0x82ef85133de648c4ull },
+    { 0xc13e60d0d2e0ebbaull, 0xa3ab66580d5fdaf5ull }, { 0x318df905079926a8ull, 0xcc963fee10b7d1b3ull },
+    { 0xfdf17746497f7052ull, 0xffbbcfe994e5c61full }, { 0xfeb6ea8bedefa633ull, 0x9fd561f1fd0f9bd3ull },
+    { 0xfe64a52ee96b8fc0ull, 0xc7caba6e7c5382c8ull }, { 0x3dfdce7aa3c673b0ull, 0xf9bd690a1b68637bull },
+    { 0x6bea10ca65c084eull, 0x9c1661a651213e2dull }, { 0x486e494fcff30a62ull, 0xc31bfa0fe5698db8ull },
+    { 0x5a89dba3c3efccfaull, 0xf3e2f893dec3f126ull }, { 0xf89629465a75e01cull, 0x986ddb5c6b3a76b7ull },
+    { 0xf6bbb397f1135823ull, 0xbe89523386091465ull }, { 0x746aa07ded582e2cull, 0xee2ba6c0678b597full },
+    { 0xa8c2a44eb4571cdcull, 0x94db483840b717efull }, { 0x92f34d62616ce413ull, 0xba121a4650e4ddebull },
+    { 0x77b020baf9c81d17ull, 0xe896a0d7e51e1566ull }, { 0xace1474dc1d122eull, 0x915e2486ef32cd60ull },
+    { 0xd819992132456baull, 0xb5b5ada8aaff80b8ull }, { 0x10e1fff697ed6c69ull, 0xe3231912d5bf60e6ull },
+    { 0xca8d3ffa1ef463c1ull, 0x8df5efabc5979c8full }, { 0xbd308ff8a6b17cb2ull, 0xb1736b96b6fd83b3ull },
+    { 0xac7cb3f6d05ddbdeull, 0xddd0467c64bce4a0ull }, { 0x6bcdf07a423aa96bull, 0x8aa22c0dbef60ee4ull },
+    { 0x86c16c98d2c953c6ull, 0xad4ab7112eb3929dull }, { 0xe871c7bf077ba8b7ull, 0xd89d64d57a607744ull },
+    { 0x11471cd764ad4972ull, 0x87625f056c7c4a8bull }, { 0xd598e40d3dd89bcfull, 0xa93af6c6c79b5d2dull },
+    { 0x4aff1d108d4ec2c3ull, 0xd389b47879823479ull }, { 0xcedf722a585139baull, 0x843610cb4bf160cbull },
+    { 0xc2974eb4ee658828ull, 0xa54394fe1eedb8feull }, { 0x733d226229feea32ull, 0xce947a3da6a9273eull },
+    { 0x806357d5a3f525full, 0x811ccc668829b887ull }, { 0xca07c2dcb0cf26f7ull, 0xa163ff802a3426a8ull },
+    { 0xfc89b393dd02f0b5ull, 0xc9bcff6034c13052ull }, { 0xbbac2078d443ace2ull, 0xfc2c3f3841f17c67ull },
+    { 0xd54b944b84aa4c0dull, 0x9d9ba7832936edc0ull }, { 0xa9e795e65d4df11ull, 0xc5029163f384a931ull },
+    { 0x4d4617b5ff4a16d5ull, 0xf64335bcf065d37dull }, { 0x504bced1bf8e4e45ull, 0x99ea0196163fa42eull },
+    { 0xe45ec2862f71e1d6ull, 0xc06481fb9bcf8d39ull }, { 0x5d767327bb4e5a4cull, 0xf07da27a82c37088ull },
+    { 0x3a6a07f8d510f86full, 0x964e858c91ba2655ull }, { 0x890489f70a55368bull, 0xbbe226efb628afeaull },
+    { 0x2b45ac74ccea842eull, 0xeadab0aba3b2dbe5ull }, { 0x3b0b8bc90012929dull, 0x92c8ae6b464fc96full },
+    { 0x9ce6ebb40173744ull, 0xb77ada0617e3bbcbull }, { 0xcc420a6a101d0515ull, 0xe55990879ddcaabdull },
+    { 0x9fa946824a12232dull, 0x8f57fa54c2a9eab6ull }, { 0x47939822dc96abf9ull, 0xb32df8e9f3546564ull },
+    { 0x59787e2b93bc56f7ull, 0xdff9772470297ebdull }, { 0x57eb4edb3c55b65aull, 0x8bfbea76c619ef36ull },
+    { 0xede622920b6b23f1ull, 0xaefae51477a06b03ull }, { 0xe95fab368e45ecedull, 0xdab99e59958885c4ull },
+    { 0x11dbcb0218ebb414ull, 0x88b402f7fd75539bull }, { 0xd652bdc29f26a119ull, 0xaae103b5fcd2a881ull },
+    { 0x4be76d3346f0495full, 0xd59944a37c0752a2ull }, { 0x6f70a4400c562ddbull, 0x857fcae62d8493a5ull },
+    { 0xcb4ccd500f6bb952ull, 0xa6dfbd9fb8e5b88eull }, { 0x7e2000a41346a7a7ull, 0xd097ad07a71f26b2ull },
+    { 0x8ed400668c0c28c8ull, 0x825ecc24c873782full }, { 0x728900802f0f32faull, 0xa2f67f2dfa90563bull },
+    { 0x4f2b40a03ad2ffb9ull, 0xcbb41ef979346bcaull }, { 0xe2f610c84987bfa8ull, 0xfea126b7d78186bcull },
+    { 0xdd9ca7d2df4d7c9ull, 0x9f24b832e6b0f436ull }, { 0x91503d1c79720dbbull, 0xc6ede63fa05d3143ull },
+    { 0x75a44c6397ce912aull, 0xf8a95fcf88747d94ull }, { 0xc986afbe3ee11abaull, 0x9b69dbe1b548ce7cull },
+    { 0xfbe85badce996168ull, 0xc24452da229b021bull }, { 0xfae27299423fb9c3ull, 0xf2d56790ab41c2a2ull },
+    { 0xdccd879fc967d41aull, 0x97c560ba6b0919a5ull }, { 0x5400e987bbc1c920ull, 0xbdb6b8e905cb600full },
+    { 0x290123e9aab23b68ull, 0xed246723473e3813ull }, { 0xf9a0b6720aaf6521ull, 0x9436c0760c86e30bull },
+    { 0xf808e40e8d5b3e69ull, 0xb94470938fa89bceull }, { 0xb60b1d1230b20e04ull, 0xe7958cb87392c2c2ull },
+    { 0xb1c6f22b5e6f48c2ull, 0x90bd77f3483bb9b9ull }, { 0x1e38aeb6360b1af3ull, 0xb4ecd5f01a4aa828ull },
+    { 0x25c6da63c38de1b0ull, 0xe2280b6c20dd5232ull }, { 0x579c487e5a38ad0eull, 0x8d590723948a535full },
+    { 0x2d835a9df0c6d851ull, 0xb0af48ec79ace837ull }, { 0xf8e431456cf88e65ull, 0xdcdb1b2798182244ull },
+    { 0x1b8e9ecb641b58ffull, 0x8a08f0f8bf0f156bull }, { 0xe272467e3d222f3full, 0xac8b2d36eed2dac5ull },
+    { 0x5b0ed81dcc6abb0full, 0xd7adf884aa879177ull }, { 0x98e947129fc2b4e9ull, 0x86ccbb52ea94baeaull },
+    { 0x3f2398d747b36224ull, 0xa87fea27a539e9a5ull }, { 0x8eec7f0d19a03aadull, 0xd29fe4b18e88640eull },
+    { 0x1953cf68300424acull, 0x83a3eeeef9153e89ull }, { 0x5fa8c3423c052dd7ull, 0xa48ceaaab75a8e2bull },
+    { 0x3792f412cb06794dull, 0xcdb02555653131b6ull }, { 0xe2bbd88bbee40bd0ull, 0x808e17555f3ebf11ull },
+    { 0x5b6aceaeae9d0ec4ull, 0xa0b19d2ab70e6ed6ull }, { 0xf245825a5a445275ull, 0xc8de047564d20a8bull },
+    { 0xeed6e2f0f0d56712ull, 0xfb158592be068d2eull }, { 0x55464dd69685606bull, 0x9ced737bb6c4183dull },
+    { 0xaa97e14c3c26b886ull, 0xc428d05aa4751e4cull }, { 0xd53dd99f4b3066a8ull, 0xf53304714d9265dfull },
+    { 0xe546a8038efe4029ull, 0x993fe2c6d07b7fabull }, { 0xde98520472bdd033ull, 0xbf8fdb78849a5f96ull },
+    { 0x963e66858f6d4440ull, 0xef73d256a5c0f77cull }, { 0xdde7001379a44aa8ull, 0x95a8637627989aadull },
+    { 0x5560c018580d5d52ull, 0xbb127c53b17ec159ull }, { 0xaab8f01e6e10b4a6ull, 0xe9d71b689dde71afull },
+    { 0xcab3961304ca70e8ull, 0x9226712162ab070dull }, { 0x3d607b97c5fd0d22ull, 0xb6b00d69bb55c8d1ull },
+    { 0x8cb89a7db77c506aull, 0xe45c10c42a2b3b05ull }, { 0x77f3608e92adb242ull, 0x8eb98a7a9a5b04e3ull },
+    { 0x55f038b237591ed3ull, 0xb267ed1940f1c61cull }, { 0x6b6c46dec52f6688ull, 0xdf01e85f912e37a3ull },
+    { 0x2323ac4b3b3da015ull, 0x8b61313bbabce2c6ull }, { 0xabec975e0a0d081aull, 0xae397d8aa96c1b77ull },
+    { 0x96e7bd358c904a21ull, 0xd9c7dced53c72255ull }, { 0x7e50d64177da2e54ull, 0x881cea14545c7575ull },
+    { 0xdde50bd1d5d0b9e9ull, 0xaa242499697392d2ull }, { 0x955e4ec64b44e864ull, 0xd4ad2dbfc3d07787ull },
+    { 0xbd5af13bef0b113eull, 0x84ec3c97da624ab4ull }, { 0xecb1ad8aeacdd58eull, 0xa6274bbdd0fadd61ull },
+    { 0x67de18eda5814af2ull, 0xcfb11ead453994baull }, { 0x80eacf948770ced7ull, 0x81ceb32c4b43fcf4ull },
+    { 0xa1258379a94d028dull, 0xa2425ff75e14fc31ull }, { 0x96ee45813a04330ull, 0xcad2f7f5359a3b3eull },
+    { 0x8bca9d6e188853fcull, 0xfd87b5f28300ca0dull }, { 0x775ea264cf55347dull, 0x9e74d1b791e07e48ull },
+    { 0x95364afe032a819dull, 0xc612062576589ddaull }, { 0x3a83ddbd83f52204ull, 0xf79687aed3eec551ull },
+    { 0xc4926a9672793542ull, 0x9abe14cd44753b52ull }, { 0x75b7053c0f178293ull, 0xc16d9a0095928a27ull },
+    { 0x5324c68b12dd6338ull, 0xf1c90080baf72cb1ull }, { 0xd3f6fc16ebca5e03ull, 0x971da05074da7beeull },
+    { 0x88f4bb1ca6bcf584ull, 0xbce5086492111aeaull }, { 0x2b31e9e3d06c32e5ull, 0xec1e4a7db69561a5ull },
+    { 0x3aff322e62439fcfull, 0x9392ee8e921d5d07ull }, { 0x9befeb9fad487c2ull, 0xb877aa3236a4b449ull },
+    { 0x4c2ebe687989a9b3ull, 0xe69594bec44de15bull }, { 0xf9d37014bf60a10ull, 0x901d7cf73ab0acd9ull },
+    { 0x538484c19ef38c94ull, 0xb424dc35095cd80full }, { 0x2865a5f206b06fb9ull, 0xe12e13424bb40e13ull },
+    { 0xf93f87b7442e45d3ull, 0x8cbccc096f5088cbull }, { 0xf78f69a51539d748ull, 0xafebff0bcb24aafeull },
+    { 0xb573440e5a884d1bull, 0xdbe6fecebdedd5beull }, { 0x31680a88f8953030ull, 0x89705f4136b4a597ull },
+    { 0xfdc20d2b36ba7c3dull, 0xabcc77118461cefcull }, { 0x3d32907604691b4cull, 0xd6bf94d5e57a42bcull },
+    { 0xa63f9a49c2c1b10full, 0x8637bd05af6c69b5ull }, { 0xfcf80dc33721d53ull, 0xa7c5ac471b478423ull },
+    { 0xd3c36113404ea4a8ull, 0xd1b71758e219652bull }, { 0x645a1cac083126e9ull, 0x83126e978d4fdf3bull },
+    { 0x3d70a3d70a3d70a3ull, 0xa3d70a3d70a3d70aull }, { 0xccccccccccccccccull, 0xccccccccccccccccull },
+    { 0x0ull, 0x8000000000000000ull }, { 0x0ull, 0xa000000000000000ull },
+    { 0x0ull, 0xc800000000000000ull }, { 0x0ull, 0xfa00000000000000ull },
+    { 0x0ull, 0x9c40000000000000ull }, { 0x0ull, 0xc350000000000000ull },
+    { 0x0ull, 0xf424000000000000ull }, { 0x0ull, 0x9896800000000000ull },
+    { 0x0ull, 0xbebc200000000000ull }, { 0x0ull, 0xee6b280000000000ull },
+    { 0x0ull, 0x9502f90000000000ull }, { 0x0ull, 0xba43b74000000000ull },
+    { 0x0ull, 0xe8d4a51000000000ull }, { 0x0ull, 0x9184e72a00000000ull },
+    { 0x0ull, 0xb5e620f480000000ull }, { 0x0ull, 0xe35fa931a0000000ull },
+    { 0x0ull, 0x8e1bc9bf04000000ull }, { 0x0ull, 0xb1a2bc2ec5000000ull },
+    { 0x0ull, 0xde0b6b3a76400000ull }, { 0x0ull, 0x8ac7230489e80000ull },
+    { 0x0ull, 0xad78ebc5ac620000ull }, { 0x0ull, 0xd8d726b7177a8000ull },
+    { 0x0ull, 0x878678326eac9000ull }, { 0x0ull, 0xa968163f0a57b400ull },
+    { 0x0ull, 0xd3c21bcecceda100ull }, { 0x0ull, 0x84595161401484a0ull },
+    { 0x0ull, 0xa56fa5b99019a5c8ull }, { 0x0ull, 0xcecb8f27f4200f3aull },
+    { 0x4000000000000000ull, 0x813f3978f8940984ull }, { 0x5000000000000000ull, 0xa18f07d736b90be5ull },
+    { 0xa400000000000000ull, 0xc9f2c9cd04674edeull }, { 0x4d00000000000000ull, 0xfc6f7c4045812296ull },
+    { 0xf020000000000000ull, 0x9dc5ada82b70b59dull }, { 0x6c28000000000000ull, 0xc5371912364ce305ull },
+    { 0xc732000000000000ull, 0xf684df56c3e01bc6ull }, { 0x3c7f400000000000ull, 0x9a130b963a6c115cull },
+    { 0x4b9f100000000000ull, 0xc097ce7bc90715b3ull }, { 0x1e86d40000000000ull, 0xf0bdc21abb48db20ull },
+    { 0x1314448000000000ull, 0x96769950b50d88f4ull }, { 0x17d955a000000000ull, 0xbc143fa4e250eb31ull },
+    { 0x5dcfab0800000000ull, 0xeb194f8e1ae525fdull }, { 0x5aa1cae500000000ull, 0x92efd1b8d0cf37beull },
+    { 0xf14a3d9e40000000ull, 0xb7abc627050305adull }, { 0x6d9ccd05d0000000ull, 0xe596b7b0c643c719ull },
+    { 0xe4820023a2000000ull, 0x8f7e32ce7bea5c6full }, { 0xdda2802c8a800000ull, 0xb35dbf821ae4f38bull },
+    { 0xd50b2037ad200000ull, 0xe0352f62a19e306eull }, { 0x4526f422cc340000ull, 0x8c213d9da502de45ull },
+    { 0x9670b12b7f410000ull, 0xaf298d050e4395d6ull }, { 0x3c0cdd765f114000ull, 0xdaf3f04651d47b4cull },
+    { 0xa5880a69fb6ac800ull, 0x88d8762bf324cd0full }, { 0x8eea0d047a457a00ull, 0xab0e93b6efee0053ull },
+    { 0x72a4904598d6d880ull, 0xd5d238a4abe98068ull }, { 0x47a6da2b7f864750ull, 0x85a36366eb71f041ull },
+    { 0x999090b65f67d924ull, 0xa70c3c40a64e6c51ull }, { 0xfff4b4e3f741cf6dull, 0xd0cf4b50cfe20765ull },
+    { 0xbff8f10e7a8921a4ull, 0x82818f1281ed449full }, { 0xaff72d52192b6a0dull, 0xa321f2d7226895c7ull },
+    { 0x9bf4f8a69f764490ull, 0xcbea6f8ceb02bb39ull }, { 0x2f236d04753d5b4ull, 0xfee50b7025c36a08ull },
+    { 0x1d762422c946590ull, 0x9f4f2726179a2245ull }, { 0x424d3ad2b7b97ef5ull, 0xc722f0ef9d80aad6ull },
+    { 0xd2e0898765a7deb2ull, 0xf8ebad2b84e0d58bull }, { 0x63cc55f49f88eb2full, 0x9b934c3b330c8577ull },
+    { 0x3cbf6b71c76b25fbull, 0xc2781f49ffcfa6d5ull }, { 0x8bef464e3945ef7aull, 0xf316271c7fc3908aull },
+    { 0x97758bf0e3cbb5acull, 0x97edd871cfda3a56ull }, { 0x3d52eeed1cbea317ull, 0xbde94e8e43d0c8ecull },
+    { 0x4ca7aaa863ee4bddull, 0xed63a231d4c4fb27ull }, { 0x8fe8caa93e74ef6aull, 0x945e455f24fb1cf8ull },
+    { 0xb3e2fd538e122b44ull, 0xb975d6b6ee39e436ull }, { 0x60dbbca87196b616ull, 0xe7d34c64a9c85d44ull },
+    { 0xbc8955e946fe31cdull, 0x90e40fbeea1d3a4aull }, { 0x6babab6398bdbe41ull, 0xb51d13aea4a488ddull },
+    { 0xc696963c7eed2dd1ull, 0xe264589a4dcdab14ull }, { 0xfc1e1de5cf543ca2ull, 0x8d7eb76070a08aecull },
+    { 0x3b25a55f43294bcbull, 0xb0de65388cc8ada8ull }, { 0x49ef0eb713f39ebeull, 0xdd15fe86affad912ull },
+    { 0x6e3569326c784337ull, 0x8a2dbf142dfcc7abull }, { 0x49c2c37f07965404ull, 0xacb92ed9397bf996ull },
+    { 0xdc33745ec97be906ull, 0xd7e77a8f87daf7fbull }, { 0x69a028bb3ded71a3ull, 0x86f0ac99b4e8dafdull },
+    { 0xc40832ea0d68ce0cull, 0xa8acd7c0222311bcull }, { 0xf50a3fa490c30190ull, 0xd2d80db02aabd62bull },
+    { 0x792667c6da79e0faull, 0x83c7088e1aab65dbull }, { 0x577001b891185938ull, 0xa4b8cab1a1563f52ull },
+    { 0xed4c0226b55e6f86ull, 0xcde6fd5e09abcf26ull }, { 0x544f8158315b05b4ull, 0x80b05e5ac60b6178ull },
+    { 0x696361ae3db1c721ull, 0xa0dc75f1778e39d6ull }, { 0x3bc3a19cd1e38e9ull, 0xc913936dd571c84cull },
+    { 0x4ab48a04065c723ull, 0xfb5878494ace3a5full }, { 0x62eb0d64283f9c76ull, 0x9d174b2dcec0e47bull },
+    { 0x3ba5d0bd324f8394ull, 0xc45d1df942711d9aull }, { 0xca8f44ec7ee36479ull, 0xf5746577930d6500ull },
+    { 0x7e998b13cf4e1ecbull, 0x9968bf6abbe85f20ull }, { 0x9e3fedd8c321a67eull, 0xbfc2ef456ae276e8ull },
+    { 0xc5cfe94ef3ea101eull, 0xefb3ab16c59b14a2ull }, { 0xbba1f1d158724a12ull, 0x95d04aee3b80ece5ull },
+    { 0x2a8a6e45ae8edc97ull, 0xbb445da9ca61281full }, { 0xf52d09d71a3293bdull, 0xea1575143cf97226ull },
+    { 0x593c2626705f9c56ull, 0x924d692ca61be758ull }, { 0x6f8b2fb00c77836cull, 0xb6e0c377cfa2e12eull },
+    { 0xb6dfb9c0f956447ull, 0xe498f455c38b997aull }, { 0x4724bd4189bd5eacull, 0x8edf98b59a373fecull },
+    { 0x58edec91ec2cb657ull, 0xb2977ee300c50fe7ull }, { 0x2f2967b66737e3edull, 0xdf3d5e9bc0f653e1ull },
+    { 0xbd79e0d20082ee74ull, 0x8b865b215899f46cull }, { 0xecd8590680a3aa11ull, 0xae67f1e9aec07187ull },
+    { 0xe80e6f4820cc9495ull, 0xda01ee641a708de9ull }, { 0x3109058d147fdcddull, 0x884134fe908658b2ull },
+    { 0xbd4b46f0599fd415ull, 0xaa51823e34a7eedeull }, { 0x6c9e18ac7007c91aull, 0xd4e5e2cdc1d1ea96ull },
+    { 0x3e2cf6bc604ddb0ull, 0x850fadc09923329eull }, { 0x84db8346b786151cull, 0xa6539930bf6bff45ull },
+    { 0xe612641865679a63ull, 0xcfe87f7cef46ff16ull }, { 0x4fcb7e8f3f60c07eull, 0x81f14fae158c5f6eull },
+    { 0xe3be5e330f38f09dull, 0xa26da3999aef7749ull }, { 0x5cadf5bfd3072cc5ull, 0xcb090c8001ab551cull },
+    { 0x73d9732fc7c8f7f6ull, 0xfdcb4fa002162a63ull }, { 0x2867e7fddcdd9afaull, 0x9e9f11c4014dda7eull },
+    { 0xb281e1fd541501b8ull, 0xc646d63501a1511dull }, { 0x1f225a7ca91a4226ull, 0xf7d88bc24209a565ull },
+    { 0x3375788de9b06958ull, 0x9ae757596946075full }, { 0x52d6b1641c83aeull, 0xc1a12d2fc3978937ull },
+    { 0xc0678c5dbd23a49aull, 0xf209787bb47d6b84ull }, { 0xf840b7ba963646e0ull, 0x9745eb4d50ce6332ull },
+    { 0xb650e5a93bc3d898ull, 0xbd176620a501fbffull }, { 0xa3e51f138ab4cebeull, 0xec5d3fa8ce427affull },
+    { 0xc66f336c36b10137ull, 0x93ba47c980e98cdfull }, { 0xb80b0047445d4184ull, 0xb8a8d9bbe123f017ull },
+    { 0xa60dc059157491e5ull, 0xe6d3102ad96cec1dull }, { 0x87c89837ad68db2full, 0x9043ea1ac7e41392ull },
+    { 0x29babe4598c311fbull, 0xb454e4a179dd1877ull }, { 0xf4296dd6fef3d67aull, 0xe16a1dc9d8545e94ull },
+    { 0x1899e4a65f58660cull, 0x8ce2529e2734bb1dull }, { 0x5ec05dcff72e7f8full, 0xb01ae745b101e9e4ull },
+    { 0x76707543f4fa1f73ull, 0xdc21a1171d42645dull }, { 0x6a06494a791c53a8ull, 0x899504ae72497ebaull },
+    { 0x487db9d17636892ull, 0xabfa45da0edbde69ull }, { 0x45a9d2845d3c42b6ull, 0xd6f8d7509292d603ull },
+    { 0xb8a2392ba45a9b2ull, 0x865b86925b9bc5c2ull }, { 0x8e6cac7768d7141eull, 0xa7f26836f282b732ull },
+    { 0x3207d795430cd926ull, 0xd1ef0244af2364ffull }, { 0x7f44e6bd49e807b8ull, 0x8335616aed761f1full },
+    { 0x5f16206c9c6209a6ull, 0xa402b9c5a8d3a6e7ull }, { 0x36dba887c37a8c0full, 0xcd036837130890a1ull },
+    { 0xc2494954da2c9789ull, 0x802221226be55a64ull }, { 0xf2db9baa10b7bd6cull, 0xa02aa96b06deb0fdull },
+    { 0x6f92829494e5acc7ull, 0xc83553c5c8965d3dull }, { 0xcb772339ba1f17f9ull, 0xfa42a8b73abbf48cull },
+    { 0xff2a760414536efbull, 0x9c69a97284b578d7ull }, { 0xfef5138519684abaull, 0xc38413cf25e2d70dull },
+    { 0x7eb258665fc25d69ull, 0xf46518c2ef5b8cd1ull }, { 0xef2f773ffbd97a61ull, 0x98bf2f79d5993802ull },
+    { 0xaafb550ffacfd8faull, 0xbeeefb584aff8603ull }, { 0x95ba2a53f983cf38ull, 0xeeaaba2e5dbf6784ull },
+    { 0xdd945a747bf26183ull, 0x952ab45cfa97a0b2ull }, { 0x94f971119aeef9e4ull, 0xba756174393d88dfull },
+    { 0x7a37cd5601aab85dull, 0xe912b9d1478ceb17ull }, { 0xac62e055c10ab33aull, 0x91abb422ccb812eeull },
+    { 0x577b986b314d6009ull, 0xb616a12b7fe617aaull }, { 0xed5a7e85fda0b80bull, 0xe39c49765fdf9d94ull },
+    { 0x14588f13be847307ull, 0x8e41ade9fbebc27dull }, { 0x596eb2d8ae258fc8ull, 0xb1d219647ae6b31cull },
+    { 0x6fca5f8ed9aef3bbull, 0xde469fbd99a05fe3ull }, { 0x25de7bb9480d5854ull, 0x8aec23d680043beeull },
+    { 0xaf561aa79a10ae6aull, 0xada72ccc20054ae9ull }, { 0x1b2ba1518094da04ull, 0xd910f7ff28069da4ull },
+    { 0x90fb44d2f05d0842ull, 0x87aa9aff79042286ull }, { 0x353a1607ac744a53ull, 0xa99541bf57452b28ull },
+    { 0x42889b8997915ce8ull, 0xd3fa922f2d1675f2ull }, { 0x69956135febada11ull, 0x847c9b5d7c2e09b7ull },
+    { 0x43fab9837e699095ull, 0xa59bc234db398c25ull }, { 0x94f967e45e03f4bbull, 0xcf02b2c21207ef2eull },
+    { 0x1d1be0eebac278f5ull, 0x8161afb94b44f57dull }, { 0x6462d92a69731732ull, 0xa1ba1ba79e1632dcull },
+    { 0x7d7b8f7503cfdcfeull, 0xca28a291859bbf93ull }, { 0x5cda735244c3d43eull, 0xfcb2cb35e702af78ull },
+    { 0x3a0888136afa64a7ull, 0x9defbf01b061adabull }, { 0x88aaa1845b8fdd0ull, 0xc56baec21c7a1916ull },
+    { 0x8aad549e57273d45ull, 0xf6c69a72a3989f5bull }, { 0x36ac54e2f678864bull, 0x9a3c2087a63f6399ull },
+    { 0x84576a1bb416a7ddull, 0xc0cb28a98fcf3c7full }, { 0x656d44a2a11c51d5ull, 0xf0fdf2d3f3c30b9full },
+    { 0x9f644ae5a4b1b325ull, 0x969eb7c47859e743ull }, { 0x873d5d9f0dde1feeull, 0xbc4665b596706114ull },
+    { 0xa90cb506d155a7eaull, 0xeb57ff22fc0c7959ull }, { 0x9a7f12442d588f2ull, 0x9316ff75dd87cbd8ull },
+    { 0xc11ed6d538aeb2full, 0xb7dcbf5354e9beceull }, { 0x8f1668c8a86da5faull, 0xe5d3ef282a242e81ull },
+    { 0xf96e017d694487bcull, 0x8fa475791a569d10ull }, { 0x37c981dcc395a9acull, 0xb38d92d760ec4455ull },
+    { 0x85bbe253f47b1417ull, 0xe070f78d3927556aull }, { 0x93956d7478ccec8eull, 0x8c469ab843b89562ull },
+    { 0x387ac8d1970027b2ull, 0xaf58416654a6babbull }, { 0x6997b05fcc0319eull, 0xdb2e51bfe9d0696aull },
+    { 0x441fece3bdf81f03ull, 0x88fcf317f22241e2ull }, { 0xd527e81cad7626c3ull, 0xab3c2fddeeaad25aull },
+    { 0x8a71e223d8d3b074ull, 0xd60b3bd56a5586f1ull }, { 0xf6872d5667844e49ull, 0x85c7056562757456ull },
+    { 0xb428f8ac016561dbull, 0xa738c6bebb12d16cull }, { 0xe13336d701beba52ull, 0xd106f86e69d785c7ull },
+    { 0xecc0024661173473ull, 0x82a45b450226b39cull }, { 0x27f002d7f95d0190ull, 0xa34d721642b06084ull },
+    { 0x31ec038df7b441f4ull, 0xcc20ce9bd35c78a5ull }, { 0x7e67047175a15271ull, 0xff290242c83396ceull },
+    { 0xf0062c6e984d386ull, 0x9f79a169bd203e41ull }, { 0x52c07b78a3e60868ull, 0xc75809c42c684dd1ull },
+    { 0xa7709a56ccdf8a82ull, 0xf92e0c3537826145ull }, { 0x88a66076400bb691ull, 0x9bbcc7a142b17ccbull },
+    { 0x6acff893d00ea435ull, 0xc2abf989935ddbfeull }, { 0x583f6b8c4124d43ull, 0xf356f7ebf83552feull },
+    { 0xc3727a337a8b704aull, 0x98165af37b2153deull }, { 0x744f18c0592e4c5cull, 0xbe1bf1b059e9a8d6ull },
+    { 0x1162def06f79df73ull, 0xeda2ee1c7064130cull }, { 0x8addcb5645ac2ba8ull, 0x9485d4d1c63e8be7ull },
+    { 0x6d953e2bd7173692ull, 0xb9a74a0637ce2ee1ull }, { 0xc8fa8db6ccdd0437ull, 0xe8111c87c5c1ba99ull },
+    { 0x1d9c9892400a22a2ull, 0x910ab1d4db9914a0ull }, { 0x2503beb6d00cab4bull, 0xb54d5e4a127f59c8ull },
+    { 0x2e44ae64840fd61dull, 0xe2a0b5dc971f303aull }, { 0x5ceaecfed289e5d2ull, 0x8da471a9de737e24ull },
+    { 0x7425a83e872c5f47ull, 0xb10d8e1456105dadull }, { 0xd12f124e28f77719ull, 0xdd50f1996b947518ull },
+    { 0x82bd6b70d99aaa6full, 0x8a5296ffe33cc92full }, { 0x636cc64d1001550bull, 0xace73cbfdc0bfb7bull },
+    { 0x3c47f7e05401aa4eull, 0xd8210befd30efa5aull }, { 0x65acfaec34810a71ull, 0x8714a775e3e95c78ull },
+    { 0x7f1839a741a14d0dull, 0xa8d9d1535ce3b396ull }, { 0x1ede48111209a050ull, 0xd31045a8341ca07cull },
+    { 0x934aed0aab460432ull, 0x83ea2b892091e44dull }, { 0xf81da84d5617853full, 0xa4e4b66b68b65d60ull },
+    { 0x36251260ab9d668eull, 0xce1de40642e3f4b9ull }, { 0xc1d72b7c6b426019ull, 0x80d2ae83e9ce78f3ull },
+    { 0xb24cf65b8612f81full, 0xa1075a24e4421730ull }, { 0xdee033f26797b627ull, 0xc94930ae1d529cfcull },
+    { 0x169840ef017da3b1ull, 0xfb9b7cd9a4a7443cull }, { 0x8e1f289560ee864eull, 0x9d412e0806e88aa5ull },
+    { 0xf1a6f2bab92a27e2ull, 0xc491798a08a2ad4eull }, { 0xae10af696774b1dbull, 0xf5b5d7ec8acb58a2ull },
+    { 0xacca6da1e0a8ef29ull, 0x9991a6f3d6bf1765ull }, { 0x17fd090a58d32af3ull, 0xbff610b0cc6edd3full },
+    { 0xddfc4b4cef07f5b0ull, 0xeff394dcff8a948eull }, { 0x4abdaf101564f98eull, 0x95f83d0a1fb69cd9ull },
+    { 0x9d6d1ad41abe37f1ull, 0xbb764c4ca7a4440full }, { 0x84c86189216dc5edull, 0xea53df5fd18d5513ull },
+    { 0x32fd3cf5b4e49bb4ull, 0x92746b9be2f8552cull }, { 0x3fbc8c33221dc2a1ull, 0xb7118682dbb66a77ull },
+    { 0xfabaf3feaa5334aull, 0xe4d5e82392a40515ull }, { 0x29cb4d87f2a7400eull, 0x8f05b1163ba6832dull },
+    { 0x743e20e9ef511012ull, 0xb2c71d5bca9023f8ull }, { 0x914da9246b255416ull, 0xdf78e4b2bd342cf6ull },
+    { 0x1ad089b6c2f7548eull, 0x8bab8eefb6409c1aull }, { 0xa184ac2473b529b1ull, 0xae9672aba3d0c320ull },
+    { 0xc9e5d72d90a2741eull, 0xda3c0f568cc4f3e8ull }, { 0x7e2fa67c7a658892ull, 0x8865899617fb1871ull },
+    { 0xddbb901b98feeab7ull, 0xaa7eebfb9df9de8dull }, { 0x552a74227f3ea565ull, 0xd51ea6fa85785631ull },
+    { 0xd53a88958f87275full, 0x8533285c936b35deull }, { 0x8a892abaf368f137ull, 0xa67ff273b8460356ull },
+    { 0x2d2b7569b0432d85ull, 0xd01fef10a657842cull }, { 0x9c3b29620e29fc73ull, 0x8213f56a67f6b29bull },
+    { 0x8349f3ba91b47b8full, 0xa298f2c501f45f42ull }, { 0x241c70a936219a73ull, 0xcb3f2f7642717713ull },
+    { 0xed238cd383aa0110ull, 0xfe0efb53d30dd4d7ull }, { 0xf4363804324a40aaull, 0x9ec95d1463e8a506ull },
+    { 0xb143c6053edcd0d5ull, 0xc67bb4597ce2ce48ull }, { 0xdd94b7868e94050aull, 0xf81aa16fdc1b81daull },
+    { 0xca7cf2b4191c8326ull, 0x9b10a4e5e9913128ull }, { 0xfd1c2f611f63a3f0ull, 0xc1d4ce1f63f57d72ull },
+    { 0xbc633b39673c8cecull, 0xf24a01a73cf2dccfull }, { 0xd5be0503e085d813ull, 0x976e41088617ca01ull },
+    { 0x4b2d8644d8a74e18ull, 0xbd49d14aa79dbc82ull }, { 0xddf8e7d60ed1219eull, 0xec9c459d51852ba2ull },
+    { 0xcabb90e5c942b503ull, 0x93e1ab8252f33b45ull }, { 0x3d6a751f3b936243ull, 0xb8da1662e7b00a17ull },
+    { 0xcc512670a783ad4ull, 0xe7109bfba19c0c9dull }, { 0x27fb2b80668b24c5ull, 0x906a617d450187e2ull },
+    { 0xb1f9f660802dedf6ull, 0xb484f9dc9641e9daull }, { 0x5e7873f8a0396973ull, 0xe1a63853bbd26451ull },
+    { 0xdb0b487b6423e1e8ull, 0x8d07e33455637eb2ull }, { 0x91ce1a9a3d2cda62ull, 0xb049dc016abc5e5full },
+    { 0x7641a140cc7810fbull, 0xdc5c5301c56b75f7ull }, { 0xa9e904c87fcb0a9dull, 0x89b9b3e11b6329baull },
+    { 0x546345fa9fbdcd44ull, 0xac2820d9623bf429ull }, { 0xa97c177947ad4095ull, 0xd732290fbacaf133ull },
+    { 0x49ed8eabcccc485dull, 0x867f59a9d4bed6c0ull }, { 0x5c68f256bfff5a74ull, 0xa81f301449ee8c70ull },
+    { 0x73832eec6fff3111ull, 0xd226fc195c6a2f8cull }, { 0xc831fd53c5ff7eabull, 0x83585d8fd9c25db7ull },
+    { 0xba3e7ca8b77f5e55ull, 0xa42e74f3d032f525ull }, { 0x28ce1bd2e55f35ebull, 0xcd3a1230c43fb26full },
+    { 0x7980d163cf5b81b3ull, 0x80444b5e7aa7cf85ull }, { 0xd7e105bcc332621full, 0xa0555e361951c366ull },
+    { 0x8dd9472bf3fefaa7ull, 0xc86ab5c39fa63440ull }, { 0xb14f98f6f0feb951ull, 0xfa856334878fc150ull },
+    { 0x6ed1bf9a569f33d3ull, 0x9c935e00d4b9d8d2ull }, { 0xa862f80ec4700c8ull, 0xc3b8358109e84f07ull },
+    { 0xcd27bb612758c0faull, 0xf4a642e14c6262c8ull }, { 0x8038d51cb897789cull, 0x98e7e9cccfbd7dbdull },
+    { 0xe0470a63e6bd56c3ull, 0xbf21e44003acdd2cull }, { 0x1858ccfce06cac74ull, 0xeeea5d5004981478ull },
+    { 0xf37801e0c43ebc8ull, 0x95527a5202df0ccbull }, { 0xd30560258f54e6baull, 0xbaa718e68396cffdull },
+    { 0x47c6b82ef32a2069ull, 0xe950df20247c83fdull }, { 0x4cdc331d57fa5441ull, 0x91d28b7416cdd27eull },
+    { 0xe0133fe4adf8e952ull, 0xb6472e511c81471dull }, { 0x58180fddd97723a6ull, 0xe3d8f9e563a198e5ull },
+    { 0x570f09eaa7ea7648ull, 0x8e679c2f5e44ff8full }, { 0x2cd2cc6551e513daull, 0xb201833b35d63f73ull },
+    { 0xf8077f7ea65e58d1ull, 0xde81e40a034bcf4full }, { 0xfb04afaf27faf782ull, 0x8b112e86420f6191ull },
+    { 0x79c5db9af1f9b563ull, 0xadd57a27d29339f6ull }, { 0x18375281ae7822bcull, 0xd94ad8b1c7380874ull },
+    { 0x8f2293910d0b15b5ull, 0x87cec76f1c830548ull }, { 0xb2eb3875504ddb22ull, 0xa9c2794ae3a3c69aull },
+    { 0x5fa60692a46151ebull, 0xd433179d9c8cb841ull }, { 0xdbc7c41ba6bcd333ull, 0x849feec281d7f328ull },
+    { 0x12b9b522906c0800ull, 0xa5c7ea73224deff3ull }, { 0xd768226b34870a00ull, 0xcf39e50feae16befull },
+    { 0xe6a1158300d46640ull, 0x81842f29f2cce375ull }, { 0x60495ae3c1097fd0ull, 0xa1e53af46f801c53ull },
+    { 0x385bb19cb14bdfc4ull, 0xca5e89b18b602368ull }, { 0x46729e03dd9ed7b5ull, 0xfcf62c1dee382c42ull },
+    { 0x6c07a2c26a8346d1ull, 0x9e19db92b4e31ba9ull }, { 0xc7098b7305241885ull, 0xc5a05277621be293ull },
+    { 0xb8cbee4fc66d1ea7ull, 0xf70867153aa2db38ull }, { 0x737f74f1dc043328ull, 0x9a65406d44a5c903ull },
+    { 0x505f522e53053ff2ull, 0xc0fe908895cf3b44ull }, { 0x647726b9e7c68fefull, 0xf13e34aabb430a15ull },
+    { 0x5eca783430dc19f5ull, 0x96c6e0eab509e64dull }, { 0xb67d16413d132072ull, 0xbc789925624c5fe0ull },
+    { 0xe41c5bd18c57e88full, 0xeb96bf6ebadf77d8ull }, { 0x8e91b962f7b6f159ull, 0x933e37a534cbaae7ull },
+    { 0x723627bbb5a4adb0ull, 0xb80dc58e81fe95a1ull }, { 0xcec3b1aaa30dd91cull, 0xe61136f2227e3b09ull },
+    { 0x213a4f0aa5e8a7b1ull, 0x8fcac257558ee4e6ull }, { 0xa988e2cd4f62d19dull, 0xb3bd72ed2af29e1full },
+    { 0x93eb1b80a33b8605ull, 0xe0accfa875af45a7ull }, { 0xbc72f130660533c3ull, 0x8c6c01c9498d8b88ull },
+    { 0xeb8fad7c7f8680b4ull, 0xaf87023b9bf0ee6aull }, { 0xa67398db9f6820e1ull, 0xdb68c2ca82ed2a05ull },
+    { 0x88083f8943a1148cull, 0x892179be91d43a43ull }, { 0x6a0a4f6b948959b0ull, 0xab69d82e364948d4ull },
+    { 0x848ce34679abb01cull, 0xd6444e39c3db9b09ull }, { 0xf2d80e0c0c0b4e11ull, 0x85eab0e41a6940e5ull },
+    { 0x6f8e118f0f0e2195ull, 0xa7655d1d2103911full }, { 0x4b7195f2d2d1a9fbull, 0xd13eb46469447567ull },
+};
+
+// mantissa * 10^exponent rounded to nearest even, false where the product is too close to a
+// halfway point to round from 128 bits, or outside the normal range
+static bool eiselLemire(uint64_t mantissa, int64_t exponent, bool negative, double *out) {
+    if(exponent < EISEL_LEMIRE_MIN_EXPONENT || exponent > EISEL_LEMIRE_MAX_EXPONENT) return false;
+    const uint64_t *power = eisel_lemire_pow10[exponent - EISEL_LEMIRE_MIN_EXPONENT];
+    int leading = __builtin_clzll(mantissa);
+    mantissa <<= leading;
+    uint64_t exponent2 = (uint64_t)(((217706 * exponent) >> 16) + 64 + 1023) - (uint64_t)leading;
+
+    uint64_t low = mantissa, high = power[1];
+    wyhashMultiply(&low, &high);
+    if((high & 0x1FF) == 0x1FF && low + mantissa < mantissa) {
+        // the low half of the power could still carry into the bits that decide rounding
+        uint64_t extra_low = mantissa, extra_high = power[0];
+        wyhashMultiply(&extra_low, &extra_high);
+        uint64_t merged_low = low + extra_high;
+        uint64_t merged_high = high + (merged_low < low);
+        if((merged_high & 0x1FF) == 0x1FF && merged_low + 1 == 0 && extra_low + mantissa < mantissa) return false;
+        low = merged_low;
+        high = merged_high;
+    }
+
+    uint64_t top = high >> 63;
+    uint64_t bits = high >> (top + 9);
+    exponent2 -= 1 ^ top;
+    if(low == 0 && (high & 0x1FF) == 0 && (bits & 3) == 1) return false; // exactly halfway, maybe
+    bits += bits & 1;
+    bits >>= 1;
+    if(bits >> 53) {
+        bits >>= 1;
+        exponent2++;
+    }
+    if(exponent2 - 1 >= 0x7FF - 1) return false; // subnormal or infinite
+    bits = (exponent2 << 52) | (bits & 0x000FFFFFFFFFFFFFull) | (negative ? 1ull << 63 : 0);
+    memcpy(out, &bits, sizeof *out);
+    return true;
+}
+
+// the same digits as written, without the point and leading zeros, read by strtod
+static double parseDoubleExactly(const char *digits, const char *digits_end, int64_t exponent, bool negative) {
+    char buffer[NUMBER_PARSE_MAX_DIGITS + 32];
+    size_t count = 0;
+    int64_t fraction_digits = 0;
+    bool after_point = false, nonzero_dropped = false;
+    for(const char *c = digits; c < digits_end; c++) {
+        if(*c == '.') {
+            after_point = true;
+            continue;
+        }
+        if(after_point) fraction_digits++;
+        if(count == 0 && *c == '0') continue;
+        if(count < NUMBER_PARSE_MAX_DIGITS) {
+            buffer[count++] = *c;
+        } else {
+            nonzero_dropped |= *c != '0';
+            fraction_digits--;
+        }
+    }
+    if(count == 0) return negative ? -0.0 : 0.0;
+    if(nonzero_dropped) {
+        buffer[count++] = '1';
+        fraction_digits++;
+    }
+    snprintf(buffer + count, sizeof buffer - count, "e%lld", (long long)(exponent - fraction_digits));
+    double value = strtod(buffer, NULL);
+    return negative ? -value : value;
+}
+
+static bool matchesLower(const char *at, const char *end, const char *lower) {
+    size_t length = strlen(lower);
+    if((size_t)(end - at) != length) return false;
+    for(size_t i = 0; i < length; i++) {
+        if((at[i] | 0x20) != lower[i]) return false;
+    }
+    return true;
+}
+
+// digits at *at, eight at a time where possible, kept in mantissa while they fit
+static void scanDigits(const char **at, const char *end, uint64_t *mantissa) {
+    const char *c = *at;
+    uint64_t value = *mantissa;
+    while(end - c >= 8) {
+        uint64_t word = loadEightDigits(c);
+        if(!areEightDigits(word)) break;
+        value = value * 100000000 + parseEightDigits(word);
+        c += 8;
+    }
+    while(c < end && (unsigned char)(*c - '0') <= 9) {
+        value = value * 10 + (uint64_t)(*c - '0');
+        c++;
+    }
+    *at = c;
+    *mantissa = value;
+}
+
+stringNumberStatus_t strviewToDouble(strview text, double *out) {
+    const char *at = text.at, *end = text.at + text.length;
+    bool negative = false;
+    if(at < end && (*at == '-' || *at == '+')) negative = *at++ == '-';
+    if(at < end && ((*at | 0x20) == 'i' || (*at | 0x20) == 'n')) {
+        double value;
+        if(matchesLower(at, end, "inf") || matchesLower(at, end, "infinity")) value = HUGE_VAL;
+        else if(matchesLower(at, end, "nan")) value = NAN;
+        else return string_number_invalid;
+        if(out) *out = negative ? -value : value;
+        return string_number_ok;
+    }
+
+    // mantissa digits, with a wrapped mantissa past 19 of them that is redone below
+    const char *digits = at;
+    uint64_t mantissa = 0;
+    scanDigits(&at, end, &mantissa);
+    const char *integer_end = at;
+    int64_t exponent = 0;
+    if(at < end && *at == '.') {
+        at++;
+        scanDigits(&at, end, &mantissa);
+        exponent = -(int64_t)(at - integer_end - 1);
+    }
+    const char *digits_end = at;
+    size_t digit_count = (size_t)(digits_end - digits) - (integer_end < digits_end);
+    if(digit_count == 0) return string_number_invalid;
+
+    int64_t exponent_written = 0;
+    if(at < end && (*at | 0x20) == 'e') {
+        at++;
+        bool exponent_negative = false;
+        if(at < end && (*at == '-' || *at == '+')) exponent_negative = *at++ == '-';
+        if(at == end || (unsigned char)(*at - '0') > 9) return string_number_invalid;
+        for(; at < end && (unsigned char)(*at - '0') <= 9; at++) {
+            if(exponent_written < 100000000) exponent_written = exponent_written * 10 + (*at - '0');
+        }
+        if(exponent_negative) exponent_written = -exponent_written;
+    }
+    if(at != end) return string_number_invalid;
+    exponent += exponent_written;
+
+    // more than 19 digits: keep the first 19 significant ones, the rest only as a tiebreak
+    bool truncated = false;
+    if(digit_count > 19) {
+        const char *c = digits;
+        while(c < digits_end && (*c == '0' || *c == '.')) {
+            if(*c == '0') digit_count--;
+            c++;
+        }
+        if(digit_count > 19) {
+            truncated = true;
+            mantissa = 0;
+            for(c = digits; c < integer_end && mantissa < 1000000000000000000ull; c++) {
+                mantissa = mantissa * 10 + (uint64_t)(*c - '0');
+            }
+            if(mantissa >= 1000000000000000000ull) {
+                exponent = (int64_t)(integer_end - c) + exponent_written;
+            } else {
+                const char *fraction = integer_end + 1;
+                for(c = fraction; c < digits_end && mantissa < 1000000000000000000ull; c++) {
+                    mantissa = mantissa * 10 + (uint64_t)(*c - '0');
+                }
+                exponent = (int64_t)(fraction - c) + exponent_written;
+            }
+        }
+    }
+
+    double value;
+    if(mantissa == 0 && !truncated) {
+        value = negative ? -0.0 : 0.0;
+    } else if(!truncated && exponent >= -22 && exponent <= 22 && mantissa <= 1ull << 53) {
+        value = (double)mantissa;
+        value = exponent < 0 ? value / exact_powers_of_ten[-exponent] : value * exact_powers_of_ten[exponent];
+        if(negative) value = -value;
+    } else if(eiselLemire(mantissa, exponent, negative, &value)) {
+        double above;
+        if(truncated && (!eiselLemire(mantissa + 1, exponent, negative, &above) || above != value)) {
+            value = parseDoubleExactly(digits, digits_end, exponent_written, negative);
+        }
+    } else {
+        value = parseDoubleExactly(digits, digits_end, exponent_written, negative);
+    }
+    if(out) *out = value;
+    return isinf(value) ? string_number_overflow : string_number_ok;
+}
+
+bool stringToInt(string str, int *out) {
+    int64_t value;
+    if(strviewToInt64(strviewFromString(str), &value) != string_number_ok) return false;
+    if(value > INT_MAX || value < INT_MIN) return false;
+    if(out) *out = (int)value;
+    return true;
+}
+
+bool stringToLong(string str, long *out) {
+    int64_t value;
+    if(strviewToInt64(strviewFromString(str), &value) != string_number_ok) return false;
+    if(value > LONG_MAX || value < LONG_MIN) return false;
+    if(out) *out = (long)value;
+    return true;
+}
+
+bool stringToDouble(string str, double *out) {
+    return strviewToDouble(strviewFromString(str), out) == string_number_ok;
+}
+
+bool stringToBool(string str, bool *out) {
+    string lower = stringToLower(str);
+    string trimmed = stringTrim(lower);
+    
+    bool result = false;
+    bool valid = false;
+    
+    if(stringeql(trimmed, string("true")) || stringeql(trimmed, string("1")) || 
+       stringeql(trimmed, string("yes")) || stringeql(trimmed, string("on"))) {
+        result = true;
+        valid = true;
+    } else if(stringeql(trimmed, string("false")) || stringeql(trimmed, string("0")) || 
+              stringeql(trimmed, string("no")) || stringeql(trimmed, string("off"))) {
+        result = false;
+        valid = true;
+    }
+    
+    destroyString(lower);
+    destroyString(trimmed);
+    
+    if(valid && out) *out = result;
+    return valid;
+}
+
+// number formatting
+//
+// integers are written back to front two digits at a time out of a table of all pairs, after
+// counting their digits so that nothing has to be moved or measured again. doubles get the
+// fewest digits that read back to the same double, with Ulf Adams' Ryu: the bounds of the
+// interval of reals that round to the double are scaled to decimal by a 128 bit power of five
+// out of a table, and digits are dropped while both bounds still differ. the digits are laid
+// out like JavaScript's Number.prototype.toString, plain up to 21 integer digits and down to
+// 1e-6, exponential outside that
+
+#define NUMBER_FORMAT_MAX 32 // longest output of any of the formatters below, with room to spare
+
+static const char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static size_t decimalDigits(uint64_t value) {
+    size_t digits = 1;
+    for(;;) {
+        if(value < 10) return digits;
+        if(value < 100) return digits + 1;
+        if(value < 1000) return digits + 2;
+        if(value < 10000) return digits + 3;
+        value /= 10000;
+        digits += 4;
+    }
+}
+
+// writes the digits of value so that they end right before end
+static void writeDigitsBackward(char *end, uint64_t value) {
+    while(value >= 100) {
+        size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        *--end = digit_pairs[pair + 1];
+        *--end = digit_pairs[pair];
+    }
+    if(value >= 10) {
+        *--end = digit_pairs[value * 2 + 1];
+        *--end = digit_pairs[value * 2];
+    } else {
+        *--end = (char)('0' + value);
+    }
+}
+
+static size_t formatUint64(char *dst, uint64_t value) {
+    size_t digits = decimalDigits(value);
+    writeDigitsBackward(dst + digits, value);
+    return digits;
+}
+
+static size_t formatInt64(char *dst, int64_t value) {
+    if(value < 0) {
+        *dst = '-';
+        return 1 + formatUint64(dst + 1, 0 - (uint64_t)value);
+    }
+    return formatUint64(dst, (uint64_t)value);
+}
+
+// ryu tables, 5^i and 2^k / 5^i scaled to 125 significant bits, split into low and high words
+
+static const uint64_t ryu_pow5_inv_split[342][2] = {
+    { 0x1ull, 0x2000000000000000ull }, { 0x999999999999999aull, 0x1999999999999999ull },
+    { 0x47ae147ae147ae15ull, 0x147ae147ae147ae1ull }, { 0x6c8b4395810624deull, 0x10624dd2f1a9fbe7ull },
+    { 0x7a786c226809d496ull, 0x1a36e2eb1c432ca5ull }, { 0x61f9f01b866e43abull, 0x14f8b588e368f084ull },
+    { 0xb4c7f34938583622ull, 0x10c6f7a0b5ed8d36ull }, { 0x87a6520ec08d236aull, 0x1ad7f29abcaf4857ull },
+    { 0x9fb841a566d74f88ull, 0x15798ee2308c39dfull }, { 0xe62d01511f12a607ull, 0x112e0be826d694b2ull },
+    { 0xd6ae6881cb5109a4ull, 0x1b7cdfd9d7bdbab7ull }, { 0xdef1ed34a2a73aeaull, 0x15fd7fe17964955full },
+    { 0x7f27f0f6e885c8bbull, 0x119799812dea1119ull }, { 0x650cb4be40d60df8ull, 0x1c25c268497681c2ull },
+    { 0xea70909833de7193ull, 0x16849b86a12b9b01ull }, { 0x21f3a6e0297ec143ull, 0x1203af9ee756159bull },
+    { 0x6985d7cd0f313537ull, 0x1cd2b297d889bc2bull }, { 0x2137dfd73f5a90f9ull, 0x170ef54646d49689ull },
+    { 0xe75fe645cc4873faull, 0x12725dd1d243aba0ull }, { 0xa5663d3c7a0d865dull, 0x1d83c94fb6d2ac34ull },
+    { 0x511e976394d79eb1ull, 0x179ca10c9242235dull }, { 0xda7edf82dd794bc1ull, 0x12e3b40a0e9b4f7dull },
+    { 0x2a6498d1625bac68ull, 0x1e392010175ee596ull }, { 0xeeb6e0a781e2f053ull, 0x182db34012b25144ull },
+    { 0x58924d52ce4f26a9ull, 0x1357c299a88ea76aull }, { 0x27507bb7b07ea441ull, 0x1ef2d0f5da7dd8aaull },
+    { 0x52a6c95fc0655034ull, 0x18c240c4aecb13bbull }, { 0xeebd44c99eaa690ull, 0x13ce9a36f23c0fc9ull },
+    { 0xb17953adc3110a80ull, 0x1fb0f6be50601941ull }, { 0xc12ddc8b02740867ull, 0x195a5efea6b34767ull },
+    { 0x3424b06f3529a052ull, 0x14484bfeebc29f86ull }, { 0x901d59f290ee19dbull, 0x1039d66589687f9eull },
+    { 0x4cfbc31db4b0295full, 0x19f623d5a8a73297ull }, { 0x3d9635b15d59bab2ull, 0x14c4e977ba1f5bacull },
+    { 0x97ab5e277de16228ull, 0x109d8792fb4c4956ull }, { 0xf2abc9d8c9689d0dull, 0x1a95a5b7f87a0ef0ull },
+    { 0x5bbca17a3aba173eull, 0x154484932d2e725aull }, { 0xafca1ac82efb45cbull, 0x11039d428a8b8eaeull },
+    { 0xb2dcf7a6b1920945ull, 0x1b38fb9daa78e44aull }, { 0xf57d92ebc141a104ull, 0x15c72fb1552d836eull },
+    { 0xc46475896767b403ull, 0x116c262777579c58ull }, { 0x6d6d88dbd8a5ecd2ull, 0x1be03d0bf225c6f4ull },
+    { 0x8abe071646eb23dbull, 0x164cfda3281e38c3ull }, { 0x6efe6c11d255b649ull, 0x11d7314f534b609cull },
+    { 0xb197134fb6ef8a0eull, 0x1c8b821885456760ull }, { 0x27ac0f72f8bfa1a5ull, 0x16d601ad376ab91aull },
+    { 0xb95672c260994e1eull, 0x1244ce242c5560e1ull }, { 0xf5571e03cdc21695ull, 0x1d3ae36d13bbce35ull },
+    { 0x2aac18030b01ababull, 0x17624f8a762fd82bull }, { 0xbbbce0026f348956ull, 0x12b50c6ec4f31355ull },
+    { 0x92c7ccd0b1eda889ull, 0x1dee7a4ad4b81eefull }, { 0xdbd30a408e57ba07ull, 0x17f1fb6f10934bf2ull },
+    { 0x7ca8d50071dfc806ull, 0x1327fc58da0f6ff5ull }, { 0xfaa7bb33e9660cd6ull, 0x1ea6608e29b24cbbull },
+    { 0x9552fc298784d711ull, 0x18851a0b548ea3c9ull }, { 0xaaa8c9bad2d0ac0eull, 0x139dae6f76d88307ull },
+    { 0xdddadc5e1e1aace3ull, 0x1f62b0b257c0d1a5ull }, { 0x7e48b04b4b488a4full, 0x191bc08eac9a4151ull },
+    { 0xcb6d59d5d5d3a1d9ull, 0x141633a556e1cddaull }, { 0x3c577b1177dc817bull, 0x1011c2eaabe7d7e2ull },
+    { 0xc6f25e825960cf2aull, 0x19b604aaaca62636ull }, { 0x6bf518684780a5bbull, 0x14919d5556eb51c5ull },
+    { 0x232a79ed06008496ull, 0x10747ddddf22a7d1ull }, { 0xd1dd8fe1a3340756ull, 0x1a53fc9631d10c81ull },
+    { 0xa7e4731ae8f66c45ull, 0x150ffd44f4a73d34ull }, { 0x531d28e253f8569eull, 0x10d9976a5d52975dull },
+    { 0xeb61db03b98d5762ull, 0x1af5bf109550f22eull }, { 0xbc4e48cfc7a445e8ull, 0x159165a6ddda5b58ull },
+    { 0x6371d3d96c836b20ull, 0x11411e1f17e1e2adull }, { 0x9f1c8628ad9f11cdull, 0x1b9b6364f3030448ull },
+    { 0xe5b06b53be18db0bull, 0x1615e91d8f359d06ull }, { 0xeaf3890fcb4715a2ull, 0x11ab20e472914a6bull },
+    { 0x44b8db4c7871bc37ull, 0x1c45016d841baa46ull }, { 0x3c715d6c6c1635full, 0x169d9abe03495505ull },
+    { 0x3638de456bcde919ull, 0x1217aefe69077737ull }, { 0x56c163a2461641c1ull, 0x1cf2b1970e725858ull },
+    { 0xdf011c81d1ab67ceull, 0x17288e1271f51379ull }, { 0x7f3416ce4155eca5ull, 0x1286d80ec190dc61ull },
+    { 0x6520247d3556476eull, 0x1da48ce468e7c702ull }, { 0xea801d30f7783925ull, 0x17b6d71d20b96c01ull },
+    { 0xbb99b0f3f92cfa84ull, 0x12f8ac174d612334ull }, { 0x5f5c4e532847f739ull, 0x1e5aacf215683854ull },
+    { 0x7f7d0b75b9d32c2eull, 0x18488a5b44536043ull }, { 0x9930d5f7c7dc2358ull, 0x136d3b7c36a919cfull },
+    { 0x8eb4898c72f9d226ull, 0x1f152bf9f10e8fb2ull }, { 0x722a07a38f2e41b8ull, 0x18ddbcc7f40ba628ull },
+    { 0xc1bb394fa5be9afaull, 0x13e497065cd61e86ull }, { 0x9c5ec2190930f7f6ull, 0x1fd424d6faf030d7ull },
+    { 0x49e56814075a5ff8ull, 0x197683df2f268d79ull }, { 0x6e51201005e1e660ull, 0x145ecfe5bf520ac7ull },
+    { 0xf1da800cd181851aull, 0x104bd984990e6f05ull }, { 0x4fc400148268d4f5ull, 0x1a12f5a0f4e3e4d6ull },
+    { 0xd96999aa01ed772bull, 0x14dbf7b3f71cb711ull }, { 0xadee1488018ac5bcull, 0x10aff95cc5b09274ull },
+    { 0x497ceda668de092cull, 0x1ab328946f80ea54ull }, { 0x3aca57b853e4d424ull, 0x155c2076bf9a5510ull },
+    { 0x623b7960431d7683ull, 0x1116805effaeaa73ull }, { 0x9d2bf566d1c8bd9eull, 0x1b5733cb32b110b8ull },
+    { 0x7dbcc452416d647full, 0x15df5ca28ef40d60ull }, { 0xcafd69db678ab6ccull, 0x117f7d4ed8c33de6ull },
+    { 0xab2f0fc572778adfull, 0x1bff2ee48e052fd7ull }, { 0x88f273045b92d580ull, 0x1665bf1d3e6a8cacull },
+    { 0xd3f528d049424466ull, 0x11eaff4a98553d56ull }, { 0xb988414d4203a0a3ull, 0x1cab3210f3bb9557ull },
+    { 0x6139cdd76802e6e9ull, 0x16ef5b40c2fc7779ull }, { 0xe761717920025254ull, 0x125915cd68c9f92dull },
+    { 0xa568b58e999d5086ull, 0x1d5b561574765b7cull }, { 0x5120913ee14aa6d2ull, 0x177c44ddf6c515fdull },
+    { 0xa74d40ff1aa21f0eull, 0x12c9d0b1923744caull }, { 0xbaece64f769cb4aull, 0x1e0fb44f50586e11ull },
+    { 0x3c8bd850c5ee3c3bull, 0x180c903f7379f1a7ull }, { 0xca0979da37f1c9c9ull, 0x133d4032c2c7f485ull },
+    { 0xa9a8c2f6bfe942dbull, 0x1ec866b79e0cba6full }, { 0x2153cf2bccba9be3ull, 0x18a0522c7e709526ull },
+    { 0x1aa9728970954982ull, 0x13b374f06526ddb8ull }, { 0xf775840f1a88759dull, 0x1f8587e7083e2f8cull },
+    { 0x5f9136727ba05e17ull, 0x19379fec0698260aull }, { 0x1940f85b9619e4dfull, 0x142c7ff0054684d5ull },
+    { 0xe100c6afab47ea4cull, 0x1023998cd1053710ull }, { 0xce67a44c453fdd47ull, 0x19d28f47b4d524e7ull },
+    { 0xd852e9d69dccb106ull, 0x14a8729fc3ddb71full }, { 0x79dbee454b0a2738ull, 0x1086c219697e2c19ull },
+    { 0x295fe3a211a9d859ull, 0x1a71368f0f30468full }, { 0xbab31c81a7bb137aull, 0x15275ed8d8f36ba5ull },
+    { 0x6228e39aec95a92full, 0x10ec4be0ad8f8951ull }, { 0x9d0e38f7e0ef7517ull, 0x1b13ac9aaf4c0ee8ull },
+    { 0xb0d82d931a592a79ull, 0x15a956e225d67253ull }, { 0x8d79be0f4847552eull, 0x11544581b7dec1dcull },
+    { 0x158f967eda0bbb7cull, 0x1bba08cf8c979c94ull }, { 0x77a611ff14d62f97ull, 0x162e6d72d6dfb076ull },
+    { 0xf951a7ff43de8c79ull, 0x11bebdf578b2f391ull }, { 0xc21c3ffed2fdad8eull, 0x1c6463225ab7ec1cull },
+    { 0x1b0333242648ad8ull, 0x16b6b5b5155ff017ull }, { 0x159c28e9b83a246ull, 0x122bc490dde659acull },
+    { 0xcef604175f3903a3ull, 0x1d12d41afca3c2acull }, { 0x725e69ac4c2d9c83ull, 0x17424348ca1c9bbdull },
+    { 0xf5185489d68ae39cull, 0x129b69070816e2fdull }, { 0xee8d540fbdab05c6ull, 0x1dc574d80cf16b2full },
+    { 0xbed77672fe226b05ull, 0x17d12a4670c1228cull }, { 0xff12c528cb4ebc04ull, 0x130dbb6b8d674ed6ull },
+    { 0xcb513b74787df9a0ull, 0x1e7c5f127bd87e24ull }, { 0x90dc929f9fe614dull, 0x18637f41fcad31b7ull },
+    { 0xa0d7d42194cb810aull, 0x1382cc34ca2427c5ull }, { 0x67bfb9cf5478ce77ull, 0x1f37ad21436d0c6full },
+    { 0x1fcc94a5dd2d71f9ull, 0x18f9574dcf8a7059ull }, { 0x7fd6dd517dbdf4c7ull, 0x13faac3e3fa1f37aull },
+    { 0xffbe2ee8c92fee0bull, 0x1ff779fd329cb8c3ull }, { 0x6631bf20a0f324d6ull, 0x1992c7fdc216fa36ull },
+    { 0xb827cc1a1a5c1d78ull, 0x14756ccb01abfb5eull }, { 0x935309ae7b7ce460ull, 0x105df0a267bcc918ull },
+    { 0x1eeb42b0c594a099ull, 0x1a2fe76a3f9474f4ull }, { 0xe58902270476e6e1ull, 0x14f31f8832dd2a5cull },
+    { 0xb7a0ce859d2bebe7ull, 0x10c27fa028b0eeb0ull }, { 0x59014a6f61dfdfd8ull, 0x1ad0cc33744e4ab4ull },
+    { 0xe0cdd525e7e64cadull, 0x1573d68f903ea229ull }, { 0x4d7177518651d6f1ull, 0x11297872d9cbb4eeull },
+    { 0x7be8bee8d6e957e8ull, 0x1b758d848fac54b0ull }, { 0xfcba3253df211320ull, 0x15f7a46a0c89dd59ull },
+    { 0x63c8284318e74280ull, 0x1192e9ee706e4aaeull }, { 0x60d0d3827d86a66ull, 0x1c1e43171a4a1117ull },
+    { 0x6b3da42cecad21ebull, 0x167e9c127b6e7412ull }, { 0x88fe1cf0bd574e56ull, 0x11fee341fc585cdbull },
+    { 0x419694b462254a23ull, 0x1ccb0536608d615full }, { 0x67abaa29e81dd4e9ull, 0x1708d0f84d3de77full },
+    { 0xb95621bb2017dd87ull, 0x126d73f9d764b932ull }, { 0xc223692b668c95a5ull, 0x1d7becc2f23ac1eaull },
+    { 0xce82ba891ed6de1dull, 0x179657025b6234bbull }, { 0xa53562074bdf1818ull, 0x12deac01e2b4f6fcull },
+    { 0x3b889cd87964f359ull, 0x1e3113363787f194ull }, { 0xfc6d4a46c783f5e1ull, 0x18274291c6065adcull },
+    { 0x30576e9f06032b1aull, 0x13529ba7d19eaf17ull }, { 0x1a257dcb3cd1de90ull, 0x1eea92a61c311825ull },
+    { 0x481dfe3c30a7e540ull, 0x18bba884e35a79b7ull }, { 0xd34b31c9c0865100ull, 0x13c9539d82aec7c5ull },
+    { 0x5211e942cda3b4cdull, 0x1fa885c8d117a609ull }, { 0x74db21023e1c90a4ull, 0x19539e3a40dfb807ull },
+    { 0xf715b401cb4a0d50ull, 0x1442e4fb67196005ull }, { 0xf8de299b09080aa7ull, 0x103583fc527ab337ull },
+    { 0x8e304291a80cddd7ull, 0x19ef3993b72ab859ull }, { 0x3e8d020e200a4b13ull, 0x14bf6142f8eef9e1ull },
+    { 0x653d9b3e80083c0full, 0x10991a9bfa58c7e7ull }, { 0x6ec8f864000d2ce4ull, 0x1a8e90f9908e0ca5ull },
+    { 0x8bd3f9e999a423eaull, 0x153eda614071a3b7ull }, { 0x3ca994bae1501cbbull, 0x10ff151a99f482f9ull },
+    { 0xc775bac49bb3612bull, 0x1b31bb5dc320d18eull }, { 0xd2c4956a16291a89ull, 0x15c162b168e70e0bull },
+    { 0xdbd0778811ba7ba1ull, 0x11678227871f3e6full }, { 0x2c80bf401c5d929bull, 0x1bd8d03f3e9863e6ull },
+    { 0xbd33cc3349e47549ull, 0x16470cff6546b651ull }, { 0xca8fd68f6e505dd4ull, 0x11d270cc51055ea7ull },
+    { 0x4419574be3b3c953ull, 0x1c83e7ad4e6efdd9ull }, { 0x347790982f63aa9ull, 0x16cfec8aa52597e1ull },
+    { 0xcf6c60d468c4fbbaull, 0x123ff06eea847980ull }, { 0xe57a34870e07f92aull, 0x1d331a4b10d3f59aull },
+    { 0x512e906c0b399422ull, 0x175c1508da432ae2ull }, { 0xda8ba6bcd5c7a9b5ull, 0x12b010d3e1cf5581ull },
+    { 0x90df712e22d90f87ull, 0x1de6815302e5559cull }, { 0xda4c5a8b4f140c6cull, 0x17eb9aa8cf1dde16ull },
+    { 0xaea37ba2a5a9a38aull, 0x1322e220a5b17e78ull }, { 0x7dd25f6aa2a905a9ull, 0x1e9e369aa2b59727ull },
+    { 0x97db7f888220d154ull, 0x187e92154ef7ac1full }, { 0x797c6606ce80a777ull, 0x139874ddd8c6234cull },
+    { 0x8f2d700ae4010bf1ull, 0x1f5a549627a36badull }, { 0xc2459a25000d65aull, 0x191510781fb5efbeull },
+    { 0x701d1481d99a4515ull, 0x1410d9f9b2f7f2feull }, { 0xc017439b147b6a77ull, 0x100d7b2e28c65bfeull },
+    { 0xccf205c4ed9243f2ull, 0x19af2b7d0e0a2ccaull }, { 0xa5b37d0be0e9cc2ull, 0x148c22ca71a1bd6full },
+    { 0x848f973cb3ee3ceull, 0x10701bd527b4978cull }, { 0xda0e5bec78649fb0ull, 0x1a4cf9550c5425acull },
+    { 0x7b3eaff060507fc0ull, 0x150a6110d6a9b7bdull }, { 0x95cbbff380406633ull, 0x10d51a73deee2c97ull },
+    { 0xefac665266cd7052ull, 0x1aee90b964b04758ull }, { 0x2623850eb8a459dbull, 0x158ba6fab6f36c47ull },
+    { 0x1e82d0d893b6ae49ull, 0x113c85955f29236cull }, { 0xfd9e1af41f8ab075ull, 0x1b9408eefea838acull },
+    { 0x97b1af29b2d559f7ull, 0x16100725988693bdull }, { 0xac8e25baf5777b2cull, 0x11a66c1e139edc97ull },
+    { 0x7a7d092b2258c513ull, 0x1c3d79c9b8fe2dbfull }, { 0x61fda0ef4ead6a76ull, 0x169794a160cb57ccull },
+    { 0xe7fe1a590bbdeec5ull, 0x1212dd4de7091309ull }, { 0xa6635d5b45fcb13aull, 0x1ceafbafd80e84dcull },
+    { 0x851c4aaf6b308dc8ull, 0x172262f3133ed0b0ull }, { 0xd0e36ef2bc26d7d4ull, 0x1281e8c275cbda26ull },
+    { 0xb49f17eac6a48c86ull, 0x1d9ca79d894629d7ull }, { 0x2a18dfef0550706bull, 0x17b08617a104ee46ull },
+    { 0x54e0b3259dd9f389ull, 0x12f39e794d9d8b6bull }, { 0x87cdeb6f62f65274ull, 0x1e5297287c2f4578ull },
+    { 0xd30b22bf825ea85dull, 0x18421286c9bf6ac6ull }, { 0xf3c1bcc684bb9e4ull, 0x13680ed23aff889full },
+    { 0x18602c7a4079296dull, 0x1f0ce4839198da98ull }, { 0x46b356c833942124ull, 0x18d71d360e13e213ull },
+    { 0x388f78a029434db6ull, 0x13df4a91a4dcb4dcull }, { 0x5a7f2766a86baf8aull, 0x1fcbaa82a1612160ull },
+    { 0x153285ebb9efbfa2ull, 0x196fbb9bb44db44dull }, { 0xaa8ed189618c994eull, 0x145962e2f6a4903dull },
+    { 0xeed8a7a11ad6e10cull, 0x1047824f2bb6d9caull }, { 0x7e27729b5e249b45ull, 0x1a0c03b1df8af611ull },
+    { 0xfe85f549181d4904ull, 0x14d6695b193bf80dull }, { 0xcb9e5dd4134aa0d0ull, 0x10ab877c142ff9a4ull },
+    { 0xdf63c9535211014dull, 0x1aac0bf9b9e65c3aull }, { 0x191ca10f74da6771ull, 0x15566ffafb1eb02full },
+    { 0xadb080d92a4852c1ull, 0x1111f32f2f4bc025ull }, { 0x15e7348eaa0d5134ull, 0x1b4feb7eb212cd09ull },
+    { 0xab1f5d3eee710dc4ull, 0x15d98932280f0a6dull }, { 0xbc1917658b8da49dull, 0x117ad428200c0857ull },
+    { 0x2cf4f23c127c3a94ull, 0x1bf7b9d9cce00d59ull }, { 0xf0c3f4fcdb969543ull, 0x165fc7e170b33de0ull },
+    { 0x5a365d9716121103ull, 0x11e6398126f5cb1aull }, { 0x9056fc24f01ce804ull, 0x1ca38f350b22de90ull },
+    { 0xd9df301d8ce3ecd0ull, 0x16e93f5da2824ba6ull }, { 0xe17f59b13d8323daull, 0x125432b14ecea2ebull },
+    { 0x68cbc2b52f38395cull, 0x1d53844ee47dd179ull }, { 0x53d6355dbf602de3ull, 0x177603725064a794ull },
+    { 0xa9782ab165e68b1cull, 0x12c4cf8ea6b6ec76ull }, { 0xf26aab56fd744faull, 0x1e07b27dd78b13f1ull },
+    { 0x3f52222abfdf6a62ull, 0x18062864ac6f4327ull }, { 0x65db4e88997f884eull, 0x1338205089f29c1full },
+    { 0x6fc54a7428cc0d4aull, 0x1ec033b40fea9365ull }, { 0x596aa1f68709a43bull, 0x1899c2f673220f84ull },
+    { 0xadeee7f86c07b696ull, 0x13ae3591f5b4d936ull }, { 0x497e3ff3e00c5756ull, 0x1f7d228322baf524ull },
+    { 0xd464fff64cd6ac45ull, 0x1930e868e89590e9ull }, { 0x4383fff83d7889d1ull, 0x14272053ed4473eeull },
+    { 0xcf9cccc69793a174ull, 0x101f4d0ff1038ff1ull }, { 0x7f6147a425b90252ull, 0x19cbae7fe805b31cull },
+    { 0xcc4dd2e9b7c7350full, 0x14a2f1ffecd15c16ull }, { 0x3d0b0f215fd290d9ull, 0x10825b3323dab012ull },
+    { 0x61ab4b689950e7c1ull, 0x1a6a2b85062ab350ull }, { 0x4e22a2ba1440b967ull, 0x1521bc6a6b555c40ull },
+    { 0xb4ee894dd009453ull, 0x10e7c9eebc4449cdull }, { 0x1217da87c800ed51ull, 0x1b0c764ac6d3a948ull },
+    { 0xdb46486ca000bddaull, 0x15a391d56bdc876cull }, { 0x490506bd4ccd64afull, 0x114fa7ddefe39f8aull },
+    { 0xa8080ac87ae23ab1ull, 0x1bb2a62fe638ff43ull }, { 0x5339a239fbe82ef4ull, 0x162884f31e93ff69ull },
+    { 0x75c7b4fb2fecf25dull, 0x11ba03f5b20fff87ull }, { 0x22d92191e647ea2eull, 0x1c5cd322b67fff3full },
+    { 0xb57a8141850654f2ull, 0x16b0a8e891ffff65ull }, { 0xc4620101373843f5ull, 0x1226ed86db3332b7ull },
+    { 0x3a366801f1f39feeull, 0x1d0b15a491eb8459ull }, { 0xfb5eb99b27f6198bull, 0x173c115074bc69e0ull },
+    { 0x2f7efae2865e7ad6ull, 0x129674405d6387e7ull }, { 0xe597f7d0d6fd9156ull, 0x1dbd86cd6238d971ull },
+    { 0x8479930d78cadaabull, 0x17cad23de82d7ac1ull }, { 0xd06142712d6f1556ull, 0x1308a831868ac89aull },
+    { 0x4d686a4eaf182222ull, 0x1e74404f3daada91ull }, { 0xa453883ef279b4e8ull, 0x185d003f6488aedaull },
+    { 0xe9dc6cff28615d87ull, 0x137d99cc506d58aeull }, { 0xa960ae650d6895a4ull, 0x1f2f5c7a1a488de4ull },
+    { 0xbab3beb73ded4483ull, 0x18f2b061aea07183ull }, { 0x2ef6322c318a9d36ull, 0x13f559e7bee6c136ull },
+    { 0xe4bd1d13827761f0ull, 0x1feef63f97d79b89ull }, { 0x83ca7da9352c4e5aull, 0x198bf832dfdfafa1ull },
+    { 0x9ca1fe20f756a515ull, 0x146ff9c24cb2f2e7ull }, { 0x4a1b31b3f9121daaull, 0x1059949b708f28b9ull },
+    { 0x435eb5ecc1b695ddull, 0x1a28edc580e50df5ull }, { 0x35e55e57015ede4aull, 0x14ed8b04671da4c4ull },
+    { 0xc4b77eac0118b1d5ull, 0x10be08d0527e1d69ull }, { 0xa12597799b5ab622ull, 0x1ac9a7b3b7302f0full },
+    { 0x4db7ac6149155e81ull, 0x156e1fc2f8f358d9ull }, { 0xd7c6238107444b9bull, 0x1124e63593f5e0adull },
+    { 0x593d059b3ed3ac2bull, 0x1b6e3d2286563449ull }, { 0xe0fd9e15cbdc89bcull, 0x15f1ca820511c36dull },
+    { 0xb3fe18116fe3a163ull, 0x118e3b9b37416924ull }, { 0x866359b57fd29bd1ull, 0x1c16c5c525357507ull },
+    { 0xd1e91491330ee30eull, 0x16789e3750f790d2ull }, { 0x74ba76da8f3f1c0bull, 0x11fa182c40c60d75ull },
+    { 0xedf72490e531c678ull, 0x1cc359e067a348bbull }, { 0x8b2c1d40b75b052dull, 0x1702ae4d1fb5d3c9ull },
+    { 0x6f567dcd5f7c0424ull, 0x12688b70e62b0fd4ull }, { 0x7ef0c94898c66d06ull, 0x1d74124e3d11b2edull },
+    { 0x98c0a106e09ebd9full, 0x17900ea4fda7c257ull }, { 0x470080d24d4bcae6ull, 0x12d9a550caec9b79ull },
+    { 0xd800ce1d487944a2ull, 0x1e29088144adc58eull }, { 0x1333d8176d2dd082ull, 0x1820d39a9d57d13full },
+    { 0xa8f646792424a6ceull, 0x134d76154aaca765ull }, { 0x74bd3d8ea03aa47dull, 0x1ee25688777aa56full },
+    { 0x5d64313ee6955064ull, 0x18b51206c5fbb78cull }, { 0x4ab68dcbebaaa6b7ull, 0x13c40e6bd1962c70ull },
+    { 0x1124161312aaa457ull, 0x1fa01712e8f0471aull }, { 0xda8344dc0eeee9dfull, 0x194cdf4253f36c14ull },
+    { 0xe2029d7cd8bf2180ull, 0x143d7f6843292343ull }, { 0x4e687dfd7a328133ull, 0x103132b9cf541c36ull },
+    { 0x4a40c9959050ceb8ull, 0x19e851294bb9c6bdull }, { 0x833d477a6a70bc6ull, 0x14b9da876fc7d231ull },
+    { 0xa02976c61eec096bull, 0x1094aed2bfd30e8dull }, { 0x4257a364acdbdfull, 0x1a877e1dffb81749ull },
+    { 0xcd01dfb5ea23e319ull, 0x153931b1996012a0ull }, { 0x70ce4c91881cb5aeull, 0x10fa8e27ade6754dull },
+    { 0x1ae3adb5a69455e2ull, 0x1b2a7d0c4970bbafull }, { 0x7be957c4854377e8ull, 0x15bb973d078d62f2ull },
+    { 0xc987796a0435f987ull, 0x1162df64060ab58eull }, { 0x75a58f1006bcc271ull, 0x1bd1656cd67788e4ull },
+    { 0xf7b7a5a66bca3527ull, 0x16411df0ab92d3e9ull }, { 0x5fc61e1ebca1c41full, 0x11cdb18d560f0feeull },
+    { 0xffa363646102d365ull, 0x1c7c4f4889b1b316ull }, { 0x32e91c504d9bdc51ull, 0x16c9d906d48e28dfull },
+    { 0x8f20e37371497d0eull, 0x123b140576d820b2ull }, { 0x7e9b0585820f2e7cull, 0x1d2b533bf159cdeaull },
+    { 0xcbaf379e01a5becaull, 0x1755dc2ff447d7eeull }, { 0x958f94b348498a1ull, 0x12ab168cc36cacbfull },
+};
+
+static const uint64_t ryu_pow5_split[326][2] = {
+    { 0x0ull, 0x1000000000000000ull }, { 0x0ull, 0x1400000000000000ull },
+    { 0x0ull, 0x1900000000000000ull }, { 0x0ull, 0x1f40000000000000ull },
+    { 0x0ull, 0x1388000000000000ull }, { 0x0ull, 0x186a000000000000ull },
+    { 0x0ull, 0x1e84800000000000ull }, { 0x0ull, 0x1312d00000000000ull },
+    { 0x0ull, 0x17d7840000000000ull }, { 0x0ull, 0x1dcd650000000000ull },
+    { 0x0ull, 0x12a05f2000000000ull }, { 0x0ull, 0x174876e800000000ull },
+    { 0x0ull, 0x1d1a94a200000000ull }, { 0x0ull, 0x12309ce540000000ull },
+    { 0x0ull, 0x16bcc41e90000000ull }, { 0x0ull, 0x1c6bf52634000000ull },
+    { 0x0ull, 0x11c37937e0800000ull }, { 0x0ull, 0x16345785d8a00000ull },
+    { 0x0ull, 0x1bc16d674ec80000ull }, { 0x0ull, 0x1158e460913d0000ull },
+    { 0x0ull, 0x15af1d78b58c4000ull }, { 0x0ull, 0x1b1ae4d6e2ef5000ull },
+    { 0x0ull, 0x10f0cf064dd59200ull }, { 0x0ull, 0x152d02c7e14af680ull },
+    { 0x0ull, 0x1a784379d99db420ull }, { 0x0ull, 0x108b2a2c28029094ull },
+    { 0x0ull, 0x14adf4b7320334b9ull }, { 0x4000000000000000ull, 0x19d971e4fe8401e7ull },
+    { 0x8800000000000000ull, 0x1027e72f1f128130ull }, { 0xaa00000000000000ull, 0x1431e0fae6d7217cull },
+    { 0xd480000000000000ull, 0x193e5939a08ce9dbull }, { 0xc9a0000000000000ull, 0x1f8def8808b02452ull },
+    { 0xbe04000000000000ull, 0x13b8b5b5056e16b3ull }, { 0xad85000000000000ull, 0x18a6e32246c99c60ull },
+    { 0xd8e6400000000000ull, 0x1ed09bead87c0378ull }, { 0x878fe80000000000ull, 0x13426172c74d822bull },
+    { 0x6973e20000000000ull, 0x1812f9cf7920e2b6ull }, { 0x3d0da8000000000ull, 0x1e17b84357691b64ull },
+    { 0x8262889000000000ull, 0x12ced32a16a1b11eull }, { 0x22fb2ab400000000ull, 0x178287f49c4a1d66ull },
+    { 0xabb9f56100000000ull, 0x1d6329f1c35ca4bfull }, { 0xcb54395ca0000000ull, 0x125dfa371a19e6f7ull },
+    { 0xbe2947b3c8000000ull, 0x16f578c4e0a060b5ull }, { 0x2db399a0ba000000ull, 0x1cb2d6f618c878e3ull },
+    { 0xfc90400474400000ull, 0x11efc659cf7d4b8dull }, { 0x7bb4500591500000ull, 0x166bb7f0435c9e71ull },
+    { 0xdaa16406f5a40000ull, 0x1c06a5ec5433c60dull }, { 0xa8a4de8459868000ull, 0x118427b3b4a05bc8ull },
+    { 0xd2ce16256fe82000ull, 0x15e531a0a1c872baull }, { 0x87819baecbe22800ull, 0x1b5e7e08ca3a8f69ull },
+    { 0xf4b1014d3f6d5900ull, 0x111b0ec57e6499a1ull }, { 0x71dd41a08f48af40ull, 0x1561d276ddfdc00aull },
+    { 0xe549208b31adb10ull, 0x1aba4714957d300dull }, { 0x28f4db456ff0c8eaull, 0x10b46c6cdd6e3e08ull },
+    { 0x33321216cbecfb24ull, 0x14e1878814c9cd8aull }, { 0xbffe969c7ee839edull, 0x1a19e96a19fc40ecull },
+    { 0xf7ff1e21cf512434ull, 0x105031e2503da893ull }, { 0xf5fee5aa43256d41ull, 0x14643e5ae44d12b8ull },
+    { 0x337e9f14d3eec892ull, 0x197d4df19d605767ull }, { 0x5e46da08ea7ab6ull, 0x1fdca16e04b86d41ull },
+    { 0xa03aec4845928cb2ull, 0x13e9e4e4c2f34448ull }, { 0xc849a75a56f72fdeull, 0x18e45e1df3b0155aull },
+    { 0x7a5c1130ecb4fbd6ull, 0x1f1d75a5709c1ab1ull }, { 0xec798abe93f11d65ull, 0x13726987666190aeull },
+    { 0xa797ed6e38ed64bfull, 0x184f03e93ff9f4daull }, { 0x517de8c9c728bdefull, 0x1e62c4e38ff87211ull },
+    { 0xd2eeb17e1c7976b5ull, 0x12fdbb0e39fb474aull }, { 0x87aa5ddda397d462ull, 0x17bd29d1c87a191dull },
+    { 0xe994f5550c7dc97bull, 0x1dac74463a989f64ull }, { 0x11fd195527ce9dedull, 0x128bc8abe49f639full },
+    { 0xd67c5faa71c24568ull, 0x172ebad6ddc73c86ull }, { 0x8c1b77950e32d6c2ull, 0x1cfa698c95390ba8ull },
+    { 0x57912abd28dfc639ull, 0x121c81f7dd43a749ull }, { 0xad75756c7317b7c8ull, 0x16a3a275d494911bull },
+    { 0x98d2d2c78fdda5baull, 0x1c4c8b1349b9b562ull }, { 0x9f83c3bcb9ea8794ull, 0x11afd6ec0e14115dull },
+    { 0x764b4abe8652979ull, 0x161bcca7119915b5ull }, { 0x493de1d6e27e73d7ull, 0x1ba2bfd0d5ff5b22ull },
+    { 0x6dc6ad264d8f0866ull, 0x1145b7e285bf98f5ull }, { 0xc938586fe0f2ca80ull, 0x159725db272f7f32ull },
+    { 0x7b866e8bd92f7d20ull, 0x1afcef51f0fb5effull }, { 0xad34051767bdae34ull, 0x10de1593369d1b5full },
+    { 0x9881065d41ad19c1ull, 0x15159af804446237ull }, { 0x7ea147f492186032ull, 0x1a5b01b605557ac5ull },
+    { 0x6f24ccf8db4f3c1full, 0x1078e111c3556cbbull }, { 0x4aee003712230b27ull, 0x14971956342ac7eaull },
+    { 0xdda98044d6abcdf0ull, 0x19bcdfabc13579e4ull }, { 0xa89f02b062b60b6ull, 0x10160bcb58c16c2full },
+    { 0xcd2c6c35c7b638e4ull, 0x141b8ebe2ef1c73aull }, { 0x8077874339a3c71dull, 0x1922726dbaae3909ull },
+    { 0xe0956914080cb8e4ull, 0x1f6b0f092959c74bull }, { 0x6c5d61ac8507f38eull, 0x13a2e965b9d81c8full },
+    { 0x4774ba17a649f072ull, 0x188ba3bf284e23b3ull }, { 0x1951e89d8fdc6c8full, 0x1eae8caef261aca0ull },
+    { 0xfd3316279e9c3d9ull, 0x132d17ed577d0be4ull }, { 0x13c7fdbb186434cfull, 0x17f85de8ad5c4eddull },
+    { 0x58b9fd29de7d4203ull, 0x1df67562d8b36294ull }, { 0xb7743e3a2b0e4942ull, 0x12ba095dc7701d9cull },
+    { 0xe5514dc8b5d1db92ull, 0x17688bb5394c2503ull }, { 0xdea5a13ae3465277ull, 0x1d42aea2879f2e44ull },
+    { 0xb2784c4ce0bf38aull, 0x1249ad2594c37cebull }, { 0xcdf165f6018ef06dull, 0x16dc186ef9f45c25ull },
+    { 0x416dbf7381f2ac88ull, 0x1c931e8ab871732full }, { 0x88e497a83137abd5ull, 0x11dbf316b346e7fdull },
+    { 0xeb1dbd923d8596caull, 0x1652efdc6018a1fcull }, { 0x25e52cf6cce6fc7dull, 0x1be7abd3781eca7cull },
+    { 0x97af3c1a40105dceull, 0x1170cb642b133e8dull }, { 0xfd9b0b20d0147542ull, 0x15ccfe3d35d80e30ull },
+    { 0x3d01cde904199292ull, 0x1b403dcc834e11bdull }, { 0x462120b1a28ffb9bull, 0x1108269fd210cb16ull },
+    { 0xd7a968de0b33fa82ull, 0x154a3047c694fddbull }, { 0xcd93c3158e00f923ull, 0x1a9cbc59b83a3d52ull },
+    { 0xc07c59ed78c09bb6ull, 0x10a1f5b813246653ull }, { 0xb09b7068d6f0c2a3ull, 0x14ca732617ed7fe8ull },
+    { 0xdcc24c830cacf34cull, 0x19fd0fef9de8dfe2ull }, { 0xc9f96fd1e7ec180full, 0x103e29f5c2b18bedull },
+    { 0x3c77cbc661e71e13ull, 0x144db473335deee9ull }, { 0x8b95beb7fa60e598ull, 0x1961219000356aa3ull },
+    { 0x6e7b2e65f8f91efeull, 0x1fb969f40042c54cull }, { 0xc50cfcffbb9bb35full, 0x13d3e2388029bb4full },
+    { 0xb6503c3faa82a037ull, 0x18c8dac6a0342a23ull }, { 0xa3e44b4f95234844ull, 0x1efb1178484134acull },
+    { 0xe66eaf11bd360d2bull, 0x135ceaeb2d28c0ebull }, { 0xe00a5ad62c839075ull, 0x183425a5f872f126ull },
+    { 0x980cf18bb7a47493ull, 0x1e412f0f768fad70ull }, { 0x5f0816f752c6c8dcull, 0x12e8bd69aa19cc66ull },
+    { 0xf6ca1cb527787b13ull, 0x17a2ecc414a03f7full }, { 0xf47ca3e2715699d7ull, 0x1d8ba7f519c84f5full },
+    { 0xf8cde66d86d62026ull, 0x127748f9301d319bull }, { 0xf7016008e88ba830ull, 0x17151b377c247e02ull },
+    { 0xb4c1b80b22ae923cull, 0x1cda62055b2d9d83ull }, { 0x50f91306f5ad1b65ull, 0x12087d4358fc8272ull },
+    { 0xe53757c8b318623full, 0x168a9c942f3ba30eull }, { 0x9e852dbadfde7acfull, 0x1c2d43b93b0a8bd2ull },
+    { 0xa3133c94cbeb0cc1ull, 0x119c4a53c4e69763ull }, { 0x8bd80bb9fee5cff1ull, 0x16035ce8b6203d3cull },
+    { 0xaece0ea87e9f43eeull, 0x1b843422e3a84c8bull }, { 0x4d40c9294f238a75ull, 0x1132a095ce492fd7ull },
+    { 0x2090fb73a2ec6d12ull, 0x157f48bb41db7bcdull }, { 0x68b53a508ba78856ull, 0x1adf1aea12525ac0ull },
+    { 0x417144725748b536ull, 0x10cb70d24b7378b8ull }, { 0x51cd958eed1ae283ull, 0x14fe4d06de5056e6ull },
+    { 0xe640faf2a8619b24ull, 0x1a3de04895e46c9full }, { 0xefe89cd7a93d00f7ull, 0x1066ac2d5daec3e3ull },
+    { 0xebe2c40d938c4134ull, 0x14805738b51a74dcull }, { 0x26db7510f86f5181ull, 0x19a06d06e2611214ull },
+    { 0x9849292a9b4592f1ull, 0x100444244d7cab4cull }, { 0xbe5b73754216f7adull, 0x1405552d60dbd61full },
+    { 0xadf25052929cb598ull, 0x1906aa78b912cba7ull }, { 0x996ee4673743e2ffull, 0x1f485516e7577e91ull },
+    { 0xffe54ec0828a6ddfull, 0x138d352e5096af1aull }, { 0xbfdea270a32d0957ull, 0x18708279e4bc5ae1ull },
+    { 0x2fd64b0ccbf84badull, 0x1e8ca3185deb719aull }, { 0x5de5eee7ff7b2f4cull, 0x1317e5ef3ab32700ull },
+    { 0x755f6aa1ff59fb1full, 0x17dddf6b095ff0c0ull }, { 0x92b7454a7f3079e7ull, 0x1dd55745cbb7ecf0ull },
+    { 0x5bb28b4e8f7e4c30ull, 0x12a5568b9f52f416ull }, { 0xf29f2e22335ddf3cull, 0x174eac2e8727b11bull },
+    { 0xef46f9aac035570bull, 0x1d22573a28f19d62ull }, { 0xd58c5c0ab8215667ull, 0x123576845997025dull },
+    { 0x4aef730d6629ac01ull, 0x16c2d4256ffcc2f5ull }, { 0x9dab4fd0bfb41701ull, 0x1c73892ecbfbf3b2ull },
+    { 0xa28b11e277d08e60ull, 0x11c835bd3f7d784full }, { 0x8b2dd65b15c4b1f9ull, 0x163a432c8f5cd663ull },
+    { 0x6df94bf1db35de77ull, 0x1bc8d3f7b3340bfcull }, { 0xc4bbcf772901ab0aull, 0x115d847ad000877dull },
+    { 0x35eac354f34215cdull, 0x15b4e5998400a95dull }, { 0x8365742a30129b40ull, 0x1b221effe500d3b4ull },
+    { 0xd21f689a5e0ba108ull, 0x10f5535fef208450ull }, { 0x6a742c0f58e894aull, 0x1532a837eae8a565ull },
+    { 0x4851137132f22b9dull, 0x1a7f5245e5a2cebeull }, { 0xed32ac26bfd75b42ull, 0x108f936baf85c136ull },
+    { 0xa87f57306fcd3212ull, 0x14b378469b673184ull }, { 0xd29f2cfc8bc07e97ull, 0x19e056584240fde5ull },
+    { 0xa3a37c1dd7584f1eull, 0x102c35f729689eafull }, { 0x8c8c5b254d2e62e6ull, 0x14374374f3c2c65bull },
+    { 0x6faf71eea079fb9full, 0x1945145230b377f2ull }, { 0xb9b4e6a48987a87ull, 0x1f965966bce055efull },
+    { 0x674111026d5f4c94ull, 0x13bdf7e0360c35b5ull }, { 0xc111554308b71fbaull, 0x18ad75d8438f4322ull },
+    { 0x7155aa93cae4e7a8ull, 0x1ed8d34e547313ebull }, { 0x26d58a9c5ecf10c9ull, 0x13478410f4c7ec73ull },
+    { 0xf08aed437682d4fbull, 0x1819651531f9e78full }, { 0xecada89454238a3aull, 0x1e1fbe5a7e786173ull },
+    { 0x73ec895cb4963664ull, 0x12d3d6f88f0b3ce8ull }, { 0x90e7abb3e1bbc3fdull, 0x1788ccb6b2ce0c22ull },
+    { 0x352196a0da2ab4fdull, 0x1d6affe45f818f2bull }, { 0x134fe24885ab11eull, 0x1262dfeebbb0f97bull },
+    { 0xc1823dadaa715d65ull, 0x16fb97ea6a9d37d9ull }, { 0x31e2cd19150db4bfull, 0x1cba7de5054485d0ull },
+    { 0x1f2dc02fad2890f7ull, 0x11f48eaf234ad3a2ull }, { 0xa6f9303b9872b535ull, 0x1671b25aec1d888aull },
+    { 0x50b77c4a7e8f6282ull, 0x1c0e1ef1a724eaadull }, { 0x5272adae8f199d91ull, 0x1188d357087712acull },
+    { 0x670f591a32e004f6ull, 0x15eb082cca94d757ull }, { 0x40d32f60bf980633ull, 0x1b65ca37fd3a0d2dull },
+    { 0x4883fd9c77bf03e0ull, 0x111f9e62fe44483cull }, { 0x5aa4fd0395aec4d8ull, 0x156785fbbdd55a4bull },
+    { 0x314e3c447b1a760eull, 0x1ac1677aad4ab0deull }, { 0xded0e5aaccf089c9ull, 0x10b8e0acac4eae8aull },
+    { 0x96851f15802cac3bull, 0x14e718d7d7625a2dull }, { 0xfc2666dae037d74aull, 0x1a20df0dcd3af0b8ull },
+    { 0x9d980048cc22e68eull, 0x10548b68a044d673ull }, { 0x84fe005aff2ba032ull, 0x1469ae42c8560c10ull },
+    { 0xa63d8071bef6883eull, 0x198419d37a6b8f14ull }, { 0xcfcce08e2eb42a4eull, 0x1fe52048590672d9ull },
+    { 0x21e00c58dd309a70ull, 0x13ef342d37a407c8ull }, { 0x2a580f6f147cc10dull, 0x18eb0138858d09baull },
+    { 0xb4ee134ad99bf150ull, 0x1f25c186a6f04c28ull }, { 0x7114cc0ec80176d2ull, 0x137798f428562f99ull },
+    { 0xcd59ff127a01d486ull, 0x18557f31326bbb7full }, { 0xc0b07ed7188249a8ull, 0x1e6adefd7f06aa5full },
+    { 0xd86e4f466f516e09ull, 0x1302cb5e6f642a7bull }, { 0xce89e3180b25c98bull, 0x17c37e360b3d351aull },
+    { 0x822c5bde0def3beeull, 0x1db45dc38e0c8261ull }, { 0xf15bb96ac8b58575ull, 0x1290ba9a38c7d17cull },
+    { 0x2db2a7c57ae2e6d2ull, 0x1734e940c6f9c5dcull }, { 0x391f51b6d99ba086ull, 0x1d022390f8b83753ull },
+    { 0x3b3931248014454ull, 0x1221563a9b732294ull }, { 0x4a077d6da019569ull, 0x16a9abc9424feb39ull },
+    { 0x45c895cc9081fac3ull, 0x1c5416bb92e3e607ull }, { 0x8b9d5d9fda513cbaull, 0x11b48e353bce6fc4ull },
+    { 0xae84b507d0e58be8ull, 0x1621b1c28ac20bb5ull }, { 0x1a25e249c51eeee3ull, 0x1baa1e332d728ea3ull },
+    { 0xf057ad6e1b33554dull, 0x114a52dffc679925ull }, { 0x6c6d98c9a2002aa1ull, 0x159ce797fb817f6full },
+    { 0x4788fefc0a803549ull, 0x1b04217dfa61df4bull }, { 0xcb59f5d8690214eull, 0x10e294eebc7d2b8full },
+    { 0xcfe30734e83429a1ull, 0x151b3a2a6b9c7672ull }, { 0x83dbc9022241340aull, 0x1a6208b50683940full },
+    { 0xb2695da15568c086ull, 0x107d457124123c89ull }, { 0x1f03b509aac2f0a7ull, 0x149c96cd6d16cbacull },
+    { 0x26c4a24c1573acd1ull, 0x19c3bc80c85c7e97ull }, { 0x783ae56f8d684c03ull, 0x101a55d07d39cf1eull },
+    { 0x16499ecb70c25f03ull, 0x1420eb449c8842e6ull }, { 0x9bdc067e4cf2f6c4ull, 0x19292615c3aa539full },
+    { 0x82d3081de02fb476ull, 0x1f736f9b3494e887ull }, { 0xb1c3e512ac1dd0c9ull, 0x13a825c100dd1154ull },
+    { 0xde34de57572544fcull, 0x18922f31411455a9ull }, { 0x55c215ed2cee963bull, 0x1eb6bafd91596b14ull },
+    { 0xb5994db43c151de5ull, 0x133234de7ad7e2ecull }, { 0xe2ffa1214b1a655eull, 0x17fec216198ddba7ull },
+    { 0xdbbf89699de0feb6ull, 0x1dfe729b9ff15291ull }, { 0x2957b5e202ac9f31ull, 0x12bf07a143f6d39bull },
+    { 0xf3ada35a8357c6feull, 0x176ec98994f48881ull }, { 0x70990c31242db8bdull, 0x1d4a7bebfa31aaa2ull },
+    { 0x865fa79eb69c9376ull, 0x124e8d737c5f0aa5ull }, { 0xe7f791866443b854ull, 0x16e230d05b76cd4eull },
+    { 0xa1f575e7fd54a669ull, 0x1c9abd04725480a2ull }, { 0xa53969b0fe54e801ull, 0x11e0b622c774d065ull },
+    { 0xe87c41d3dea2202ull, 0x1658e3ab7952047full }, { 0xd229b5248d64aa82ull, 0x1bef1c9657a6859eull },
+    { 0x435a1136d85eea91ull, 0x117571ddf6c81383ull }, { 0x143095848e76a536ull, 0x15d2ce55747a1864ull },
+    { 0x193cbae5b2144e83ull, 0x1b4781ead1989e7dull }, { 0x2fc5f4cf8f4cb112ull, 0x110cb132c2ff630eull },
+    { 0xbbb77203731fdd56ull, 0x154fdd7f73bf3bd1ull }, { 0x2aa54e844fe7d4acull, 0x1aa3d4df50af0ac6ull },
+    { 0xdaa75112b1f0e4ebull, 0x10a6650b926d66bbull }, { 0xd15125575e6d1e26ull, 0x14cffe4e7708c06aull },
+    { 0x85a56ead360865b0ull, 0x1a03fde214caf085ull }, { 0x7387652c41c53f8eull, 0x10427ead4cfed653ull },
+    { 0x50693e7752368f71ull, 0x14531e58a03e8be8ull }, { 0x64838e1526c4334eull, 0x1967e5eec84e2ee2ull },
+    { 0xfda4719a70754022ull, 0x1fc1df6a7a61ba9aull }, { 0xde86c70086494815ull, 0x13d92ba28c7d14a0ull },
+    { 0x162878c0a7db9a1aull, 0x18cf768b2f9c59c9ull }, { 0x5bb296f0d1d280a1ull, 0x1f03542dfb83703bull },
+    { 0x194f9e5683239064ull, 0x1362149cbd322625ull }, { 0x5fa385ec23ec747eull, 0x183a99c3ec7eafaeull },
+    { 0xf78c67672ce7919dull, 0x1e494034e79e5b99ull }, { 0x3ab7c0a07c10bb02ull, 0x12edc82110c2f940ull },
+    { 0x4965b0c89b14e9c3ull, 0x17a93a2954f3b790ull }, { 0x5bbf1cfac1da2433ull, 0x1d9388b3aa30a574ull },
+    { 0xb957721cb92856a0ull, 0x127c35704a5e6768ull }, { 0xe7ad4ea3e7726c48ull, 0x171b42cc5cf60142ull },
+    { 0xa198a24ce14f075aull, 0x1ce2137f74338193ull }, { 0x44ff65700cd16498ull, 0x120d4c2fa8a030fcull },
+    { 0x563f3ecc1005bdbeull, 0x16909f3b92c83d3bull }, { 0x2bcf0e7f14072d2eull, 0x1c34c70a777a4c8aull },
+    { 0x5b61690f6c847c3dull, 0x11a0fc668aac6fd6ull }, { 0xf239c35347a59b4cull, 0x16093b802d578bcbull },
+    { 0xeec83428198f021full, 0x1b8b8a6038ad6ebeull }, { 0x553d20990ff96153ull, 0x1137367c236c6537ull },
+    { 0x2a8c68bf53f7b9a8ull, 0x1585041b2c477e85ull }, { 0x752f82ef28f5a812ull, 0x1ae64521f7595e26ull },
+    { 0x93db1d57999890bull, 0x10cfeb353a97dad8ull }, { 0xb8d1e4ad7ffeb4eull, 0x1503e602893dd18eull },
+    { 0x8e7065dd8dffe622ull, 0x1a44df832b8d45f1ull }, { 0xf9063faa78bfefd5ull, 0x106b0bb1fb384bb6ull },
+    { 0xb747cf9516efebcaull, 0x1485ce9e7a065ea4ull }, { 0xe519c37a5cabe6bdull, 0x19a742461887f64dull },
+    { 0xaf301a2c79eb7036ull, 0x1008896bcf54f9f0ull }, { 0xdafc20b798664c43ull, 0x140aabc6c32a386cull },
+    { 0x11bb28e57e7fdf54ull, 0x190d56b873f4c688ull }, { 0x1629f31ede1fd72aull, 0x1f50ac6690f1f82aull },
+    { 0x4dda37f34ad3e67aull, 0x13926bc01a973b1aull }, { 0xe150c5f01d88e019ull, 0x187706b0213d09e0ull },
+    { 0x19a4f76c24eb181full, 0x1e94c85c298c4c59ull }, { 0xb0071aa39712ef13ull, 0x131cfd3999f7afb7ull },
+    { 0x9c08e14c7cd7aad8ull, 0x17e43c8800759ba5ull }, { 0x30b199f9c0d958eull, 0x1ddd4baa0093028full },
+    { 0x61e6f003c1887d79ull, 0x12aa4f4a405be199ull }, { 0xba60ac04b1ea9cd7ull, 0x1754e31cd072d9ffull },
+    { 0xa8f8d705de65440dull, 0x1d2a1be4048f907full }, { 0xc99b8663aaff4a88ull, 0x123a516e82d9ba4full },
+    { 0xbc0267fc95bf1d2aull, 0x16c8e5ca239028e3ull }, { 0xab0301fbbb2ee474ull, 0x1c7b1f3cac74331cull },
+    { 0xeae1e13d54fd4ec9ull, 0x11ccf385ebc89ff1ull }, { 0x659a598caa3ca27bull, 0x1640306766bac7eeull },
+    { 0xff00efefd4cbcb1aull, 0x1bd03c81406979e9ull }, { 0x3f6095f5e4ff5ef0ull, 0x116225d0c841ec32ull },
+    { 0xcf38bb735e3f36acull, 0x15baaf44fa52673eull }, { 0x8306ea5035cf0457ull, 0x1b295b1638e7010eull },
+    { 0x11e4527221a162b6ull, 0x10f9d8ede39060a9ull }, { 0x565d670eaa09bb64ull, 0x15384f295c7478d3ull },
+    { 0x2bf4c0d2548c2a3dull, 0x1a8662f3b3919708ull }, { 0x1b78f88374d79a66ull, 0x1093fdd8503afe65ull },
+    { 0x625736a4520d8100ull, 0x14b8fd4e6449bdfeull }, { 0xfaed044d6690e140ull, 0x19e73ca1fd5c2d7dull },
+    { 0xbcd422b0601a8cc8ull, 0x103085e53e599c6eull }, { 0x6c092b5c78212ffaull, 0x143ca75e8df0038aull },
+    { 0x70b763396297bf8ull, 0x194bd136316c046dull }, { 0x48ce53c07bb3daf6ull, 0x1f9ec583bdc70588ull },
+    { 0x2d80f4584d5068daull, 0x13c33b72569c6375ull }, { 0x78e1316e60a48310ull, 0x18b40a4eec437c52ull },
+};
+
+// ceil(log2(5^e)), floor(log10(2^e)) and floor(log10(5^e)), exact over the range used
+static inline int32_t ryuPow5Bits(int32_t e) {
+    return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+static inline uint32_t ryuLog10Pow2(int32_t e) {
+    return ((uint32_t)e * 78913) >> 18;
+}
+
+static inline uint32_t ryuLog10Pow5(int32_t e) {
+    return ((uint32_t)e * 732923) >> 20;
+}
+
+static inline bool ryuMultipleOfPow5(uint64_t value, uint32_t p) {
+    uint32_t count = 0;
+    while(value % 5 == 0) {
+        value /= 5;
+        count++;
+    }
+    return count >= p;
+}
+
+static inline bool ryuMultipleOfPow2(uint64_t value, uint32_t p) {
+    return (value & ((1ull << p) - 1)) == 0;
+}
+
+// (m * mul) >> j for the 128 bit mul, 64 < j < 128
+static inline uint64_t ryuMulShift(uint64_t m, const uint64_t mul[2], int32_t j) {
+    #ifdef __SIZEOF_INT128__
+    __uint128_t low = (__uint128_t)m * mul[0];
+    __uint128_t high = (__uint128_t)m * mul[1];
+    return (uint64_t)(((low >> 64) + high) >> (j - 64));
+    #else
+    uint64_t m_hi = m >> 32, m_lo = (uint32_t)m;
+    uint64_t products[2][2];
+    for(size_t w = 0; w < 2; w++) {
+        uint64_t b_hi = mul[w] >> 32, b_lo = (uint32_t)mul[w];
+        uint64_t lo_lo = m_lo * b_lo, hi_lo = m_hi * b_lo, lo_hi = m_lo * b_hi, hi_hi = m_hi * b_hi;
+        uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+        products[w][0] = (cross << 32) | (uint32_t)lo_lo;
+        products[w][1] = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    }
+    uint64_t sum_lo = products[0][1] + products[1][0];
+    uint64_t sum_hi = products[1][1] + (sum_lo < products[0][1]);
+    int32_t shift = j - 64;
+    return shift == 0 ? sum_lo : (sum_hi << (64 - shift)) | (sum_lo >> shift);
+    #endif
+}
+
+// shortest decimal for a finite, nonzero double: mantissa * 10^exponent
+static void ryuShortest(uint64_t ieee_mantissa, uint32_t ieee_exponent, uint64_t *mantissa, int32_t *exponent) {
+    int32_t e2;
+    uint64_t m2;
+    if(ieee_exponent == 0) {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = ieee_mantissa;
+    } else {
+        e2 = (int32_t)ieee_exponent - 1023 - 52 - 2;
+        m2 = (1ull << 52) | ieee_mantissa;
+    }
+    bool accept_bounds = (m2 & 1) == 0; // round half to even when reading back
+    // the double and the midpoints to its neighbours, times 4; the lower gap halves at powers of 2
+    uint64_t mv = 4 * m2;
+    uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+    uint64_t vr, vp, vm;
+    int32_t e10;
+    bool vm_trailing_zeros = false, vr_trailing_zeros = false;
+    if(e2 >= 0) {
+        uint32_t q = ryuLog10Pow2(e2) - (e2 > 3);
+        e10 = (int32_t)q;
+        int32_t k = 125 + ryuPow5Bits((int32_t)q) - 1;
+        int32_t i = -e2 + (int32_t)q + k;
+        vr = ryuMulShift(4 * m2, ryu_pow5_inv_split[q], i);
+        vp = ryuMulShift(4 * m2 + 2, ryu_pow5_inv_split[q], i);
+        vm = ryuMulShift(4 * m2 - 1 - mm_shift, ryu_pow5_inv_split[q], i);
+        if(q <= 21) {
+            // only here can the scaled values be exact, the digits dropped then are all zero
+            if(mv % 5 == 0) {
+                vr_trailing_zeros = ryuMultipleOfPow5(mv, q);
+            } else if(accept_bounds) {
+                vm_trailing_zeros = ryuMultipleOfPow5(mv - 1 - mm_shift, q);
+            } else {
+                vp -= ryuMultipleOfPow5(mv + 2, q);
+            }
+        }
+    } else {
+        uint32_t q = ryuLog10Pow5(-e2) - (-e2 > 1);
+        e10 = (int32_t)q + e2;
+        int32_t i = -e2 - (int32_t)q;
+        int32_t k = ryuPow5Bits(i) - 125;
+        int32_t j = (int32_t)q - k;
+        vr = ryuMulShift(4 * m2, ryu_pow5_split[i], j);
+        vp = ryuMulShift(4 * m2 + 2, ryu_pow5_split[i], j);
+        vm = ryuMulShift(4 * m2 - 1 - mm_shift, ryu_pow5_split[i], j);
+        if(q <= 1) {
+            vr_trailing_zeros = true;
+            if(accept_bounds) {
+                vm_trailing_zeros = mm_shift == 1;
+            } else {
+                vp--;
+            }
+        } else if(q < 63) {
+            vr_trailing_zeros = ryuMultipleOfPow2(mv, q);
+        }
+    }
+
+    int32_t removed = 0;
+    uint8_t last_removed = 0;
+    uint64_t output;
+    if(vm_trailing_zeros || vr_trailing_zeros) {
+        // exact bounds, rare
+        while(vp / 10 > vm / 10) {
+            vm_trailing_zeros &= vm % 10 == 0;
+            vr_trailing_zeros &= last_removed == 0;
+            last_removed = (uint8_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if(vm_trailing_zeros) {
+            while(vm % 10 == 0) {
+                vr_trailing_zeros &= last_removed == 0;
+                last_removed = (uint8_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if(vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) {
+            last_removed = 4; // exactly halfway, round to even
+        }
+        output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+    } else {
+        bool round_up = false;
+        if(vp / 100 > vm / 100) {
+            round_up = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while(vp / 10 > vm / 10) {
+            round_up = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || round_up);
+    }
+    *mantissa = output;
+    *exponent = e10 + removed;
+}
+
+static size_t formatDouble(char *dst, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t ieee_mantissa = bits & ((1ull << 52) - 1);
+    uint32_t ieee_exponent = (uint32_t)(bits >> 52) & 0x7FF;
+    char *out = dst;
+    if(ieee_exponent == 0x7FF && ieee_mantissa != 0) {
+        memcpy(out, "nan", 3);
+        return 3;
+    }
+    if(bits >> 63) *out++ = '-';
+    if(ieee_exponent == 0x7FF) {
+        memcpy(out, "inf", 3);
+        return (size_t)(out - dst) + 3;
+    }
+    if(ieee_exponent == 0 && ieee_mantissa == 0) {
+        *out++ = '0';
+        return (size_t)(out - dst);
+    }
+
+    uint64_t mantissa;
+    int32_t exponent;
+    int32_t e2 = (int32_t)ieee_exponent - 1075;
+    uint64_t m2 = (1ull << 52) | ieee_mantissa;
+    if(ieee_exponent != 0 && e2 <= 0 && e2 >= -52 && (m2 & ((1ull << -e2) - 1)) == 0) {
+        // integers below 2^53 are exact, only their trailing zeros need to go
+        mantissa = m2 >> -e2;
+        exponent = 0;
+        while(mantissa % 10 == 0) {
+            mantissa /= 10;
+            exponent++;
+        }
+    } else {
+        ryuShortest(ieee_mantissa, ieee_exponent, &mantissa, &exponent);
+    }
+
+    char digits[20];
+    int32_t k = (int32_t)formatUint64(digits, mantissa);
+    int32_t point = k + exponent; // value is 0.digits * 10^point
+    if(k <= point && point <= 21) {
+        memcpy(out, digits, (size_t)k);
+        memset(out + k, '0', (size_t)(point - k));
+        out += point;
+    } else if(0 < point && point <= 21) {
+        memcpy(out, digits, (size_t)point);
+        out[point] = '.';
+        memcpy(out + point + 1, digits + point, (size_t)(k - point));
+        out += k + 1;
+    } else if(-6 < point && point <= 0) {
+        *out++ = '0';
+        *out++ = '.';
+        memset(out, '0', (size_t)-point);
+        out += -point;
+        memcpy(out, digits, (size_t)k);
+        out += k;
+    } else {
+        *out++ = digits[0];
+        if(k > 1) {
+            *out++ = '.';
+            memcpy(out, digits + 1, (size_t)(k - 1));
+            out += k - 1;
+        }
+        *out++ = 'e';
+        *out++ = point - 1 < 0 ? '-' : '+';
+        out += formatUint64(out, (uint64_t)(point - 1 < 0 ? 1 - point : point - 1));
+    }
+    return (size_t)(out - dst);
+}
+
+string stringFromInt(int value) {
+    return stringFromInt64(value);
+}
+
+string stringFromLong(long value) {
+    return stringFromInt64(value);
+}
+
+string stringFromInt64(int64_t value) {
+    char buffer[NUMBER_FORMAT_MAX];
+    return stringFromStrview(strviewFromParts(buffer, formatInt64(buffer, value)));
+}
+
+string stringFromUint64(uint64_t value) {
+    char buffer[NUMBER_FORMAT_MAX];
+    return stringFromStrview(strviewFromParts(buffer, formatUint64(buffer, value)));
+}
+
+string stringFromDouble(double value, int precision) {
+    char buffer[128];
+    if(precision < 0) {
+        return stringFromStrview(strviewFromParts(buffer, formatDouble(buffer, value)));
+    }
+    int len = snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+    if((size_t)len < sizeof(buffer)) {
+        return stringFromStrview(strviewFromParts(buffer, (size_t)len));
+    }
+    // large magnitudes or precisions
+    stringHeader_t *result = allocStringHeader((size_t)len);
+    snprintf(result->data, (size_t)len + 1, "%.*f", precision, value);
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+string stringFromBool(bool value) {
+    return value ? string("true") : string("false");
+}
+
+// string and hashing
+//
+// wyhash (final version 4, public domain, by Wang Yi): 16 bytes per step on short input and three
+// independent 16 byte lanes on long input, each step a 64x64->128 bit multiply folded back to 64
+
+static const uint64_t wyhash_secret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull,
+};
+
+static inline void wyhashMultiply(uint64_t *a, uint64_t *b) {
+    #ifdef __SIZEOF_INT128__
+    __uint128_t product = (__uint128_t)*a * *b;
+    *a = (uint64_t)product;
+    *b = (uint64_t)(product >> 64);
+    #else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+    *a = lo;
+    *b = hi;
+    #endif
+}
+
+static inline uint64_t wyhashMix(uint64_t a, uint64_t b) {
+    wyhashMultiply(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t wyhashRead8(const unsigned char *p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof value);
+    return value;
+}
+
+static inline uint64_t wyhashRead4(const unsigned char *p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof value);
+    return value;
+}
+
+static inline uint64_t wyhashRead3(const unsigned char *p, size_t k) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+static uint64_t wyhash(const void *key, size_t len, uint64_t seed) {
+    const unsigned char *p = key;
+    const uint64_t *secret = wyhash_secret;
+    uint64_t a, b;
+    seed ^= wyhashMix(seed ^ secret[0], secret[1]);
+    if(len <= 16) {
+        if(len >= 4) {
+            a = (wyhashRead4(p) << 32) | wyhashRead4(p + ((len >> 3) << 2));
+            b = (wyhashRead4(p + len - 4) << 32) | wyhashRead4(p + len - 4 - ((len >> 3) << 2));
+        } else if(len > 0) {
+            a = wyhashRead3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if(i >= 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = wyhashMix(wyhashRead8(p) ^ secret[1], wyhashRead8(p + 8) ^ seed);
+                see1 = wyhashMix(wyhashRead8(p + 16) ^ secret[2], wyhashRead8(p + 24) ^ see1);
+                see2 = wyhashMix(wyhashRead8(p + 32) ^ secret[3], wyhashRead8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while(i >= 48);
+            seed ^= see1 ^ see2;
+        }
+        while(i > 16) {
+            seed = wyhashMix(wyhashRead8(p) ^ secret[1], wyhashRead8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = wyhashRead8(p + i - 16);
+        b = wyhashRead8(p + i - 8);
+    }
+    a ^= secret[1];
+    b ^= seed;
+    wyhashMultiply(&a, &b);
+    return wyhashMix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+// the unseeded hash is cached in the header until the next stringInvalidate. threads reading the
+// same string may all store it, they store the same value and the flag is only set after it
+uint64_t stringHash64(string str) {
+    stringHeader_t *header = getHeaderPointer(str);
+    if(atomic_load_explicit(&header->flags, memory_order_acquire) & string_hash_cached) {
+        return atomic_load_explicit(&header->hash, memory_order_relaxed);
+    }
+    uint64_t hash = wyhash(header->data, header->length, 0);
+    atomic_store_explicit(&header->hash, hash, memory_order_relaxed);
+    atomic_fetch_or_explicit(&header->flags, string_hash_cached, memory_order_release);
+    return hash;
+}
+
+uint32_t stringHash(string str) {
+    uint64_t hash = stringHash64(str);
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+uint64_t stringHashSeeded(string str, uint64_t seed) {
+    return wyhash(str.at, stringlen(str), seed);
+}
+
+// interning
+//
+// canonical copies live in a set split into STRING_INTERN_SHARDS independently locked open
+// addressing tables, the top bits of the hash pick the shard. each shard keeps its strings in its
+// own arena, so the whole pool is released at once by stringInternReset
+
+#define STRING_INTERN_SHARDS 64
+#define STRING_INTERN_SHARD_BITS 6
+
+typedef struct {
+    uint64_t hash;
+    stringHeader_t *header;
+} internSlot_t;
+
+typedef struct {
+    atomic_bool locked;
+    size_t count;
+    size_t capacity; // power of two, 0 until the first insert
+    internSlot_t *slots;
+    stringAllocator_t arena;
+} internShard_t;
+
+static internShard_t intern_shards[STRING_INTERN_SHARDS];
+
+static void internLock(internShard_t *shard) {
+    while(atomic_exchange_explicit(&shard->locked, true, memory_order_acquire)) {
+        while(atomic_load_explicit(&shard->locked, memory_order_relaxed)) {
+            #ifdef CHAD_X86_SIMD
+            _mm_pause();
+            #endif
+        }
+    }
+}
+
+static void internUnlock(internShard_t *shard) {
+    atomic_store_explicit(&shard->locked, false, memory_order_release);
+}
+
+static void internGrow(internShard_t *shard) {
+    size_t capacity = shard->capacity ? shard->capacity * 2 : 64;
+    internSlot_t *slots = calloc(capacity, sizeof(internSlot_t));
+    if(slots == NULL) {
+        fprintf(stderr, "failed to allocate memory in internGrow\n");
+        exit(EXIT_FAILURE);
+    }
+    for(size_t i = 0; i < shard->capacity; i++) {
+        internSlot_t slot = shard->slots[i];
+        if(slot.header == NULL) continue;
+        size_t at = slot.hash & (capacity - 1);
+        while(slots[at].header != NULL) {
+            at = (at + 1) & (capacity - 1);
+        }
+        slots[at] = slot;
+    }
+    if(shard->capacity == 0) {
+        shard->arena = stringArenaCreate(16 * 1024);
+    }
+    free(shard->slots);
+    shard->slots = slots;
+    shard->capacity = capacity;
+}
+
+string stringIntern(strview view) {
+    uint64_t hash = wyhash(view.at, view.length, 0);
+    internShard_t *shard = &intern_shards[hash >> (64 - STRING_INTERN_SHARD_BITS)];
+    internLock(shard);
+    if((shard->count + 1) * 2 > shard->capacity) {
+        internGrow(shard);
+    }
+    size_t mask = shard->capacity - 1;
+    size_t at = hash & mask;
+    for(; shard->slots[at].header != NULL; at = (at + 1) & mask) {
+        stringHeader_t *candidate = shard->slots[at].header;
+        if(shard->slots[at].hash == hash && candidate->length == view.length
+            && (view.length == 0 || memcmp(candidate->data, view.at, view.length) == 0)) {
+            internUnlock(shard);
+            return (string) { .data = (dataSegmentOfString_t *)candidate->data };
+        }
+    }
+    stringAllocator_t *previous = stringUseAllocator(&shard->arena);
+    string interned = stringFromStrview(view);
+    stringUseAllocator(previous);
+    stringHeader_t *header = getHeaderPointer(interned);
+    atomic_store_explicit(&header->hash, hash, memory_order_relaxed);
+    atomic_fetch_or_explicit(&header->flags, string_interned | string_hash_cached, memory_order_release);
+    shard->slots[at] = (internSlot_t) { .hash = hash, .header = header };
+    shard->count++;
+    internUnlock(shard);
+    return interned;
+}
+
+bool stringIsInterned(string str) {
+    return str.data != NULL && (getHeaderPointer(str)->flags & string_interned);
+}
+
+size_t stringInternCount(void) {
+    size_t count = 0;
+    for(size_t i = 0; i < STRING_INTERN_SHARDS; i++) {
+        internLock(&intern_shards[i]);
+        count += intern_shards[i].count;
+        internUnlock(&intern_shards[i]);
+    }
+    return count;
+}
+
+void stringInternReset(void) {
+    for(size_t i = 0; i < STRING_INTERN_SHARDS; i++) {
+        internShard_t *shard = &intern_shards[i];
+        internLock(shard);
+        if(shard->capacity != 0) {
+            stringAllocatorDestroy(&shard->arena);
+            free(shard->slots);
+        }
+        shard->slots = NULL;
+        shard->count = 0;
+        shard->capacity = 0;
+        internUnlock(shard);
+    }
+}
+
+// string builder
+//
+// appends write straight into the spare room of the current buffer. a growing builder lets
+// stringGrowBuffer double it, a chunked one seals the buffer into chunks once it is full and
+// starts a new one, so nothing that was written is ever copied again until it is joined
+
+#define STRING_BUILDER_DEFAULT_CAPACITY 256
+#define STRING_BUILDER_DEFAULT_CHUNK (64 * 1024)
+
+static string builderNewBuffer(size_t capacity) {
+    stringHeader_t *buf = allocStringHeader(capacity);
+    buf->length = 0;
+    buf->data[0] = '\0';
+    return (string) { .data = (dataSegmentOfString_t *)buf->data };
+}
+
+static void builderAdopt(stringBuilder_t *sb, string buffer) {
+    sb->buffer = buffer;
+    sb->capacity = buffer.data != NULL ? stringCapacity(buffer) : 0;
+}
+
+// moves the current buffer into the chunks and starts one with room for at least min_capacity
+static void builderSeal(stringBuilder_t *sb, size_t min_capacity) {
+    string full = sb->buffer;
+    if(full.data != NULL && stringlen(full) > 0) {
+        dynarray_append(sb->chunks, full);
+        sb->sealed_length += stringlen(full);
+    } else {
+        destroyString(full);
+    }
+    size_t capacity = min_capacity > sb->chunk_size ? min_capacity : sb->chunk_size;
+    builderAdopt(sb, builderNewBuffer(capacity));
+}
+
+// room for n more contiguous bytes (plus the terminator) at the end of the current buffer
+static char *builderTail(stringBuilder_t *sb, size_t n) {
+    if(sb->buffer.data != NULL) {
+        stringHeader_t *header = getHeaderPointer(sb->buffer);
+        if(header->length + n <= sb->capacity && !headerIsShared(header)) {
+            return header->data + header->length;
+        }
+    }
+    if(sb->chunk_size != 0) {
+        builderSeal(sb, n);
+    } else {
+        // also detaches a buffer still shared with a stringBuilderToString result
+        builderAdopt(sb, stringGrowBuffer(sb->buffer, n));
+    }
+    return sb->buffer.at + stringlen(sb->buffer);
+}
+
+static void builderCommit(stringBuilder_t *sb, size_t n) {
+    stringHeader_t *header = getHeaderPointer(sb->buffer);
+    header->length += n;
+    header->data[header->length] = '\0';
+    stringInvalidate(sb->buffer);
+}
+
+static string builderJoin(const stringBuilder_t *sb) {
+    size_t total = stringBuilderLength(sb);
+    stringHeader_t *result = allocStringHeader(total);
+    char *out = result->data;
+    for(size_t i = 0; i < sb->chunks.count; i++) {
+        memcpy(out, sb->chunks.at[i].at, stringlen(sb->chunks.at[i]));
+        out += stringlen(sb->chunks.at[i]);
+    }
+    if(sb->buffer.data != NULL) {
+        memcpy(out, sb->buffer.at, stringlen(sb->buffer));
+    }
+    result->data[total] = '\0';
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+static void builderDropChunks(stringBuilder_t *sb) {
+    for(size_t i = 0; i < sb->chunks.count; i++) {
+        destroyString(sb->chunks.at[i]);
+    }
+    destroy_dynarray(sb->chunks);
+    sb->sealed_length = 0;
+}
+
+stringBuilder_t stringBuilderCreate(size_t initial_capacity) {
+    if(initial_capacity == 0) initial_capacity = STRING_BUILDER_DEFAULT_CAPACITY;
+    stringBuilder_t sb = { .chunk_size = 0, .chunks = {}, .sealed_length = 0 };
+    builderAdopt(&sb, builderNewBuffer(initial_capacity));
+    return sb;
+}
+
+stringBuilder_t stringBuilderCreateChunked(size_t chunk_size) {
+    if(chunk_size == 0) chunk_size = STRING_BUILDER_DEFAULT_CHUNK;
+    stringBuilder_t sb = { .chunk_size = chunk_size, .chunks = {}, .sealed_length = 0 };
+    builderAdopt(&sb, builderNewBuffer(chunk_size));
+    return sb;
+}
+
+void stringBuilderAppendStrview(stringBuilder_t *sb, strview view) {
+    // a chunked builder tops up the current chunk before sealing it
+    while(sb->chunk_size != 0 && view.length > 0) {
+        size_t room = sb->buffer.data != NULL ? sb->capacity - stringlen(sb->buffer) : 0;
+        if(room >= view.length) break;
+        if(room > 0) {
+            memcpy(builderTail(sb, room), view.at, room);
+            builderCommit(sb, room);
+            view.at += room;
+            view.length -= room;
+        }
+        builderSeal(sb, 0);
+    }
+    if(view.length == 0) return;
+    memcpy(builderTail(sb, view.length), view.at, view.length);
+    builderCommit(sb, view.length);
+}
+
+void stringBuilderAppend(stringBuilder_t *sb, string str) {
+    stringBuilderAppendStrview(sb, strviewFromString(str));
+}
+
+void stringBuilderAppendCStr(stringBuilder_t *sb, const char *cstr) {
+    stringBuilderAppendStrview(sb, strviewFromParts(cstr, strlen(cstr)));
+}
+
+void stringBuilderAppendChar(stringBuilder_t *sb, char ch) {
+    *builderTail(sb, 1) = ch;
+    builderCommit(sb, 1);
+}
+
+void stringBuilderAppendFormatVa(stringBuilder_t *sb, const char *fmt, va_list args) {
+    va_list args_copy;
+    va_copy(args_copy, args);
+    char *tail = builderTail(sb, 0);
+    size_t room = sb->capacity - stringlen(sb->buffer);
+    int len = vsnprintf(tail, room + 1, fmt, args);
+    if(len < 0) {
+        fprintf(stderr, "vsnprintf failed in stringBuilderAppendFormatVa\n");
+        exit(EXIT_FAILURE);
+    }
+    if((size_t)len > room) {
+        // did not fit, put the terminator back and format again into a tail that is big enough
+        *tail = '\0';
+        tail = builderTail(sb, len);
+        vsnprintf(tail, len + 1, fmt, args_copy);
+    }
+    va_end(args_copy);
+    builderCommit(sb, len);
+}
+
+void stringBuilderAppendFormat(stringBuilder_t *sb, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    stringBuilderAppendFormatVa(sb, fmt, args);
+    va_end(args);
+}
+
+void stringBuilderAppendInt(stringBuilder_t *sb, int64_t value) {
+    char *tail = builderTail(sb, NUMBER_FORMAT_MAX);
+    builderCommit(sb, formatInt64(tail, value));
+}
+
+void stringBuilderAppendUint(stringBuilder_t *sb, uint64_t value) {
+    char *tail = builderTail(sb, NUMBER_FORMAT_MAX);
+    builderCommit(sb, formatUint64(tail, value));
+}
+
+void stringBuilderAppendDouble(stringBuilder_t *sb, double value) {
+    char *tail = builderTail(sb, NUMBER_FORMAT_MAX);
+    builderCommit(sb, formatDouble(tail, value));
+}
+
+size_t stringBuilderLength(const stringBuilder_t *sb) {
+    return sb->sealed_length + (sb->buffer.data != NULL ? stringlen(sb->buffer) : 0);
+}
+
+string stringBuilderToString(stringBuilder_t *sb) {
+    if(sb->chunks.count > 0) {
+        return builderJoin(sb);
+    }
+    if(sb->buffer.data == NULL) {
+        return string("");
+    }
+    return stringFromString(sb->buffer);
+}
+
+string stringBuilderFinish(stringBuilder_t *sb) {
+    string ret;
+    if(sb->chunks.count > 0) {
+        ret = builderJoin(sb);
+        destroyString(sb->buffer);
+        builderDropChunks(sb);
+    } else {
+        ret = sb->buffer.data != NULL ? sb->buffer : string("");
+    }
+    builderAdopt(sb, (string) { .data = NULL });
+    return ret;
+}
+
+dynarray(string) stringBuilderFinishChunks(stringBuilder_t *sb) {
+    dynarray(string) ret = sb->chunks;
+    if(sb->buffer.data != NULL && stringlen(sb->buffer) > 0) {
+        dynarray_append(ret, sb->buffer);
+    } else {
+        destroyString(sb->buffer);
+    }
+    sb->chunks = (typeof(sb->chunks)) {};
+    sb->sealed_length = 0;
+    builderAdopt(sb, (string) { .data = NULL });
+    return ret;
+}
+
+void stringBuilderClear(stringBuilder_t *sb) {
+    builderDropChunks(sb);
+    if(sb->buffer.data == NULL) return;
+    stringHeader_t *header = getHeaderPointer(sb->buffer);
+    if(headerIsShared(header)) {
+        // still referenced by a stringBuilderToString result, start over in a buffer of our own
+        header = detachStringHeader(header, 0, sb->capacity);
+        builderAdopt(sb, (string) { .data = (dataSegmentOfString_t *)header->data });
+    }
+    stringInvalidate(sb->buffer);
+    getHeaderPointer(sb->buffer)->length = 0;
+    sb->buffer.at[0] = '\0';
+}
+
+void stringBuilderDestroy(stringBuilder_t *sb) {
+    destroyString(sb->buffer);
+    builderDropChunks(sb);
+    builderAdopt(sb, (string) { .data = NULL });
+}
+
+string stringRemoveDuplicates(string str) {
+    if(stringlen(str) <= 1) return stringFromString(str);
+    
+    bool seen[256] = {false};
+    stringHeader_t *result = allocStringHeader(stringlen(str));
+    result->length = 0;
+    
+    for(size_t i = 0; i < stringlen(str); i++) {
+        unsigned char ch = (unsigned char)str.at[i];
+        if(!seen[ch]) {
+            seen[ch] = true;
+            result->data[result->length++] = str.at[i];
+        }
+    }
+    result->data[result->length] = '\0';
+    
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+string stringIntersect(string a, string b) {
+    bool in_b[256] = {false};
+    bool added[256] = {false};
+    
+    for(size_t i = 0; i < stringlen(b); i++) {
+        in_b[(unsigned char)b.at[i]] = true;
+    }
+    
+    stringHeader_t *result = allocStringHeader(stringlen(a));
+    result->length = 0;
+    
+    for(size_t i = 0; i < stringlen(a); i++) {
+        unsigned char ch = (unsigned char)a.at[i];
+        if(in_b[ch] && !added[ch]) {
+            added[ch] = true;
+            result->data[result->length++] = a.at[i];
+        }
+    }
+    result->data[result->length] = '\0';
+    
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+string stringDifference(string a, string b) {
+    bool in_b[256] = {false};
+    
+    for(size_t i = 0; i < stringlen(b); i++) {
+        in_b[(unsigned char)b.at[i]] = true;
+    }
+    
+    stringHeader_t *result = allocStringHeader(stringlen(a));
+    result->length = 0;
+    
+    for(size_t i = 0; i < stringlen(a); i++) {
+        unsigned char ch = (unsigned char)a.at[i];
+        if(!in_b[ch]) {
+            result->data[result->length++] = a.at[i];
+        }
+    }
+    result->data[result->length] = '\0';
+    
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+// escaping and hex
+//
+// most text needs no escaping at all. the escaper measures its output first, then copies each
+// run of plain bytes with a single memcpy and writes only the escapes one at a time, the runs
+// are found a block at a time by comparing against the few bytes that need an escape. the
+// unescaper copies everything between backslashes in bulk. hex is encoded a block at a time by
+// splitting the bytes into nibbles and looking their digits up with a shuffle, and decoded by
+// validating and packing the nibbles back, both straight into an output of the exact size
+
+// character after the backslash, 'x' for \xNN, 0 for bytes that stay as they are
+static const char c_escapes[256] = {
+    'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'b', 't', 'n', 'x', 'f', 'r', 'x', 'x',
+    'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
+    0, 0, '"', 0, 0, 0, 0, '\'', 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 'x',
+    'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
+    'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
+    'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
+    'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
+    'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
+    'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
+    'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
+    'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
+};
+
+static const char hex_digits[] = "0123456789abcdef";
+
+static inline int hexDigitValue(unsigned char ch) {
+    if((unsigned)(ch - '0') < 10) return ch - '0';
+    ch |= 0x20;
+    if((unsigned)(ch - 'a') < 6) return ch - 'a' + 10;
+    return -1;
+}
+
+static size_t escapePlainRunScalar(const unsigned char *at, size_t len) {
+    size_t i = 0;
+    while(i < len && c_escapes[at[i]] == 0) i++;
+    return i;
+}
+
+#ifdef CHAD_X86_SIMD
+
+// bytes below ' ' (signed, so with everything from 0x80 up), DEL, backslash and both quotes
+static inline unsigned escapeMaskSse2(__m128i v) {
+    __m128i special = _mm_or_si128(_mm_cmpgt_epi8(_mm_set1_epi8(' '), v), _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F)));
+    special = _mm_or_si128(special, _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    special = _mm_or_si128(special, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+    special = _mm_or_si128(special, _mm_cmpeq_epi8(v, _mm_set1_epi8('\'')));
+    return (unsigned)_mm_movemask_epi8(special);
+}
+
+static size_t escapePlainRunSse2(const unsigned char *at, size_t len) {
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        unsigned mask = escapeMaskSse2(_mm_loadu_si128((const __m128i *)(at + i)));
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+    return i + escapePlainRunScalar(at + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static size_t escapePlainRunAvx2(const unsigned char *at, size_t len) {
+    size_t i = 0;
+    for(; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(at + i));
+        __m256i special = _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(' '), v),
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F)));
+        special = _mm256_or_si256(special, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+        special = _mm256_or_si256(special, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+        special = _mm256_or_si256(special, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\'')));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(special);
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+    return i + escapePlainRunSse2(at + i, len - i);
+}
+
+__attribute__((target("ssse3")))
+static size_t hexEncodeSsse3(const unsigned char *src, size_t len, char *dst) {
+    const __m128i digits = _mm_loadu_si128((const __m128i *)hex_digits);
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)));
+        __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(v, _mm_set1_epi8(0x0F)));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t hexEncodeAvx2(const unsigned char *src, size_t len, char *dst) {
+    const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)hex_digits));
+    size_t i = 0;
+    for(; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F)));
+        __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, _mm256_set1_epi8(0x0F)));
+        // unpacking works within lanes, the first lane holds bytes 0-7 and 8-15
+        __m256i first = _mm256_unpacklo_epi8(high, low), second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256((__m256i *)(dst + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return i;
+}
+
+// nibble values of 16 hex digits, all ones in invalid when any of them is not one
+__attribute__((target("ssse3")))
+static inline __m128i hexNibblesSsse3(__m128i v, __m128i *invalid) {
+    __m128i digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    *invalid = _mm_or_si128(*invalid, _mm_andnot_si128(_mm_or_si128(is_digit, is_letter), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+        _mm_andnot_si128(is_digit, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+// stops before the first block with anything but hex digits, the scalar code reports it
+__attribute__((target("ssse3")))
+static size_t hexDecodeSsse3(const char *src, size_t pairs, unsigned char *dst) {
+    size_t i = 0;
+    for(; i + 16 <= pairs; i += 16) {
+        __m128i invalid = _mm_setzero_si128();
+        __m128i first = hexNibblesSsse3(_mm_loadu_si128((const __m128i *)(src + 2 * i)), &invalid);
+        __m128i second = hexNibblesSsse3(_mm_loadu_si128((const __m128i *)(src + 2 * i + 16)), &invalid);
+        if(_mm_movemask_epi8(invalid) != 0) break;
+        // high nibble * 16 + low nibble for each pair
+        __m128i weights = _mm_set1_epi16(0x0110);
+        __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights));
+        _mm_storeu_si128((__m128i *)(dst + i), bytes);
+    }
+    return i;
+}
+
+#endif // CHAD_X86_SIMD
+
+// bytes of at before the first one that needs an escape
+static size_t escapePlainRun(const char *at, size_t len) {
+    const unsigned char *bytes = (const unsigned char *)at;
+    #ifdef CHAD_X86_SIMD
+    if(len >= 32 && __builtin_cpu_supports("avx2")) {
+        return escapePlainRunAvx2(bytes, len);
+    }
+    if(len >= 16) {
+        return escapePlainRunSse2(bytes, len);
+    }
+    #endif
+    return escapePlainRunScalar(bytes, len);
+}
+
+string stringEscapeC(string str) {
+    const char *at = str.at;
+    size_t len = stringlen(str);
+    size_t out_len = len;
+    for(size_t i = escapePlainRun(at, len); i < len; i += 1 + escapePlainRun(at + i + 1, len - i - 1)) {
+        out_len += c_escapes[(unsigned char)at[i]] == 'x' ? 3 : 1;
+    }
+
+    stringHeader_t *result = allocStringHeader(out_len);
+    char *out = result->data;
+    size_t i = 0;
+    for(;;) {
+        size_t run = escapePlainRun(at + i, len - i);
+        memcpy(out, at + i, run);
+        out += run;
+        i += run;
+        if(i == len) break;
+        unsigned char ch = (unsigned char)at[i++];
+        *out++ = '\\';
+        *out++ = c_escapes[ch];
+        if(c_escapes[ch] == 'x') {
+            *out++ = hex_digits[ch >> 4];
+            *out++ = hex_digits[ch & 0x0F];
+        }
+    }
+    result->data[out_len] = '\0';
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+string stringUnescapeC(string str) {
+    const char *at = str.at, *end = str.at + stringlen(str);
+    stringHeader_t *result = allocStringHeader(stringlen(str));
+    char *out = result->data;
+    while(at < end) {
+        const char *backslash = memchr(at, '\\', (size_t)(end - at));
+        if(backslash == NULL || backslash + 1 == end) {
+            // a trailing lone backslash stays
+            memcpy(out, at, (size_t)(end - at));
+            out += end - at;
+            break;
+        }
+        memcpy(out, at, (size_t)(backslash - at));
+        out += backslash - at;
+        at = backslash + 2;
+        char ch = backslash[1];
+        switch(ch) {
+            case 'n': *out++ = '\n'; break;
+            case 'r': *out++ = '\r'; break;
+            case 't': *out++ = '\t'; break;
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'x':
+                if(end - at >= 2 && hexDigitValue((unsigned char)at[0]) >= 0 && hexDigitValue((unsigned char)at[1]) >= 0) {
+                    *out++ = (char)(hexDigitValue((unsigned char)at[0]) << 4 | hexDigitValue((unsigned char)at[1]));
+                    at += 2;
+                } else {
+                    *out++ = 'x';
+                }
+                break;
+            default:
+                // \\ \" \' and unknown escapes stand for the character itself
+                *out++ = ch;
+                break;
+        }
+    }
+    result->length = (size_t)(out - result->data);
+    *out = '\0';
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+string stringToHex(string str) {
+    const unsigned char *src = (const unsigned char *)str.at;
+    size_t len = stringlen(str);
+    stringHeader_t *result = allocStringHeader(len * 2);
+    char *out = result->data;
+    size_t i = 0;
+    #ifdef CHAD_X86_SIMD
+    if(len >= 32 && __builtin_cpu_supports("avx2")) {
+        i = hexEncodeAvx2(src, len, out);
+    }
+    if(len - i >= 16 && __builtin_cpu_supports("ssse3")) {
+        i += hexEncodeSsse3(src + i, len - i, out + 2 * i);
+    }
+    #endif
+    for(; i < len; i++) {
+        out[2 * i] = hex_digits[src[i] >> 4];
+        out[2 * i + 1] = hex_digits[src[i] & 0x0F];
+    }
+    out[len * 2] = '\0';
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+string stringFromHex(string hex_str) {
+    if(stringlen(hex_str) % 2 != 0) {
+        return string("");
+    }
+
+    size_t result_len = stringlen(hex_str) / 2;
+    stringHeader_t *result = allocStringHeader(result_len);
+    unsigned char *out = (unsigned char *)result->data;
+    size_t i = 0;
+    #ifdef CHAD_X86_SIMD
+    if(result_len >= 16 && __builtin_cpu_supports("ssse3")) {
+        i = hexDecodeSsse3(hex_str.at, result_len, out);
+    }
+    #endif
+    for(; i < result_len; i++) {
+        int high = hexDigitValue((unsigned char)hex_str.at[2 * i]);
+        int low = hexDigitValue((unsigned char)hex_str.at[2 * i + 1]);
+        if(high < 0 || low < 0) {
+            freeStringHeader(result);
+            return string("");
+        }
+        out[i] = (unsigned char)(high << 4 | low);
+    }
+    result->data[result_len] = '\0';
+
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+// base64
+//
+// the bulk of the input goes through SIMD kernels after Muła and Lemire: the encoder spreads
+// 12 input bytes over 16 lanes, cuts them into sextets with two multiplies and maps the sextets
+// to ASCII with a 16 entry offset table. the decoder classifies every character by its two
+// nibbles, which also validates the block, and packs the sextets back with two multiply-adds.
+// blocks with anything the kernels do not handle (padding, whitespace, errors) and the tail go
+// through the scalar code, which keeps its state in a stringBase64Stream_t so that the same
+// code serves the streaming functions
+
+#define BASE64_WHITESPACE 0x80
+#define BASE64_PAD 0x81
+#define BASE64_INVALID 0xFF
+
+// sextet values, 0x40 to 0x43 stand for + / - _ which depend on the alphabet
+static const uint8_t base64_decode_table[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x40, 0xFF, 0x42, 0xFF, 0x41,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0x81, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x43,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+static const char base64_standard_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char base64_url_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// sextet of one of + / - _ under flags, BASE64_INVALID when the alphabet does not have it
+static uint8_t base64Special(uint8_t code, stringBase64Flags_t flags) {
+    bool lenient = flags & string_base64_lenient;
+    bool url = flags & string_base64_url;
+    switch(code) {
+        case 0x40: return lenient || !url ? 62 : BASE64_INVALID;
+        case 0x41: return lenient || !url ? 63 : BASE64_INVALID;
+        case 0x42: return lenient || url ? 62 : BASE64_INVALID;
+        case 0x43: return lenient || url ? 63 : BASE64_INVALID;
+    }
+    return code;
+}
+
+static void base64EncodeScalar(const unsigned char *src, size_t len, char *dst, const char *chars) {
+    for(size_t i = 0; i + 3 <= len; i += 3) {
+        uint32_t v = (uint32_t)src[i] << 16 | (uint32_t)src[i + 1] << 8 | src[i + 2];
+        dst[0] = chars[v >> 18];
+        dst[1] = chars[(v >> 12) & 63];
+        dst[2] = chars[(v >> 6) & 63];
+        dst[3] = chars[v & 63];
+        dst += 4;
+    }
+}
+
+#ifdef CHAD_X86_SIMD
+
+__attribute__((target("ssse3")))
+static __m128i base64ToAsciiSsse3(__m128i sextets, bool url) {
+    // 0..25 use slot 13, 26..51 slot 0, 52..63 slots 1 to 12
+    __m128i slot = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+    slot = _mm_or_si128(slot, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), sextets), _mm_set1_epi8(13)));
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, url ? '-' - 62 : '+' - 62,
+        url ? '_' - 63 : '/' - 63, 'A', 0, 0);
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, slot), sextets);
+}
+
+__attribute__((target("ssse3")))
+static size_t base64EncodeSsse3(const unsigned char *src, size_t len, char *dst, bool url) {
+    const __m128i spread = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    size_t i = 0;
+    for(; i + 16 <= len; i += 12) {
+        __m128i bits = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(src + i)), spread);
+        // sextets of each 3 byte group, one per byte: two shifted into place by a high multiply,
+        // two by a low multiply
+        __m128i sextets = _mm_or_si128(
+            _mm_mulhi_epu16(_mm_and_si128(bits, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040)),
+            _mm_mullo_epi16(_mm_and_si128(bits, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010)));
+        _mm_storeu_si128((__m128i *)dst, base64ToAsciiSsse3(sextets, url));
+        dst += 16;
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static __m256i base64ToAsciiAvx2(__m256i sextets, bool url) {
+    __m256i slot = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+    slot = _mm256_or_si256(slot, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets), _mm256_set1_epi8(13)));
+    const __m256i offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        url ? '-' - 62 : '+' - 62, url ? '_' - 63 : '/' - 63, 'A', 0, 0));
+    return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, slot), sextets);
+}
+
+__attribute__((target("avx2")))
+static size_t base64EncodeAvx2(const unsigned char *src, size_t len, char *dst, bool url) {
+    const __m256i spread = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    size_t i = 0;
+    // each lane loads 16 bytes and uses 12, the second lane starts 12 bytes in
+    for(; i + 28 <= len; i += 24) {
+        __m256i bits = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(src + i))),
+            _mm_loadu_si128((const __m128i *)(src + i + 12)), 1);
+        bits = _mm256_shuffle_epi8(bits, spread);
+        __m256i sextets = _mm256_or_si256(
+            _mm256_mulhi_epu16(_mm256_and_si256(bits, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040)),
+            _mm256_mullo_epi16(_mm256_and_si256(bits, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010)));
+        _mm256_storeu_si256((__m256i *)dst, base64ToAsciiAvx2(sextets, url));
+        dst += 32;
+    }
+    return i;
+}
+
+// maps - and _ onto + and /, so that the standard tables apply, false when the block holds
+// characters of the other alphabet which flags do not allow
+#define BASE64_URL_TO_STANDARD(chars, flags, set1, cmpeq, and, or, sub, movemask)              \
+    ({                                                                                        \
+        bool usable = true;                                                                   \
+        if((flags) & (string_base64_url | string_base64_lenient)) {                           \
+            if(!((flags) & string_base64_lenient)) {                                          \
+                usable = movemask(or(cmpeq(chars, set1('+')), cmpeq(chars, set1('/')))) == 0; \
+            }                                                                                 \
+            chars = sub(chars, and(cmpeq(chars, set1('-')), set1('-' - '+')));                \
+            chars = sub(chars, and(cmpeq(chars, set1('_')), set1('_' - '/')));                \
+        }                                                                                     \
+        usable;                                                                               \
+    })
+
+// the nibble tables accept exactly A-Z a-z 0-9 + /, roll turns a character into its sextet
+#define BASE64_LUT_LO 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define BASE64_LUT_HI 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define BASE64_LUT_ROLL 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+#define BASE64_PACK 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+
+__attribute__((target("ssse3")))
+static size_t base64DecodeSsse3(const unsigned char *src, size_t len, unsigned char *dst, size_t room,
+    stringBase64Flags_t flags) {
+    const __m128i lut_lo = _mm_setr_epi8(BASE64_LUT_LO);
+    const __m128i lut_hi = _mm_setr_epi8(BASE64_LUT_HI);
+    const __m128i lut_roll = _mm_setr_epi8(BASE64_LUT_ROLL);
+    const __m128i mask_2f = _mm_set1_epi8(0x2f);
+    size_t i = 0, o = 0;
+    for(; i + 16 <= len && o + 16 <= room; i += 16, o += 12) {
+        __m128i chars = _mm_loadu_si128((const __m128i *)(src + i));
+        if(!BASE64_URL_TO_STANDARD(chars, flags, _mm_set1_epi8, _mm_cmpeq_epi8, _mm_and_si128,
+            _mm_or_si128, _mm_sub_epi8, _mm_movemask_epi8)) break;
+        __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(chars, 4), mask_2f);
+        __m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(chars, mask_2f));
+        __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF) break;
+        __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(chars, mask_2f), hi_nibbles));
+        __m128i sextets = _mm_add_epi8(chars, roll);
+        __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+        __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i *)(dst + o), _mm_shuffle_epi8(words, _mm_setr_epi8(BASE64_PACK)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t base64DecodeAvx2(const unsigned char *src, size_t len, unsigned char *dst, size_t room,
+    stringBase64Flags_t flags) {
+    const __m256i lut_lo = _mm256_broadcastsi128_si256(_mm_setr_epi8(BASE64_LUT_LO));
+    const __m256i lut_hi = _mm256_broadcastsi128_si256(_mm_setr_epi8(BASE64_LUT_HI));
+    const __m256i lut_roll = _mm256_broadcastsi128_si256(_mm_setr_epi8(BASE64_LUT_ROLL));
+    const __m256i pack = _mm256_broadcastsi128_si256(_mm_setr_epi8(BASE64_PACK));
+    const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+    size_t i = 0, o = 0;
+    for(; i + 32 <= len && o + 32 <= room; i += 32, o += 24) {
+        __m256i chars = _mm256_loadu_si256((const __m256i *)(src + i));
+        if(!BASE64_URL_TO_STANDARD(chars, flags, _mm256_set1_epi8, _mm256_cmpeq_epi8, _mm256_and_si256,
+            _mm256_or_si256, _mm256_sub_epi8, _mm256_movemask_epi8)) break;
+        __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(chars, 4), mask_2f);
+        __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(chars, mask_2f));
+        __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        if(!_mm256_testz_si256(lo, hi)) break;
+        __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(chars, mask_2f), hi_nibbles));
+        __m256i sextets = _mm256_add_epi8(chars, roll);
+        __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+        __m256i words = _mm256_shuffle_epi8(_mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000)), pack);
+        // 12 bytes per lane, moved together
+        words = _mm256_permutevar8x32_epi32(words, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256((__m256i *)(dst + o), words);
+    }
+    return i;
+}
+
+#endif // CHAD_X86_SIMD
+
+// encodes len bytes, a multiple of 3, into len / 3 * 4 characters
+static void base64EncodeBlocks(const unsigned char *src, size_t len, char *dst, bool url) {
+    size_t done = 0;
+    #ifdef CHAD_X86_SIMD
+    if(__builtin_cpu_supports("avx2")) {
+        done = base64EncodeAvx2(src, len, dst, url);
+    }
+    if(__builtin_cpu_supports("ssse3")) {
+        done += base64EncodeSsse3(src + done, len - done, dst + done / 3 * 4, url);
+    }
+    #endif
+    base64EncodeScalar(src + done, len - done, dst + done / 3 * 4, url ? base64_url_chars : base64_standard_chars);
+}
+
+// encodes the last one or two bytes of the input, returns the characters written
+static size_t base64EncodeFinal(uint32_t bits, size_t count, char *dst, stringBase64Flags_t flags) {
+    if(count == 0) return 0;
+    const char *chars = flags & string_base64_url ? base64_url_chars : base64_standard_chars;
+    uint32_t v = bits << (8 * (3 - count));
+    dst[0] = chars[v >> 18];
+    dst[1] = chars[(v >> 12) & 63];
+    if(count == 2) dst[2] = chars[(v >> 6) & 63];
+    if(flags & string_base64_no_pad) return count + 1;
+    if(count == 1) dst[2] = '=';
+    dst[3] = '=';
+    return 4;
+}
+
+// decodes as far as the input goes, full quads only, the rest waits in the stream; dst has room
+// for (stream->count + len) / 4 * 3 bytes. false on input the flags do not allow, nothing counts
+// as written then
+static bool base64DecodeRun(stringBase64Stream_t *stream, const unsigned char *src, size_t len,
+    unsigned char *dst, size_t *written) {
+    stringBase64Flags_t flags = stream->flags;
+    bool lenient = flags & string_base64_lenient;
+    size_t room = (stream->count + len) / 4 * 3;
+    size_t i = 0, o = 0;
+    *written = 0;
+    while(i < len) {
+        if(stream->count == 0 && stream->padding == 0) {
+            size_t consumed = 0;
+            #ifdef CHAD_X86_SIMD
+            if(__builtin_cpu_supports("avx2")) {
+                consumed = base64DecodeAvx2(src + i, len - i, dst + o, room - o, flags);
+                i += consumed;
+                o += consumed / 4 * 3;
+            }
+            if(__builtin_cpu_supports("ssse3")) {
+                consumed = base64DecodeSsse3(src + i, len - i, dst + o, room - o, flags);
+                i += consumed;
+                o += consumed / 4 * 3;
+            }
+            #endif
+            // whole quads of ordinary characters
+            for(; i + 4 <= len; i += 4, o += 3) {
+                uint8_t a = base64_decode_table[src[i]], b = base64_decode_table[src[i + 1]];
+                uint8_t c = base64_decode_table[src[i + 2]], d = base64_decode_table[src[i + 3]];
+                if((a | b | c | d) >= 64) break;
+                uint32_t v = (uint32_t)a << 18 | (uint32_t)b << 12 | (uint32_t)c << 6 | d;
+                dst[o] = (unsigned char)(v >> 16);
+                dst[o + 1] = (unsigned char)(v >> 8);
+                dst[o + 2] = (unsigned char)v;
+            }
+            if(i >= len) break;
+        }
+        uint8_t code = base64_decode_table[src[i++]];
+        if(code == BASE64_WHITESPACE) {
+            if(!lenient) return false;
+            continue;
+        }
+        if(code == BASE64_PAD) {
+            if((flags & string_base64_no_pad) && !lenient) return false;
+            if(stream->count < 2 || stream->count + ++stream->padding > 4) return false;
+            continue;
+        }
+        code = base64Special(code, flags);
+        if(code == BASE64_INVALID || stream->padding) return false;
+        stream->bits = stream->bits << 6 | code;
+        if(++stream->count == 4) {
+            dst[o++] = (unsigned char)(stream->bits >> 16);
+            dst[o++] = (unsigned char)(stream->bits >> 8);
+            dst[o++] = (unsigned char)stream->bits;
+            stream->bits = 0;
+            stream->count = 0;
+        }
+    }
+    *written = o;
+    return true;
+}
+
+// decodes the partial quad left at the end, at most 2 bytes
+static bool base64DecodeFinal(stringBase64Stream_t *stream, unsigned char *dst, size_t *written) {
+    size_t count = stream->count;
+    *written = 0;
+    if(count == 0) return true;
+    if(count == 1) return false;
+    if(!(stream->flags & string_base64_lenient)) {
+        size_t padding = stream->flags & string_base64_no_pad ? 0 : 4 - count;
+        // the bits below the last byte must be zero, so that every input has one encoding
+        uint32_t unused = count == 2 ? 0xF : 0x3;
+        if(stream->padding != padding || (stream->bits & unused) != 0) return false;
+    }
+    uint32_t v = stream->bits << (6 * (4 - count));
+    dst[0] = (unsigned char)(v >> 16);
+    if(count == 3) dst[1] = (unsigned char)(v >> 8);
+    *written = count - 1;
+    stream->bits = 0;
+    stream->count = 0;
+    stream->padding = 0;
+    return true;
+}
+
+string stringBase64EncodeWith(string str, stringBase64Flags_t flags) {
+    const unsigned char *src = (const unsigned char *)str.at;
+    size_t len = stringlen(str);
+    size_t whole = len / 3 * 3;
+    size_t rest = len - whole;
+    size_t out_len = whole / 3 * 4 + (rest == 0 ? 0 : flags & string_base64_no_pad ? rest + 1 : 4);
+    stringHeader_t *result = allocStringHeader(out_len);
+    base64EncodeBlocks(src, whole, result->data, flags & string_base64_url);
+    uint32_t bits = 0;
+    for(size_t i = whole; i < len; i++) {
+        bits = bits << 8 | src[i];
+    }
+    base64EncodeFinal(bits, rest, result->data + whole / 3 * 4, flags);
+    result->data[out_len] = '\0';
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+string stringBase64Encode(string str) {
+    return stringBase64EncodeWith(str, string_base64_standard);
+}
+
+option(string) stringBase64DecodeWith(string str, stringBase64Flags_t flags) {
+    size_t len = stringlen(str);
+    stringBase64Stream_t stream = stringBase64StreamCreate(flags);
+    stringHeader_t *result = allocStringHeader(len / 4 * 3 + 2);
+    string ret = { .data = (dataSegmentOfString_t *)result->data };
+    unsigned char *dst = (unsigned char *)result->data;
+    size_t decoded, final;
+    if(!base64DecodeRun(&stream, (const unsigned char *)str.at, len, dst, &decoded)
+        || !base64DecodeFinal(&stream, dst + decoded, &final)) {
+        destroyString(ret);
+        return (option(string)) none;
+    }
+    result->length = decoded + final;
+    result->data[result->length] = '\0';
+    return (option(string)) some(ret);
 }
 
-int stringLastIndexOf(string haystack, char ch) {
-    for(size_t i = stringlen(haystack); i > 0; i--) {
-        if(haystack.at[i - 1] == ch) {
-            return (int)(i - 1);
-        }
-    }
-    return -1;
+option(string) stringBase64Decode(string str) {
+    return stringBase64DecodeWith(str, string_base64_standard);
 }
 
-string stringSubstring(string str, size_t start, size_t length) {
-    if(start >= stringlen(str)) {
-        return string("");
-    }
-    size_t end = start + length;
-    if(end > stringlen(str)) {
-        end = stringlen(str);
-    }
-    return stringSliceFromString(str, start, end);
+stringBase64Stream_t stringBase64StreamCreate(stringBase64Flags_t flags) {
+    return (stringBase64Stream_t) { .flags = flags };
 }
 
-dynarray(string) stringSplitLines(string str) {
-    dynarray(string) result = {};
-    size_t line_start = 0;
-    
-    for(size_t i = 0; i < stringlen(str); i++) {
-        if(str.at[i] == '\n') {
-            string line = stringSliceFromString(str, line_start, i);
-            dynarray_append(result, line);
-            line_start = i + 1;
-        } else if(str.at[i] == '\r') {
-            if(i + 1 < stringlen(str) && str.at[i + 1] == '\n') {
-                string line = stringSliceFromString(str, line_start, i);
-                dynarray_append(result, line);
-                line_start = i + 2;
-                i++;
-            } else {
-                string line = stringSliceFromString(str, line_start, i);
-                dynarray_append(result, line);
-                line_start = i + 1;
-            }
+void stringBase64EncodeChunk(stringBase64Stream_t *stream, stringBuilder_t *out, strview chunk) {
+    const unsigned char *src = (const unsigned char *)chunk.at;
+    size_t len = chunk.length;
+    // complete the group the previous chunk left over
+    if(stream->count > 0) {
+        while(stream->count < 3 && len > 0) {
+            stream->bits = stream->bits << 8 | *src++;
+            stream->count++;
+            len--;
         }
+        if(stream->count < 3) return;
+        const unsigned char group[3] = { (unsigned char)(stream->bits >> 16), (unsigned char)(stream->bits >> 8),
+            (unsigned char)stream->bits };
+        base64EncodeScalar(group, 3, builderTail(out, 4),
+            stream->flags & string_base64_url ? base64_url_chars : base64_standard_chars);
+        builderCommit(out, 4);
+        stream->bits = 0;
+        stream->count = 0;
+    }
+    size_t whole = len / 3 * 3;
+    if(whole > 0) {
+        char *tail = builderTail(out, whole / 3 * 4);
+        base64EncodeBlocks(src, whole, tail, stream->flags & string_base64_url);
+        builderCommit(out, whole / 3 * 4);
+    }
+    for(size_t i = whole; i < len; i++) {
+        stream->bits = stream->bits << 8 | src[i];
+        stream->count++;
     }
-    
-    if(line_start <= stringlen(str)) {
-        string line = stringSliceFromString(str, line_start, stringlen(str));
-        dynarray_append(result, line);
-    }
-    
-    return result;
 }
 
-string stringReplaceChar(string str, char find, char replace) {
-    string result = stringFromString(str);
-    for(size_t i = 0; i < stringlen(result); i++) {
-        if(result.at[i] == find) {
-            result.at[i] = replace;
-        }
-    }
-    return result;
+void stringBase64EncodeEnd(stringBase64Stream_t *stream, stringBuilder_t *out) {
+    char *tail = builderTail(out, 4);
+    builderCommit(out, base64EncodeFinal(stream->bits, stream->count, tail, stream->flags));
+    stream->bits = 0;
+    stream->count = 0;
 }
 
-string stringRemoveChar(string str, char to_remove) {
-    size_t new_len = 0;
-    for(size_t i = 0; i < stringlen(str); i++) {
-        if(str.at[i] != to_remove) {
-            new_len++;
-        }
-    }
-    
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + new_len + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringRemoveChar\n");
-        exit(EXIT_FAILURE);
-    }
-    result->allocated_bytes = sizeof(stringHeader_t) + new_len + 1;
-    result->length = new_len;
-    
-    size_t pos = 0;
-    for(size_t i = 0; i < stringlen(str); i++) {
-        if(str.at[i] != to_remove) {
-            result->data[pos++] = str.at[i];
-        }
-    }
-    result->data[new_len] = '\0';
-    
-    return (string) { .data = (dataSegmentOfString_t *)result->data };
+bool stringBase64DecodeChunk(stringBase64Stream_t *stream, stringBuilder_t *out, strview chunk) {
+    if(stream->failed) return false;
+    unsigned char *tail = (unsigned char *)builderTail(out, (stream->count + chunk.length) / 4 * 3);
+    size_t decoded;
+    stream->failed = !base64DecodeRun(stream, (const unsigned char *)chunk.at, chunk.length, tail, &decoded);
+    builderCommit(out, decoded);
+    return !stream->failed;
 }
 
-string stringTruncate(string str, size_t max_length, const char *suffix) {
-    if(stringlen(str) <= max_length) {
-        return stringFromString(str);
-    }
-    
-    size_t suffix_len = suffix ? my_strlen(suffix) : 0;
-    if(suffix_len >= max_length) {
-        return stringSliceFromString(str, 0, max_length);
-    }
-    
-    size_t truncate_at = max_length - suffix_len;
-    string truncated = stringSliceFromString(str, 0, truncate_at);
-    
-    if(suffix) {
-        string with_suffix = stringAppendCharPtr(truncated, suffix);
-        return with_suffix;
-    }
-    
-    return truncated;
+bool stringBase64DecodeEnd(stringBase64Stream_t *stream, stringBuilder_t *out) {
+    if(stream->failed) return false;
+    unsigned char *tail = (unsigned char *)builderTail(out, 2);
+    size_t decoded;
+    stream->failed = !base64DecodeFinal(stream, tail, &decoded);
+    builderCommit(out, decoded);
+    return !stream->failed;
 }
 
-
-bool stringToInt(string str, int *out) {
-    if(stringlen(str) == 0) return false;
-    
-    char *endptr;
-    long val = strtol(str.at, &endptr, 10);
+bool stringMatchWildcard(string str, string pattern) {
+    size_t s = 0, p = 0;
+    size_t star_idx = (size_t)-1;
+    size_t match_idx = 0;
     
-    if(endptr == str.at || *endptr != '\0') {
-        return false;
+    while(s < stringlen(str)) {
+        if(p < stringlen(pattern) && 
+           (pattern.at[p] == '?' || pattern.at[p] == str.at[s])) {
+            s++;
+            p++;
+        } else if(p < stringlen(pattern) && pattern.at[p] == '*') {
+            star_idx = p;
+            match_idx = s;
+            p++;
+        } else if(star_idx != (size_t)-1) {
+            p = star_idx + 1;
+            match_idx++;
+            s = match_idx;
+        } else {
+            return false;
+        }
     }
     
-    if(val > INT_MAX || val < INT_MIN) {
-        return false;
+    while(p < stringlen(pattern) && pattern.at[p] == '*') {
+        p++;
     }
     
-    if(out) *out = (int)val;
-    return true;
+    return p == stringlen(pattern);
 }
 
-bool stringToLong(string str, long *out) {
-    if(stringlen(str) == 0) return false;
-    
-    char *endptr;
-    long val = strtol(str.at, &endptr, 10);
-    
-    if(endptr == str.at || *endptr != '\0') {
-        return false;
-    }
-    
-    if(out) *out = val;
-    return true;
-}
+// compiled globs
+//
+// a glob is compiled once into a Glushkov automaton: every character, class or star of the
+// pattern becomes a position, and the transitions are the positions that may follow each other.
+// stars are positions that follow themselves and can be skipped. a pattern set joins the
+// automata of its patterns under one start position, so a single pass over the text answers
+// for all of them. the automaton is then turned into a DFA over byte classes (the bytes no
+// pattern tells apart share a column), which costs one table lookup per text byte. patterns
+// whose DFA would grow past GLOB_DFA_MAX_STATES keep the automaton and simulate it instead
+//
+// syntax: ? and * match one or any number of characters other than '/', ** also matches '/',
+// and a / ** / in the middle of a path also matches a single '/'. [a-z0-9_] and [!...] or
+// [^...] are classes, {a,b} alternatives which may nest, \ escapes the next character. an
+// unterminated [ or { is an ordinary character
 
-bool stringToDouble(string str, double *out) {
-    if(stringlen(str) == 0) return false;
-    
-    char *endptr;
-    double val = strtod(str.at, &endptr);
-    
-    if(endptr == str.at || *endptr != '\0') {
-        return false;
+#define GLOB_DFA_MAX_STATES 8192
+#define GLOB_DEAD 0
+#define GLOB_START 1
+
+struct stringGlobProgram {
+    size_t pattern_count;
+    size_t position_count;  // the start position is the last one
+    uint64_t (*classes)[4]; // bytes each position matches
+    uint32_t *owner;        // pattern each position belongs to
+    bool *is_last;          // the pattern matches when the text ends on this position
+    bool *nullable;         // per pattern, matches the empty text
+    uint32_t *follow_offset;
+    uint32_t *follow;       // follow[follow_offset[p] .. follow_offset[p + 1]], sorted
+    uint8_t byte_class[256];
+    uint8_t class_byte[256]; // a representative byte of each byte class
+    size_t class_count;
+    // dfa, state_count is 0 when the automaton is simulated instead
+    size_t state_count;
+    uint32_t *next;         // next[state * class_count + byte_class[c]]
+    uint32_t *match_offset;
+    uint32_t *matches;      // patterns matching in each state, sorted
+    bool *sticky;           // accepting and every byte stays in the state
+};
+
+typedef struct {
+    dynarray(uint32_t) first;
+    dynarray(uint32_t) last;
+    bool nullable;
+} globFragment_t;
+
+typedef struct {
+    stringGlobProgram_t *program;
+    dynarray(uint32_t) *follow; // per position, unsorted while parsing
+    const char *at;
+    size_t length;
+    size_t pos;
+    uint32_t pattern;
+} globParser_t;
+
+static void *globAlloc(size_t count, size_t size) {
+    void *ret = calloc(count ? count : 1, size);
+    if(!ret) {
+        fprintf(stderr, "failed to allocate memory in stringGlobCompile\n");
+        exit(EXIT_FAILURE);
     }
-    
-    if(out) *out = val;
-    return true;
+    return ret;
 }
 
-bool stringToBool(string str, bool *out) {
-    string lower = stringToLower(str);
-    string trimmed = stringTrim(lower);
-    
-    bool result = false;
-    bool valid = false;
-    
-    if(stringeql(trimmed, string("true")) || stringeql(trimmed, string("1")) || 
-       stringeql(trimmed, string("yes")) || stringeql(trimmed, string("on"))) {
-        result = true;
-        valid = true;
-    } else if(stringeql(trimmed, string("false")) || stringeql(trimmed, string("0")) || 
-              stringeql(trimmed, string("no")) || stringeql(trimmed, string("off"))) {
-        result = false;
-        valid = true;
-    }
-    
-    destroyString(lower);
-    destroyString(trimmed);
-    
-    if(valid && out) *out = result;
-    return valid;
+static void globClassSet(uint64_t class[4], unsigned char c) {
+    class[c >> 6] |= 1ull << (c & 63);
 }
 
-string stringFromInt(int value) {
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%d", value);
-    return stringFromCharPtr(buffer);
+static bool globClassHas(const uint64_t class[4], unsigned char c) {
+    return (class[c >> 6] >> (c & 63)) & 1;
 }
 
-string stringFromLong(long value) {
-    char buffer[64];
-    snprintf(buffer, sizeof(buffer), "%ld", value);
-    return stringFromCharPtr(buffer);
+static uint32_t globPosition(globParser_t *parser, const uint64_t class[4]) {
+    stringGlobProgram_t *program = parser->program;
+    uint32_t p = (uint32_t)program->position_count++;
+    memcpy(program->classes[p], class, sizeof(program->classes[p]));
+    program->owner[p] = parser->pattern;
+    return p;
 }
 
-string stringFromDouble(double value, int precision) {
-    char buffer[128];
-    if(precision < 0) {
-        snprintf(buffer, sizeof(buffer), "%f", value);
-    } else {
-        snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+static globFragment_t globAtom(globParser_t *parser, const uint64_t class[4], bool repeat) {
+    uint32_t p = globPosition(parser, class);
+    globFragment_t ret = { .nullable = repeat };
+    dynarray_append(ret.first, p);
+    dynarray_append(ret.last, p);
+    if(repeat) {
+        dynarray_append(parser->follow[p], p);
     }
-    return stringFromCharPtr(buffer);
+    return ret;
 }
 
-string stringFromBool(bool value) {
-    return value ? string("true") : string("false");
+static globFragment_t globLiteral(globParser_t *parser, unsigned char c) {
+    uint64_t class[4] = {};
+    globClassSet(class, c);
+    return globAtom(parser, class, false);
 }
 
-// string and hashing
-
-uint32_t stringHash(string str) {
-    // FNV-1a hash algorithm
-    uint32_t hash = 2166136261u;
-    for(size_t i = 0; i < stringlen(str); i++) {
-        hash ^= (uint8_t)str.at[i];
-        hash *= 16777619u;
+static void globAppendAll(dynarray(uint32_t) *dst, dynarray(uint32_t) src) {
+    for(size_t i = 0; i < src.count; i++) {
+        dynarray_append((*dst), src.at[i]);
     }
-    return hash;
 }
 
-uint64_t stringHash64(string str) {
-    // FNV-1a 64-bit hash algorithm
-    uint64_t hash = 14695981039346656037ULL;
-    for(size_t i = 0; i < stringlen(str); i++) {
-        hash ^= (uint8_t)str.at[i];
-        hash *= 1099511628211ULL;
-    }
-    return hash;
+static globFragment_t globConcat(globParser_t *parser, globFragment_t a, globFragment_t b) {
+    for(size_t i = 0; i < a.last.count; i++) {
+        globAppendAll(&parser->follow[a.last.at[i]], b.first);
+    }
+    if(a.nullable) globAppendAll(&a.first, b.first);
+    if(b.nullable) globAppendAll(&b.last, a.last);
+    globFragment_t ret = { .first = a.first, .last = b.last, .nullable = a.nullable && b.nullable };
+    destroy_dynarray(a.last);
+    destroy_dynarray(b.first);
+    return ret;
 }
 
-stringBuilder_t stringBuilderCreate(size_t initial_capacity) {
-    if(initial_capacity == 0) initial_capacity = 256;
-    
-    stringHeader_t *buf = malloc(sizeof(stringHeader_t) + initial_capacity);
-    if(!buf) {
-        fprintf(stderr, "failed to allocate memory in stringBuilderCreate\n");
-        exit(EXIT_FAILURE);
-    }
-    buf->allocated_bytes = sizeof(stringHeader_t) + initial_capacity;
-    buf->length = 0;
-    buf->data[0] = '\0';
-    
-    stringBuilder_t sb;
-    sb.buffer = (string) { .data = (dataSegmentOfString_t *)buf->data };
-    sb.capacity = initial_capacity;
-    return sb;
+static globFragment_t globUnion(globFragment_t a, globFragment_t b) {
+    globAppendAll(&a.first, b.first);
+    globAppendAll(&a.last, b.last);
+    a.nullable = a.nullable || b.nullable;
+    destroy_dynarray(b.first);
+    destroy_dynarray(b.last);
+    return a;
 }
 
-void stringBuilderAppend(stringBuilder_t *sb, string str) {
-    sb->buffer = stringAppendString(sb->buffer, str);
-    sb->capacity = stringbytesalloced(sb->buffer) - sizeof(stringHeader_t);
+// index of the '}' closing the '{' at open, or 0 when there is none
+static size_t globClosingBrace(const globParser_t *parser, size_t open) {
+    size_t depth = 0;
+    for(size_t i = open; i < parser->length; i++) {
+        if(parser->at[i] == '\\') {
+            i++;
+        } else if(parser->at[i] == '{') {
+            depth++;
+        } else if(parser->at[i] == '}' && --depth == 0) {
+            return i;
+        }
+    }
+    return 0;
 }
 
-void stringBuilderAppendCStr(stringBuilder_t *sb, const char *cstr) {
-    sb->buffer = stringAppendCharPtr(sb->buffer, cstr);
-    sb->capacity = stringbytesalloced(sb->buffer) - sizeof(stringHeader_t);
+// parses the class starting at the '[' at pos, false when it is not terminated
+static bool globParseClass(globParser_t *parser, uint64_t class[4]) {
+    size_t i = parser->pos + 1;
+    bool negate = i < parser->length && (parser->at[i] == '!' || parser->at[i] == '^');
+    if(negate) i++;
+    memset(class, 0, 4 * sizeof(uint64_t));
+    bool first = true;
+    while(i < parser->length && (first || parser->at[i] != ']')) {
+        first = false;
+        if(parser->at[i] == '\\' && i + 1 < parser->length) i++;
+        unsigned char low = (unsigned char)parser->at[i++];
+        unsigned char high = low;
+        if(i + 1 < parser->length && parser->at[i] == '-' && parser->at[i + 1] != ']') {
+            i++;
+            if(parser->at[i] == '\\' && i + 1 < parser->length) i++;
+            high = (unsigned char)parser->at[i++];
+        }
+        for(unsigned c = low; c <= high; c++) {
+            globClassSet(class, (unsigned char)c);
+        }
+    }
+    if(i >= parser->length) return false;
+    if(negate) {
+        for(size_t w = 0; w < 4; w++) class[w] = ~class[w];
+        class['/' >> 6] &= ~(1ull << ('/' & 63));
+    }
+    parser->pos = i + 1;
+    return true;
 }
 
-void stringBuilderAppendChar(stringBuilder_t *sb, char ch) {
-    sb->buffer = stringAppendChar(sb->buffer, ch);
-    sb->capacity = stringbytesalloced(sb->buffer) - sizeof(stringHeader_t);
-}
+static globFragment_t globParseSequence(globParser_t *parser, size_t depth);
 
-void stringBuilderAppendFormat(stringBuilder_t *sb, const char *fmt, ...) {
-    va_list args;
-    va_start(args, fmt);
-    string formatted = stringFormatVa(fmt, args);
-    va_end(args);
-    
-    stringBuilderAppend(sb, formatted);
-    destroyString(formatted);
+static globFragment_t globParseAtom(globParser_t *parser, bool at_segment_start) {
+    uint64_t any_but_slash[4] = { ~0ull, ~0ull, ~0ull, ~0ull };
+    any_but_slash['/' >> 6] &= ~(1ull << ('/' & 63));
+    char c = parser->at[parser->pos];
+    switch(c) {
+        case '*': {
+            size_t stars = 0;
+            while(parser->pos < parser->length && parser->at[parser->pos] == '*') {
+                parser->pos++;
+                stars++;
+            }
+            if(stars == 1) return globAtom(parser, any_but_slash, true);
+            uint64_t any[4] = { ~0ull, ~0ull, ~0ull, ~0ull };
+            globFragment_t ret = globAtom(parser, any, true);
+            if(at_segment_start && parser->pos < parser->length && parser->at[parser->pos] == '/') {
+                // "**/" may also match nothing at all, a/**/b matches a/b
+                parser->pos++;
+                ret = globConcat(parser, ret, globLiteral(parser, '/'));
+                ret.nullable = true;
+            }
+            return ret;
+        }
+        case '?':
+            parser->pos++;
+            return globAtom(parser, any_but_slash, false);
+        case '[': {
+            uint64_t class[4];
+            if(globParseClass(parser, class)) return globAtom(parser, class, false);
+            break;
+        }
+        case '{': {
+            size_t close = globClosingBrace(parser, parser->pos);
+            if(close == 0) break;
+            parser->pos++;
+            globFragment_t ret = globParseSequence(parser, 1);
+            while(parser->at[parser->pos] == ',') {
+                parser->pos++;
+                ret = globUnion(ret, globParseSequence(parser, 1));
+            }
+            parser->pos++; // '}'
+            return ret;
+        }
+        case '\\':
+            if(parser->pos + 1 < parser->length) parser->pos++;
+            break;
+    }
+    return globLiteral(parser, (unsigned char)parser->at[parser->pos++]);
 }
 
-string stringBuilderToString(stringBuilder_t *sb) {
-    return stringFromString(sb->buffer);
+static globFragment_t globParseSequence(globParser_t *parser, size_t depth) {
+    globFragment_t ret = { .nullable = true };
+    while(parser->pos < parser->length) {
+        char c = parser->at[parser->pos];
+        if(depth > 0 && (c == ',' || c == '}')) break;
+        bool at_segment_start = parser->pos == 0 || parser->at[parser->pos - 1] == '/';
+        ret = globConcat(parser, ret, globParseAtom(parser, at_segment_start));
+    }
+    return ret;
 }
 
-void stringBuilderClear(stringBuilder_t *sb) {
-    getHeaderPointer(sb->buffer)->length = 0;
-    sb->buffer.at[0] = '\0';
+static int globCompareIds(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
 }
 
-void stringBuilderDestroy(stringBuilder_t *sb) {
-    destroyString(sb->buffer);
-    sb->capacity = 0;
+// sorts and removes duplicates, returns the new count
+static size_t globSortUnique(uint32_t *ids, size_t count) {
+    if(count < 2) return count;
+    qsort(ids, count, sizeof(uint32_t), globCompareIds);
+    size_t out = 1;
+    for(size_t i = 1; i < count; i++) {
+        if(ids[i] != ids[out - 1]) ids[out++] = ids[i];
+    }
+    return out;
 }
 
-string stringRemoveDuplicates(string str) {
-    if(stringlen(str) <= 1) return stringFromString(str);
-    
-    bool seen[256] = {false};
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + stringlen(str) + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringRemoveDuplicates\n");
-        exit(EXIT_FAILURE);
-    }
-    result->allocated_bytes = sizeof(stringHeader_t) + stringlen(str) + 1;
-    result->length = 0;
-    
-    for(size_t i = 0; i < stringlen(str); i++) {
-        unsigned char ch = (unsigned char)str.at[i];
-        if(!seen[ch]) {
-            seen[ch] = true;
-            result->data[result->length++] = str.at[i];
+// splits the bytes into classes that every position either matches entirely or not at all
+static void globByteClasses(stringGlobProgram_t *program) {
+    memset(program->byte_class, 0, sizeof(program->byte_class));
+    size_t count = 1;
+    for(size_t p = 0; p + 1 < program->position_count; p++) {
+        int16_t split[2][256];
+        memset(split, -1, sizeof(split));
+        size_t new_count = 0;
+        for(size_t c = 0; c < 256; c++) {
+            bool has = globClassHas(program->classes[p], (unsigned char)c);
+            int16_t *slot = &split[has][program->byte_class[c]];
+            if(*slot < 0) *slot = (int16_t)new_count++;
+            program->byte_class[c] = (uint8_t)*slot;
         }
+        count = new_count;
+        if(count == 256) break;
+    }
+    program->class_count = count;
+    for(size_t c = 256; c-- > 0;) {
+        program->class_byte[program->byte_class[c]] = (uint8_t)c;
     }
-    result->data[result->length] = '\0';
-    
-    return (string) { .data = (dataSegmentOfString_t *)result->data };
 }
 
-string stringIntersect(string a, string b) {
-    bool in_b[256] = {false};
-    bool added[256] = {false};
-    
-    for(size_t i = 0; i < stringlen(b); i++) {
-        in_b[(unsigned char)b.at[i]] = true;
+// positions reachable from set on byte c, set and out are sorted, mark has position_count bits
+static size_t globStep(const stringGlobProgram_t *program, const uint32_t *set, size_t count,
+    unsigned char c, uint64_t *mark, uint32_t *out) {
+    size_t out_count = 0;
+    for(size_t i = 0; i < count; i++) {
+        for(uint32_t f = program->follow_offset[set[i]]; f < program->follow_offset[set[i] + 1]; f++) {
+            uint32_t q = program->follow[f];
+            if(!globClassHas(program->classes[q], c) || (mark[q >> 6] >> (q & 63)) & 1) continue;
+            mark[q >> 6] |= 1ull << (q & 63);
+            out[out_count++] = q;
+        }
     }
-    
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + stringlen(a) + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringIntersect\n");
-        exit(EXIT_FAILURE);
+    for(size_t i = 0; i < out_count; i++) {
+        mark[out[i] >> 6] &= ~(1ull << (out[i] & 63));
     }
-    result->allocated_bytes = sizeof(stringHeader_t) + stringlen(a) + 1;
-    result->length = 0;
-    
-    for(size_t i = 0; i < stringlen(a); i++) {
-        unsigned char ch = (unsigned char)a.at[i];
-        if(in_b[ch] && !added[ch]) {
-            added[ch] = true;
-            result->data[result->length++] = a.at[i];
+    if(out_count > 1) qsort(out, out_count, sizeof(uint32_t), globCompareIds);
+    return out_count;
+}
+
+// patterns accepting a position set, written to out, returns their count
+static size_t globSetMatches(const stringGlobProgram_t *program, const uint32_t *set, size_t count,
+    uint32_t *out) {
+    size_t out_count = 0;
+    uint32_t start = (uint32_t)program->position_count - 1;
+    for(size_t i = 0; i < count; i++) {
+        if(set[i] == start) {
+            for(size_t k = 0; k < program->pattern_count; k++) {
+                if(program->nullable[k]) out[out_count++] = (uint32_t)k;
+            }
+        } else if(program->is_last[set[i]]) {
+            out[out_count++] = program->owner[set[i]];
         }
     }
-    result->data[result->length] = '\0';
-    
-    return (string) { .data = (dataSegmentOfString_t *)result->data };
+    return globSortUnique(out, out_count);
+}
+
+typedef struct {
+    dynarray(uint32_t) pool;   // the position sets of all states back to back
+    dynarray(uint32_t) offset; // state s is pool[offset[s] .. offset[s + 1]]
+    uint32_t *table;           // open addressing, state index + 1, 0 is empty
+    size_t table_size;
+} globStates_t;
+
+static uint64_t globHashSet(const uint32_t *set, size_t count) {
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ count;
+    for(size_t i = 0; i < count; i++) {
+        h = (h ^ set[i]) * 0xff51afd7ed558ccdull;
+        h ^= h >> 32;
+    }
+    return h;
 }
 
-string stringDifference(string a, string b) {
-    bool in_b[256] = {false};
-    
-    for(size_t i = 0; i < stringlen(b); i++) {
-        in_b[(unsigned char)b.at[i]] = true;
+static bool globStateIs(const globStates_t *states, uint32_t s, const uint32_t *set, size_t count) {
+    size_t begin = states->offset.at[s], end = states->offset.at[s + 1];
+    return end - begin == count && memcmp(states->pool.at + begin, set, count * sizeof(uint32_t)) == 0;
+}
+
+static void globStatesRehash(globStates_t *states) {
+    size_t state_count = states->offset.count - 1;
+    free(states->table);
+    states->table_size = states->table_size ? states->table_size * 2 : 64;
+    states->table = globAlloc(states->table_size, sizeof(uint32_t));
+    for(uint32_t s = 0; s < state_count; s++) {
+        size_t begin = states->offset.at[s];
+        uint64_t h = globHashSet(states->pool.at + begin, states->offset.at[s + 1] - begin);
+        size_t slot = h & (states->table_size - 1);
+        while(states->table[slot]) slot = (slot + 1) & (states->table_size - 1);
+        states->table[slot] = s + 1;
     }
-    
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + stringlen(a) + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringDifference\n");
-        exit(EXIT_FAILURE);
+}
+
+// state index of a position set, adding it when it is new
+static uint32_t globStateFor(globStates_t *states, const uint32_t *set, size_t count) {
+    if(2 * states->offset.count >= states->table_size) {
+        globStatesRehash(states);
     }
-    result->allocated_bytes = sizeof(stringHeader_t) + stringlen(a) + 1;
-    result->length = 0;
-    
-    for(size_t i = 0; i < stringlen(a); i++) {
-        unsigned char ch = (unsigned char)a.at[i];
-        if(!in_b[ch]) {
-            result->data[result->length++] = a.at[i];
-        }
+    size_t slot = globHashSet(set, count) & (states->table_size - 1);
+    for(; states->table[slot]; slot = (slot + 1) & (states->table_size - 1)) {
+        if(globStateIs(states, states->table[slot] - 1, set, count)) return states->table[slot] - 1;
     }
-    result->data[result->length] = '\0';
-    
-    return (string) { .data = (dataSegmentOfString_t *)result->data };
+    uint32_t s = (uint32_t)states->offset.count - 1;
+    for(size_t i = 0; i < count; i++) {
+        dynarray_append(states->pool, set[i]);
+    }
+    dynarray_append(states->offset, (uint32_t)states->pool.count);
+    states->table[slot] = s + 1;
+    return s;
 }
 
-string stringEscapeC(string str) {
-    stringBuilder_t sb = stringBuilderCreate(stringlen(str) * 2);
-    
-    for(size_t i = 0; i < stringlen(str); i++) {
-        char ch = str.at[i];
-        switch(ch) {
-            case '\n': stringBuilderAppendCStr(&sb, "\\n"); break;
-            case '\r': stringBuilderAppendCStr(&sb, "\\r"); break;
-            case '\t': stringBuilderAppendCStr(&sb, "\\t"); break;
-            case '\b': stringBuilderAppendCStr(&sb, "\\b"); break;
-            case '\f': stringBuilderAppendCStr(&sb, "\\f"); break;
-            case '\\': stringBuilderAppendCStr(&sb, "\\\\"); break;
-            case '\"': stringBuilderAppendCStr(&sb, "\\\""); break;
-            case '\'': stringBuilderAppendCStr(&sb, "\\'"); break;
-            default:
-                if(ch >= 32 && ch <= 126) {
-                    stringBuilderAppendChar(&sb, ch);
-                } else {
-                    char hex[8];
-                    snprintf(hex, sizeof(hex), "\\x%02x", (unsigned char)ch);
-                    stringBuilderAppendCStr(&sb, hex);
+static void globBuildDfa(stringGlobProgram_t *program) {
+    size_t positions = program->position_count;
+    size_t classes = program->class_count;
+    uint64_t *mark = globAlloc((positions + 63) / 64, sizeof(uint64_t));
+    uint32_t *set = globAlloc(positions, sizeof(uint32_t));
+    uint32_t *ids = globAlloc(positions + program->pattern_count, sizeof(uint32_t));
+    globStates_t states = {};
+    dynarray_append(states.offset, 0);
+    globStateFor(&states, NULL, 0); // GLOB_DEAD
+    uint32_t start = (uint32_t)positions - 1;
+    globStateFor(&states, &start, 1); // GLOB_START
+
+    size_t capacity = 64;
+    uint32_t *next = globAlloc(capacity * classes, sizeof(uint32_t));
+    dynarray(uint32_t) match_offset = {};
+    dynarray(uint32_t) matches = {};
+    bool complete = true;
+    for(uint32_t s = 0; s + 1 < states.offset.count; s++) {
+        if(states.offset.count - 1 > GLOB_DFA_MAX_STATES) {
+            complete = false;
+            break;
+        }
+        size_t begin = states.offset.at[s], count = states.offset.at[s + 1] - begin;
+        // the pool may move while states are added, the set is copied out first
+        memcpy(set, states.pool.at + begin, count * sizeof(uint32_t));
+        size_t match_count = globSetMatches(program, set, count, ids);
+        dynarray_append(match_offset, (uint32_t)matches.count);
+        for(size_t i = 0; i < match_count; i++) {
+            dynarray_append(matches, ids[i]);
+        }
+        for(size_t c = 0; c < classes; c++) {
+            size_t next_count = globStep(program, set, count, program->class_byte[c], mark, ids);
+            uint32_t target = globStateFor(&states, ids, next_count);
+            if(states.offset.count - 1 > capacity) {
+                capacity *= 2;
+                next = realloc(next, capacity * classes * sizeof(uint32_t));
+                if(!next) {
+                    fprintf(stderr, "failed to allocate memory in stringGlobCompile\n");
+                    exit(EXIT_FAILURE);
                 }
-                break;
+            }
+            next[s * classes + c] = target;
         }
     }
-    
-    string result = stringBuilderToString(&sb);
-    stringBuilderDestroy(&sb);
-    return result;
+    if(complete) {
+        size_t state_count = states.offset.count - 1;
+        dynarray_append(match_offset, (uint32_t)matches.count);
+        program->state_count = state_count;
+        program->next = next;
+        program->match_offset = match_offset.at;
+        program->matches = matches.at;
+        program->sticky = globAlloc(state_count, sizeof(bool));
+        for(size_t s = 0; s < state_count; s++) {
+            bool sticky = match_offset.at[s + 1] > match_offset.at[s];
+            for(size_t c = 0; c < classes && sticky; c++) {
+                sticky = next[s * classes + c] == s;
+            }
+            program->sticky[s] = sticky;
+        }
+    } else {
+        free(next);
+        destroy_dynarray(match_offset);
+        destroy_dynarray(matches);
+    }
+    destroy_dynarray(states.pool);
+    destroy_dynarray(states.offset);
+    free(states.table);
+    free(ids);
+    free(set);
+    free(mark);
 }
 
-string stringUnescapeC(string str) {
-    stringBuilder_t sb = stringBuilderCreate(stringlen(str));
-    
-    for(size_t i = 0; i < stringlen(str); i++) {
-        if(str.at[i] == '\\' && i + 1 < stringlen(str)) {
-            i++;
-            switch(str.at[i]) {
-                case 'n': stringBuilderAppendChar(&sb, '\n'); break;
-                case 'r': stringBuilderAppendChar(&sb, '\r'); break;
-                case 't': stringBuilderAppendChar(&sb, '\t'); break;
-                case 'b': stringBuilderAppendChar(&sb, '\b'); break;
-                case 'f': stringBuilderAppendChar(&sb, '\f'); break;
-                case '\\': stringBuilderAppendChar(&sb, '\\'); break;
-                case '\"': stringBuilderAppendChar(&sb, '\"'); break;
-                case '\'': stringBuilderAppendChar(&sb, '\''); break;
-                case 'x':
-                    if(i + 2 < stringlen(str)) {
-                        char hex[3] = {str.at[i+1], str.at[i+2], '\0'};
-                        char *endptr;
-                        long val = strtol(hex, &endptr, 16);
-                        if(endptr != hex) {
-                            stringBuilderAppendChar(&sb, (char)val);
-                            i += 2;
-                        } else {
-                            stringBuilderAppendChar(&sb, str.at[i]);
-                        }
-                    } else {
-                        stringBuilderAppendChar(&sb, str.at[i]);
-                    }
-                    break;
-                default:
-                    stringBuilderAppendChar(&sb, str.at[i]);
-                    break;
-            }
-        } else {
-            stringBuilderAppendChar(&sb, str.at[i]);
+stringGlob_t stringGlobCompileSet(dynarray(string) patterns) {
+    stringGlobProgram_t *program = globAlloc(1, sizeof(stringGlobProgram_t));
+    // every position consumes at least one pattern byte, plus the start position
+    size_t max_positions = 1;
+    for(size_t k = 0; k < patterns.count; k++) {
+        max_positions += stringlen(patterns.at[k]);
+    }
+    program->pattern_count = patterns.count;
+    program->classes = globAlloc(max_positions, sizeof(program->classes[0]));
+    program->owner = globAlloc(max_positions, sizeof(uint32_t));
+    program->is_last = globAlloc(max_positions, sizeof(bool));
+    program->nullable = globAlloc(patterns.count, sizeof(bool));
+    globParser_t parser = { .program = program };
+    parser.follow = globAlloc(max_positions, sizeof(parser.follow[0]));
+
+    dynarray(uint32_t) start_follow = {};
+    for(size_t k = 0; k < patterns.count; k++) {
+        parser.at = patterns.at[k].at;
+        parser.length = stringlen(patterns.at[k]);
+        parser.pos = 0;
+        parser.pattern = (uint32_t)k;
+        globFragment_t fragment = globParseSequence(&parser, 0);
+        for(size_t i = 0; i < fragment.last.count; i++) {
+            program->is_last[fragment.last.at[i]] = true;
         }
+        program->nullable[k] = fragment.nullable;
+        globAppendAll(&start_follow, fragment.first);
+        destroy_dynarray(fragment.first);
+        destroy_dynarray(fragment.last);
     }
-    
-    string result = stringBuilderToString(&sb);
-    stringBuilderDestroy(&sb);
-    return result;
+    uint32_t start = (uint32_t)program->position_count++;
+    parser.follow[start] = start_follow;
+
+    // flatten the follow lists
+    size_t total = 0;
+    for(size_t p = 0; p < program->position_count; p++) {
+        parser.follow[p].count = globSortUnique(parser.follow[p].at, parser.follow[p].count);
+        total += parser.follow[p].count;
+    }
+    program->follow_offset = globAlloc(program->position_count + 1, sizeof(uint32_t));
+    program->follow = globAlloc(total, sizeof(uint32_t));
+    total = 0;
+    for(size_t p = 0; p < program->position_count; p++) {
+        program->follow_offset[p] = (uint32_t)total;
+        if(parser.follow[p].count) {
+            memcpy(program->follow + total, parser.follow[p].at, parser.follow[p].count * sizeof(uint32_t));
+        }
+        total += parser.follow[p].count;
+        destroy_dynarray(parser.follow[p]);
+    }
+    program->follow_offset[program->position_count] = (uint32_t)total;
+    free(parser.follow);
+
+    globByteClasses(program);
+    globBuildDfa(program);
+    return (stringGlob_t) { .program = program };
 }
 
-string stringToHex(string str) {
-    stringBuilder_t sb = stringBuilderCreate(stringlen(str) * 2);
-    
-    for(size_t i = 0; i < stringlen(str); i++) {
-        char hex[3];
-        snprintf(hex, sizeof(hex), "%02x", (unsigned char)str.at[i]);
-        stringBuilderAppendCStr(&sb, hex);
+stringGlob_t stringGlobCompile(string pattern) {
+    dynarray(string) patterns = {};
+    dynarray_append(patterns, pattern);
+    stringGlob_t ret = stringGlobCompileSet(patterns);
+    destroy_dynarray(patterns);
+    return ret;
+}
+
+void destroyStringGlob(stringGlob_t glob) {
+    stringGlobProgram_t *program = glob.program;
+    if(!program) return;
+    free(program->classes);
+    free(program->owner);
+    free(program->is_last);
+    free(program->nullable);
+    free(program->follow_offset);
+    free(program->follow);
+    free(program->next);
+    free(program->match_offset);
+    free(program->matches);
+    free(program->sticky);
+    free(program);
+}
+
+// runs the dfa over str, the state it stops in
+static uint32_t globRunDfa(const stringGlobProgram_t *program, string str) {
+    const unsigned char *at = (const unsigned char *)str.at;
+    size_t len = stringlen(str);
+    size_t classes = program->class_count;
+    uint32_t s = GLOB_START;
+    for(size_t i = 0; i < len; i++) {
+        s = program->next[s * classes + program->byte_class[at[i]]];
+        if(s == GLOB_DEAD || program->sticky[s]) break;
     }
-    
-    string result = stringBuilderToString(&sb);
-    stringBuilderDestroy(&sb);
-    return result;
+    return s;
 }
 
-string stringFromHex(string hex_str) {
-    if(stringlen(hex_str) % 2 != 0) {
-        return string("");
+// simulates the automaton over str, writes the matching patterns to ids and returns their count
+static size_t globRunAutomaton(const stringGlobProgram_t *program, string str, uint32_t *ids) {
+    size_t positions = program->position_count;
+    uint64_t *mark = globAlloc((positions + 63) / 64, sizeof(uint64_t));
+    uint32_t *set = globAlloc(2 * positions, sizeof(uint32_t));
+    uint32_t *other = set + positions;
+    set[0] = (uint32_t)positions - 1;
+    size_t count = 1;
+    size_t len = stringlen(str);
+    for(size_t i = 0; i < len && count > 0; i++) {
+        count = globStep(program, set, count, (unsigned char)str.at[i], mark, other);
+        uint32_t *swap = set;
+        set = other;
+        other = swap;
+    }
+    size_t ret = globSetMatches(program, set, count, ids);
+    free(set < other ? set : other);
+    free(mark);
+    return ret;
+}
+
+bool stringGlobMatch(stringGlob_t glob, string str) {
+    return stringGlobMatchFirst(glob, str) >= 0;
+}
+
+int stringGlobMatchFirst(stringGlob_t glob, string str) {
+    const stringGlobProgram_t *program = glob.program;
+    if(program->state_count) {
+        uint32_t s = globRunDfa(program, str);
+        if(program->match_offset[s + 1] == program->match_offset[s]) return -1;
+        return (int)program->matches[program->match_offset[s]];
+    }
+    // one entry per accepting position before duplicates are dropped, as in globBuildDfa
+    uint32_t *ids = globAlloc(program->position_count + program->pattern_count, sizeof(uint32_t));
+    size_t count = globRunAutomaton(program, str, ids);
+    int ret = count ? (int)ids[0] : -1;
+    free(ids);
+    return ret;
+}
+
+dynarray(size_t) stringGlobMatchAll(stringGlob_t glob, string str) {
+    const stringGlobProgram_t *program = glob.program;
+    dynarray(size_t) ret = {};
+    if(program->state_count) {
+        uint32_t s = globRunDfa(program, str);
+        for(uint32_t i = program->match_offset[s]; i < program->match_offset[s + 1]; i++) {
+            dynarray_append(ret, (size_t)program->matches[i]);
+        }
+        return ret;
     }
-    
-    size_t result_len = stringlen(hex_str) / 2;
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + result_len + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringFromHex\n");
-        exit(EXIT_FAILURE);
+    // one entry per accepting position before duplicates are dropped, as in globBuildDfa
+    uint32_t *ids = globAlloc(program->position_count + program->pattern_count, sizeof(uint32_t));
+    size_t count = globRunAutomaton(program, str, ids);
+    for(size_t i = 0; i < count; i++) {
+        dynarray_append(ret, (size_t)ids[i]);
     }
-    result->allocated_bytes = sizeof(stringHeader_t) + result_len + 1;
-    result->length = result_len;
-    
-    for(size_t i = 0; i < result_len; i++) {
-        char hex[3] = {hex_str.at[i*2], hex_str.at[i*2+1], '\0'};
-        char *endptr;
-        long val = strtol(hex, &endptr, 16);
-        if(endptr == hex || *endptr != '\0') {
-            free(result);
-            return string("");
+    free(ids);
+    return ret;
+}
+
+bool stringMatchGlob(string str, string pattern) {
+    stringGlob_t glob = stringGlobCompile(pattern);
+    bool ret = stringGlobMatch(glob, str);
+    destroyStringGlob(glob);
+    return ret;
+}
+
+// edit distance
+//
+// Myers' bit-vector algorithm in Hyyrö's formulation for edit distance: a column of the DP table
+// is kept as its vertical deltas, +1 bits in pv and -1 bits in mv, one 64 bit word per 64
+// pattern characters. a text character advances a whole word with a handful of logic ops, longer
+// patterns pass the horizontal delta of each word's last row on to the next word as a carry. the
+// last row only moves by one per column, which lets a bounded search stop as soon as the rest of
+// the text cannot bring it back under the bound
+
+typedef struct {
+    size_t length;
+    size_t blocks;
+    uint64_t *peq;        // peq[c * blocks + b]: bit i set when pattern[b * 64 + i] == c
+    uint64_t single[256]; // storage for peq while the pattern fits a single word
+} levPattern_t;
+
+static void levPatternInit(levPattern_t *pattern, const char *at, size_t length) {
+    pattern->length = length;
+    pattern->blocks = (length + 63) / 64;
+    if(pattern->blocks <= 1) {
+        memset(pattern->single, 0, sizeof(pattern->single));
+        pattern->peq = pattern->single;
+    } else {
+        pattern->peq = calloc(256 * pattern->blocks, sizeof(uint64_t));
+        if(pattern->peq == NULL) {
+            fprintf(stderr, "failed to allocate memory in levPatternInit\n");
+            exit(EXIT_FAILURE);
         }
-        result->data[i] = (char)val;
     }
-    result->data[result_len] = '\0';
-    
-    return (string) { .data = (dataSegmentOfString_t *)result->data };
+    for(size_t i = 0; i < length; i++) {
+        pattern->peq[(unsigned char)at[i] * pattern->blocks + i / 64] |= 1ull << (i % 64);
+    }
 }
 
-string stringBase64Encode(string str) {
-    static const char base64_chars[] = 
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    
-    size_t in_len = stringlen(str);
-    size_t out_len = 4 * ((in_len + 2) / 3);
-    
-    stringHeader_t *result = malloc(sizeof(stringHeader_t) + out_len + 1);
-    if(!result) {
-        fprintf(stderr, "failed to allocate memory in stringBase64Encode\n");
+static void levPatternFree(levPattern_t *pattern) {
+    if(pattern->peq != pattern->single) {
+        free(pattern->peq);
+    }
+}
+
+// once the last row is past max by more than the columns left, it cannot come back
+static inline bool levHopeless(size_t score, size_t max, size_t columns_left) {
+    return score > max && score - max > columns_left;
+}
+
+static size_t levSingleWord(const levPattern_t *pattern, const unsigned char *text, size_t n, size_t max) {
+    uint64_t pv = ~0ull, mv = 0;
+    uint64_t last = 1ull << (pattern->length - 1);
+    size_t score = pattern->length;
+    for(size_t j = 0; j < n; j++) {
+        uint64_t eq = pattern->peq[text[j]];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        score += (ph & last) != 0;
+        score -= (mh & last) != 0;
+        // row 0 of the table is 0, 1, 2, ... so every column enters with a +1
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        if(levHopeless(score, max, n - j - 1)) return max + 1;
+    }
+    return score <= max ? score : max + 1;
+}
+
+static size_t levBlocked(const levPattern_t *pattern, const unsigned char *text, size_t n, size_t max) {
+    size_t blocks = pattern->blocks;
+    uint64_t *pv = malloc(2 * blocks * sizeof(uint64_t));
+    if(pv == NULL) {
+        fprintf(stderr, "failed to allocate memory in levBlocked\n");
         exit(EXIT_FAILURE);
     }
-    result->allocated_bytes = sizeof(stringHeader_t) + out_len + 1;
-    result->length = out_len;
-    
-    size_t i = 0, j = 0;
-    unsigned char array_3[3];
-    unsigned char array_4[4];
-    
-    while(in_len--) {
-        array_3[i++] = str.at[j++];
-        if(i == 3) {
-            array_4[0] = (array_3[0] & 0xfc) >> 2;
-            array_4[1] = ((array_3[0] & 0x03) << 4) + ((array_3[1] & 0xf0) >> 4);
-            array_4[2] = ((array_3[1] & 0x0f) << 2) + ((array_3[2] & 0xc0) >> 6);
-            array_4[3] = array_3[2] & 0x3f;
-            
-            for(i = 0; i < 4; i++) {
-            	assert((j - 3 + i) >= 0);
-                result->data[j - 3 + i] = base64_chars[array_4[i]];
+    uint64_t *mv = pv + blocks;
+    for(size_t b = 0; b < blocks; b++) {
+        pv[b] = ~0ull;
+        mv[b] = 0;
+    }
+    uint64_t last = 1ull << ((pattern->length - 1) % 64);
+    size_t score = pattern->length;
+    for(size_t j = 0; j < n; j++) {
+        const uint64_t *eqs = pattern->peq + (size_t)text[j] * blocks;
+        int carry = 1;
+        for(size_t b = 0; b < blocks; b++) {
+            uint64_t high = b + 1 == blocks ? last : 1ull << 63;
+            uint64_t eq = eqs[b];
+            uint64_t xv = eq | mv[b];
+            if(carry < 0) eq |= 1;
+            uint64_t xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+            uint64_t ph = mv[b] | ~(xh | pv[b]);
+            uint64_t mh = pv[b] & xh;
+            int carry_out = ((ph & high) != 0) - ((mh & high) != 0);
+            ph <<= 1;
+            mh <<= 1;
+            if(carry < 0) {
+                mh |= 1;
+            } else if(carry > 0) {
+                ph |= 1;
             }
-            i = 0;
-        }
-    }
-    
-    if(i) {
-        for(size_t k = i; k < 3; k++) {
-            array_3[k] = '\0';
-        }
-        
-        array_4[0] = (array_3[0] & 0xfc) >> 2;
-        array_4[1] = ((array_3[0] & 0x03) << 4) + ((array_3[1] & 0xf0) >> 4);
-        array_4[2] = ((array_3[1] & 0x0f) << 2) + ((array_3[2] & 0xc0) >> 6);
-        
-        for(size_t k = 0; k < i + 1; k++) {
-            result->data[j++] = base64_chars[array_4[k]];
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+            carry = carry_out;
         }
-        
-        while(i++ < 3) {
-            result->data[j++] = '=';
+        score += carry;
+        if(levHopeless(score, max, n - j - 1)) {
+            free(pv);
+            return max + 1;
         }
     }
-    
-    result->data[out_len] = '\0';
-    return (string) { .data = (dataSegmentOfString_t *)result->data };
+    free(pv);
+    return score <= max ? score : max + 1;
 }
 
-bool stringMatchWildcard(string str, string pattern) {
-    size_t s = 0, p = 0;
-    size_t star_idx = (size_t)-1;
-    size_t match_idx = 0;
-    
-    while(s < stringlen(str)) {
-        if(p < stringlen(pattern) && 
-           (pattern.at[p] == '?' || pattern.at[p] == str.at[s])) {
-            s++;
-            p++;
-        } else if(p < stringlen(pattern) && pattern.at[p] == '*') {
-            star_idx = p;
-            match_idx = s;
-            p++;
-        } else if(star_idx != (size_t)-1) {
-            p = star_idx + 1;
-            match_idx++;
-            s = match_idx;
-        } else {
-            return false;
-        }
-    }
-    
-    while(p < stringlen(pattern) && pattern.at[p] == '*') {
-        p++;
-    }
-    
-    return p == stringlen(pattern);
+// distance between the pattern and text, max + 1 for anything above max
+static size_t levDistance(const levPattern_t *pattern, const char *text, size_t n, size_t max) {
+    size_t m = pattern->length;
+    size_t length_gap = m > n ? m - n : n - m;
+    if(length_gap > max) return max + 1;
+    if(m == 0) return n;
+    if(pattern->blocks == 1) {
+        return levSingleWord(pattern, (const unsigned char *)text, n, max);
+    }
+    return levBlocked(pattern, (const unsigned char *)text, n, max);
+}
+
+size_t stringLevenshteinBounded(string a, string b, size_t max_distance) {
+    if(max_distance == SIZE_MAX) max_distance--; // keeps max_distance + 1 representable
+    // the shorter string makes the pattern, fewer words per column
+    if(stringlen(a) > stringlen(b)) {
+        string swap = a;
+        a = b;
+        b = swap;
+    }
+    levPattern_t pattern;
+    levPatternInit(&pattern, a.at, stringlen(a));
+    size_t distance = levDistance(&pattern, b.at, stringlen(b), max_distance);
+    levPatternFree(&pattern);
+    return distance;
 }
 
 size_t stringLevenshteinDistance(string a, string b) {
-    size_t len_a = stringlen(a);
-    size_t len_b = stringlen(b);
-    
-    if(len_a == 0) return (int)len_b;
-    if(len_b == 0) return (int)len_a;
-    
-    size_t *prev_row = malloc((len_b + 1) * sizeof(size_t));
-    size_t *curr_row = malloc((len_b + 1) * sizeof(size_t));
-    
-    if(!prev_row || !curr_row) {
-        fprintf(stderr, "failed to allocate memory in stringLevenshteinDistance\n");
-        exit(EXIT_FAILURE);
+    return stringLevenshteinBounded(a, b, SIZE_MAX);
+}
+
+// keeps the k best matches as a max heap on (distance, index), the worst one on top
+static bool fuzzyWorse(stringFuzzyMatch_t x, stringFuzzyMatch_t y) {
+    return x.distance != y.distance ? x.distance > y.distance : x.index > y.index;
+}
+
+static void fuzzySiftDown(stringFuzzyMatch_t *heap, size_t count, size_t at) {
+    for(;;) {
+        size_t worst = at;
+        size_t left = 2 * at + 1, right = 2 * at + 2;
+        if(left < count && fuzzyWorse(heap[left], heap[worst])) worst = left;
+        if(right < count && fuzzyWorse(heap[right], heap[worst])) worst = right;
+        if(worst == at) return;
+        stringFuzzyMatch_t swap = heap[at];
+        heap[at] = heap[worst];
+        heap[worst] = swap;
+        at = worst;
     }
-    
-    for(size_t j = 0; j <= len_b; j++) {
-        prev_row[j] = j;
+}
+
+static void fuzzySiftUp(stringFuzzyMatch_t *heap, size_t at) {
+    while(at > 0 && fuzzyWorse(heap[at], heap[(at - 1) / 2])) {
+        stringFuzzyMatch_t swap = heap[at];
+        heap[at] = heap[(at - 1) / 2];
+        heap[(at - 1) / 2] = swap;
+        at = (at - 1) / 2;
     }
-    
-    for(size_t i = 0; i < len_a; i++) {
-        curr_row[0] = i + 1;
-        
-        for(size_t j = 0; j < len_b; j++) {
-            size_t cost = (a.at[i] == b.at[j]) ? 0 : 1;
-            size_t deletion = prev_row[j + 1] + 1;
-            size_t insertion = curr_row[j] + 1;
-            size_t substitution = prev_row[j] + cost;
-            
-            curr_row[j + 1] = deletion < insertion ? deletion : insertion;
-            curr_row[j + 1] = curr_row[j + 1] < substitution ? curr_row[j + 1] : substitution;
+}
+
+static int fuzzyCompare(const void *x, const void *y) {
+    const stringFuzzyMatch_t *mx = x, *my = y;
+    return fuzzyWorse(*mx, *my) - fuzzyWorse(*my, *mx);
+}
+
+dynarray(stringFuzzyMatch_t) stringClosestMatches(string query, dynarray(string) candidates,
+    size_t k, size_t max_distance) {
+    dynarray(stringFuzzyMatch_t) ret = {};
+    if(k == 0) return ret;
+    if(max_distance == SIZE_MAX) max_distance--;
+    // the query is preprocessed once and then run against every candidate, and once k matches
+    // are known only candidates that beat the worst of them are followed to the end
+    levPattern_t pattern;
+    levPatternInit(&pattern, query.at, stringlen(query));
+    size_t bound = max_distance;
+    for(size_t i = 0; i < candidates.count; i++) {
+        string candidate = candidates.at[i];
+        size_t distance = levDistance(&pattern, candidate.at, stringlen(candidate), bound);
+        if(distance > bound) continue;
+        stringFuzzyMatch_t match = { .index = i, .distance = distance };
+        if(ret.count < k) {
+            dynarray_append(ret, match);
+            fuzzySiftUp(ret.at, ret.count - 1);
+        } else {
+            ret.at[0] = match;
+            fuzzySiftDown(ret.at, ret.count, 0);
+        }
+        if(ret.count == k) {
+            // later candidates have higher indices and must be strictly closer
+            if(ret.at[0].distance == 0) break;
+            bound = ret.at[0].distance - 1;
         }
-        
-        size_t *temp = prev_row;
-        prev_row = curr_row;
-        curr_row = temp;
     }
-    
-    int result = (int)prev_row[len_b];
-    free(prev_row);
-    free(curr_row);
-    return result;
+    levPatternFree(&pattern);
+    if(ret.count > 1) qsort(ret.at, ret.count, sizeof(stringFuzzyMatch_t), fuzzyCompare);
+    return ret;
 }
 
 string stringToTitleCase(string str) {
-    string result = stringFromString(str);
+    string result = stringClone(str);
     bool new_word = true;
     
     for(size_t i = 0; i < stringlen(result); i++) {
@@ -1740,8 +6576,7 @@ string stringToCamelCase(string str) {
         }
     }
     
-    string result = stringBuilderToString(&sb);
-    stringBuilderDestroy(&sb);
+    string result = stringBuilderFinish(&sb);
     return result;
 }
 
@@ -1761,8 +6596,7 @@ string stringToSnakeCase(string str) {
         }
     }
     
-    string result = stringBuilderToString(&sb);
-    stringBuilderDestroy(&sb);
+    string result = stringBuilderFinish(&sb);
     return result;
 }
 
@@ -1782,7 +6616,149 @@ string stringToKebabCase(string str) {
         }
     }
     
-    string result = stringBuilderToString(&sb);
-    stringBuilderDestroy(&sb);
+    string result = stringBuilderFinish(&sb);
     return result;
 }
+
+// string views
+
+strview strviewFromString(string str) {
+    if(str.data == NULL) {
+        return (strview) { .at = NULL, .length = 0 };
+    }
+    return (strview) { .at = str.at, .length = stringlen(str) };
+}
+
+strview strviewFromCharPtr(const char *cstr) {
+    if(cstr == NULL) {
+        return (strview) { .at = NULL, .length = 0 };
+    }
+    return (strview) { .at = cstr, .length = my_strlen(cstr) };
+}
+
+strview strviewFromParts(const char *at, size_t length) {
+    return (strview) { .at = at, .length = length };
+}
+
+string stringFromStrview(strview view) {
+    stringHeader_t *result = allocStringHeader(view.length);
+    if(view.length) {
+        memcpy(result->data, view.at, view.length);
+    }
+    result->data[view.length] = '\0';
+    return (string) { .data = (dataSegmentOfString_t *)result->data };
+}
+
+strview strviewSlice(strview view, size_t start, size_t end) {
+    if(end > view.length) end = view.length;
+    if(start > end) start = end;
+    return (strview) { .at = view.at + start, .length = end - start };
+}
+
+int strviewcmp(strview a, strview b) {
+    size_t min = a.length < b.length ? a.length : b.length;
+    int res = min ? memcmp(a.at, b.at, min) : 0;
+    if(res != 0) {
+        return res;
+    }
+    return (a.length > b.length) - (a.length < b.length);
+}
+
+bool strvieweql(strview a, strview b) {
+    return a.length == b.length && (a.length == 0 || memcmp(a.at, b.at, a.length) == 0);
+}
+
+bool strviewStartsWith(strview view, strview prefix) {
+    return prefix.length <= view.length 
+        && (prefix.length == 0 || memcmp(view.at, prefix.at, prefix.length) == 0);
+}
+
+bool strviewEndsWith(strview view, strview suffix) {
+    return suffix.length <= view.length 
+        && (suffix.length == 0 
+            || memcmp(view.at + view.length - suffix.length, suffix.at, suffix.length) == 0);
+}
+
+int strviewFindFrom(strview haystack, strview needle, size_t start) {
+    if(needle.length == 0) return (int)start;
+    if(needle.length > haystack.length || start > haystack.length - needle.length) return -1;
+    size_t found = searchForward(haystack.at + start, haystack.length - start, needle.at, needle.length);
+    return found == SEARCH_NOT_FOUND ? -1 : (int)(start + found);
+}
+
+int strviewFind(strview haystack, strview needle) {
+    return strviewFindFrom(haystack, needle, 0);
+}
+
+int strviewFindLast(strview haystack, strview needle) {
+    if(needle.length == 0) return (int)haystack.length;
+    size_t found = searchReverse(haystack.at, haystack.length, needle.at, needle.length);
+    return found == SEARCH_NOT_FOUND ? -1 : (int)found;
+}
+
+uint64_t strviewHash(strview view) {
+    return wyhash(view.at, view.length, 0);
+}
+
+uint64_t strviewHashSeeded(strview view, uint64_t seed) {
+    return wyhash(view.at, view.length, seed);
+}
+
+strview strviewTrimLeft(strview view) {
+    size_t start = 0;
+    while(start < view.length && isspace((unsigned char)view.at[start])) {
+        start++;
+    }
+    return strviewSlice(view, start, view.length);
+}
+
+strview strviewTrimRight(strview view) {
+    size_t end = view.length;
+    while(end > 0 && isspace((unsigned char)view.at[end - 1])) {
+        end--;
+    }
+    return strviewSlice(view, 0, end);
+}
+
+strview strviewTrim(strview view) {
+    return strviewTrimRight(strviewTrimLeft(view));
+}
+
+utf32_t strviewUtf8DecodeAt(strview view, size_t byte_index, size_t *bytes_read) {
+    if(byte_index >= view.length) {
+        if(bytes_read) *bytes_read = 0;
+        return 0;
+    }
+    
+    unsigned char c = view.at[byte_index];
+    
+    if((c & 0x80) == 0) {
+        if(bytes_read) *bytes_read = 1;
+        return c;
+    } else if((c & 0xE0) == 0xC0) {
+        if(byte_index + 1 >= view.length) {
+            if(bytes_read) *bytes_read = 0;
+            return 0;
+        }
+        if(bytes_read) *bytes_read = 2;
+        return ((c & 0x1F) << 6) | (view.at[byte_index + 1] & 0x3F);
+    } else if((c & 0xF0) == 0xE0) {
+        if(byte_index + 2 >= view.length) {
+            if(bytes_read) *bytes_read = 0;
+            return 0;
+        }
+        if(bytes_read) *bytes_read = 3;
+        return ((c & 0x0F) << 12) | ((view.at[byte_index + 1] & 0x3F) << 6) | (view.at[byte_index + 2] & 0x3F);
+    } else if((c & 0xF8) == 0xF0) {
+        if(byte_index + 3 >= view.length) {
+            if(bytes_read) *bytes_read = 0;
+            return 0;
+        }
+        if(bytes_read) *bytes_read = 4;
+        return ((c & 0x07) << 18) | ((view.at[byte_index + 1] & 0x3F) << 12) | 
+               ((view.at[byte_index + 2] & 0x3F) << 6) | (view.at[byte_index + 3] & 0x3F);
+    }
+    
+    if(bytes_read) *bytes_read = 0;
+    return 0;
+}
@@ -0,0 +1,696 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023-2025 defg43
+// https://github.com/defg43/
+
+#include "../include/chad/strindex.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+// the suffix array orders every suffix of the text, so all occurrences of a pattern sit next to
+// each other in it and two binary searches find them. rows of the FM-index are the same order
+// with the empty suffix in front, the Burrows-Wheeler transform lists the byte before each of
+// them. backward search narrows the row range one pattern byte at a time using only rank
+// queries on that column, and LF steps from a row to the row of the suffix one byte longer,
+// which is how a row is walked back to one of the sampled suffix offsets
+
+// one in this many suffix offsets is kept by the FM-index, locating takes at most as many steps
+#define STRING_INDEX_SAMPLE 32
+
+#define SA_EMPTY UINT32_MAX
+#define FM_BLOCK_BITS 448
+#define INDEX_ALIGN 64
+
+// one cache line: the ones before the block, then the block's 448 bits
+typedef struct {
+    uint64_t rank;
+    uint64_t bits[7];
+} fmBlock_t;
+
+struct stringIndexData {
+    string storage;              // the indexed string, or the mapped index file
+    void *copy;                  // aligned copy of a loaded file that could not be used in place
+    bool owns_tables;            // tables were allocated by the build rather than loaded
+    stringIndexFlags_t flags;
+    const unsigned char *text;
+    size_t length;
+    size_t repeat_offset;
+    size_t repeat_length;
+    const uint32_t *suffixes;    // length entries, NULL without string_index_suffix_array
+    // fm-index, rows are the suffix array with the empty suffix prepended
+    const fmBlock_t *levels;     // 8 bit planes of the wavelet matrix, fm_blocks each
+    const fmBlock_t *sampled;    // rows whose suffix offset was kept
+    const uint32_t *samples;     // the kept offsets in row order
+    size_t fm_blocks;
+    size_t sample_count;
+    size_t primary;              // row whose BWT entry is the sentinel, stored as a 0 byte
+    size_t zeros[8];             // zero bits of each plane
+    size_t counts[256];          // first row of the suffixes starting with each byte
+    size_t symbol_start[256];    // first position of each byte below the last plane
+};
+
+static void *indexAlloc(size_t count, size_t size) {
+    void *ret = calloc(count ? count : 1, size);
+    if(!ret) {
+        fprintf(stderr, "failed to allocate memory in stringIndexBuild\n");
+        exit(EXIT_FAILURE);
+    }
+    return ret;
+}
+
+// suffix array construction
+//
+// SA-IS: suffixes are typed S or L by whether they sort before or after their right neighbour,
+// and sorting only the leftmost S suffixes (LMS) is enough to induce the order of all others in
+// two bucket scans. the LMS substrings are sorted by one induction pass and named, if a name
+// repeats the string of names is sorted recursively. the end of the text is a virtual sentinel
+// smaller than every byte, so embedded zero bytes need no special care. level 0 reads bytes,
+// deeper levels read the 32 bit names stored at the back of the suffix array itself
+
+static inline uint32_t saChar(const void *s, bool wide, size_t i) {
+    return wide ? ((const uint32_t *)s)[i] : ((const unsigned char *)s)[i];
+}
+
+static inline bool saIsS(const uint8_t *types, size_t i) {
+    return types[i >> 3] >> (i & 7) & 1;
+}
+
+static inline bool saIsLms(const uint8_t *types, size_t i) {
+    return i > 0 && saIsS(types, i) && !saIsS(types, i - 1);
+}
+
+static void saBuckets(const void *s, bool wide, size_t n, uint32_t *bucket, size_t k, bool ends) {
+    memset(bucket, 0, k * sizeof(uint32_t));
+    for(size_t i = 0; i < n; i++) bucket[saChar(s, wide, i)]++;
+    uint32_t sum = 0;
+    for(size_t c = 0; c < k; c++) {
+        uint32_t count = bucket[c];
+        sum += count;
+        bucket[c] = ends ? sum : sum - count;
+    }
+}
+
+static void saInduceL(const void *s, bool wide, const uint8_t *types, uint32_t *sa, size_t n,
+    uint32_t *bucket, size_t k) {
+    saBuckets(s, wide, n, bucket, k, false);
+    // the sentinel sorts first, the last suffix is the first one it induces
+    sa[bucket[saChar(s, wide, n - 1)]++] = n - 1;
+    for(size_t i = 0; i < n; i++) {
+        uint32_t j = sa[i];
+        if(j != SA_EMPTY && j > 0 && !saIsS(types, j - 1)) {
+            sa[bucket[saChar(s, wide, j - 1)]++] = j - 1;
+        }
+    }
+}
+
+static void saInduceS(const void *s, bool wide, const uint8_t *types, uint32_t *sa, size_t n,
+    uint32_t *bucket, size_t k) {
+    saBuckets(s, wide, n, bucket, k, true);
+    for(size_t i = n; i-- > 0;) {
+        uint32_t j = sa[i];
+        if(j != SA_EMPTY && j > 0 && saIsS(types, j - 1)) {
+            sa[--bucket[saChar(s, wide, j - 1)]] = j - 1;
+        }
+    }
+}
+
+static bool saLmsEqual(const void *s, bool wide, const uint8_t *types, size_t n, size_t a, size_t b) {
+    for(size_t d = 0;; d++) {
+        // only the last LMS substring reaches the sentinel, it equals no other
+        if(a + d == n || b + d == n) return false;
+        if(saChar(s, wide, a + d) != saChar(s, wide, b + d) || saIsS(types, a + d) != saIsS(types, b + d)) {
+            return false;
+        }
+        if(d > 0 && saIsLms(types, a + d)) return true;
+    }
+}
+
+static void saIs(const void *s, bool wide, uint32_t *sa, size_t n, size_t k) {
+    if(n == 0) return;
+    if(n == 1) {
+        sa[0] = 0;
+        return;
+    }
+    // the last suffix is L, it sorts after the empty one following it
+    uint8_t *types = indexAlloc(n / 8 + 1, 1);
+    for(size_t i = n - 1; i-- > 0;) {
+        uint32_t a = saChar(s, wide, i), b = saChar(s, wide, i + 1);
+        if(a < b || (a == b && saIsS(types, i + 1))) types[i >> 3] |= (uint8_t)(1u << (i & 7));
+    }
+
+    // sort the LMS substrings
+    uint32_t *bucket = indexAlloc(k, sizeof(uint32_t));
+    saBuckets(s, wide, n, bucket, k, true);
+    for(size_t i = 0; i < n; i++) sa[i] = SA_EMPTY;
+    for(size_t i = 1; i < n; i++) {
+        if(saIsLms(types, i)) sa[--bucket[saChar(s, wide, i)]] = (uint32_t)i;
+    }
+    saInduceL(s, wide, types, sa, n, bucket, k);
+    saInduceS(s, wide, types, sa, n, bucket, k);
+    free(bucket);
+
+    // name them, LMS positions are at least two apart so pos / 2 gives each its own slot
+    size_t n1 = 0;
+    for(size_t i = 0; i < n; i++) {
+        if(saIsLms(types, sa[i])) sa[n1++] = sa[i];
+    }
+    for(size_t i = n1; i < n; i++) sa[i] = SA_EMPTY;
+    uint32_t names = 0;
+    size_t previous = SIZE_MAX;
+    for(size_t i = 0; i < n1; i++) {
+        size_t pos = sa[i];
+        if(previous == SIZE_MAX || !saLmsEqual(s, wide, types, n, pos, previous)) {
+            names++;
+            previous = pos;
+        }
+        sa[n1 + pos / 2] = names - 1;
+    }
+    size_t j = n;
+    for(size_t i = n; i-- > n1;) {
+        if(sa[i] != SA_EMPTY) sa[--j] = sa[i];
+    }
+
+    // sort the LMS suffixes through the reduced string of names
+    uint32_t *reduced = sa + n - n1;
+    if(names < n1) {
+        saIs(reduced, true, sa, n1, names);
+    } else {
+        for(size_t i = 0; i < n1; i++) sa[reduced[i]] = (uint32_t)i;
+    }
+
+    // place them at the ends of their buckets and induce everything else
+    j = 0;
+    for(size_t i = 1; i < n; i++) {
+        if(saIsLms(types, i)) reduced[j++] = (uint32_t)i;
+    }
+    for(size_t i = 0; i < n1; i++) sa[i] = reduced[sa[i]];
+    for(size_t i = n1; i < n; i++) sa[i] = SA_EMPTY;
+    bucket = indexAlloc(k, sizeof(uint32_t));
+    saBuckets(s, wide, n, bucket, k, true);
+    for(size_t i = n1; i-- > 0;) {
+        uint32_t pos = sa[i];
+        sa[i] = SA_EMPTY;
+        sa[--bucket[saChar(s, wide, pos)]] = pos;
+    }
+    saInduceL(s, wide, types, sa, n, bucket, k);
+    saInduceS(s, wide, types, sa, n, bucket, k);
+    free(bucket);
+    free(types);
+}
+
+// longest repeat
+//
+// the longest repeat is the largest common prefix of two suffixes adjacent in the suffix array.
+// taking them in text order instead (Kärkkäinen's permuted LCP) each value is at least the
+// previous one minus one, so the whole scan compares O(n) bytes
+
+static void findLongestRepeat(stringIndexData_t *data, const uint32_t *sa) {
+    size_t n = data->length;
+    if(n < 2) return;
+    uint32_t *phi = indexAlloc(n, sizeof(uint32_t));
+    phi[sa[0]] = SA_EMPTY;
+    for(size_t i = 1; i < n; i++) phi[sa[i]] = sa[i - 1];
+    const unsigned char *text = data->text;
+    size_t common = 0;
+    for(size_t i = 0; i < n; i++) {
+        if(phi[i] == SA_EMPTY) {
+            common = 0;
+            continue;
+        }
+        size_t j = phi[i];
+        while(i + common < n && j + common < n && text[i + common] == text[j + common]) common++;
+        if(common > data->repeat_length) {
+            data->repeat_length = common;
+            data->repeat_offset = i;
+        }
+        if(common > 0) common--;
+    }
+    free(phi);
+}
+
+// fm-index
+//
+// the BWT is stored as a wavelet matrix: plane l holds bit 7 - l of every entry, then the entries
+// are stably partitioned by that bit, zeros first, before the next plane. following one byte's
+// bits down the planes maps a row to its position among equal bytes, which is its rank
+
+static size_t fmBlockCount(size_t bits) {
+    return bits / FM_BLOCK_BITS + 1;
+}
+
+static inline bool fmBit(const fmBlock_t *blocks, size_t i) {
+    size_t r = i % FM_BLOCK_BITS;
+    return blocks[i / FM_BLOCK_BITS].bits[r / 64] >> (r % 64) & 1;
+}
+
+static inline void fmSetBit(fmBlock_t *blocks, size_t i) {
+    size_t r = i % FM_BLOCK_BITS;
+    blocks[i / FM_BLOCK_BITS].bits[r / 64] |= 1ull << (r % 64);
+}
+
+// ones before position i
+static inline size_t fmRank1(const fmBlock_t *blocks, size_t i) {
+    const fmBlock_t *block = &blocks[i / FM_BLOCK_BITS];
+    size_t r = i % FM_BLOCK_BITS;
+    size_t ones = block->rank;
+    for(size_t w = 0; w < r / 64; w++) ones += __builtin_popcountll(block->bits[w]);
+    if(r % 64) ones += __builtin_popcountll(block->bits[r / 64] & ((1ull << (r % 64)) - 1));
+    return ones;
+}
+
+static void fmFinishRanks(fmBlock_t *blocks, size_t count) {
+    uint64_t total = 0;
+    for(size_t b = 0; b < count; b++) {
+        blocks[b].rank = total;
+        for(size_t w = 0; w < 7; w++) total += __builtin_popcountll(blocks[b].bits[w]);
+    }
+}
+
+// follow the bits of c from position i down through every plane
+static size_t fmDescend(const stringIndexData_t *data, unsigned c, size_t i) {
+    for(size_t l = 0; l < 8; l++) {
+        size_t ones = fmRank1(data->levels + l * data->fm_blocks, i);
+        i = c >> (7 - l) & 1 ? data->zeros[l] + ones : i - ones;
+    }
+    return i;
+}
+
+// occurrences of c among the BWT entries before row
+static size_t fmRank(const stringIndexData_t *data, unsigned c, size_t row) {
+    size_t ret = fmDescend(data, c, row) - data->symbol_start[c];
+    return c == 0 && row > data->primary ? ret - 1 : ret;
+}
+
+// the row of the suffix starting one byte earlier, row must not be the primary row
+static size_t fmLf(const stringIndexData_t *data, size_t row) {
+    unsigned c = 0;
+    size_t i = row;
+    for(size_t l = 0; l < 8; l++) {
+        const fmBlock_t *level = data->levels + l * data->fm_blocks;
+        bool bit = fmBit(level, i);
+        size_t ones = fmRank1(level, i);
+        c = c << 1 | bit;
+        i = bit ? data->zeros[l] + ones : i - ones;
+    }
+    size_t rank = i - data->symbol_start[c];
+    if(c == 0 && row > data->primary) rank--;
+    return data->counts[c] + rank;
+}
+
+static void fmSymbolStarts(stringIndexData_t *data) {
+    for(unsigned c = 0; c < 256; c++) data->symbol_start[c] = fmDescend(data, c, 0);
+}
+
+static void fmBuild(stringIndexData_t *data, const uint32_t *sa) {
+    size_t n = data->length, rows = n + 1;
+    const unsigned char *text = data->text;
+    unsigned char *bwt = indexAlloc(rows, 1);
+    unsigned char *next = indexAlloc(rows, 1);
+    // the empty suffix is row 0 and preceded by the last byte, or by the sentinel in an empty text
+    bwt[0] = n ? text[n - 1] : 0;
+    data->primary = 0;
+    for(size_t r = 1; r < rows; r++) {
+        uint32_t pos = sa[r - 1];
+        if(pos == 0) data->primary = r;
+        bwt[r] = pos ? text[pos - 1] : 0;
+    }
+
+    size_t histogram[256] = {};
+    for(size_t i = 0; i < n; i++) histogram[text[i]]++;
+    size_t row = 1;
+    for(size_t c = 0; c < 256; c++) {
+        data->counts[c] = row;
+        row += histogram[c];
+    }
+
+    size_t blocks = fmBlockCount(rows);
+    fmBlock_t *levels = indexAlloc(8 * blocks, sizeof(fmBlock_t));
+    for(size_t l = 0; l < 8; l++) {
+        fmBlock_t *level = levels + l * blocks;
+        unsigned shift = 7 - (unsigned)l;
+        size_t zeros = 0;
+        for(size_t r = 0; r < rows; r++) {
+            if(bwt[r] >> shift & 1) {
+                fmSetBit(level, r);
+            } else {
+                zeros++;
+            }
+        }
+        fmFinishRanks(level, blocks);
+        size_t z = 0, o = zeros;
+        for(size_t r = 0; r < rows; r++) {
+            if(bwt[r] >> shift & 1) {
+                next[o++] = bwt[r];
+            } else {
+                next[z++] = bwt[r];
+            }
+        }
+        unsigned char *swap = bwt;
+        bwt = next;
+        next = swap;
+        data->zeros[l] = zeros;
+    }
+    free(bwt);
+    free(next);
+    data->levels = levels;
+    data->fm_blocks = blocks;
+
+    // keep the offsets that are multiples of the sample rate, the empty suffix's included
+    fmBlock_t *sampled = indexAlloc(blocks, sizeof(fmBlock_t));
+    size_t count = 0;
+    for(size_t r = 0; r < rows; r++) {
+        size_t pos = r ? sa[r - 1] : n;
+        if(pos % STRING_INDEX_SAMPLE == 0) {
+            fmSetBit(sampled, r);
+            count++;
+        }
+    }
+    fmFinishRanks(sampled, blocks);
+    uint32_t *samples = indexAlloc(count, sizeof(uint32_t));
+    count = 0;
+    for(size_t r = 0; r < rows; r++) {
+        size_t pos = r ? sa[r - 1] : n;
+        if(pos % STRING_INDEX_SAMPLE == 0) samples[count++] = (uint32_t)pos;
+    }
+    data->sampled = sampled;
+    data->samples = samples;
+    data->sample_count = count;
+    fmSymbolStarts(data);
+}
+
+// rows [first, last) of the suffixes starting with pattern, by backward search
+static void fmRange(const stringIndexData_t *data, strview pattern, size_t *first, size_t *last) {
+    size_t sp = 0, ep = data->length + 1;
+    for(size_t k = pattern.length; k-- > 0 && sp < ep;) {
+        unsigned c = (unsigned char)pattern.at[k];
+        sp = data->counts[c] + fmRank(data, c, sp);
+        ep = data->counts[c] + fmRank(data, c, ep);
+    }
+    *first = sp;
+    *last = sp < ep ? ep : sp;
+}
+
+static size_t fmLocateRow(const stringIndexData_t *data, size_t row) {
+    size_t steps = 0;
+    while(!fmBit(data->sampled, row)) {
+        row = fmLf(data, row);
+        steps++;
+    }
+    return data->samples[fmRank1(data->sampled, row)] + steps;
+}
+
+// suffix array search
+//
+// both bounds are binary searches, a comparison starts after the prefix the pattern is already
+// known to share with both ends of the remaining range, since every suffix between shares it too
+
+// <0 if the suffix at pos sorts before every string starting with pattern, 0 if it starts with
+// it, >0 after. matched holds the bytes known to match on entry and the matched bytes on return
+static int suffixCompare(const stringIndexData_t *data, size_t pos, strview pattern, size_t *matched) {
+    const unsigned char *suffix = data->text + pos;
+    size_t available = data->length - pos;
+    size_t k = *matched;
+    while(k < pattern.length && k < available && suffix[k] == (unsigned char)pattern.at[k]) k++;
+    *matched = k;
+    if(k == pattern.length) return 0;
+    if(k == available) return -1;
+    return suffix[k] < (unsigned char)pattern.at[k] ? -1 : 1;
+}
+
+static size_t suffixBound(const stringIndexData_t *data, strview pattern, bool upper) {
+    size_t lo = 0, hi = data->length, lo_matched = 0, hi_matched = 0;
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        size_t matched = lo_matched < hi_matched ? lo_matched : hi_matched;
+        int cmp = suffixCompare(data, data->suffixes[mid], pattern, &matched);
+        if(cmp < 0 || (upper && cmp == 0)) {
+            lo = mid + 1;
+            lo_matched = matched;
+        } else {
+            hi = mid;
+            hi_matched = matched;
+        }
+    }
+    return lo;
+}
+
+// construction and destruction
+
+stringIndex_t stringIndexBuild(string str) {
+    return stringIndexBuildWith(str, string_index_suffix_array);
+}
+
+stringIndex_t stringIndexBuildWith(string str, stringIndexFlags_t flags) {
+    size_t n = stringlen(str);
+    if(n >= UINT32_MAX) {
+        fprintf(stderr, "string too large to index in stringIndexBuild\n");
+        exit(EXIT_FAILURE);
+    }
+    if(!(flags & (string_index_suffix_array | string_index_fm))) flags |= string_index_suffix_array;
+    stringIndexData_t *data = indexAlloc(1, sizeof(stringIndexData_t));
+    data->storage = stringFromString(str);
+    data->owns_tables = true;
+    data->flags = flags;
+    data->text = (const unsigned char *)data->storage.at;
+    data->length = n;
+
+    uint32_t *sa = indexAlloc(n, sizeof(uint32_t));
+    saIs(data->text, false, sa, n, 256);
+    findLongestRepeat(data, sa);
+    if(flags & string_index_fm) fmBuild(data, sa);
+    if(flags & string_index_suffix_array) {
+        data->suffixes = sa;
+    } else {
+        free(sa);
+    }
+    return (stringIndex_t) { .data = data };
+}
+
+void destroyStringIndex(stringIndex_t index) {
+    stringIndexData_t *data = index.data;
+    if(data == NULL) return;
+    if(data->owns_tables) {
+        free((void *)data->suffixes);
+        free((void *)data->levels);
+        free((void *)data->sampled);
+        free((void *)data->samples);
+    }
+    free(data->copy);
+    destroyString(data->storage);
+    free(data);
+}
+
+// saving and loading
+//
+// the file is a header followed by the text and the tables exactly as they sit in memory, each
+// section aligned to a cache line. a loaded index points into the mapped file, nothing is
+// copied, so loading is O(1) and pages are read as queries touch them
+
+static const char index_magic[8] = "chadidx1";
+
+typedef struct {
+    char magic[8];
+    uint32_t byte_order; // 0x01020304 as written, files only load on machines of the same order
+    uint32_t flags;
+    uint64_t length;
+    uint64_t repeat_offset;
+    uint64_t repeat_length;
+    uint64_t primary;
+    uint64_t sample_count;
+    uint64_t zeros[8];
+    uint64_t counts[256];
+} stringIndexFileHeader_t;
+
+typedef struct {
+    size_t text;
+    size_t suffixes;
+    size_t levels;
+    size_t sampled;
+    size_t samples;
+    size_t end;
+} indexLayout_t;
+
+static size_t indexAlign(size_t offset) {
+    return (offset + INDEX_ALIGN - 1) & ~(size_t)(INDEX_ALIGN - 1);
+}
+
+static indexLayout_t indexLayout(size_t length, unsigned flags, size_t sample_count) {
+    size_t blocks = fmBlockCount(length + 1);
+    bool fm = flags & string_index_fm;
+    indexLayout_t layout;
+    layout.text = indexAlign(sizeof(stringIndexFileHeader_t));
+    layout.suffixes = indexAlign(layout.text + length);
+    layout.levels = indexAlign(layout.suffixes + (flags & string_index_suffix_array ? length * sizeof(uint32_t) : 0));
+    layout.sampled = layout.levels + (fm ? 8 * blocks * sizeof(fmBlock_t) : 0);
+    layout.samples = layout.sampled + (fm ? blocks * sizeof(fmBlock_t) : 0);
+    layout.end = layout.samples + (fm ? sample_count * sizeof(uint32_t) : 0);
+    return layout;
+}
+
+// pad with zeros up to offset, then write size bytes
+static bool indexWrite(FILE *file, size_t *written, size_t offset, const void *bytes, size_t size) {
+    static const char padding[INDEX_ALIGN];
+    while(*written < offset) {
+        size_t n = offset - *written < INDEX_ALIGN ? offset - *written : INDEX_ALIGN;
+        if(fwrite(padding, 1, n, file) != n) return false;
+        *written += n;
+    }
+    if(size > 0 && fwrite(bytes, 1, size, file) != size) return false;
+    *written += size;
+    return true;
+}
+
+bool stringIndexSave(stringIndex_t index, const char *path) {
+    const stringIndexData_t *data = index.data;
+    stringIndexFileHeader_t header;
+    memset(&header, 0, sizeof header);
+    memcpy(header.magic, index_magic, sizeof header.magic);
+    header.byte_order = 0x01020304;
+    header.flags = data->flags;
+    header.length = data->length;
+    header.repeat_offset = data->repeat_offset;
+    header.repeat_length = data->repeat_length;
+    header.primary = data->primary;
+    header.sample_count = data->sample_count;
+    for(size_t l = 0; l < 8; l++) header.zeros[l] = data->zeros[l];
+    for(size_t c = 0; c < 256; c++) header.counts[c] = data->counts[c];
+
+    FILE *file = fopen(path, "wb");
+    if(file == NULL) return false;
+    indexLayout_t layout = indexLayout(data->length, data->flags, data->sample_count);
+    size_t written = 0;
+    bool ok = indexWrite(file, &written, 0, &header, sizeof header)
+        && indexWrite(file, &written, layout.text, data->text, data->length);
+    if(ok && data->suffixes) {
+        ok = indexWrite(file, &written, layout.suffixes, data->suffixes, data->length * sizeof(uint32_t));
+    }
+    if(ok && data->levels) {
+        ok = indexWrite(file, &written, layout.levels, data->levels, 8 * data->fm_blocks * sizeof(fmBlock_t))
+            && indexWrite(file, &written, layout.sampled, data->sampled, data->fm_blocks * sizeof(fmBlock_t))
+            && indexWrite(file, &written, layout.samples, data->samples, data->sample_count * sizeof(uint32_t));
+    }
+    ok = indexWrite(file, &written, layout.end, NULL, 0) && ok;
+    return fclose(file) == 0 && ok;
+}
+
+// only the header is checked, the tables are trusted as written, see stringIndexLoad
+static bool indexHeaderValid(const stringIndexFileHeader_t *header, size_t size) {
+    unsigned all = string_index_suffix_array | string_index_fm;
+    if(memcmp(header->magic, index_magic, sizeof header->magic) != 0 || header->byte_order != 0x01020304) {
+        return false;
+    }
+    if(header->flags == 0 || (header->flags & ~all) != 0 || header->length >= UINT32_MAX) return false;
+    uint64_t length = header->length, rows = length + 1;
+    if(header->repeat_offset > length || header->repeat_length > length - header->repeat_offset) return false;
+    if(header->flags & string_index_fm) {
+        if(header->primary >= rows || header->sample_count > rows) return false;
+        for(size_t l = 0; l < 8; l++) {
+            if(header->zeros[l] > rows) return false;
+        }
+        // the empty suffix is row 0, the rows of each byte follow in order
+        if(header->counts[0] != 1) return false;
+        for(size_t c = 1; c < 256; c++) {
+            if(header->counts[c] < header->counts[c - 1] || header->counts[c] > rows) return false;
+        }
+    }
+    return indexLayout(length, header->flags, header->sample_count).end <= size;
+}
+
+option(stringIndex_t) stringIndexLoad(const char *path) {
+    option(string) file = stringMapFileWith(path, string_map_random);
+    if(!file.valid) return (option(stringIndex_t)) none;
+    const char *bytes = file.value.at;
+    size_t size = stringlen(file.value);
+    stringIndexFileHeader_t header;
+    if(size < sizeof header) {
+        destroyString(file.value);
+        return (option(stringIndex_t)) none;
+    }
+    memcpy(&header, bytes, sizeof header);
+    if(!indexHeaderValid(&header, size)) {
+        destroyString(file.value);
+        return (option(stringIndex_t)) none;
+    }
+
+    stringIndexData_t *data = indexAlloc(1, sizeof(stringIndexData_t));
+    data->storage = file.value;
+    // a mapping is page aligned, a file read into a small string buffer may not be
+    if((uintptr_t)bytes % _Alignof(fmBlock_t) != 0) {
+        data->copy = indexAlloc(size, 1);
+        memcpy(data->copy, bytes, size);
+        bytes = data->copy;
+    }
+    indexLayout_t layout = indexLayout(header.length, header.flags, header.sample_count);
+    data->flags = header.flags;
+    data->text = (const unsigned char *)bytes + layout.text;
+    data->length = header.length;
+    data->repeat_offset = header.repeat_offset;
+    data->repeat_length = header.repeat_length;
+    if(header.flags & string_index_suffix_array) {
+        data->suffixes = (const uint32_t *)(bytes + layout.suffixes);
+    }
+    if(header.flags & string_index_fm) {
+        data->levels = (const fmBlock_t *)(bytes + layout.levels);
+        data->sampled = (const fmBlock_t *)(bytes + layout.sampled);
+        data->samples = (const uint32_t *)(bytes + layout.samples);
+        data->fm_blocks = fmBlockCount(header.length + 1);
+        data->sample_count = header.sample_count;
+        data->primary = header.primary;
+        for(size_t l = 0; l < 8; l++) data->zeros[l] = header.zeros[l];
+        for(size_t c = 0; c < 256; c++) data->counts[c] = header.counts[c];
+        fmSymbolStarts(data);
+    }
+    return (option(stringIndex_t)) some((stringIndex_t) { .data = data });
+}
+
+// queries
+
+strview stringIndexText(stringIndex_t index) {
+    return strviewFromParts((const char *)index.data->text, index.data->length);
+}
+
+size_t stringIndexCount(stringIndex_t index, strview pattern) {
+    const stringIndexData_t *data = index.data;
+    if(pattern.length == 0 || pattern.length > data->length) return 0;
+    if(data->levels) {
+        size_t first, last;
+        fmRange(data, pattern, &first, &last);
+        return last - first;
+    }
+    return suffixBound(data, pattern, true) - suffixBound(data, pattern, false);
+}
+
+static int compareOffsets(const void *a, const void *b) {
+    size_t x = *(const size_t *)a, y = *(const size_t *)b;
+    return (x > y) - (x < y);
+}
+
+dynarray(size_t) stringIndexLocate(stringIndex_t index, strview pattern) {
+    const stringIndexData_t *data = index.data;
+    dynarray(size_t) ret = {};
+    if(pattern.length == 0 || pattern.length > data->length) return ret;
+    size_t first, last;
+    if(data->suffixes) {
+        first = suffixBound(data, pattern, false);
+        last = suffixBound(data, pattern, true);
+    } else {
+        fmRange(data, pattern, &first, &last);
+    }
+    if(first == last) return ret;
+    ret.at = malloc((last - first) * sizeof(size_t));
+    if(ret.at == NULL) {
+        fprintf(stderr, "failed to allocate memory in stringIndexLocate\n");
+        exit(EXIT_FAILURE);
+    }
+    ret.capacity = last - first;
+    for(size_t i = first; i < last; i++) {
+        ret.at[ret.count++] = data->suffixes ? data->suffixes[i] : fmLocateRow(data, i);
+    }
+    qsort(ret.at, ret.count, sizeof(size_t), compareOffsets);
+    return ret;
+}
+
+strview stringIndexLongestRepeat(stringIndex_t index) {
+    const stringIndexData_t *data = index.data;
+    return strviewFromParts((const char *)data->text + data->repeat_offset, data->repeat_length);
+}
@@ -6,11 +6,15 @@ int test_parser();
 int test_str();
 int test_ion();
 int test_format();
+int test_rope();
+int test_strindex();
 
 int main() {
 	test_str();
 	test_ion();
 	test_format();
+	test_rope();
+	test_strindex();
 	test_parser();
   	return 0;
 }
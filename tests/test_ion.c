@@ -90,8 +90,15 @@ static void test_ion_json_parsing(void) {
     obj_t_value_t val = objget(obj, string("key"));
     ASSERT_TRUE("key is 'val'", stringeql(val.str, string("val")));
     
+    ASSERT_TRUE("keys not interned by default", !stringIsInterned(obj.key[0]));
+    
+    object_t shared = jsonToObjectWith(json, ion_parse_intern_keys);
+    ASSERT_TRUE("intern_keys interns keys", shared.count == 2 && stringIsInterned(shared.key[0])
+        && objcontains(shared, string("num")));
+    
     destroyString(json);
     destroyObject(obj);
+    destroyObject(shared);
 }
 
 int test_ion(void) {
@@ -0,0 +1,217 @@
+#include "../include/chad/rope.h"
+#include "../include/chad/str.h"
+#include <stdio.h>
+#include <string.h>
+
+static int passed = 0;
+static int failed = 0;
+
+#define ASSERT_TRUE(label, expr) do { \
+    if (expr) { \
+        printf("\033[32m✓\033[0m " label "\n"); \
+        passed++; \
+    } else { \
+        printf("\033[31m✗\033[0m " label "\n"); \
+        failed++; \
+    } \
+} while(0)
+
+static bool rope_ok(rope_t rope, const char *expected) {
+    string flat = ropeToString(rope);
+    bool ok = ropeLength(rope) == strlen(expected) && strcmp(flat.at, expected) == 0
+        && stringlen(flat) == strlen(expected);
+    if (!ok) printf("    content: got '%s' want '%s'\n", flat.at, expected);
+    destroyString(flat);
+    return ok;
+}
+
+static void test_rope_basic(void) {
+    printf("\n-- Rope Basic --\n");
+
+    rope_t empty = ropeCreate();
+    ASSERT_TRUE("empty rope",              ropeLength(empty) == 0 && rope_ok(empty, ""));
+    ASSERT_TRUE("char past the end",       ropeCharAt(empty, 0) == '\0');
+
+    rope_t r = ropeFromStrview(strview("hello world"));
+    ropeInsert(&r, 5, strview(","));
+    ropeAppend(&r, strview("!"));
+    ropePrepend(&r, strview(">> "));
+    ASSERT_TRUE("insert append prepend",   rope_ok(r, ">> hello, world!"));
+    ASSERT_TRUE("char at",                 ropeCharAt(r, 3) == 'h' && ropeCharAt(r, 15) == '!');
+    ropeDelete(&r, 0, 3);
+    ropeDelete(&r, 5, 1);
+    ASSERT_TRUE("delete",                  rope_ok(r, "hello world!"));
+    ropeDelete(&r, 5, 100);
+    ASSERT_TRUE("delete clamps",           rope_ok(r, "hello"));
+    ropeInsert(&r, 100, strview(" again"));
+    ASSERT_TRUE("insert clamps",           rope_ok(r, "hello again"));
+    destroyRope(r);
+    destroyRope(empty);
+}
+
+static void test_rope_sharing(void) {
+    printf("\n-- Rope Sharing --\n");
+
+    char big[4096];
+    for (size_t i = 0; i < sizeof big - 1; i++) big[i] = 'a' + i % 26;
+    big[sizeof big - 1] = '\0';
+    string source = stringFromCharPtr(big);
+
+    rope_t r = ropeFromString(source);
+    ropeInsertString(&r, 10, source);
+    ASSERT_TRUE("large strings are shared", getHeaderPointer(source)->refcount == 4);
+    ASSERT_TRUE("shared insert length",    ropeLength(r) == 2 * strlen(big));
+
+    rope_t copy = ropeCopy(r);
+    ropeDelete(&copy, 0, 10);
+    ropeAppend(&copy, strview("tail"));
+    ASSERT_TRUE("copy edited",             ropeLength(copy) == 2 * strlen(big) - 10 + 4);
+    ASSERT_TRUE("original untouched",      ropeLength(r) == 2 * strlen(big) && ropeCharAt(r, 0) == 'a');
+    ASSERT_TRUE("source untouched",        strcmp(source.at, big) == 0);
+
+    rope_t slice = ropeSlice(r, 5, 15);
+    ASSERT_TRUE("slice across pieces",     rope_ok(slice, "fghijabcde"));
+    rope_t out_of_range = ropeSlice(r, 20, 10);
+    ASSERT_TRUE("reversed slice is empty", ropeLength(out_of_range) == 0);
+
+    size_t chunks = 0, total = 0;
+    bool in_order = true;
+    ropeChunkIter_t iter = ropeChunks(r);
+    strview chunk;
+    while (ropeChunkNext(&iter, &chunk)) {
+        in_order &= chunk.at[0] == ropeCharAt(r, total);
+        chunks++;
+        total += chunk.length;
+    }
+    ASSERT_TRUE("chunks cover the rope",   total == ropeLength(r) && in_order && chunks == 3);
+
+    destroyRope(out_of_range);
+    destroyRope(slice);
+    destroyRope(copy);
+    destroyRope(r);
+    ASSERT_TRUE("pieces given back",       getHeaderPointer(source)->refcount == 1);
+    destroyString(source);
+}
+
+static void test_rope_random_edits(void) {
+    printf("\n-- Rope Random Edits --\n");
+
+    // the same edits applied to a flat buffer
+    enum { capacity = 1 << 16 };
+    static char expected[capacity];
+    size_t length = 0;
+    rope_t r = ropeCreate();
+    rope_t snapshot = ropeCreate();
+    char snapshot_text[capacity];
+    uint64_t seed = 12345;
+    bool matches = true;
+
+    for (size_t step = 0; step < 4000; step++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        size_t pos = length ? (seed >> 33) % (length + 1) : 0;
+        if ((seed >> 20) % 4 != 0 || length < 64) {
+            char text[40];
+            size_t n = 1 + (seed >> 40) % (sizeof text);
+            if ((seed >> 10) % 64 == 0) n = 1;
+            for (size_t i = 0; i < n; i++) text[i] = 'a' + (step + i) % 26;
+            if (length + n >= capacity) break;
+            memmove(expected + pos + n, expected + pos, length - pos);
+            memcpy(expected + pos, text, n);
+            length += n;
+            ropeInsert(&r, pos, strviewFromParts(text, n));
+        } else {
+            size_t n = (seed >> 45) % 32;
+            if (n > length - pos) n = length - pos;
+            memmove(expected + pos, expected + pos + n, length - pos - n);
+            length -= n;
+            ropeDelete(&r, pos, n);
+        }
+        if (step == 2000) {
+            destroyRope(snapshot);
+            snapshot = ropeCopy(r);
+            memcpy(snapshot_text, expected, length);
+            snapshot_text[length] = '\0';
+        }
+        if (step % 500 == 0) {
+            expected[length] = '\0';
+            matches &= rope_ok(r, expected);
+        }
+    }
+    expected[length] = '\0';
+    ASSERT_TRUE("matches flat buffer",     matches && rope_ok(r, expected));
+    ASSERT_TRUE("snapshot unaffected",     rope_ok(snapshot, snapshot_text));
+
+    size_t chunks = 0;
+    ropeChunkIter_t iter = ropeChunks(r);
+    strview chunk;
+    while (ropeChunkNext(&iter, &chunk)) chunks++;
+    ASSERT_TRUE("small inserts coalesce",  chunks < length / 16);
+
+    rope_t slice = ropeSlice(r, length / 3, 2 * length / 3);
+    string flat = ropeToString(slice);
+    ASSERT_TRUE("slice of edited rope",
+        stringlen(flat) == 2 * length / 3 - length / 3
+        && memcmp(flat.at, expected + length / 3, stringlen(flat)) == 0);
+    destroyString(flat);
+    destroyRope(slice);
+    destroyRope(snapshot);
+    destroyRope(r);
+}
+
+static void test_rope_mid_piece_edits(void) {
+    printf("\n-- Rope Mid Piece Edits --\n");
+
+    // inserts too large to be merged, so nearly every edit cuts a piece in two
+    enum { capacity = 1 << 20 };
+    static char expected[capacity + 1];
+    static char text[2048];
+    size_t length = 0;
+    rope_t r = ropeCreate();
+    uint64_t seed = 777;
+    bool matches = true;
+
+    for (size_t step = 0; step < 3000; step++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        size_t pos = length ? (seed >> 33) % (length + 1) : 0;
+        if ((seed >> 20) % 3 != 0 || length < 4096) {
+            size_t n = 600 + (seed >> 40) % 1400;
+            if (length + n > capacity) break;
+            for (size_t i = 0; i < n; i++) text[i] = 'a' + (step * 7 + i) % 26;
+            memmove(expected + pos + n, expected + pos, length - pos);
+            memcpy(expected + pos, text, n);
+            length += n;
+            ropeInsert(&r, pos, strviewFromParts(text, n));
+        } else {
+            size_t n = (seed >> 45) % 900;
+            if (n > length - pos) n = length - pos;
+            memmove(expected + pos, expected + pos + n, length - pos - n);
+            length -= n;
+            ropeDelete(&r, pos, n);
+        }
+        if (step % 250 == 0) {
+            expected[length] = '\0';
+            matches &= rope_ok(r, expected);
+        }
+    }
+    expected[length] = '\0';
+    ASSERT_TRUE("matches flat buffer",     matches && rope_ok(r, expected));
+    bool chars_ok = true;
+    for (size_t i = 0; i < length; i += 997) chars_ok &= ropeCharAt(r, i) == expected[i];
+    ASSERT_TRUE("char at after edits",     chars_ok);
+    destroyRope(r);
+}
+
+int test_rope(void) {
+    test_rope_basic();
+    test_rope_sharing();
+    test_rope_random_edits();
+    test_rope_mid_piece_edits();
+
+    printf("\n");
+    if (failed == 0) {
+        printf("\033[32mAll %d rope tests passed.\033[0m\n", passed);
+    } else {
+        printf("\033[31m%d/%d rope tests FAILED.\033[0m\n", failed, passed + failed);
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -1,7 +1,13 @@
+#define _DEFAULT_SOURCE // pipe, read and write for the reader tests
+
 #include "../include/chad/str.h"
 #include "../include/chad/macros/foreach.h"
+#include <limits.h>
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
+#include <threads.h>
+#include <unistd.h>
 
 
 static int passed = 0;
@@ -56,7 +62,7 @@ static void test_from_string(void) {
     printf("\n-- stringFromString --\n");
 
     string orig = stringFromCharPtr("copy me");
-    string copy = stringFromString(orig);
+    string copy = stringClone(orig);
     
     ASSERT_TRUE("copy equals original",     str_ok(copy, "copy me"));
     ASSERT_TRUE("copy is independent alloc", copy.data != orig.data);
@@ -131,6 +137,99 @@ static void test_append_many(void) {
     destroyString(s);
 }
 
+static void test_small_strings(void) {
+    printf("\n-- small strings --\n");
+
+    string s = stringFromCharPtr("key");
+    ASSERT_TRUE("short string value",   str_ok(s, "key"));
+#ifndef CHAD_STRING_NO_SMALL
+    ASSERT_TRUE("short string is small", getHeaderPointer(s)->flags & string_small);
+#endif
+
+    for (int i = 0; i < 20; i++) {
+        s = stringAppendChar(s, 'x');
+    }
+    ASSERT_TRUE("fills cell",           str_ok(s, "keyxxxxxxxxxxxxxxxxxxxx"));
+    s = stringAppendCharPtr(s, "yz");
+    ASSERT_TRUE("outgrows cell",        str_ok(s, "keyxxxxxxxxxxxxxxxxxxxxyz"));
+    ASSERT_TRUE("moved out of cell",    !(getHeaderPointer(s)->flags & string_small));
+    destroyString(s);
+
+    string src = stringFromCharPtr("a string that is longer than a small cell");
+    ASSERT_TRUE("long string not small", !(getHeaderPointer(src)->flags & string_small));
+    string slice = stringSliceFromString(src, 2, 8);
+    ASSERT_TRUE("short slice of long",  str_ok(slice, "string"));
+    string copy = stringClone(slice);
+    ASSERT_TRUE("copy of short slice",  str_ok(copy, "string") && copy.data != slice.data);
+    destroyString(copy);
+    destroyString(slice);
+    destroyString(src);
+
+    string p = stringFromCharPtr("ab");
+    p = stringPrependCharPtr(p, "xy");
+    ASSERT_TRUE("prepend in cell",      str_ok(p, "xyab"));
+    destroyString(p);
+}
+
+static void test_allocators(void) {
+    printf("\n-- string allocator backends --\n");
+
+    stringAllocator_t arena = stringArenaCreate(256);
+    stringAllocator_t *previous = stringUseAllocator(&arena);
+    ASSERT_TRUE("default backend was active", previous == NULL);
+
+    string a = stringFromCharPtr("arena string");
+    string b = stringFromCharPtr("another one that is a bit longer");
+    ASSERT_TRUE("arena value",          str_ok(a, "arena string"));
+    ASSERT_TRUE("arena owns string",    getHeaderPointer(a)->allocator == &arena);
+    b = stringAppendCharPtr(b, " and grows");
+    ASSERT_TRUE("arena append",         str_ok(b, "another one that is a bit longer and grows"));
+    string big = stringFromCharPtr("");
+    for (int i = 0; i < 100; i++) {
+        big = stringAppendString(big, a);
+    }
+    ASSERT_TRUE("larger than a block",  stringlen(big) == 1200);
+    destroyString(a);
+
+    stringAllocator_t pool = stringPoolCreate();
+    stringUseAllocator(&pool);
+    string p = stringFromCharPtr("pooled");
+    ASSERT_TRUE("pool owns string",     getHeaderPointer(p)->allocator == &pool);
+    dataSegmentOfString_t *first = p.data;
+    destroyString(p);
+    string q = stringFromCharPtr("reused");
+    ASSERT_TRUE("pool reuses cell",     q.data == first);
+    for (int i = 0; i < 200; i++) {
+        q = stringAppendChar(q, '.');
+    }
+    ASSERT_TRUE("pool grows across classes", stringlen(q) == 206 && q.at[206] == '\0');
+    destroyString(q);
+    // past the largest class, both directly and by growing a pooled string, then freed by reset
+    string large = stringFromCharPtr("");
+    for (int i = 0; i < 1000; i++) {
+        large = stringAppendCharPtr(large, "0123456789");
+    }
+    string large_too = stringClone(large);
+    ASSERT_TRUE("pool large blocks",    stringlen(large) == 10000 && stringeql(large, large_too)
+        && getHeaderPointer(large_too)->allocator == &pool);
+    destroyString(large_too);
+    stringAllocatorReset(&pool);
+    stringUseAllocator(&pool);
+
+    stringUseAllocator(NULL);
+    string m = stringFromCharPtr("malloc again");
+    ASSERT_TRUE("back on default backend", getHeaderPointer(m)->allocator == NULL);
+    destroyString(m);
+
+    stringAllocatorReset(&arena);
+    string c = stringFromCharPtr("after reset");
+    ASSERT_TRUE("default after reset",  str_ok(c, "after reset"));
+    destroyString(c);
+
+    stringAllocatorDestroy(&arena);
+    stringAllocatorDestroy(&pool);
+}
+
 static void test_slice(void) {
     printf("\n-- stringSliceFromString --\n");
 
@@ -155,6 +254,46 @@ static void test_slice(void) {
     destroyString(src);
 }
 
+static void test_strview(void) {
+    printf("\n-- strview --\n");
+
+    string src = stringFromCharPtr("  key: value  ");
+    strview v = strview(src);
+    ASSERT_TRUE("view of string",        v.at == src.at && v.length == 14);
+
+    strview t = strviewTrim(v);
+    ASSERT_TRUE("trim points into source", t.at == src.at + 2 && t.length == 10);
+    ASSERT_TRUE("trim left",             strviewTrimLeft(v).length == 12);
+    ASSERT_TRUE("trim right",            strviewTrimRight(v).length == 12);
+
+    int colon = strviewFind(t, strview(":"));
+    ASSERT_TRUE("find in view",          colon == 3);
+    strview key = strviewSlice(t, 0, colon);
+    strview value = strviewTrim(strviewSlice(t, colon + 1, t.length));
+    ASSERT_TRUE("key view",              strvieweql(key, strview("key")));
+    ASSERT_TRUE("value view",            strvieweql(value, strview("value")));
+    ASSERT_TRUE("slice clamps",          strviewSlice(t, 8, 100).length == 2);
+    ASSERT_TRUE("find missing",          strviewFind(t, strview("xyz")) == -1);
+    ASSERT_TRUE("find last",             strviewFindLast(strview("abcabc"), strview("bc")) == 4);
+
+    ASSERT_TRUE("starts with",           strviewStartsWith(t, strview("key")));
+    ASSERT_TRUE("ends with",             strviewEndsWith(t, strview("lue")));
+    ASSERT_TRUE("not starts with",       !strviewStartsWith(key, strview("keys")));
+    ASSERT_TRUE("cmp orders",            strviewcmp(key, value) < 0 && strviewcmp(value, key) > 0);
+    ASSERT_TRUE("cmp prefix shorter",    strviewcmp(strview("ab"), strview("abc")) < 0);
+    ASSERT_TRUE("hash of equal views",   strviewHash(key) == strviewHash(strview("key")));
+
+    string copy = stringFromStrview(value);
+    ASSERT_TRUE("view to string",        str_ok(copy, "value"));
+    destroyString(copy);
+
+    size_t bytes_read = 0;
+    strview u = strview("xé");
+    ASSERT_TRUE("utf8 decode in view",   strviewUtf8DecodeAt(u, 1, &bytes_read) == 0xE9 && bytes_read == 2);
+
+    destroyString(src);
+}
+
 static void test_cmp(void) {
     printf("\n-- stringcmp / stringeql --\n");
 
@@ -172,8 +311,15 @@ static void test_cmp(void) {
     ASSERT_TRUE("cmp returns >0",     stringcmp(c, a) > 0);
     ASSERT_TRUE("cmp equal is 0",     stringcmp(a, b) == 0);
 
+    string ab = stringFromCharPtr("ab");
+    string abcd = stringFromCharPtr("abcd");
+    ASSERT_TRUE("ncmp prefix ending before n", stringncmp(ab, abcd, 3) < 0 && stringncmp(abcd, ab, 3) > 0);
+    ASSERT_TRUE("ncmp equal in first n",       stringncmp(abcd, a, 3) == 0 && stringncmp(ab, abcd, 2) == 0);
+    ASSERT_TRUE("ncmp with empty",             stringncmp(e, ab, 1) < 0 && stringncmp(ab, e, 0) == 0);
+
     destroyString(a); destroyString(b); destroyString(c);
     destroyString(e); destroyString(e2);
+    destroyString(ab); destroyString(abcd);
 }
 
 static void test_find(void) {
@@ -227,6 +373,65 @@ static void test_tokenize(void) {
     ASSERT_TRUE("empty tokenize no crash", true);
 }
 
+static void test_split_iter(void) {
+    printf("\n-- stringSplitIter --\n");
+
+    // pick a couple of fields out of a wide record without allocating the rest
+    string record = stringFromCharPtr("id,name,,email,created,tags");
+    string comma = stringFromCharPtr(",");
+    stringSplitIter_t it = stringSplitIter(record, comma);
+    strview field;
+    size_t index = 0;
+    bool name_ok = false, email_ok = false, empty_ok = false;
+    while (stringSplitNext(&it, &field)) {
+        if (index == 1) name_ok = strvieweql(field, strview("name"));
+        if (index == 2) empty_ok = field.length == 0;
+        if (index == 3) email_ok = strvieweql(field, strview("email"));
+        index++;
+    }
+    ASSERT_TRUE("split iter field count", index == 6);
+    ASSERT_TRUE("split iter field 1", name_ok);
+    ASSERT_TRUE("split iter empty field", empty_ok);
+    ASSERT_TRUE("split iter field 3", email_ok);
+    ASSERT_TRUE("split iter views input", field.at >= record.at && field.at < record.at + stringlen(record));
+    ASSERT_TRUE("split iter exhausted", !stringSplitNext(&it, &field));
+
+    string text = stringFromCharPtr("one\r\ntwo\rthree\n");
+    stringSplitIter_t lines = stringSplitLinesIter(text);
+    dynarray(string) expected = stringSplitLines(text);
+    bool lines_ok = true;
+    for (size_t i = 0; i < expected.count; i++) {
+        lines_ok &= stringSplitNext(&lines, &field) && strvieweql(field, strviewFromString(expected.at[i]));
+    }
+    ASSERT_TRUE("lines iter matches stringSplitLines", lines_ok && !stringSplitNext(&lines, &field));
+    ASSERT_TRUE("lines trailing empty line", expected.count == 4 && stringlen(expected.at[3]) == 0);
+    foreach(string s of expected) {
+        destroyString(s);
+    }
+    destroy_dynarray(expected);
+
+    stringSplitIter_t pairs = stringTokenizePairwiseIter("a [b] c [dd", "[", "]");
+    ASSERT_TRUE("pairwise iter first", stringSplitNext(&pairs, &field) && strvieweql(field, strview("b")));
+    ASSERT_TRUE("pairwise iter unclosed", stringSplitNext(&pairs, &field) && strvieweql(field, strview("dd")));
+    ASSERT_TRUE("pairwise iter end", !stringSplitNext(&pairs, &field));
+
+    stringSplitIter_t null_input = stringTokenizeIter(NULL, ";");
+    ASSERT_TRUE("tokenize iter null input", !stringSplitNext(&null_input, &field));
+
+    // collect into an arena, the whole batch goes away with one reset
+    stringAllocator_t arena = stringArenaCreate(4096);
+    dynarray(string) fields = stringSplitCollect(stringSplitIter(record, comma), &arena);
+    ASSERT_TRUE("collect count", fields.count == 6);
+    ASSERT_TRUE("collect value", str_ok(fields.at[5], "tags"));
+    ASSERT_TRUE("collect restores allocator", stringUseAllocator(NULL) == NULL);
+    destroy_dynarray(fields);
+    stringAllocatorDestroy(&arena);
+
+    destroyString(text);
+    destroyString(record);
+    destroyString(comma);
+}
+
 static void test_replace(void) {
     printf("\n-- stringReplace --\n");
 
@@ -255,9 +460,99 @@ static void test_replace(void) {
     destroyString(result3);
     destroyString(nomatch);
 
+    string dots = stringFromCharPtr("a.b.c.d");
+    string dot = stringFromCharPtr(".");
+    string sep = stringFromCharPtr("::");
+    string result4 = stringReplaceN(dots, dot, sep, 2);
+    ASSERT_TRUE("replaceN limit", str_ok(result4, "a::b::c.d"));
+    destroyString(result4);
+    destroyString(dots); destroyString(dot); destroyString(sep);
+
     destroyString(src); destroyString(find); destroyString(rep);
 }
 
+// leftmost-longest reference for stringReplaceMany, one pattern at a time per position
+static string naive_replace_many(const char *text, const char **finds, const char **reps, size_t count) {
+    string out = stringFromCharPtr("");
+    size_t len = strlen(text);
+    for (size_t i = 0; i < len;) {
+        size_t best = count;
+        for (size_t p = 0; p < count; p++) {
+            size_t flen = strlen(finds[p]);
+            if (flen && i + flen <= len && memcmp(text + i, finds[p], flen) == 0
+                && (best == count || flen > strlen(finds[best]))) {
+                best = p;
+            }
+        }
+        if (best == count) {
+            out = stringAppendChar(out, text[i++]);
+        } else {
+            out = stringAppendCharPtr(out, (char *)reps[best]);
+            i += strlen(finds[best]);
+        }
+    }
+    return out;
+}
+
+static void test_replace_many(void) {
+    printf("\n-- stringReplaceMany --\n");
+
+    string finds[] = { stringFromCharPtr("he"), stringFromCharPtr("she"),
+                       stringFromCharPtr("hers"), stringFromCharPtr("&") };
+    string reps[]  = { stringFromCharPtr("1"), stringFromCharPtr("2"),
+                       stringFromCharPtr("3"), stringFromCharPtr("&amp;") };
+    string text = stringFromCharPtr("ushers & she said hershey");
+    string result = stringReplaceMany(text, finds, reps, 4);
+    ASSERT_TRUE("replace many leftmost-longest", str_ok(result, "u2rs &amp; 2 said 31y"));
+    destroyString(result);
+
+    stringReplacer_t *replacer = stringReplacerCreate(finds, reps, 4);
+    string plain = stringFromCharPtr("nothing to see");
+    string unchanged = stringReplacerApply(replacer, plain);
+    ASSERT_TRUE("replacer no match", str_ok(unchanged, "nothing to see"));
+    destroyString(unchanged);
+    destroyString(plain);
+    stringReplacerDestroy(replacer);
+    for (size_t i = 0; i < 4; i++) {
+        destroyString(finds[i]);
+        destroyString(reps[i]);
+    }
+    destroyString(text);
+
+    // random patterns over a tiny alphabet, so matches overlap all the time
+    const char *pool[] = { "a", "ab", "abc", "ba", "bab", "c", "cc", "abab", "bca" };
+    const char *pool_reps[] = { "1", "22", "", "4444", "5", "66", "7", "8", "99" };
+    unsigned seed = 7;
+    bool all_ok = true;
+    for (int round = 0; round < 300; round++) {
+        size_t count = 1 + round % 9;
+        const char *rf[9], *rr[9];
+        string sf[9], sr[9];
+        for (size_t i = 0; i < count; i++) {
+            size_t pick = (seed = seed * 1103515245 + 12345) / 65536 % 9;
+            rf[i] = pool[pick];
+            rr[i] = pool_reps[pick];
+            sf[i] = stringFromCharPtr((char *)rf[i]);
+            sr[i] = stringFromCharPtr((char *)rr[i]);
+        }
+        char buf[80];
+        size_t blen = (seed = seed * 1103515245 + 12345) / 65536 % (sizeof buf - 1);
+        for (size_t i = 0; i < blen; i++) buf[i] = 'a' + (seed = seed * 1103515245 + 12345) / 65536 % 3;
+        buf[blen] = '\0';
+
+        string input = stringFromCharPtr(buf);
+        string got = stringReplaceMany(input, sf, sr, count);
+        string want = naive_replace_many(buf, rf, rr, count);
+        all_ok &= stringeql(got, want);
+        destroyString(input); destroyString(got); destroyString(want);
+        for (size_t i = 0; i < count; i++) {
+            destroyString(sf[i]);
+            destroyString(sr[i]);
+        }
+    }
+    ASSERT_TRUE("replace many matches reference", all_ok);
+}
+
 static void test_trim(void) {
     printf("\n-- stringTrim --\n");
 
@@ -296,6 +591,403 @@ static void test_grow_buffer(void) {
     destroyString(s);
 }
 
+static void test_reserve(void) {
+    printf("\n-- stringReserve / stringShrinkToFit --\n");
+
+    string s = stringFromCharPtr("abc");
+    s = stringReserve(s, 1000);
+    ASSERT_TRUE("reserve capacity",      stringCapacity(s) >= 1000);
+    ASSERT_TRUE("reserve keeps content", str_ok(s, "abc"));
+
+    dataSegmentOfString_t *before = s.data;
+    for (int i = 0; i < 900; i++) {
+        s = stringAppendChar(s, 'x');
+    }
+    ASSERT_TRUE("appends stay in reserved buffer", s.data == before);
+    ASSERT_TRUE("length after appends", stringlen(s) == 903);
+
+    s = stringShrinkToFit(s);
+    ASSERT_TRUE("shrink capacity",       stringCapacity(s) == 903);
+    ASSERT_TRUE("shrink keeps content",  stringlen(s) == 903 && s.at[903] == '\0');
+    destroyString(s);
+
+    string g = stringFromCharPtr("");
+    size_t growths = 0;
+    size_t last_capacity = stringCapacity(g);
+    for (int i = 0; i < 100000; i++) {
+        g = stringAppendChar(g, 'y');
+        if (stringCapacity(g) != last_capacity) {
+            growths++;
+            last_capacity = stringCapacity(g);
+        }
+    }
+    ASSERT_TRUE("geometric growth",      growths < 32);
+    destroyString(g);
+}
+
+static int naive_find(const char *h, size_t hlen, const char *n, size_t m, bool last) {
+    int found = -1;
+    for (size_t i = 0; i + m <= hlen; i++) {
+        if (memcmp(h + i, n, m) == 0) {
+            found = (int)i;
+            if (!last) break;
+        }
+    }
+    return found;
+}
+
+static void test_search(void) {
+    printf("\n-- substring search --\n");
+
+    // long periodic needle only matches at the very end, exercises two-way
+    char hay[4096];
+    memset(hay, 'a', sizeof hay);
+    hay[sizeof hay - 1] = 'b';
+    char needle[100];
+    memset(needle, 'a', sizeof needle);
+    needle[sizeof needle - 1] = 'b';
+    strview h = strviewFromParts(hay, sizeof hay);
+    strview n = strviewFromParts(needle, sizeof needle);
+    ASSERT_TRUE("two-way periodic", strviewFind(h, n) == (int)(sizeof hay - sizeof needle));
+    ASSERT_TRUE("two-way periodic last", strviewFindLast(h, n) == (int)(sizeof hay - sizeof needle));
+    ASSERT_TRUE("two-way start past match", strviewFindFrom(h, n, sizeof hay - sizeof needle + 1) == -1);
+
+    // randomized against brute force on a small alphabet, so matches are frequent
+    unsigned seed = 12345;
+    bool forward_ok = true, last_ok = true;
+    for (int round = 0; round < 2000; round++) {
+        char rh[300], rn[64];
+        size_t hlen = (seed = seed * 1103515245 + 12345) % sizeof rh;
+        size_t m = 1 + (seed = seed * 1103515245 + 12345) % sizeof rn;
+        int alphabet = 2 + round % 3;
+        for (size_t i = 0; i < hlen; i++) rh[i] = 'a' + (seed = seed * 1103515245 + 12345) / 65536 % alphabet;
+        for (size_t i = 0; i < m; i++)    rn[i] = 'a' + (seed = seed * 1103515245 + 12345) / 65536 % alphabet;
+        if (m <= hlen && round % 2) {
+            memcpy(rn, rh + (seed / 65536) % (hlen - m + 1), m);
+        }
+        strview vh = strviewFromParts(rh, hlen), vn = strviewFromParts(rn, m);
+        forward_ok &= strviewFind(vh, vn) == naive_find(rh, hlen, rn, m, false);
+        last_ok &= strviewFindLast(vh, vn) == naive_find(rh, hlen, rn, m, true);
+    }
+    ASSERT_TRUE("random find matches brute force", forward_ok);
+    ASSERT_TRUE("random find last matches brute force", last_ok);
+
+    string s = stringFromCharPtr("the cat sat on the mat with the hat");
+    string th = stringFromCharPtr("th");
+    string the = stringFromCharPtr("the");
+    string at = stringFromCharPtr("at");
+    ASSERT_TRUE("stringFind two bytes", stringFind(s, th) == 0);
+    ASSERT_TRUE("stringFindLast", stringFindLast(s, the) == 28);
+    ASSERT_TRUE("stringCount", stringCount(s, at) == 4);
+    destroyString(s);
+    destroyString(th);
+    destroyString(the);
+    destroyString(at);
+}
+
+static string hash_shared[2];
+
+// threads race to cache the hash of the same headers while comparing them
+static int hash_worker(void *arg) {
+    (void)arg;
+    bool ok = true;
+    for (size_t i = 0; i < 1000; i++) {
+        ok &= stringHash64(hash_shared[i % 2]) == strviewHash(strview("shared between threads"));
+        ok &= stringeql(hash_shared[0], hash_shared[1]);
+    }
+    return ok;
+}
+
+static void test_hash(void) {
+    printf("\n-- stringHash --\n");
+
+    string a = stringFromCharPtr("identifier");
+    string b = stringFromCharPtr("identifier");
+    ASSERT_TRUE("equal strings hash equal", stringHash64(a) == stringHash64(b));
+    ASSERT_TRUE("hash matches view hash",   stringHash64(a) == strviewHash(strview("identifier")));
+    ASSERT_TRUE("hash cached",              getHeaderPointer(a)->flags & string_hash_cached);
+    ASSERT_TRUE("32-bit fold",              stringHash(a) == stringHash(b));
+    ASSERT_TRUE("seed changes hash",        stringHashSeeded(a, 1) != stringHashSeeded(a, 2));
+    ASSERT_TRUE("seed 0 is the default",    stringHashSeeded(a, 0) == stringHash64(a));
+
+    uint64_t before = stringHash64(a);
+    a = stringAppendChar(a, 's');
+    ASSERT_TRUE("append drops cached hash", !(getHeaderPointer(a)->flags & string_hash_cached));
+    ASSERT_TRUE("hash follows contents",    stringHash64(a) != before);
+    ASSERT_TRUE("eql with cached hashes",   !stringeql(a, b) && stringeql(b, b));
+
+    hash_shared[0] = stringFromCharPtr("shared between threads");
+    hash_shared[1] = stringClone(hash_shared[0]);
+    thrd_t threads[4];
+    for (size_t i = 0; i < 4; i++) {
+        thrd_create(&threads[i], hash_worker, NULL);
+    }
+    bool threads_ok = true;
+    for (size_t i = 0; i < 4; i++) {
+        int ok = 0;
+        thrd_join(threads[i], &ok);
+        threads_ok &= ok != 0;
+    }
+    ASSERT_TRUE("concurrent hash caching",  threads_ok && (getHeaderPointer(hash_shared[1])->flags & string_hash_cached));
+    destroyString(hash_shared[0]);
+    destroyString(hash_shared[1]);
+
+    // every length class of the hash, long inputs included
+    char buf[256];
+    bool distinct = true;
+    for (size_t len = 0; len < sizeof buf; len++) {
+        memset(buf, 'x', len);
+        uint64_t h1 = strviewHash(strviewFromParts(buf, len));
+        if (len > 0) {
+            buf[len / 2] = 'y';
+            distinct &= strviewHash(strviewFromParts(buf, len)) != h1;
+        }
+        distinct &= len == 0 || strviewHash(strviewFromParts(buf, len - 1)) != h1;
+    }
+    ASSERT_TRUE("single byte changes the hash", distinct);
+
+    destroyString(a);
+    destroyString(b);
+}
+
+enum { intern_threads = 4, intern_keys = 2000 };
+static string intern_results[intern_threads][intern_keys];
+
+static int intern_worker(void *arg) {
+    size_t id = (size_t)arg;
+    char key[32];
+    for (size_t i = 0; i < intern_keys; i++) {
+        // every thread walks the keys in a different order
+        size_t k = (i + id * 517) % intern_keys;
+        int len = snprintf(key, sizeof key, "key_%zu", k);
+        intern_results[id][k] = stringIntern(strviewFromParts(key, len));
+    }
+    return 0;
+}
+
+static string intern_utf8;
+
+// code point lookups on a shared interned string while other keys are being interned
+static int intern_utf8_worker(void *arg) {
+    size_t id = (size_t)arg;
+    bool ok = true;
+    char key[32];
+    for (size_t i = 0; i < 2000; i++) {
+        int len = snprintf(key, sizeof key, "utf8_key_%zu_%zu", id, i);
+        stringIntern(strviewFromParts(key, len));
+        string ch = stringUtf8At(intern_utf8, 64 + (i + id) % 100);
+        ok &= str_ok(ch, (i + id) % 2 == 0 ? "\u00e9" : "x");
+        destroyString(ch);
+    }
+    return ok;
+}
+
+static void test_intern(void) {
+    printf("\n-- stringIntern --\n");
+    stringInternReset();
+
+    string a = stringFromCharPtr("storage_key");
+    string b = stringFromCharPtr("storage_key");
+    string ia = stringIntern(strviewFromString(a));
+    string ib = stringIntern(strviewFromString(b));
+    ASSERT_TRUE("same contents same pointer", ia.data == ib.data);
+    ASSERT_TRUE("interned value",             str_ok(ia, "storage_key"));
+    ASSERT_TRUE("is interned",                stringIsInterned(ia) && !stringIsInterned(a));
+    ASSERT_TRUE("interned eql plain",         stringeql(ia, a));
+    string other = stringIntern(strview("storage_kez"));
+    ASSERT_TRUE("different contents differ",  other.data != ia.data && !stringeql(other, ia));
+    string empty = stringIntern(strview(""));
+    ASSERT_TRUE("empty interns",              stringlen(empty) == 0 && empty.data == stringIntern(strview("")).data);
+    destroyString(ia); // ignored, the pool owns it
+    ASSERT_TRUE("destroy is a no-op",         str_ok(ib, "storage_key"));
+    destroyString(a);
+    destroyString(b);
+
+    thrd_t threads[intern_threads];
+    for (size_t i = 0; i < intern_threads; i++) {
+        thrd_create(&threads[i], intern_worker, (void *)i);
+    }
+    for (size_t i = 0; i < intern_threads; i++) {
+        thrd_join(threads[i], NULL);
+    }
+    bool agree = true;
+    for (size_t k = 0; k < intern_keys; k++) {
+        for (size_t t = 1; t < intern_threads; t++) {
+            agree &= intern_results[t][k].data == intern_results[0][k].data;
+        }
+    }
+    ASSERT_TRUE("threads agree on canonical copies", agree);
+    ASSERT_TRUE("pool count",                        stringInternCount() == intern_keys + 3);
+
+    char text[400] = "";
+    for (size_t i = 0; i < 100; i++) strcat(text, "\u00e9x");
+    intern_utf8 = stringIntern(strviewFromCharPtr(text));
+    for (size_t i = 0; i < intern_threads; i++) {
+        thrd_create(&threads[i], intern_utf8_worker, (void *)i);
+    }
+    bool utf8_ok = true;
+    for (size_t i = 0; i < intern_threads; i++) {
+        int ok = 0;
+        thrd_join(threads[i], &ok);
+        utf8_ok &= ok != 0;
+    }
+    ASSERT_TRUE("code points of an interned string",  utf8_ok);
+    ASSERT_TRUE("no index cached on interned string", getHeaderPointer(intern_utf8)->utf8_index == NULL);
+
+    stringInternReset();
+    ASSERT_TRUE("reset empties the pool",            stringInternCount() == 0);
+}
+
+enum { cow_threads = 4, cow_rounds = 20000 };
+
+static int cow_worker(void *arg) {
+    string shared = *(string *)arg;
+    for (size_t i = 0; i < cow_rounds; i++) {
+        string copy = stringFromString(shared);
+        if (i % 8 == 0) {
+            copy = stringAppendChar(copy, '!');
+        }
+        destroyString(copy);
+    }
+    return 0;
+}
+
+static void test_cow(void) {
+    printf("\n-- copy on write --\n");
+
+    string orig = stringFromCharPtr("a string long enough to leave the small cells");
+    string copy = stringFromString(orig);
+    ASSERT_TRUE("copy shares the buffer",     copy.data == orig.data);
+    ASSERT_TRUE("reference counted",          getHeaderPointer(orig)->refcount == 2);
+    copy = stringAppendCharPtr(copy, " and more");
+    ASSERT_TRUE("append detaches",            copy.data != orig.data);
+    ASSERT_TRUE("original unchanged",         str_ok(orig, "a string long enough to leave the small cells"));
+    ASSERT_TRUE("copy changed",               str_ok(copy, "a string long enough to leave the small cells and more"));
+    ASSERT_TRUE("reference given back",       getHeaderPointer(orig)->refcount == 1);
+    destroyString(copy);
+
+    string second = stringFromString(orig);
+    destroyString(orig); // second keeps the buffer alive
+    ASSERT_TRUE("survives the original",      str_ok(second, "a string long enough to leave the small cells"));
+    second = stringReverse(second);
+    ASSERT_TRUE("sole owner reverses in place", str_ok(second, "sllec llams eht evael ot hguone gnol gnirts a"));
+
+    string third = stringFromString(second);
+    string reversed = stringReverse(third);
+    ASSERT_TRUE("shared reverse detaches",    reversed.data != second.data && str_ok(reversed, "a string long enough to leave the small cells"));
+    ASSERT_TRUE("shared side untouched",      str_ok(second, "sllec llams eht evael ot hguone gnol gnirts a"));
+    destroyString(reversed);
+
+    string upper = stringFromString(second);
+    string shouted = stringToUpper(upper);
+    ASSERT_TRUE("case conversion copies",     second.at[0] == 's' && shouted.at[0] == 'S');
+    destroyString(shouted);
+    destroyString(upper);
+
+    stringBuilder_t sb = stringBuilderCreate(64);
+    stringBuilderAppendCStr(&sb, "built");
+    string built = stringBuilderToString(&sb);
+    stringBuilderClear(&sb);
+    stringBuilderAppendCStr(&sb, "again");
+    ASSERT_TRUE("builder result kept",        str_ok(built, "built"));
+    string rebuilt = stringBuilderToString(&sb);
+    ASSERT_TRUE("builder reused",             str_ok(rebuilt, "again"));
+    destroyString(built);
+    destroyString(rebuilt);
+    stringBuilderDestroy(&sb);
+
+    stringAllocator_t arena = stringArenaCreate(4096);
+    stringAllocator_t *previous = stringUseAllocator(&arena);
+    string in_arena = stringFromCharPtr("owned by the arena");
+    stringUseAllocator(previous);
+    string out = stringFromString(in_arena);
+    ASSERT_TRUE("other backend gets a copy",  out.data != in_arena.data && str_ok(out, "owned by the arena"));
+    stringAllocatorDestroy(&arena);
+    ASSERT_TRUE("copy outlives the arena",    str_ok(out, "owned by the arena"));
+    destroyString(out);
+
+    thrd_t threads[cow_threads];
+    for (size_t i = 0; i < cow_threads; i++) {
+        thrd_create(&threads[i], cow_worker, &second);
+    }
+    for (size_t i = 0; i < cow_threads; i++) {
+        thrd_join(threads[i], NULL);
+    }
+    ASSERT_TRUE("threads leave the count",    getHeaderPointer(second)->refcount == 1);
+    ASSERT_TRUE("threads leave the contents", str_ok(second, "sllec llams eht evael ot hguone gnol gnirts a"));
+    destroyString(second);
+}
+
+static void test_builder(void) {
+    printf("\n-- stringBuilder --\n");
+
+    stringBuilder_t sb = stringBuilderCreate(8);
+    char expected[4096];
+    size_t len = 0;
+    for (int i = 0; i < 300; i++) {
+        stringBuilderAppendFormat(&sb, "%d,", i);
+        len += snprintf(expected + len, sizeof expected - len, "%d,", i);
+        stringBuilderAppendChar(&sb, 'x');
+        expected[len++] = 'x';
+    }
+    stringBuilderAppendCStr(&sb, "end");
+    memcpy(expected + len, "end", 4);
+    len += 3;
+    ASSERT_TRUE("appends and formats",     str_ok(sb.buffer, expected) && stringBuilderLength(&sb) == len);
+    ASSERT_TRUE("capacity grows ahead",    sb.capacity >= len && sb.capacity < 4 * len);
+
+    char *buffer = sb.buffer.at;
+    string done = stringBuilderFinish(&sb);
+    ASSERT_TRUE("finish hands over",       done.at == buffer && str_ok(done, expected));
+    ASSERT_TRUE("finish empties",          stringBuilderLength(&sb) == 0);
+    stringBuilderAppendFormat(&sb, "%s-%05d", "again", 42);
+    string again = stringBuilderToString(&sb);
+    ASSERT_TRUE("usable after finish",     str_ok(again, "again-00042"));
+    destroyString(again);
+    destroyString(done);
+    stringBuilderDestroy(&sb);
+
+    stringBuilder_t chunked = stringBuilderCreateChunked(16);
+    len = 0;
+    for (int i = 0; i < 20; i++) {
+        stringBuilderAppendCStr(&chunked, "abcdefg");
+        memcpy(expected + len, "abcdefg", 7);
+        len += 7;
+    }
+    stringBuilderAppendFormat(&chunked, "[%40s]", "wide");
+    len += snprintf(expected + len, sizeof expected - len, "[%40s]", "wide");
+    stringBuilderAppendChar(&chunked, '!');
+    expected[len++] = '!';
+    expected[len] = '\0';
+    ASSERT_TRUE("chunked length",          stringBuilderLength(&chunked) == len);
+    ASSERT_TRUE("chunked buffer terminated", chunked.buffer.at[stringlen(chunked.buffer)] == '\0');
+    string joined = stringBuilderToString(&chunked);
+    ASSERT_TRUE("chunked to string",       str_ok(joined, expected));
+
+    dynarray(string) chunks = stringBuilderFinishChunks(&chunked);
+    bool ordered = true;
+    size_t covered = 0, chunk_count = chunks.count;
+    for (size_t i = 0; i < chunks.count; i++) {
+        // chunks hold at least 16 bytes, more if the allocator rounds up or a format needs it
+        ordered &= stringlen(chunks.at[i]) > 0 && stringlen(chunks.at[i]) <= 42;
+        ordered &= memcmp(chunks.at[i].at, expected + covered, stringlen(chunks.at[i])) == 0;
+        covered += stringlen(chunks.at[i]);
+        destroyString(chunks.at[i]);
+    }
+    destroy_dynarray(chunks);
+    ASSERT_TRUE("chunks in order",         ordered && covered == len);
+    ASSERT_TRUE("chunks are filled",       chunk_count >= 3 && chunk_count <= len / 16 + 2);
+
+    stringBuilderAppendCStr(&chunked, "0123456789abcdef0123");
+    stringBuilderClear(&chunked);
+    stringBuilderAppendCStr(&chunked, "after clear, more than one chunk");
+    string finished = stringBuilderFinish(&chunked);
+    ASSERT_TRUE("chunked finish joins",    str_ok(finished, "after clear, more than one chunk"));
+    destroyString(finished);
+    destroyString(joined);
+    stringBuilderDestroy(&chunked);
+}
+
 static void test_reverse(void) {
     printf("\n-- stringReverse --\n");
 
@@ -347,6 +1039,83 @@ static void test_format(void) {
     destroyString(s2);
 }
 
+// strict reference decoder for the validator tests
+static bool reference_utf8_valid(const unsigned char *at, size_t len) {
+    for (size_t i = 0; i < len;) {
+        unsigned char c = at[i];
+        size_t need = c < 0x80 ? 0 : c < 0xC0 ? 9 : c < 0xE0 ? 1 : c < 0xF0 ? 2 : c < 0xF8 ? 3 : 9;
+        if (need == 9 || i + need >= len + (need == 0)) return need == 0 && i < len;
+        uint32_t cp = need == 0 ? c : c & (0x3F >> need);
+        for (size_t k = 1; k <= need; k++) {
+            if ((at[i + k] & 0xC0) != 0x80) return false;
+            cp = cp << 6 | (at[i + k] & 0x3F);
+        }
+        static const uint32_t min_for_length[] = { 0, 0x80, 0x800, 0x10000 };
+        if (cp < min_for_length[need] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return false;
+        i += need + 1;
+    }
+    return true;
+}
+
+static void test_utf8_validate(void) {
+    printf("\n-- stringUtf8Validate --\n");
+
+    struct { const char *bytes; bool valid; const char *name; } cases[] = {
+        { "\xC3\xA9", true, "two byte" },
+        { "\xE2\x82\xAC", true, "three byte" },
+        { "\xF0\x9F\x98\x80", true, "four byte" },
+        { "\xF4\x8F\xBF\xBF", true, "max code point" },
+        { "\xC0\x80", false, "overlong nul" },
+        { "\xC1\xBF", false, "overlong two byte" },
+        { "\xE0\x80\xAF", false, "overlong three byte" },
+        { "\xF0\x8F\xBF\xBF", false, "overlong four byte" },
+        { "\xED\xA0\x80", false, "surrogate" },
+        { "\xF4\x90\x80\x80", false, "above max" },
+        { "\xF8\x88\x80\x80\x80", false, "five byte" },
+        { "\xE2\x82", false, "truncated" },
+        { "\x80", false, "stray continuation" },
+    };
+    bool accepts_valid = true, rejects_invalid = true;
+    for (size_t i = 0; i < sizeof cases / sizeof cases[0]; i++) {
+        // at the end of a long ascii run as well, so the block paths see it too
+        string alone = stringFromCharPtr((char *)cases[i].bytes);
+        string padded = stringFromCharPtr("0123456789abcdefghijklmnopqrstuvwxyz0123456789");
+        padded = stringAppendCharPtr(padded, (char *)cases[i].bytes);
+        bool ok = stringUtf8Validate(alone) == cases[i].valid && stringUtf8Validate(padded) == cases[i].valid;
+        if (!ok) printf("  wrong verdict: %s\n", cases[i].name);
+        if (cases[i].valid) accepts_valid &= ok;
+        else rejects_invalid &= ok;
+        destroyString(alone);
+        destroyString(padded);
+    }
+    ASSERT_TRUE("validate accepts multibyte", accepts_valid);
+    ASSERT_TRUE("validate rejects overlong, surrogate, truncated", rejects_invalid);
+
+    // random mixes of valid text and bad bytes against the reference
+    static const char *pieces[] = { "a", "hello world, ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+                                    "\x80", "\xC0", "\xED\xA0", "\xF4\x90", "\xE0\xA0", "\xFF", "\xEF\xBF\xBD" };
+    unsigned seed = 42;
+    bool validate_ok = true, length_ok = true;
+    for (int round = 0; round < 3000; round++) {
+        unsigned char buf[200];
+        size_t len = 0;
+        size_t pieces_wanted = (seed = seed * 1103515245 + 12345) / 65536 % 40;
+        for (size_t p = 0; p < pieces_wanted; p++) {
+            size_t pick = (seed = seed * 1103515245 + 12345) / 65536 % (round % 3 ? 5 : 12);
+            size_t plen = strlen(pieces[pick]);
+            if (len + plen > sizeof buf) break;
+            memcpy(buf + len, pieces[pick], plen);
+            len += plen;
+        }
+        validate_ok &= strviewUtf8Validate(strviewFromParts((char *)buf, len)) == reference_utf8_valid(buf, len);
+        size_t code_points = 0;
+        for (size_t i = 0; i < len; i++) code_points += (buf[i] & 0xC0) != 0x80;
+        length_ok &= strviewUtf8Length(strviewFromParts((char *)buf, len)) == code_points;
+    }
+    ASSERT_TRUE("validate matches reference", validate_ok);
+    ASSERT_TRUE("length counts code points", length_ok);
+}
+
 static void test_utf8(void) {
     printf("\n-- UTF-8 Support --\n");
 
@@ -374,23 +1143,1073 @@ static void test_utf8(void) {
     destroyString(u);
 }
 
+static void test_ascii(void) {
+    printf("\n-- ascii case and classes --\n");
+
+    string mixed = stringFromCharPtr("Content-Type: Text/HTML; charset=\xC3\x89t\xC3\xA9 @[`{ 0123456789");
+    string upper = stringToUpper(mixed);
+    string lower = stringToLower(mixed);
+    ASSERT_TRUE("upper",                  str_ok(upper, "CONTENT-TYPE: TEXT/HTML; CHARSET=\xC3\x89T\xC3\xA9 @[`{ 0123456789"));
+    ASSERT_TRUE("lower",                  str_ok(lower, "content-type: text/html; charset=\xC3\x89t\xC3\xA9 @[`{ 0123456789"));
+    ASSERT_TRUE("ignore case equal",      stringcmpIgnoreCase(upper, lower) == 0 && stringcmpIgnoreCase(mixed, upper) == 0);
+
+    // every length around the block sizes, every byte value, against the per byte definition
+    char bytes[80], want_upper[80], want_lower[80];
+    bool cases_agree = true;
+    for (size_t len = 0; len < sizeof bytes; len++) {
+        for (size_t start = 0; start < 256; start += 37) {
+            for (size_t i = 0; i < len; i++) {
+                unsigned char c = (unsigned char)(start + i * 7);
+                bytes[i] = (char)c;
+                want_upper[i] = (char)(c >= 'a' && c <= 'z' ? c - 32 : c);
+                want_lower[i] = (char)(c >= 'A' && c <= 'Z' ? c + 32 : c);
+            }
+            string source = stringFromStrview(strviewFromParts(bytes, len));
+            string up = stringToUpper(source);
+            source = stringToLowerInPlace(source);
+            cases_agree &= memcmp(up.at, want_upper, len) == 0 && memcmp(source.at, want_lower, len) == 0
+                && stringlen(up) == len && stringlen(source) == len;
+            destroyString(up);
+            destroyString(source);
+        }
+    }
+    ASSERT_TRUE("all bytes, all lengths", cases_agree);
+
+    string shared = stringFromString(mixed);
+    shared = stringToUpperInPlace(shared);
+    ASSERT_TRUE("in place detaches",      shared.data != mixed.data && str_ok(shared, upper.at));
+    ASSERT_TRUE("shared side untouched",  str_ok(mixed, "Content-Type: Text/HTML; charset=\xC3\x89t\xC3\xA9 @[`{ 0123456789"));
+    string own = stringFromCharPtr("MiXeD CaSe KeY");
+    char *before = own.at;
+    own = stringToLowerInPlace(own);
+    ASSERT_TRUE("sole owner stays put",   own.at == before && str_ok(own, "mixed case key"));
+    destroyString(own);
+    destroyString(shared);
+
+    bool classes_agree = true;
+    char run[70];
+    for (size_t len = 1; len < sizeof run; len++) {
+        for (size_t bad = 0; bad <= len; bad++) {
+            for (size_t i = 0; i < len; i++) run[i] = "0123456789"[i % 10];
+            if (bad < len) run[bad] = 'x';
+            string digits = stringFromStrview(strviewFromParts(run, len));
+            classes_agree &= stringIsDigit(digits) == (bad == len);
+            for (size_t i = 0; i < len; i++) run[i] = " \t\n\v\f\r"[i % 6];
+            if (bad < len) run[bad] = '\xA0';
+            string spaces = stringFromStrview(strviewFromParts(run, len));
+            classes_agree &= stringIsWhitespace(spaces) == (bad == len);
+            for (size_t i = 0; i < len; i++) run[i] = "aZ"[i % 2];
+            if (bad < len) run[bad] = (bad % 2) ? '@' : '[';
+            string alpha = stringFromStrview(strviewFromParts(run, len));
+            classes_agree &= stringIsAlpha(alpha) == (bad == len);
+            run[len] = '\0';
+            if (bad < len) run[bad] = (bad % 2) ? '7' : '`';
+            classes_agree &= stringIsOnlyAlphNum(run) == (bad == len || bad % 2 == 1);
+            destroyString(digits);
+            destroyString(spaces);
+            destroyString(alpha);
+        }
+    }
+    ASSERT_TRUE("classes at every position", classes_agree);
+    ASSERT_TRUE("empty is in no class",   !stringIsDigit(string("")) && stringIsOnlyAlphNum(""));
+
+    bool order_agrees = true;
+    char a[70], b[70];
+    for (size_t len = 1; len < sizeof a; len++) {
+        for (size_t diff = 0; diff < len; diff++) {
+            for (size_t i = 0; i < len; i++) {
+                a[i] = "aBcD"[i % 4];
+                b[i] = "AbCd"[i % 4];
+            }
+            b[diff] = 'z';
+            string sa = stringFromStrview(strviewFromParts(a, len));
+            string sb = stringFromStrview(strviewFromParts(b, len));
+            int want = (a[diff] | 0x20) - 'z';
+            order_agrees &= stringcmpIgnoreCase(sa, sb) == want && stringcmpIgnoreCase(sb, sa) == -want;
+            destroyString(sa);
+            destroyString(sb);
+        }
+    }
+    ASSERT_TRUE("first difference decides", order_agrees);
+
+    destroyString(upper);
+    destroyString(lower);
+    destroyString(mixed);
+}
+
+static string utf8_shared;
+
+// every thread starts on an unindexed string, so they race to publish the index
+static int utf8_index_worker(void *arg) {
+    size_t id = (size_t)arg;
+    bool ok = true;
+    for (size_t i = 0; i < 200; i++) {
+        size_t at = 64 + (i * 7 + id * 13) % 900;
+        string ch = stringUtf8At(utf8_shared, at);
+        ok &= str_ok(ch, at % 2 == 0 ? "\u00e9" : "x");
+        destroyString(ch);
+    }
+    return ok;
+}
+
+static void test_utf8_index(void) {
+    printf("\n-- stringUtf8At index --\n");
+
+    // mixed widths, so character and byte offsets drift apart
+    static const char *glyphs[] = { "a", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80" };
+    string text = stringFromCharPtr("");
+    for (size_t i = 0; i < 1000; i++) {
+        text = stringAppendCharPtr(text, (char *)glyphs[i % 4]);
+    }
+
+    bool all_ok = true;
+    for (size_t i = 0; i < 1000; i += 7) {
+        string c = stringUtf8At(text, i);
+        all_ok &= str_ok(c, glyphs[i % 4]);
+        destroyString(c);
+    }
+    ASSERT_TRUE("indexed lookups", all_ok);
+    ASSERT_TRUE("index built", getHeaderPointer(text)->utf8_index != NULL);
+    ASSERT_TRUE("past the end", stringUtf8At(text, 1000).data == NULL);
+
+    // appending drops the index, the next lookup sees the new characters
+    text = stringAppendCharPtr(text, "xyz");
+    ASSERT_TRUE("append invalidates", getHeaderPointer(text)->utf8_index == NULL);
+    string last = stringUtf8At(text, 1002);
+    ASSERT_TRUE("lookup after append", str_ok(last, "z"));
+    destroyString(last);
+
+    text = stringPrependChar(text, '!');
+    string shifted = stringUtf8At(text, 100);
+    ASSERT_TRUE("lookup after prepend", str_ok(shifted, glyphs[99 % 4]));
+    destroyString(shifted);
+    destroyString(text);
+
+    utf8_shared = stringFromCharPtr("");
+    for (size_t i = 0; i < 500; i++) {
+        utf8_shared = stringAppendCharPtr(utf8_shared, "\u00e9x");
+    }
+    thrd_t threads[4];
+    for (size_t i = 0; i < 4; i++) {
+        thrd_create(&threads[i], utf8_index_worker, (void *)i);
+    }
+    bool threads_ok = true;
+    for (size_t i = 0; i < 4; i++) {
+        int ok = 0;
+        thrd_join(threads[i], &ok);
+        threads_ok &= ok != 0;
+    }
+    ASSERT_TRUE("concurrent first lookups", threads_ok && getHeaderPointer(utf8_shared)->utf8_index != NULL);
+    destroyString(utf8_shared);
+
+    // arena strings are walked, the arena is not locked for other threads
+    stringAllocator_t arena = stringArenaCreate(1024);
+    stringAllocator_t *previous = stringUseAllocator(&arena);
+    string in_arena = stringFromCharPtr("");
+    for (size_t i = 0; i < 300; i++) {
+        in_arena = stringAppendCharPtr(in_arena, (char *)glyphs[i % 4]);
+    }
+    string deep = stringUtf8At(in_arena, 299);
+    stringUseAllocator(previous);
+    ASSERT_TRUE("arena lookup", str_ok(deep, glyphs[299 % 4])
+        && getHeaderPointer(in_arena)->utf8_index == NULL);
+    stringAllocatorDestroy(&arena);
+}
+
+static bool number_ok(string str, const char *expected) {
+    bool ok = str_ok(str, expected);
+    destroyString(str);
+    return ok;
+}
+
+// the significant digits of a formatted double, without sign, point, exponent or leading zeros
+static size_t significant_digits(const char *text, char *digits) {
+    size_t n = 0;
+    for (const char *c = text; *c && *c != 'e'; c++) {
+        if (*c >= '0' && *c <= '9' && (n > 0 || *c != '0')) digits[n++] = *c;
+    }
+    while (n > 1 && digits[n - 1] == '0' && strchr(text, '.') == NULL) n--; // integer zeros
+    digits[n] = '\0';
+    return n;
+}
+
+static void test_numbers(void) {
+    printf("\n-- number formatting --\n");
+
+    ASSERT_TRUE("small integers",         number_ok(stringFromInt(0), "0") && number_ok(stringFromInt(7), "7")
+        && number_ok(stringFromInt(42), "42") && number_ok(stringFromInt(-100), "-100"));
+    ASSERT_TRUE("integer limits",         number_ok(stringFromInt(INT_MIN), "-2147483648")
+        && number_ok(stringFromInt64(INT64_MIN), "-9223372036854775808")
+        && number_ok(stringFromUint64(UINT64_MAX), "18446744073709551615"));
+    bool ints_agree = true;
+    uint64_t seed = 17;
+    char want[64];
+    for (size_t i = 0; i < 20000; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        int64_t value = (int64_t)seed >> (seed % 64);
+        snprintf(want, sizeof want, "%lld", (long long)value);
+        ints_agree &= number_ok(stringFromInt64(value), want);
+        snprintf(want, sizeof want, "%llu", (unsigned long long)seed >> (seed % 61));
+        ints_agree &= number_ok(stringFromUint64(seed >> (seed % 61)), want);
+    }
+    ASSERT_TRUE("integers match printf",  ints_agree);
+
+    ASSERT_TRUE("shortest doubles",       number_ok(stringFromDouble(0.1, -1), "0.1")
+        && number_ok(stringFromDouble(1.0, -1), "1") && number_ok(stringFromDouble(-0.0, -1), "-0")
+        && number_ok(stringFromDouble(123.456, -1), "123.456") && number_ok(stringFromDouble(0.3, -1), "0.3")
+        && number_ok(stringFromDouble(0.1 + 0.2, -1), "0.30000000000000004")
+        && number_ok(stringFromDouble(-1.5e-7, -1), "-1.5e-7") && number_ok(stringFromDouble(0.000001, -1), "0.000001")
+        && number_ok(stringFromDouble(1e20, -1), "100000000000000000000") && number_ok(stringFromDouble(1e21, -1), "1e+21")
+        && number_ok(stringFromDouble(5e-324, -1), "5e-324")
+        && number_ok(stringFromDouble(1.7976931348623157e308, -1), "1.7976931348623157e+308")
+        && number_ok(stringFromDouble(9007199254740993.0, -1), "9007199254740992"));
+    ASSERT_TRUE("special doubles",        number_ok(stringFromDouble(0.0 / 0.0, -1), "nan")
+        && number_ok(stringFromDouble(-1.0 / 0.0, -1), "-inf") && number_ok(stringFromDouble(1.0 / 0.0, -1), "inf"));
+    string wide = stringFromDouble(1e300, 2);
+    ASSERT_TRUE("fixed precision",        number_ok(stringFromDouble(3.14159, 2), "3.14")
+        && stringlen(wide) == 304 && strncmp(wide.at, "1000000000000000052504760255204420248704", 40) == 0);
+    destroyString(wide);
+
+    // every random bit pattern reads back exactly, and no shorter decimal does
+    bool round_trips = true, shortest = true;
+    char ours[64], digits[32], theirs[32];
+    for (size_t i = 0; i < 200000 && round_trips && shortest; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        double value;
+        uint64_t bits = seed;
+        if (i % 4 == 0) bits = (bits & ~(0x7FFull << 52)) | ((seed >> 7) % 64 + 1000) << 52; // magnitudes near 1
+        memcpy(&value, &bits, sizeof value);
+        if (value != value || value - value != 0) continue;
+        string text = stringFromDouble(value, -1);
+        snprintf(ours, sizeof ours, "%s", text.at);
+        destroyString(text);
+        round_trips &= strtod(ours, NULL) == value;
+        size_t n = significant_digits(ours, digits);
+        if (n > 1) {
+            snprintf(want, sizeof want, "%.*e", (int)n - 2, value);
+            shortest &= strtod(want, NULL) != value;
+        }
+        snprintf(want, sizeof want, "%.*e", (int)n - 1, value);
+        significant_digits(want, theirs);
+        shortest &= strcmp(digits, theirs) == 0 || strtod(want, NULL) != value;
+        if (!round_trips || !shortest) printf("    %s vs %s\n", ours, want);
+    }
+    ASSERT_TRUE("random doubles round trip", round_trips);
+    ASSERT_TRUE("and are shortest",       shortest);
+
+    stringBuilder_t sb = stringBuilderCreate(0);
+    stringBuilderAppendInt(&sb, -42);
+    stringBuilderAppendChar(&sb, ',');
+    stringBuilderAppendUint(&sb, 18446744073709551615ull);
+    stringBuilderAppendChar(&sb, ',');
+    stringBuilderAppendDouble(&sb, 2.5);
+    string line = stringBuilderFinish(&sb);
+    ASSERT_TRUE("builder numbers",        str_ok(line, "-42,18446744073709551615,2.5"));
+    destroyString(line);
+}
+
+static bool int64_is(const char *text, stringNumberStatus_t status, int64_t expected) {
+    int64_t value = 0;
+    stringNumberStatus_t got = strviewToInt64(strview(text), &value);
+    bool ok = got == status && (status == string_number_invalid || value == expected);
+    if (!ok) printf("    '%s': status %d value %lld\n", text, (int)got, (long long)value);
+    return ok;
+}
+
+// strtod is correctly rounded in glibc, compare bit for bit
+static bool double_agrees(const char *text) {
+    double value = 0, expected = strtod(text, NULL);
+    stringNumberStatus_t status = strviewToDouble(strview(text), &value);
+    bool ok = memcmp(&value, &expected, sizeof value) == 0
+        && status == (expected - expected != 0 && (text[strspn(text, "+-")] | 0x20) != 'i' ? string_number_overflow : string_number_ok);
+    if (!ok) printf("    '%.60s': got %.17g want %.17g\n", text, value, expected);
+    return ok;
+}
+
+static void test_parse_numbers(void) {
+    printf("\n-- number parsing --\n");
+
+    ASSERT_TRUE("integers",               int64_is("0", string_number_ok, 0) && int64_is("-0", string_number_ok, 0)
+        && int64_is("+42", string_number_ok, 42) && int64_is("1234567890123456", string_number_ok, 1234567890123456)
+        && int64_is("-00000000000000000000000000017", string_number_ok, -17));
+    ASSERT_TRUE("int64 limits",           int64_is("9223372036854775807", string_number_ok, INT64_MAX)
+        && int64_is("-9223372036854775808", string_number_ok, INT64_MIN)
+        && int64_is("9223372036854775808", string_number_overflow, INT64_MAX)
+        && int64_is("-9223372036854775809", string_number_overflow, INT64_MIN)
+        && int64_is("123456789012345678901234567890", string_number_overflow, INT64_MAX));
+    ASSERT_TRUE("malformed integers",     int64_is("", string_number_invalid, 0) && int64_is("-", string_number_invalid, 0)
+        && int64_is(" 1", string_number_invalid, 0) && int64_is("12a", string_number_invalid, 0)
+        && int64_is("99999999999999999999x", string_number_invalid, 0) && int64_is("1234567a", string_number_invalid, 0));
+    uint64_t unsigned_value = 0;
+    ASSERT_TRUE("uint64 limits",          strviewToUint64(strview("18446744073709551615"), &unsigned_value) == string_number_ok
+        && unsigned_value == UINT64_MAX
+        && strviewToUint64(strview("18446744073709551616"), &unsigned_value) == string_number_overflow
+        && strviewToUint64(strview("-1"), &unsigned_value) == string_number_invalid);
+
+    // no terminator after the view, reading past it would trip the sanitizers
+    char digits[16];
+    memcpy(digits, "1234567890123456", 16);
+    int64_t bounded = 0;
+    double bounded_double = 0;
+    ASSERT_TRUE("stops at the view",      strviewToInt64(strviewFromParts(digits, 16), &bounded) == string_number_ok
+        && bounded == 1234567890123456 && strviewToInt64(strviewFromParts(digits, 5), &bounded) == string_number_ok
+        && bounded == 12345 && strviewToDouble(strviewFromParts(digits, 12), &bounded_double) == string_number_ok
+        && bounded_double == 123456789012.0);
+    string line = stringFromCharPtr("width=640;height=480");
+    string width = stringSliceFromString(line, 6, 9);
+    int parsed_int = 0;
+    long parsed_long = 0;
+    ASSERT_TRUE("string wrappers",        stringToInt(width, &parsed_int) && parsed_int == 640
+        && !stringToInt(string("2147483648"), &parsed_int) && stringToLong(string("-2147483649"), &parsed_long)
+        && parsed_long == -2147483649L);
+    destroyString(width);
+    destroyString(line);
+
+    ASSERT_TRUE("doubles",                double_agrees("0") && double_agrees("-0.0") && double_agrees("3.14159")
+        && double_agrees(".5") && double_agrees("5.") && double_agrees("1e10") && double_agrees("1E-5")
+        && double_agrees("0.1") && double_agrees("123456789012345678901234567890")
+        && double_agrees("0.000000000000000000000000000000000000001234567890123456789"));
+    ASSERT_TRUE("hard doubles",           double_agrees("9007199254740993") && double_agrees("2.2250738585072011e-308")
+        && double_agrees("4.9406564584124654e-324") && double_agrees("2.4703282292062328e-324")
+        && double_agrees("1.7976931348623157e308") && double_agrees("1.7976931348623158e308")
+        && double_agrees("1e-400") && double_agrees("-1e400") && double_agrees("7.2057594037927933e16"));
+    ASSERT_TRUE("special doubles",        double_agrees("inf") && double_agrees("-Infinity")
+        && strviewToDouble(strview("NaN"), &bounded_double) == string_number_ok && bounded_double != bounded_double);
+    ASSERT_TRUE("malformed doubles",      strviewToDouble(strview(""), NULL) == string_number_invalid
+        && strviewToDouble(strview("."), NULL) == string_number_invalid
+        && strviewToDouble(strview("1e"), NULL) == string_number_invalid
+        && strviewToDouble(strview("1.5 "), NULL) == string_number_invalid
+        && strviewToDouble(strview("0x10"), NULL) == string_number_invalid
+        && strviewToDouble(strview("infinit"), NULL) == string_number_invalid);
+
+    // random doubles in every precision, long digit strings, and exact halfway points between neighbours
+    bool all_agree = true;
+    uint64_t seed = 99;
+    char text[1024];
+    for (size_t i = 0; i < 100000 && all_agree; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        double value;
+        memcpy(&value, &seed, sizeof value);
+        if (value != value || value - value != 0) continue;
+        switch (i % 4) {
+        case 0: snprintf(text, sizeof text, "%.17g", value); break;
+        case 1: snprintf(text, sizeof text, "%.*e", (int)(seed >> 59), value); break;
+        case 2: {
+            size_t n = 1 + (seed >> 52) % 40;
+            for (size_t d = 0; d < n; d++) text[d] = '0' + (char)((seed >> (d % 50)) % 10);
+            snprintf(text + n, sizeof text - n, "e%d", (int)((seed >> 20) % 640) - 340);
+            break;
+        }
+        default: {
+            long double next = nextafter(value, value * 2);
+            snprintf(text, sizeof text, "%.800Le", (long double)value + (next - (long double)value) / 2);
+        }
+        }
+        all_agree &= double_agrees(text);
+    }
+    ASSERT_TRUE("random doubles agree with strtod", all_agree);
+}
+
+static size_t reference_escape(const char *raw, size_t len, char *out) {
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        unsigned char ch = (unsigned char)raw[i];
+        char named = 0;
+        switch (ch) {
+            case '\n': named = 'n'; break;
+            case '\r': named = 'r'; break;
+            case '\t': named = 't'; break;
+            case '\b': named = 'b'; break;
+            case '\f': named = 'f'; break;
+            case '\\': case '"': case '\'': named = (char)ch; break;
+        }
+        if (named != 0) {
+            out[n++] = '\\';
+            out[n++] = named;
+        } else if (ch < 32 || ch > 126) {
+            n += (size_t)snprintf(out + n, 5, "\\x%02x", ch);
+        } else {
+            out[n++] = (char)ch;
+        }
+    }
+    out[n] = '\0';
+    return n;
+}
+
+static void test_escape_hex(void) {
+    printf("\n-- escaping and hex --\n");
+
+    string tricky = stringFromStrview(strviewFromParts("a\"b\\c\n\x01\xff'", 9));
+    string escaped = stringEscapeC(tricky);
+    ASSERT_TRUE("escape",                 str_ok(escaped, "a\\\"b\\\\c\\n\\x01\\xff\\'"));
+    string unescaped = stringUnescapeC(escaped);
+    ASSERT_TRUE("unescape",               stringeql(unescaped, tricky));
+    destroyString(unescaped);
+    destroyString(escaped);
+    destroyString(tricky);
+
+    string odd = stringFromCharPtr("\\q \\x4g \\x7e\\");
+    string odd_result = stringUnescapeC(odd);
+    ASSERT_TRUE("unusual escapes",        str_ok(odd_result, "q x4g ~\\"));
+    destroyString(odd_result);
+    destroyString(odd);
+
+    // escapes at every offset of long plain runs, and random bytes, through both directions
+    bool escapes_ok = true, hex_ok = true;
+    char raw[300], expected[1200];
+    uint64_t seed = 5;
+    for (size_t round = 0; round < 600; round++) {
+        size_t len = round % 300;
+        for (size_t i = 0; i < len; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            raw[i] = round < 300 ? (char)('a' + i % 26) : (char)(seed >> 56);
+        }
+        if (round < 300 && len > 0) raw[(round * 7) % len] = "\n\"\\\x80"[round % 4];
+        string input = stringFromStrview(strviewFromParts(raw, len));
+
+        size_t n = reference_escape(raw, len, expected);
+        string e = stringEscapeC(input);
+        string back = stringUnescapeC(e);
+        escapes_ok &= stringlen(e) == n && strcmp(e.at, expected) == 0 && stringeql(back, input);
+
+        for (size_t i = 0; i < len; i++) snprintf(expected + 2 * i, 3, "%02x", (unsigned char)raw[i]);
+        string hex = stringToHex(input);
+        string decoded = stringFromHex(hex);
+        hex_ok &= stringlen(hex) == 2 * len && memcmp(hex.at, expected, 2 * len) == 0 && stringeql(decoded, input);
+        destroyString(decoded);
+        destroyString(hex);
+        destroyString(back);
+        destroyString(e);
+        destroyString(input);
+    }
+    ASSERT_TRUE("escapes match reference", escapes_ok);
+    ASSERT_TRUE("hex round trips",        hex_ok);
+
+    string upper = stringFromHex(string("DEADbeef00"));
+    ASSERT_TRUE("hex in either case",     stringlen(upper) == 5 && memcmp(upper.at, "\xde\xad\xbe\xef", 5) == 0);
+    destroyString(upper);
+    string bad = stringFromCharPtr("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1g");
+    string bad_result = stringFromHex(bad);
+    string odd_length = stringFromHex(string("abc"));
+    ASSERT_TRUE("invalid hex",            stringlen(bad_result) == 0 && stringlen(odd_length) == 0);
+    destroyString(odd_length);
+    destroyString(bad_result);
+    destroyString(bad);
+}
+
+// a scratch file of len bytes in a repeating pattern
+static bool write_temp_file(const char *path, size_t len) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return false;
+    for (size_t i = 0; i < len; i++) fputc('a' + i % 23, file);
+    return fclose(file) == 0;
+}
+
+static void test_map_file(void) {
+    printf("\n-- mapped files --\n");
+
+    // a page exactly, so that the terminator has to come from the spare page, and an odd size
+    size_t sizes[] = { 4096, 100003, 0 };
+    bool contents_ok = true, terminated = true, mapped = true;
+    for (size_t s = 0; s < 3; s++) {
+        const char *path = "chad_map_test.tmp";
+        if (!write_temp_file(path, sizes[s])) {
+            contents_ok = false;
+            continue;
+        }
+        option(string) file = stringMapFileWith(path, s == 1 ? string_map_sequential : string_map_normal);
+        remove(path);
+        if (!file.valid) {
+            contents_ok = false;
+            continue;
+        }
+        for (size_t i = 0; i < sizes[s]; i++) contents_ok &= file.value.at[i] == 'a' + (char)(i % 23);
+        contents_ok &= stringlen(file.value) == sizes[s];
+        terminated &= file.value.at[sizes[s]] == '\0';
+        mapped &= sizes[s] == 0 || (getHeaderPointer(file.value)->flags & string_mapped);
+        destroyString(file.value);
+    }
+    ASSERT_TRUE("mapped contents",        contents_ok);
+    ASSERT_TRUE("mapped and terminated",  mapped && terminated);
+
+    const char *path = "chad_map_test.tmp";
+    write_temp_file(path, 10000);
+    option(string) file = stringMapFileWith(path, string_map_random);
+    remove(path);
+    string shared = stringFromString(file.value);
+    ASSERT_TRUE("shared like any string", shared.data == file.value.data && getHeaderPointer(shared)->refcount == 2);
+    ASSERT_TRUE("searchable",             stringFind(file.value, string("vwabc")) == 21);
+    destroyString(shared);
+
+    // writes go to a private copy, even with a single owner
+    string appended = stringAppendCharPtr(stringFromString(file.value), "!");
+    string upper = stringToUpperInPlace(stringFromString(file.value));
+    ASSERT_TRUE("copied on write",        stringlen(appended) == 10001 && appended.at[10000] == '!'
+        && upper.at[0] == 'A' && file.value.at[0] == 'a' && getHeaderPointer(file.value)->refcount == 1);
+    destroyString(upper);
+    destroyString(appended);
+    string grown = stringAppendCharPtr(file.value, "?");
+    ASSERT_TRUE("sole owner copies too",  stringlen(grown) == 10001 && !(getHeaderPointer(grown)->flags & string_mapped));
+    destroyString(grown);
+
+    ASSERT_TRUE("missing file",           !stringMapFile("/nonexistent/chad").valid && !stringMapFile("/tmp").valid);
+}
+
+// the lines of text the way stringSplitLines cuts them, without its empty token after a final break
+static bool reader_matches_split(const char *text, size_t len, size_t buffer_size) {
+    FILE *file = tmpfile();
+    fwrite(text, 1, len, file);
+    rewind(file);
+    stringReader_t reader = stringReaderFromFile(file, buffer_size);
+    string whole = stringFromStrview(strviewFromParts(text, len));
+    dynarray(string) expected = stringSplitLines(whole);
+    size_t count = expected.count;
+    if (count > 0 && stringlen(expected.at[count - 1]) == 0) count--;
+    bool ok = true;
+    size_t i = 0;
+    strview line;
+    while (stringReaderNextLine(&reader, &line)) {
+        ok &= i < count && line.length == stringlen(expected.at[i]) && memcmp(line.at, expected.at[i].at, line.length) == 0;
+        i++;
+    }
+    ok &= i == count && !reader.failed;
+    foreach(string s of expected) destroyString(s);
+    destroy_dynarray(expected);
+    destroyString(whole);
+    destroyStringReader(&reader);
+    fclose(file);
+    return ok;
+}
+
+typedef struct {
+    int fd;
+    size_t lines;
+} pipe_writer_t;
+
+// writes numbered lines in small uneven pieces, like a process logging into a pipe
+static int pipe_writer(void *arg) {
+    pipe_writer_t *writer = arg;
+    char text[64];
+    for (size_t i = 0; i < writer->lines; i++) {
+        size_t len = (size_t)snprintf(text, sizeof text, "line %zu of the log\n", i);
+        for (size_t at = 0; at < len; at += 7) {
+            if (write(writer->fd, text + at, len - at < 7 ? len - at : 7) < 0) return 1;
+        }
+    }
+    close(writer->fd);
+    return 0;
+}
+
+static void test_reader(void) {
+    printf("\n-- streaming readers --\n");
+
+    const char *mixed = "alpha\nbeta\r\ngamma\rdelta\n\nlast";
+    ASSERT_TRUE("lines of every kind",    reader_matches_split(mixed, strlen(mixed), 0)
+        && reader_matches_split(mixed, strlen(mixed), 1));
+    ASSERT_TRUE("crlf across a refill",   reader_matches_split("abc\r\nd", 6, 4));
+
+    bool random_ok = true;
+    uint64_t seed = 31;
+    char text[400];
+    for (size_t round = 0; round < 300; round++) {
+        size_t len = round % 400;
+        for (size_t i = 0; i < len; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            text[i] = "ab\n\r"[(seed >> 60) % 4 == 0 ? (seed >> 40) % 4 : 0];
+        }
+        random_ok &= reader_matches_split(text, len, 1 + round % 40);
+    }
+    ASSERT_TRUE("random lines and buffers", random_ok);
+
+    FILE *file = tmpfile();
+    fputs("one||two|||three||", file);
+    rewind(file);
+    stringReader_t reader = stringReaderFromFile(file, 3);
+    strview record;
+    const char *want[] = { "one", "two", "|three" };
+    bool records_ok = true;
+    size_t count = 0;
+    while (stringReaderNextRecord(&reader, strview("||"), &record)) {
+        records_ok &= count < 3 && record.length == strlen(want[count]) && memcmp(record.at, want[count], record.length) == 0;
+        count++;
+    }
+    ASSERT_TRUE("records on a delimiter", records_ok && count == 3);
+    destroyStringReader(&reader);
+    fclose(file);
+
+    // a pipe filled while it is read, refills see whatever part of a line has arrived
+    int fds[2];
+    bool piped_ok = pipe(fds) == 0;
+    pipe_writer_t writer = { .fd = fds[1], .lines = 20000 };
+    thrd_t thread;
+    if (piped_ok) {
+        thrd_create(&thread, pipe_writer, &writer);
+        reader = stringReaderFromFd(fds[0], 64);
+        size_t line_number = 0;
+        strview line;
+        char expected[64];
+        while (stringReaderNextLine(&reader, &line)) {
+            size_t len = (size_t)snprintf(expected, sizeof expected, "line %zu of the log", line_number++);
+            piped_ok &= line.length == len && memcmp(line.at, expected, len) == 0;
+        }
+        thrd_join(thread, NULL);
+        piped_ok &= line_number == writer.lines && !reader.failed && reader.capacity == 64;
+        destroyStringReader(&reader);
+        close(fds[0]);
+    }
+    ASSERT_TRUE("lines from a pipe",      piped_ok);
+
+    // a line that arrived is returned while the writer still holds the pipe open
+    bool open_ok = pipe(fds) == 0;
+    FILE *stream = open_ok ? fdopen(fds[0], "r") : NULL;
+    if (stream != NULL) {
+        open_ok &= write(fds[1], "first\n", 6) == 6;
+        reader = stringReaderFromFile(stream, 0);
+        strview line;
+        open_ok &= stringReaderNextLine(&reader, &line) && strvieweql(line, strview("first"));
+        open_ok &= write(fds[1], "second\nthird", 12) == 12;
+        close(fds[1]);
+        open_ok &= stringReaderNextLine(&reader, &line) && strvieweql(line, strview("second"));
+        open_ok &= stringReaderNextLine(&reader, &line) && strvieweql(line, strview("third"));
+        open_ok &= !stringReaderNextLine(&reader, &line) && !reader.failed;
+        destroyStringReader(&reader);
+        fclose(stream);
+    }
+    ASSERT_TRUE("file reader does not wait for a full buffer", open_ok);
+
+    reader = stringReaderFromFd(-1, 0);
+    strview nothing;
+    ASSERT_TRUE("read errors end the input", !stringReaderNextLine(&reader, &nothing) && reader.failed);
+    destroyStringReader(&reader);
+}
+
+static int compare_strings(const void *a, const void *b) {
+    return stringcmp(*(const string *)a, *(const string *)b);
+}
+
+static bool sorts_like_qsort(size_t count, size_t threads, uint64_t seed) {
+    dynarray(string) strings = {};
+    char text[40];
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        // long shared prefixes, duplicates, empty strings and embedded zero bytes
+        size_t len = (seed >> 58) % 24;
+        for (size_t k = 0; k < len; k++) {
+            text[k] = k < 10 && (seed >> 50) % 3 != 0 ? 'p' : "ab\0z"[(seed >> (k * 2 % 48)) % 4];
+        }
+        dynarray_append(strings, stringFromStrview(strviewFromParts(text, len)));
+    }
+    string *expected = malloc(count * sizeof *expected + 1);
+    if (count > 0) memcpy(expected, strings.at, count * sizeof *expected);
+    qsort(expected, count, sizeof *expected, compare_strings);
+    if (threads == 1) {
+        stringSort(strings);
+    } else {
+        stringSortParallel(strings, threads);
+    }
+    bool ok = true;
+    for (size_t i = 0; i < count; i++) ok &= stringcmp(strings.at[i], expected[i]) == 0;
+    foreach(string s of strings) destroyString(s);
+    destroy_dynarray(strings);
+    free(expected);
+    return ok;
+}
+
+static void test_sort(void) {
+    printf("\n-- sorting --\n");
+
+    string empty = stringFromCharPtr(""), a = stringFromCharPtr("a"), ab = stringFromCharPtr("ab");
+    string with_zero = stringFromStrview(strviewFromParts("a\0", 2));
+    ASSERT_TRUE("compare by bytes then length", stringcmp(empty, a) < 0 && stringcmp(ab, a) > 0
+        && stringcmp(a, with_zero) < 0 && stringcmp(with_zero, ab) < 0 && stringcmp(a, a) == 0);
+    destroyString(with_zero);
+    destroyString(ab);
+    destroyString(a);
+    destroyString(empty);
+
+    string sentence = stringFromCharPtr("pear apple fig apple banana");
+    string space = stringFromCharPtr(" "), comma = stringFromCharPtr(",");
+    dynarray(string) words = stringSplit(sentence, space);
+    stringSort(words);
+    string joined = stringJoin(words, comma);
+    ASSERT_TRUE("sorts words",            str_ok(joined, "apple,apple,banana,fig,pear"));
+    destroyString(joined);
+    destroyString(comma);
+    destroyString(space);
+    destroyString(sentence);
+    foreach(string s of words) destroyString(s);
+    destroy_dynarray(words);
+
+    bool small_ok = true;
+    for (size_t count = 0; count < 60; count++) small_ok &= sorts_like_qsort(count, 1, count);
+    ASSERT_TRUE("small arrays",           small_ok);
+    ASSERT_TRUE("matches qsort",          sorts_like_qsort(50000, 1, 7));
+    ASSERT_TRUE("parallel matches qsort", sorts_like_qsort(200000, 4, 8) && sorts_like_qsort(100000, 0, 9));
+}
+
+static const char *reference_base64(const unsigned char *src, size_t len, char *out, bool url, bool pad) {
+    const char *chars = url ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+                            : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        size_t n = len - i < 3 ? len - i : 3;
+        uint32_t v = (uint32_t)src[i] << 16 | (n > 1 ? (uint32_t)src[i + 1] << 8 : 0) | (n > 2 ? src[i + 2] : 0);
+        for (size_t k = 0; k <= n; k++) out[o++] = chars[(v >> (18 - 6 * k)) & 63];
+        for (size_t k = n; pad && k < 3; k++) out[o++] = '=';
+    }
+    out[o] = '\0';
+    return out;
+}
+
+static bool decodes_to(const char *input, stringBase64Flags_t flags, const char *expected) {
+    string source = stringFromCharPtr(input);
+    option(string) decoded = stringBase64DecodeWith(source, flags);
+    destroyString(source);
+    if (!decoded.valid) return expected == NULL;
+    bool ok = expected != NULL && str_ok(decoded.value, expected);
+    destroyString(decoded.value);
+    return ok;
+}
+
+static void test_base64(void) {
+    printf("\n-- base64 --\n");
+
+    const char *plain[] = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+    const char *encoded[] = { "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy" };
+    bool vectors = true;
+    for (size_t i = 0; i < 7; i++) {
+        string source = stringFromCharPtr(plain[i]);
+        string e = stringBase64Encode(source);
+        vectors &= str_ok(e, encoded[i]) && decodes_to(encoded[i], string_base64_standard, plain[i]);
+        destroyString(e);
+        destroyString(source);
+    }
+    ASSERT_TRUE("rfc 4648 vectors",       vectors);
+    string no_pad = stringBase64EncodeWith(string("fooba"), string_base64_no_pad);
+    ASSERT_TRUE("no padding",             str_ok(no_pad, "Zm9vYmE") && decodes_to("Zm9vYmE", string_base64_no_pad, "fooba"));
+    destroyString(no_pad);
+    string url = stringBase64EncodeWith(string("\xfb\xff\xbf"), string_base64_url);
+    ASSERT_TRUE("url alphabet",           str_ok(url, "-_-_") && decodes_to("-_-_", string_base64_url, "\xfb\xff\xbf"));
+    destroyString(url);
+
+    ASSERT_TRUE("strict rejects",         decodes_to("Zm9", 0, NULL) && decodes_to("Zg=", 0, NULL)
+        && decodes_to("Zg", 0, NULL) && decodes_to("Zm9v\n", 0, NULL) && decodes_to("Z===", 0, NULL)
+        && decodes_to("Zh==", 0, NULL) && decodes_to("Zg==Zg==", 0, NULL) && decodes_to("-_-_", 0, NULL)
+        && decodes_to("+/+/", string_base64_url, NULL) && decodes_to("Zg==", string_base64_no_pad, NULL)
+        && decodes_to("Z", string_base64_lenient, NULL) && decodes_to("Zm9v!", string_base64_lenient, NULL));
+    ASSERT_TRUE("lenient accepts",        decodes_to(" Zm9v\r\nYmE ", string_base64_lenient, "fooba")
+        && decodes_to("Zg", string_base64_lenient, "f") && decodes_to("Zh==", string_base64_lenient, "f")
+        && decodes_to("-_+/", string_base64_lenient, "\xfb\xff\xbf"));
+
+    // long random inputs run through the vector kernels, every flag combination
+    unsigned char bytes[700];
+    char want[1000], wrapped[1100];
+    uint64_t seed = 11;
+    bool round_trips = true, wraps = true, bad_found = true;
+    for (size_t len = 0; len < sizeof bytes; len += 1 + len / 8) {
+        for (size_t i = 0; i < len; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            bytes[i] = (unsigned char)(seed >> 56);
+        }
+        string source = stringFromStrview(strviewFromParts((const char *)bytes, len));
+        for (stringBase64Flags_t flags = 0; flags < 4; flags++) {
+            string e = stringBase64EncodeWith(source, flags);
+            round_trips &= strcmp(e.at, reference_base64(bytes, len, want, flags & string_base64_url,
+                !(flags & string_base64_no_pad))) == 0;
+            option(string) d = stringBase64DecodeWith(e, flags);
+            round_trips &= d.valid && stringlen(d.value) == len && memcmp(d.value.at, bytes, len) == 0;
+            if (d.valid) destroyString(d.value);
+            // one bad character anywhere is found, also inside a vector block
+            if (stringlen(e) > 0) {
+                size_t at = (seed >> 20) % stringlen(e);
+                char saved = e.at[at];
+                e.at[at] = '*';
+                option(string) bad = stringBase64DecodeWith(e, flags);
+                bad_found &= !bad.valid;
+                e.at[at] = saved;
+            }
+            destroyString(e);
+        }
+        // 76 character lines as in MIME
+        size_t w = 0, n = strlen(reference_base64(bytes, len, want, false, true));
+        for (size_t i = 0; i < n; i++) {
+            wrapped[w++] = want[i];
+            if (i % 76 == 75) { wrapped[w++] = '\r'; wrapped[w++] = '\n'; }
+        }
+        wrapped[w] = '\0';
+        string lines = stringFromCharPtr(wrapped);
+        option(string) d = stringBase64DecodeWith(lines, string_base64_lenient);
+        wraps &= d.valid && stringlen(d.value) == len && memcmp(d.value.at, bytes, len) == 0;
+        if (d.valid) destroyString(d.value);
+        destroyString(lines);
+        destroyString(source);
+    }
+    ASSERT_TRUE("round trips",            round_trips);
+    ASSERT_TRUE("invalid characters",     bad_found);
+    ASSERT_TRUE("wrapped lines",          wraps);
+
+    // the same input in pieces of every size gives the same output
+    bool streams = true;
+    for (size_t piece = 1; piece < 80; piece += 7) {
+        stringBase64Stream_t enc = stringBase64StreamCreate(string_base64_url);
+        stringBuilder_t sb = stringBuilderCreateChunked(64);
+        for (size_t i = 0; i < sizeof bytes; i += piece) {
+            size_t n = sizeof bytes - i < piece ? sizeof bytes - i : piece;
+            stringBase64EncodeChunk(&enc, &sb, strviewFromParts((const char *)bytes + i, n));
+        }
+        stringBase64EncodeEnd(&enc, &sb);
+        string e = stringBuilderFinish(&sb);
+        streams &= strcmp(e.at, reference_base64(bytes, sizeof bytes, want, true, true)) == 0;
+
+        stringBase64Stream_t dec = stringBase64StreamCreate(string_base64_url);
+        stringBuilder_t out = stringBuilderCreate(0);
+        for (size_t i = 0; i < stringlen(e); i += piece) {
+            size_t n = stringlen(e) - i < piece ? stringlen(e) - i : piece;
+            streams &= stringBase64DecodeChunk(&dec, &out, strviewFromParts(e.at + i, n));
+        }
+        streams &= stringBase64DecodeEnd(&dec, &out);
+        string d = stringBuilderFinish(&out);
+        streams &= stringlen(d) == sizeof bytes && memcmp(d.at, bytes, sizeof bytes) == 0;
+        destroyString(d);
+        destroyString(e);
+    }
+    ASSERT_TRUE("streaming in pieces",    streams);
+
+    stringBase64Stream_t dec = stringBase64StreamCreate(0);
+    stringBuilder_t out = stringBuilderCreate(0);
+    bool first = stringBase64DecodeChunk(&dec, &out, strview("Zm9v"));
+    bool second = stringBase64DecodeChunk(&dec, &out, strview("Zm$v"));
+    bool third = stringBase64DecodeChunk(&dec, &out, strview("Zm9v"));
+    string d = stringBuilderFinish(&out);
+    ASSERT_TRUE("stream stops at error",  first && !second && !third && str_ok(d, "foo"));
+    destroyString(d);
+}
+
+static bool glob_ok(const char *pattern, const char *text) {
+    string pat = stringFromCharPtr(pattern);
+    stringGlob_t glob = stringGlobCompile(pat);
+    string str = stringFromCharPtr(text);
+    bool ret = stringGlobMatch(glob, str);
+    destroyString(str);
+    destroyString(pat);
+    destroyStringGlob(glob);
+    return ret;
+}
+
+static void test_glob(void) {
+    printf("\n-- globs --\n");
+
+    ASSERT_TRUE("literal",                glob_ok("abc", "abc") && !glob_ok("abc", "abd") && !glob_ok("abc", "ab"));
+    ASSERT_TRUE("empty",                  glob_ok("", "") && !glob_ok("", "a") && glob_ok("*", ""));
+    ASSERT_TRUE("question mark",          glob_ok("a?c", "abc") && !glob_ok("a?c", "ac") && !glob_ok("a?c", "a/c"));
+    ASSERT_TRUE("star",                   glob_ok("*.c", "str.c") && glob_ok("*.c", ".c") && !glob_ok("*.c", "src/str.c"));
+    ASSERT_TRUE("star in the middle",     glob_ok("a*b*c", "aXXbYYc") && glob_ok("a*b*c", "abbc") && !glob_ok("a*b*c", "acb"));
+    ASSERT_TRUE("double star",            glob_ok("src/**", "src/a/b.c") && glob_ok("**.c", "src/a/b.c"));
+    ASSERT_TRUE("double star segment",    glob_ok("a/**/b", "a/b") && glob_ok("a/**/b", "a/x/b")
+        && glob_ok("a/**/b", "a/x/y/b") && !glob_ok("a/**/b", "ab") && glob_ok("**/*.h", "chad.h"));
+    ASSERT_TRUE("class",                  glob_ok("[a-c]x", "bx") && !glob_ok("[a-c]x", "dx") && glob_ok("v[0-9][0-9]", "v42"));
+    ASSERT_TRUE("negated class",          glob_ok("[!a-c]x", "dx") && !glob_ok("[^a-c]x", "ax") && !glob_ok("[!a]", "/"));
+    ASSERT_TRUE("class edge cases",       glob_ok("[]]", "]") && glob_ok("[a-]", "-") && glob_ok("[\\]]", "]"));
+    ASSERT_TRUE("unterminated class",     glob_ok("[ab", "[ab") && !glob_ok("[ab", "a"));
+    ASSERT_TRUE("alternatives",           glob_ok("*.{c,h}", "str.h") && glob_ok("*.{c,h}", "str.c") && !glob_ok("*.{c,h}", "str.o"));
+    ASSERT_TRUE("nested alternatives",    glob_ok("{a,b{c,d}}x", "bdx") && glob_ok("{a,b{c,d}}x", "ax") && !glob_ok("{a,b{c,d}}x", "bx"));
+    ASSERT_TRUE("empty alternative",      glob_ok("a{,b}", "a") && glob_ok("a{,b}", "ab"));
+    ASSERT_TRUE("unterminated brace",     glob_ok("{a,b", "{a,b") && glob_ok("a,b}", "a,b}"));
+    ASSERT_TRUE("escapes",                glob_ok("\\*", "*") && !glob_ok("\\*", "a") && glob_ok("a\\", "a\\"));
+    ASSERT_TRUE("stringMatchGlob",        stringMatchGlob(string("include/chad/str.h"), string("include/**/*.[ch]")));
+
+    // without '/' in the text, * and ? agree with stringMatchWildcard
+    uint64_t seed = 5;
+    bool agrees = true;
+    char pattern[12], text[16];
+    for (size_t round = 0; round < 4000 && agrees; round++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        size_t plen = (seed >> 33) % sizeof pattern;
+        size_t tlen = (seed >> 45) % sizeof text;
+        for (size_t i = 0; i < plen; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            pattern[i] = "ab*?"[(seed >> 33) % 4];
+        }
+        for (size_t i = 0; i < tlen; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            text[i] = "ab"[(seed >> 33) % 2];
+        }
+        string p = stringFromStrview(strviewFromParts(pattern, plen));
+        string t = stringFromStrview(strviewFromParts(text, tlen));
+        agrees &= stringMatchGlob(t, p) == stringMatchWildcard(t, p);
+        destroyString(p);
+        destroyString(t);
+    }
+    ASSERT_TRUE("agrees with wildcard",   agrees);
+
+    // the n-th character from the end has 2^n dfa states, too many to build
+    ASSERT_TRUE("automaton fallback",     glob_ok("**a?????????????????", "xxabbbbbbbbbbbbbbbbb")
+        && !glob_ok("**a?????????????????", "xxbabbbbbbbbbbbbbbbb")
+        && glob_ok("**a?????????????????", "baabbbbaabababababab"));
+    // the alternative at the end gives the pattern several accepting positions
+    ASSERT_TRUE("automaton fallback alternative", glob_ok("**a?????????????????{x,?}", "xxabbbbbbbbbbbbbbbbbx")
+        && glob_ok("**a?????????????????{x,?}", "xxabbbbbbbbbbbbbbbbby")
+        && !glob_ok("**a?????????????????{x,?}", "xxbbbbbbbbbbbbbbbbbbx"));
+
+    dynarray(string) routes = {};
+    const char *route_patterns[] = { "/api/v1/users/*", "/api/v1/**", "/static/**.{css,js}", "/api/v[0-9]/users/*/posts", "**" };
+    for (size_t i = 0; i < sizeof route_patterns / sizeof route_patterns[0]; i++) {
+        dynarray_append(routes, stringFromCharPtr(route_patterns[i]));
+    }
+    stringGlob_t set = stringGlobCompileSet(routes);
+    ASSERT_TRUE("set first match",        stringGlobMatchFirst(set, string("/api/v1/users/42")) == 0
+        && stringGlobMatchFirst(set, string("/api/v2/users/42/posts")) == 3
+        && stringGlobMatchFirst(set, string("/static/css/site.css")) == 2
+        && stringGlobMatchFirst(set, string("/favicon.ico")) == 4);
+    dynarray(size_t) all = stringGlobMatchAll(set, string("/api/v1/users/42/posts"));
+    ASSERT_TRUE("set all matches",        all.count == 3 && all.at[0] == 1 && all.at[1] == 3 && all.at[2] == 4);
+    destroy_dynarray(all);
+    destroyStringGlob(set);
+    destroyString(routes.at[4]);
+    routes.count--;
+    set = stringGlobCompileSet(routes);
+    ASSERT_TRUE("set without match",      stringGlobMatchFirst(set, string("/favicon.ico")) == -1
+        && !stringGlobMatch(set, string("")) && stringGlobMatch(set, string("/api/v1/")));
+    destroyStringGlob(set);
+    for (size_t i = 0; i < routes.count; i++) destroyString(routes.at[i]);
+    destroy_dynarray(routes);
+}
+
+static size_t reference_levenshtein(const char *a, size_t n, const char *b, size_t m) {
+    size_t *row = malloc((m + 1) * sizeof(size_t));
+    for (size_t j = 0; j <= m; j++) row[j] = j;
+    for (size_t i = 1; i <= n; i++) {
+        size_t diagonal = row[0];
+        row[0] = i;
+        for (size_t j = 1; j <= m; j++) {
+            size_t above = row[j];
+            size_t best = diagonal + (a[i - 1] != b[j - 1]);
+            if (above + 1 < best) best = above + 1;
+            if (row[j - 1] + 1 < best) best = row[j - 1] + 1;
+            row[j] = best;
+            diagonal = above;
+        }
+    }
+    size_t distance = row[m];
+    free(row);
+    return distance;
+}
+
+static void test_levenshtein(void) {
+    printf("\n-- levenshtein --\n");
+
+    ASSERT_TRUE("kitten sitting",         stringLevenshteinDistance(string("kitten"), string("sitting")) == 3);
+    ASSERT_TRUE("empty sides",            stringLevenshteinDistance(string(""), string("abc")) == 3
+        && stringLevenshteinDistance(string("abc"), string("")) == 3
+        && stringLevenshteinDistance(string(""), string("")) == 0);
+    ASSERT_TRUE("bounded within",         stringLevenshteinBounded(string("kitten"), string("sitting"), 3) == 3);
+    ASSERT_TRUE("bounded past",           stringLevenshteinBounded(string("kitten"), string("sitting"), 2) == 3);
+    ASSERT_TRUE("bounded length gap",     stringLevenshteinBounded(string("a"), string("abcdefgh"), 4) == 5);
+
+    // lengths on both sides of one and two words, small alphabets so that matches are common
+    uint64_t seed = 99;
+    bool exact = true, bounded = true;
+    char a[200], b[200];
+    for (size_t round = 0; round < 600; round++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        size_t n = (seed >> 33) % sizeof a;
+        size_t alphabet = 2 + (seed >> 50) % 6;
+        for (size_t i = 0; i < n; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            a[i] = 'a' + (seed >> 33) % alphabet;
+        }
+        // b is a mutation of a, or unrelated every fourth round
+        size_t m = 0;
+        for (size_t i = 0; i < n && m < sizeof b; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            unsigned roll = (seed >> 33) % 16;
+            if (round % 4 == 0) b[m++] = 'a' + (seed >> 40) % alphabet;
+            else if (roll == 0) continue;
+            else if (roll == 1) b[m++] = 'z';
+            else if (roll == 2 && m + 1 < sizeof b) { b[m++] = 'y'; b[m++] = a[i]; }
+            else b[m++] = a[i];
+        }
+        string sa = stringFromStrview(strviewFromParts(a, n));
+        string sb = stringFromStrview(strviewFromParts(b, m));
+        size_t want = reference_levenshtein(a, n, b, m);
+        exact &= stringLevenshteinDistance(sa, sb) == want && stringLevenshteinDistance(sb, sa) == want;
+        size_t max = round % 20;
+        size_t got = stringLevenshteinBounded(sa, sb, max);
+        bounded &= want <= max ? got == want : got == max + 1;
+        if (!exact || !bounded) {
+            printf("    n=%zu m=%zu want %zu\n", n, m, want);
+            destroyString(sa);
+            destroyString(sb);
+            break;
+        }
+        destroyString(sa);
+        destroyString(sb);
+    }
+    ASSERT_TRUE("matches the dp table",   exact);
+    ASSERT_TRUE("bounded agrees",         bounded);
+
+    dynarray(string) names = {};
+    const char *words[] = { "expression", "expressions", "statement", "express", "impression",
+                            "term", "factor", "expresion", "repression" };
+    for (size_t i = 0; i < sizeof words / sizeof words[0]; i++) {
+        dynarray_append(names, stringFromCharPtr(words[i]));
+    }
+    dynarray(stringFuzzyMatch_t) top = stringClosestMatches(string("expresson"), names, 3, 3);
+    ASSERT_TRUE("top k nearest first",    top.count == 3
+        && top.at[0].index == 0 && top.at[0].distance == 1
+        && top.at[1].index == 7 && top.at[1].distance == 1
+        && top.at[2].index == 1 && top.at[2].distance == 2);
+    destroy_dynarray(top);
+    top = stringClosestMatches(string("factr"), names, 5, 1);
+    ASSERT_TRUE("max distance filters",   top.count == 1 && top.at[0].index == 6);
+    destroy_dynarray(top);
+    top = stringClosestMatches(string("zzzzzzzz"), names, 2, 2);
+    ASSERT_TRUE("nothing close enough",   top.count == 0);
+    destroy_dynarray(top);
+    for (size_t i = 0; i < names.count; i++) destroyString(names.at[i]);
+    destroy_dynarray(names);
+}
+
 int test_str(void) {
     test_from_charptr();
     test_from_string();
     test_concat();
     test_append();
     test_append_many();
+    test_small_strings();
+    test_allocators();
     test_slice();
+    test_strview();
+    test_hash();
+    test_intern();
+    test_cow();
+    test_builder();
     test_cmp();
     test_find();
+    test_search();
     test_tokenize();
+    test_split_iter();
     test_replace();
+    test_replace_many();
     test_trim();
     test_grow_buffer();
+    test_reserve();
     test_reverse();
     test_join();
     test_format();
     test_utf8();
+    test_utf8_validate();
+    test_utf8_index();
+    test_ascii();
+    test_numbers();
+    test_parse_numbers();
+    test_escape_hex();
+    test_map_file();
+    test_reader();
+    test_sort();
+    test_base64();
+    test_glob();
+    test_levenshtein();
 
     printf("\n");
     if (failed == 0) {
@@ -0,0 +1,202 @@
+#include "../include/chad/strindex.h"
+#include "../include/chad/str.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static int passed = 0;
+static int failed = 0;
+
+#define ASSERT_TRUE(label, expr) do { \
+    if (expr) { \
+        printf("\033[32m✓\033[0m " label "\n"); \
+        passed++; \
+    } else { \
+        printf("\033[31m✗\033[0m " label "\n"); \
+        failed++; \
+    } \
+} while(0)
+
+static const stringIndexFlags_t all_modes[] = {
+    string_index_suffix_array, string_index_fm, string_index_suffix_array | string_index_fm,
+};
+
+static bool view_is(strview view, const char *expected) {
+    return view.length == strlen(expected) && memcmp(view.at, expected, view.length) == 0;
+}
+
+// locate checked against a scan of every offset, count against locate
+static bool finds_like_scan(stringIndex_t index, const char *text, size_t length, strview pattern) {
+    dynarray(size_t) found = stringIndexLocate(index, pattern);
+    size_t expected = 0;
+    bool ok = true;
+    for (size_t i = 0; pattern.length > 0 && i + pattern.length <= length; i++) {
+        if (memcmp(text + i, pattern.at, pattern.length) != 0) continue;
+        ok &= expected < found.count && found.at[expected] == i;
+        expected++;
+    }
+    ok &= found.count == expected && stringIndexCount(index, pattern) == expected;
+    destroy_dynarray(found);
+    return ok;
+}
+
+static size_t longest_repeat_by_scan(const char *text, size_t length) {
+    size_t best = 0;
+    for (size_t i = 0; i < length; i++) {
+        for (size_t j = i + 1; j < length; j++) {
+            size_t k = 0;
+            while (j + k < length && text[i + k] == text[j + k]) k++;
+            if (k > best) best = k;
+        }
+    }
+    return best;
+}
+
+static void test_index_basic(void) {
+    printf("\n-- Index Basic --\n");
+
+    string text = stringFromCharPtr("banana bandana");
+    for (size_t m = 0; m < 3; m++) {
+        stringIndex_t index = stringIndexBuildWith(text, all_modes[m]);
+        dynarray(size_t) found = stringIndexLocate(index, strview("ana"));
+        ASSERT_TRUE("overlapping occurrences", stringIndexCount(index, strview("ana")) == 3
+            && found.count == 3 && found.at[0] == 1 && found.at[1] == 3 && found.at[2] == 11);
+        destroy_dynarray(found);
+        ASSERT_TRUE("missing pattern",         stringIndexCount(index, strview("nab")) == 0
+            && stringIndexCount(index, strview("banana bandanas")) == 0);
+        ASSERT_TRUE("empty pattern",           stringIndexCount(index, strview("")) == 0);
+        ASSERT_TRUE("whole text",              stringIndexCount(index, strview("banana bandana")) == 1);
+        strview repeat = stringIndexLongestRepeat(index);
+        ASSERT_TRUE("longest repeat",          repeat.length == 3 && stringIndexCount(index, repeat) >= 2);
+        destroyStringIndex(index);
+    }
+    ASSERT_TRUE("text is shared",          getHeaderPointer(text)->refcount == 1);
+    destroyString(text);
+
+    string empty = stringFromCharPtr("");
+    stringIndex_t index = stringIndexBuildWith(empty, string_index_suffix_array | string_index_fm);
+    ASSERT_TRUE("empty text",              stringIndexCount(index, strview("a")) == 0
+        && stringIndexLongestRepeat(index).length == 0 && stringIndexText(index).length == 0);
+    destroyStringIndex(index);
+    destroyString(empty);
+
+    string zeros = stringFromStrview(strviewFromParts("a\0b\0a\0b", 7));
+    index = stringIndexBuildWith(zeros, string_index_fm);
+    ASSERT_TRUE("embedded zero bytes",     stringIndexCount(index, strviewFromParts("\0", 1)) == 3
+        && stringIndexCount(index, strviewFromParts("b\0a", 3)) == 1
+        && stringIndexLongestRepeat(index).length == 3
+        && memcmp(stringIndexLongestRepeat(index).at, "a\0b", 3) == 0);
+    destroyStringIndex(index);
+    destroyString(zeros);
+}
+
+static void test_index_random(void) {
+    printf("\n-- Index Random Texts --\n");
+
+    enum { length = 3000 };
+    char text[length];
+    uint64_t seed = 99;
+    bool finds_ok = true, repeat_ok = true;
+    for (size_t round = 0; round < 24; round++) {
+        // alphabets from a single byte up to all 256, long runs and periodic stretches
+        size_t n = round < 8 ? round * 7 : length - round * 50;
+        size_t alphabet = 1 + round % 5 * (round % 5) * 12;
+        for (size_t i = 0; i < n; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            text[i] = (char)((seed >> 33) % alphabet);
+            if (round % 3 == 0 && i >= 40 && (seed >> 20) % 4 != 0) text[i] = text[i - 40];
+        }
+        string str = stringFromStrview(strviewFromParts(text, n));
+        for (size_t m = 0; m < 3; m++) {
+            stringIndex_t index = stringIndexBuildWith(str, all_modes[m]);
+            for (size_t q = 0; q < 40 && n > 0; q++) {
+                seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+                size_t at = (seed >> 33) % n, len = 1 + (seed >> 20) % 12;
+                if (at + len > n) len = n - at;
+                finds_ok &= finds_like_scan(index, text, n, strviewFromParts(text + at, len));
+                // a pattern that is unlikely to occur
+                char probe[3] = { text[at], (char)(alphabet + 1), text[at] };
+                finds_ok &= finds_like_scan(index, text, n, strviewFromParts(probe, 3));
+            }
+            if (n <= 600) {
+                strview repeat = stringIndexLongestRepeat(index);
+                repeat_ok &= repeat.length == longest_repeat_by_scan(text, n)
+                    && (repeat.length == 0 || stringIndexCount(index, repeat) >= 2);
+            }
+            destroyStringIndex(index);
+        }
+        destroyString(str);
+    }
+    ASSERT_TRUE("count and locate match a scan", finds_ok);
+    ASSERT_TRUE("longest repeat matches a scan", repeat_ok);
+}
+
+static void test_index_save_load(void) {
+    printf("\n-- Index Save and Load --\n");
+
+    const char *path = "chad_index_test.tmp";
+    string text = stringFromCharPtr("the quick brown fox jumps over the lazy dog, the end");
+    for (size_t m = 0; m < 3; m++) {
+        stringIndex_t index = stringIndexBuildWith(text, all_modes[m]);
+        bool saved = stringIndexSave(index, path);
+        destroyStringIndex(index);
+        option(stringIndex_t) loaded = stringIndexLoad(path);
+        ASSERT_TRUE("round trip",              saved && loaded.valid);
+        if (!loaded.valid) continue;
+        ASSERT_TRUE("loaded text",             view_is(stringIndexText(loaded.value), text.at));
+        ASSERT_TRUE("loaded queries",          finds_like_scan(loaded.value, text.at, stringlen(text), strview("the"))
+            && finds_like_scan(loaded.value, text.at, stringlen(text), strview("o"))
+            && view_is(stringIndexLongestRepeat(loaded.value), " the "));
+        destroyStringIndex(loaded.value);
+    }
+
+    // header fields patched in place: magic, order and flags take 16 bytes, then length,
+    // repeat_offset and repeat_length, primary, sample_count, zeros[8] and counts[256]
+    stringIndex_t index = stringIndexBuildWith(text, string_index_fm);
+    uint64_t wrapping[2] = { 2, UINT64_MAX };
+    stringIndexSave(index, path);
+    FILE *file = fopen(path, "r+b");
+    fseek(file, 24, SEEK_SET);
+    fwrite(wrapping, sizeof wrapping, 1, file);
+    fclose(file);
+    option(stringIndex_t) wrapped = stringIndexLoad(path);
+    ASSERT_TRUE("wrapping repeat rejected", !wrapped.valid);
+    uint64_t count = UINT64_MAX / 2;
+    stringIndexSave(index, path);
+    file = fopen(path, "r+b");
+    fseek(file, 56 + 8 * 8 + 'q' * 8, SEEK_SET);
+    fwrite(&count, sizeof count, 1, file);
+    fclose(file);
+    option(stringIndex_t) bad_counts = stringIndexLoad(path);
+    ASSERT_TRUE("out of range counts rejected", !bad_counts.valid);
+    destroyStringIndex(index);
+    destroyString(text);
+
+    file = fopen(path, "r+b");
+    fputc('X', file);
+    fclose(file);
+    option(stringIndex_t) corrupt = stringIndexLoad(path);
+    ASSERT_TRUE("bad magic rejected",      !corrupt.valid);
+    file = fopen(path, "wb");
+    fputs("chadidx1", file);
+    fclose(file);
+    option(stringIndex_t) truncated = stringIndexLoad(path);
+    ASSERT_TRUE("truncated file rejected", !truncated.valid);
+    remove(path);
+    option(stringIndex_t) missing = stringIndexLoad(path);
+    ASSERT_TRUE("missing file",            !missing.valid);
+}
+
+int test_strindex(void) {
+    test_index_basic();
+    test_index_random();
+    test_index_save_load();
+
+    printf("\n");
+    if (failed == 0) {
+        printf("\033[32mAll %d index tests passed.\033[0m\n", passed);
+    } else {
+        printf("\033[31m%d/%d index tests FAILED.\033[0m\n", failed, passed + failed);
+    }
+    return failed == 0 ? 0 : 1;
+}